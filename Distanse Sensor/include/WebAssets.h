@@ -0,0 +1,677 @@
+#pragma once
+
+/*
+   Web UI assets, generated by scripts/build_web.py from web/.
+   Do not edit: change the files in web/ and rebuild.
+*/
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+
+struct WebAsset {
+  const char* contentType;
+  const char* etag;      // quoted CRC32 of the gzip data
+  const uint8_t* data;   // gzip stream in PROGMEM
+  size_t size;
+};
+
+// index.html: 2524 bytes, 2371 minified, 860 gzip'd
+constexpr uint8_t WEB_INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x56, 0x6d, 0x6f, 0xdb, 0x36,
+  0x10, 0xfe, 0x2b, 0x37, 0x7d, 0x49, 0x07, 0xcc, 0x15, 0xda, 0x0f, 0xc5, 0x50, 0xc8, 0x1a, 0x52,
+  0x3b, 0xc3, 0x06, 0x34, 0x8d, 0x17, 0xa7, 0x75, 0xfb, 0x91, 0x16, 0xcf, 0x16, 0x17, 0x4a, 0x14,
+  0x48, 0xca, 0xaa, 0x81, 0xfd, 0xf8, 0x1d, 0x29, 0xc9, 0xa6, 0x25, 0xc5, 0x68, 0x0d, 0xc4, 0x70,
+  0xee, 0xee, 0x39, 0xde, 0x3d, 0xbc, 0x17, 0x26, 0xbf, 0x2c, 0x1f, 0x16, 0x4f, 0xdf, 0x56, 0x77,
+  0x90, 0xdb, 0x42, 0xa6, 0x49, 0xf7, 0x8d, 0x8c, 0xa7, 0x49, 0x81, 0x96, 0x41, 0xc9, 0x0a, 0x9c,
+  0xdf, 0x1c, 0x04, 0x36, 0x95, 0xd2, 0xf6, 0x06, 0x32, 0x55, 0x5a, 0x2c, 0xed, 0xfc, 0xa6, 0x11,
+  0xdc, 0xe6, 0x73, 0x8e, 0x07, 0x91, 0xe1, 0xcc, 0xff, 0xf3, 0x9b, 0x28, 0x85, 0x15, 0x4c, 0xce,
+  0x4c, 0xc6, 0x24, 0xce, 0xdf, 0xdc, 0xc4, 0x69, 0x62, 0x85, 0x95, 0x98, 0xde, 0xad, 0x57, 0xbf,
+  0xbf, 0x7d, 0xf7, 0x0e, 0xd6, 0x68, 0xad, 0x28, 0xf7, 0x26, 0x89, 0x5b, 0x79, 0x22, 0x45, 0xf9,
+  0x0c, 0x1a, 0xe5, 0x3c, 0x32, 0xf6, 0x28, 0xd1, 0xe4, 0x88, 0x36, 0x82, 0x5c, 0xe3, 0x6e, 0x1e,
+  0xc5, 0x5e, 0xf4, 0x3a, 0x33, 0x26, 0x4a, 0x13, 0x93, 0x69, 0x51, 0x59, 0x30, 0x3a, 0x23, 0x05,
+  0xab, 0xaa, 0xd7, 0xff, 0x9a, 0x08, 0x38, 0xee, 0x50, 0xa7, 0x49, 0xdc, 0x2a, 0xe9, 0x47, 0x1b,
+  0xf7, 0x56, 0xf1, 0x23, 0x70, 0x66, 0xd9, 0xac, 0x62, 0x7b, 0x74, 0xae, 0x99, 0xad, 0x9d, 0x93,
+  0xfc, 0xed, 0x29, 0x92, 0xa5, 0x20, 0x69, 0x99, 0x21, 0x85, 0x54, 0x1a, 0xa5, 0x83, 0xc8, 0xc8,
+  0x28, 0xe1, 0xe2, 0x00, 0x99, 0x64, 0xc6, 0xcc, 0x23, 0xca, 0x77, 0x27, 0xf6, 0xb5, 0x46, 0x4e,
+  0x0e, 0x2a, 0x72, 0x9e, 0x2e, 0x7d, 0xca, 0x70, 0x7f, 0xbb, 0x80, 0x5b, 0xce, 0x35, 0x1a, 0x83,
+  0xe6, 0x7d, 0x12, 0x6f, 0xe9, 0xfc, 0xea, 0x02, 0x5a, 0xb0, 0x6c, 0x26, 0xca, 0x9d, 0x72, 0xe1,
+  0x5b, 0xad, 0xca, 0x7d, 0xba, 0x11, 0x7f, 0x0a, 0x07, 0x24, 0xf3, 0x4e, 0x02, 0x89, 0xa9, 0x58,
+  0x09, 0x82, 0xcf, 0xa3, 0x46, 0xec, 0xc4, 0x3d, 0xcb, 0x22, 0x97, 0x10, 0xc9, 0xe8, 0x28, 0x7d,
+  0x02, 0x52, 0xd8, 0xb3, 0x4f, 0x0f, 0x9b, 0x17, 0xb1, 0x68, 0xaa, 0x4f, 0xaa, 0x09, 0xd1, 0xf0,
+  0xea, 0xb3, 0x41, 0xb0, 0xb9, 0x30, 0xb0, 0xa3, 0xfc, 0x7a, 0x07, 0x7d, 0x3a, 0xcc, 0x0a, 0x55,
+  0xfe, 0x0a, 0x49, 0x4c, 0xf1, 0x76, 0x79, 0xad, 0x3d, 0x4d, 0x3e, 0x13, 0xd8, 0x60, 0xa1, 0x0c,
+  0x10, 0xf6, 0x9c, 0x3e, 0x30, 0xa9, 0x89, 0xde, 0xa3, 0xcf, 0xb2, 0x85, 0x05, 0xb9, 0x36, 0x4c,
+  0x97, 0xc4, 0x5f, 0xcf, 0xd1, 0xa2, 0xd6, 0x9a, 0xaa, 0x04, 0x16, 0xe1, 0x71, 0x67, 0x92, 0x6a,
+  0xe9, 0xae, 0xde, 0x19, 0xae, 0x98, 0xb7, 0x6b, 0xf3, 0xda, 0x86, 0x29, 0x55, 0x5e, 0x73, 0x41,
+  0x48, 0xec, 0x30, 0x2d, 0xee, 0x11, 0x77, 0xc4, 0x7c, 0x0e, 0x8f, 0xcc, 0xe2, 0x10, 0xa9, 0x5b,
+  0x9d, 0x53, 0x4d, 0x62, 0x3f, 0x30, 0x0a, 0x4e, 0xc2, 0x5f, 0x28, 0xf6, 0xb9, 0x1d, 0x82, 0xb7,
+  0x5e, 0xd9, 0xea, 0xce, 0x64, 0x66, 0x45, 0xe8, 0xa0, 0xab, 0x99, 0x69, 0x07, 0x85, 0xaa, 0x4b,
+  0x3b, 0x79, 0xee, 0x13, 0x2b, 0x9f, 0x87, 0xd6, 0x54, 0x84, 0xcf, 0x93, 0xc6, 0xed, 0x19, 0x43,
+  0x73, 0xe3, 0xa5, 0xeb, 0xbe, 0xa0, 0xc7, 0xb0, 0x5b, 0xa1, 0xe1, 0x09, 0x8b, 0x0a, 0x89, 0x72,
+  0xba, 0xb5, 0xd1, 0x71, 0x67, 0xd5, 0x34, 0x35, 0xb5, 0x36, 0x63, 0x4a, 0x9c, 0x70, 0xd2, 0xbc,
+  0xaf, 0xaa, 0x0f, 0xcc, 0x66, 0x39, 0x5d, 0xff, 0x98, 0x4c, 0x92, 0x5f, 0x45, 0x3e, 0xa2, 0x1b,
+  0x2b, 0x66, 0x7c, 0x85, 0x5e, 0xfc, 0xc2, 0xf5, 0x59, 0x8b, 0xfa, 0x08, 0xf7, 0x8a, 0x8f, 0xf2,
+  0x93, 0xaa, 0x59, 0xa9, 0x06, 0xf5, 0x24, 0xf0, 0xe3, 0xdd, 0x12, 0xc2, 0x22, 0x0f, 0x60, 0xc8,
+  0xaf, 0x70, 0xea, 0xbb, 0x76, 0xbd, 0xfe, 0x7b, 0x39, 0xba, 0x0d, 0x23, 0xf8, 0x8a, 0xaa, 0x4d,
+  0x7c, 0x3f, 0xe1, 0xbe, 0xfa, 0xcf, 0x08, 0xbd, 0xa2, 0x26, 0x69, 0x94, 0xe6, 0xe3, 0x22, 0x6f,
+  0xe5, 0x57, 0x39, 0x9a, 0x8e, 0xb9, 0x6d, 0xf9, 0xab, 0xc0, 0x25, 0x4a, 0x71, 0x20, 0xaa, 0x86,
+  0x50, 0xde, 0xc9, 0x07, 0xe0, 0xd8, 0xb5, 0xe5, 0xa8, 0xb3, 0xdb, 0x92, 0x1b, 0x36, 0xf6, 0x86,
+  0x9a, 0x4b, 0xc3, 0x47, 0x3c, 0xa0, 0x9c, 0x9c, 0x7d, 0xd2, 0x69, 0xa2, 0x76, 0xae, 0x39, 0x53,
+  0x6f, 0x19, 0xf5, 0xee, 0xab, 0xd3, 0x74, 0x65, 0x95, 0x9b, 0x0c, 0x6e, 0x42, 0x16, 0x4c, 0xca,
+  0xf4, 0x8b, 0x92, 0x75, 0x81, 0xef, 0x83, 0x58, 0x0f, 0x5e, 0x72, 0xee, 0xc4, 0xff, 0x4e, 0xa3,
+  0x3b, 0xb4, 0xe2, 0x9d, 0xec, 0xb2, 0x63, 0x5b, 0x9f, 0x3e, 0xb4, 0x17, 0x4f, 0xbc, 0xcb, 0x72,
+  0x05, 0xff, 0xd4, 0x4c, 0x0a, 0x7b, 0x0c, 0x3d, 0x22, 0xc9, 0x03, 0x7e, 0x7e, 0xc4, 0xd5, 0x13,
+  0x31, 0xc3, 0x43, 0x1f, 0xd6, 0x09, 0x7e, 0xd2, 0xc9, 0x83, 0xcd, 0x51, 0x77, 0x5b, 0xc9, 0x84,
+  0xce, 0x94, 0x53, 0x74, 0xf2, 0x69, 0x9f, 0xc1, 0x2c, 0xdf, 0xe4, 0xcc, 0x42, 0xa3, 0x6a, 0xc9,
+  0xe1, 0xa8, 0x6a, 0x90, 0xe2, 0x99, 0x76, 0x81, 0x02, 0xae, 0xfe, 0x38, 0x5d, 0x16, 0xeb, 0xd7,
+  0x6c, 0x5d, 0x71, 0x37, 0x29, 0xfb, 0x80, 0xb6, 0xb6, 0x04, 0xfa, 0x9b, 0x55, 0x5a, 0x14, 0xcc,
+  0xd5, 0xc8, 0x67, 0xaf, 0x0f, 0x36, 0x24, 0x0b, 0xc0, 0x34, 0x68, 0xdd, 0xc6, 0x1e, 0x60, 0x4f,
+  0xdb, 0xe0, 0xd1, 0xa9, 0xdd, 0xc9, 0x4b, 0xdc, 0xb1, 0x5a, 0xda, 0x4b, 0x70, 0x57, 0x5a, 0x43,
+  0xb4, 0xa9, 0xb3, 0x0c, 0xdd, 0xd6, 0xff, 0x42, 0xaf, 0x8e, 0xb0, 0xd2, 0x2e, 0xd1, 0xf4, 0xc8,
+  0x10, 0x5b, 0x7d, 0x35, 0xf4, 0x45, 0x6f, 0xd2, 0x11, 0x7a, 0xe9, 0x80, 0xe3, 0xb6, 0xde, 0xd3,
+  0x92, 0x7e, 0x19, 0xbf, 0x74, 0x16, 0x97, 0x9b, 0xde, 0xbb, 0x88, 0xdd, 0x13, 0xc3, 0xbd, 0x37,
+  0xdc, 0x6b, 0xe9, 0x7f, 0x18, 0xcc, 0x4c, 0x25, 0x43, 0x09, 0x00, 0x00,
+};
+constexpr WebAsset WEB_INDEX_HTML = {"text/html", "\"26a9dbf9\"", WEB_INDEX_HTML_GZ, sizeof(WEB_INDEX_HTML_GZ)};
+
+// update.html: 9497 bytes, 8738 minified, 2710 gzip'd
+constexpr uint8_t WEB_UPDATE_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5a, 0x8d, 0x6f, 0xdb, 0xba,
+  0x11, 0xff, 0x57, 0x6e, 0x06, 0xde, 0x8b, 0x0b, 0x38, 0xfe, 0x4a, 0x93, 0x97, 0xb5, 0xb6, 0x81,
+  0x24, 0x4e, 0xd6, 0x0e, 0x4d, 0x13, 0xc4, 0x29, 0xd2, 0x61, 0x18, 0x1e, 0x68, 0x89, 0xb6, 0xb9,
+  0x48, 0xa2, 0x46, 0x52, 0x71, 0xfc, 0xdf, 0xef, 0x8e, 0x1f, 0x92, 0x9c, 0xc4, 0x4e, 0x9c, 0xe1,
+  0x61, 0x5b, 0xd1, 0xd6, 0x26, 0x45, 0x1e, 0xef, 0x7e, 0xf7, 0xc9, 0x93, 0x07, 0x7f, 0x1a, 0x5f,
+  0x9d, 0xdd, 0xfe, 0xed, 0xfa, 0x1c, 0x16, 0x26, 0x4d, 0x46, 0x03, 0xff, 0x3f, 0x67, 0xf1, 0x68,
+  0x90, 0x72, 0xc3, 0x20, 0x63, 0x29, 0x1f, 0xee, 0x3d, 0x08, 0xbe, 0xcc, 0xa5, 0x32, 0x7b, 0x10,
+  0xc9, 0xcc, 0xf0, 0xcc, 0x0c, 0xf7, 0x96, 0x22, 0x36, 0x8b, 0x61, 0xcc, 0x1f, 0x44, 0xc4, 0xf7,
+  0xed, 0xa0, 0x25, 0x32, 0x61, 0x04, 0x4b, 0xf6, 0x75, 0xc4, 0x12, 0x3e, 0xec, 0xed, 0x75, 0x46,
+  0x03, 0x23, 0x4c, 0xc2, 0x47, 0xe7, 0x93, 0xeb, 0xe3, 0xfe, 0xd1, 0x11, 0x4c, 0xb8, 0x31, 0x22,
+  0x9b, 0x6b, 0xd8, 0x87, 0x1f, 0x79, 0xcc, 0x0c, 0x1f, 0x74, 0xdc, 0x82, 0x41, 0x22, 0xb2, 0x7b,
+  0x50, 0x3c, 0x19, 0x36, 0xb4, 0x59, 0x25, 0x5c, 0x2f, 0x38, 0x37, 0x0d, 0x58, 0x28, 0x3e, 0x1b,
+  0x36, 0x3a, 0x76, 0xaa, 0x1d, 0x69, 0xdd, 0x18, 0x0d, 0x74, 0xa4, 0x44, 0x6e, 0x40, 0xab, 0x08,
+  0x1f, 0xb0, 0x3c, 0x6f, 0xff, 0x53, 0x37, 0x20, 0xe6, 0x33, 0xae, 0x46, 0x83, 0x8e, 0x7b, 0x88,
+  0x5f, 0x9c, 0x00, 0x53, 0x19, 0xaf, 0x00, 0x8f, 0x61, 0xfb, 0x39, 0x9b, 0xf3, 0x61, 0xa3, 0xb0,
+  0x67, 0x22, 0x91, 0x45, 0xbf, 0x64, 0x69, 0x2c, 0xb4, 0x61, 0x59, 0xc4, 0x91, 0xb7, 0x4c, 0x4b,
+  0x55, 0xb2, 0x88, 0x34, 0xfa, 0xa3, 0x41, 0x2c, 0x1e, 0x20, 0x4a, 0x98, 0xd6, 0xc3, 0x86, 0xc8,
+  0x66, 0x12, 0xb7, 0xe6, 0x48, 0x76, 0x34, 0xb6, 0x52, 0xc3, 0xe5, 0xc9, 0x19, 0x9c, 0xc4, 0xb1,
+  0xe2, 0x5a, 0x73, 0xfd, 0x69, 0xd0, 0x99, 0xe2, 0xc9, 0xf9, 0xda, 0xa6, 0x94, 0x45, 0xfb, 0x7e,
+  0xa3, 0x36, 0x4a, 0x66, 0xf3, 0xd1, 0x9d, 0xb8, 0x10, 0xb4, 0x11, 0x97, 0xfb, 0x19, 0x18, 0xe8,
+  0x9c, 0x65, 0x20, 0xe2, 0x61, 0x63, 0x29, 0x66, 0xe2, 0x92, 0x45, 0x0d, 0x12, 0x05, 0xe7, 0xf0,
+  0x28, 0x55, 0x6e, 0x44, 0x86, 0xf7, 0xbf, 0x5f, 0xdd, 0x6d, 0xdc, 0xcb, 0x75, 0xfe, 0x5d, 0x2e,
+  0xeb, 0xbb, 0xa1, 0xf9, 0x43, 0x73, 0x30, 0x0b, 0xa1, 0x61, 0x86, 0x92, 0x05, 0x02, 0xa8, 0xc1,
+  0x99, 0x98, 0x17, 0x8a, 0x19, 0x21, 0xb3, 0x0f, 0x30, 0xe8, 0x20, 0xbf, 0x5e, 0xae, 0x89, 0x61,
+  0xa6, 0x70, 0x92, 0xd4, 0x28, 0x23, 0x40, 0x16, 0x35, 0xcf, 0x13, 0x89, 0xe8, 0xf6, 0xd4, 0x04,
+  0xd5, 0x16, 0xbd, 0x86, 0x5b, 0xcf, 0x4d, 0x91, 0xa3, 0xf2, 0x44, 0x1c, 0xf3, 0xcc, 0x53, 0x3e,
+  0x2b, 0x94, 0x42, 0xb3, 0x81, 0x3b, 0x24, 0xa5, 0xe0, 0x1b, 0x7f, 0xe0, 0xc9, 0x8b, 0x80, 0x25,
+  0xf4, 0xc4, 0x91, 0x59, 0xd2, 0x52, 0xbb, 0xb2, 0x11, 0x0e, 0xcc, 0xc3, 0xb2, 0x88, 0xe5, 0xc4,
+  0x3d, 0xc1, 0x9a, 0xb2, 0x24, 0x19, 0x05, 0x2d, 0x7e, 0xaa, 0xb1, 0x1d, 0xfb, 0xb9, 0x0a, 0x8f,
+  0x28, 0xc5, 0x6f, 0x76, 0x7d, 0x4d, 0x08, 0x84, 0x26, 0x75, 0x56, 0x4e, 0x8c, 0x5b, 0xdd, 0x37,
+  0x80, 0x45, 0x44, 0x7e, 0xb8, 0xd7, 0xd1, 0xec, 0x81, 0xef, 0x01, 0x7a, 0xc2, 0x42, 0xc6, 0xc3,
+  0xbd, 0x5c, 0x6a, 0xb3, 0xb7, 0xc6, 0x2f, 0xed, 0xde, 0x9f, 0x2b, 0x89, 0x02, 0xa3, 0x11, 0xb3,
+  0x29, 0x4f, 0x08, 0xeb, 0x61, 0x23, 0x4f, 0x49, 0x11, 0xd7, 0xcc, 0x0a, 0x5d, 0xb3, 0x13, 0x14,
+  0xda, 0xae, 0x1a, 0x0d, 0x44, 0x96, 0x17, 0x06, 0xcc, 0x2a, 0xc7, 0x83, 0x0d, 0x7f, 0x34, 0x4e,
+  0x68, 0xbb, 0xcf, 0xb3, 0xe3, 0xbe, 0xe7, 0x09, 0x8b, 0xf8, 0x42, 0x26, 0x31, 0x47, 0xb2, 0x17,
+  0x17, 0x9f, 0xd6, 0xff, 0x36, 0x5e, 0xd0, 0xc5, 0x26, 0x9e, 0x52, 0x91, 0x15, 0x86, 0xa3, 0x13,
+  0xdd, 0xf0, 0x19, 0xf2, 0xb2, 0x80, 0x1b, 0x44, 0xf8, 0x65, 0x86, 0xb2, 0x22, 0x9d, 0x72, 0x54,
+  0x67, 0xd0, 0xee, 0x02, 0x7d, 0xdf, 0x31, 0x18, 0x88, 0x78, 0x1e, 0xcb, 0x21, 0x7e, 0x19, 0x36,
+  0xba, 0xf8, 0xc9, 0x1e, 0x87, 0x8d, 0xc3, 0x3f, 0x37, 0x46, 0xe0, 0x1f, 0xc1, 0x1b, 0x09, 0x6b,
+  0x8e, 0x86, 0x19, 0x97, 0x84, 0xcb, 0xe1, 0x73, 0xc2, 0xfe, 0x11, 0xec, 0x20, 0x39, 0x7b, 0xbc,
+  0x0c, 0xc2, 0xdf, 0x2d, 0x44, 0x42, 0x5e, 0xc1, 0x9d, 0x15, 0x02, 0x7a, 0xc7, 0xc4, 0x60, 0xb8,
+  0x58, 0xb5, 0xa0, 0xc8, 0xc1, 0xc8, 0x9d, 0x01, 0xa9, 0x68, 0x07, 0x4c, 0x6a, 0x33, 0xff, 0x31,
+  0x2c, 0xb8, 0x71, 0xb2, 0x8e, 0x4c, 0x7d, 0x66, 0x0b, 0x38, 0xce, 0xd0, 0x6f, 0x50, 0x32, 0x1b,
+  0x71, 0x75, 0x22, 0x97, 0x10, 0xcb, 0x65, 0x06, 0xda, 0xf0, 0x1c, 0xa6, 0x2b, 0xf7, 0xb9, 0x2c,
+  0xd1, 0xb0, 0x9e, 0x87, 0x93, 0x6c, 0xa5, 0x81, 0x18, 0x63, 0x59, 0x0c, 0x73, 0x09, 0x53, 0x16,
+  0xdd, 0x23, 0x2a, 0x76, 0x89, 0xf2, 0x76, 0x83, 0xa1, 0x83, 0x03, 0x43, 0x9a, 0x52, 0x66, 0xf4,
+  0x29, 0x0c, 0xa4, 0xf2, 0x81, 0xeb, 0x36, 0xdc, 0xe2, 0x2a, 0x8d, 0x5c, 0xd2, 0xec, 0xb3, 0x1d,
+  0xf7, 0x9c, 0xe7, 0x76, 0xf1, 0x4c, 0x3c, 0xf2, 0xb8, 0x72, 0xc5, 0xb7, 0x6a, 0x71, 0xca, 0x30,
+  0x86, 0x60, 0x30, 0x38, 0xb5, 0x9f, 0xf0, 0x85, 0x8b, 0xf9, 0xc2, 0x40, 0x33, 0x4a, 0x3f, 0x6c,
+  0xd7, 0x19, 0xc1, 0xe8, 0xf7, 0x7a, 0x08, 0xc3, 0xc8, 0xc2, 0xd7, 0xf3, 0xf0, 0xf5, 0xba, 0x5d,
+  0x44, 0x92, 0x50, 0xa1, 0xb9, 0x5d, 0xfc, 0x4a, 0x16, 0x99, 0x69, 0x8c, 0x7c, 0x02, 0xf1, 0x6c,
+  0xb1, 0x29, 0x22, 0x62, 0x31, 0xb8, 0x28, 0x92, 0xc4, 0xdb, 0xda, 0xeb, 0xbc, 0xbe, 0x60, 0x00,
+  0x96, 0x7a, 0xd0, 0xbd, 0x1b, 0xac, 0xab, 0xbd, 0x62, 0xbb, 0xdb, 0xee, 0x95, 0x21, 0xf1, 0xbb,
+  0x34, 0x50, 0x68, 0x1e, 0x83, 0xa4, 0xec, 0x46, 0x8c, 0xb8, 0x18, 0x4d, 0x06, 0x8f, 0xf9, 0x59,
+  0x4c, 0x49, 0x27, 0x31, 0x34, 0xcf, 0xc2, 0xf7, 0x90, 0x01, 0x51, 0xa7, 0x76, 0xb5, 0x61, 0xca,
+  0x00, 0x25, 0xce, 0x0f, 0xbb, 0xab, 0x4a, 0x2f, 0x58, 0x8e, 0x81, 0xf7, 0x96, 0x61, 0x56, 0x9f,
+  0xd0, 0xf7, 0x4a, 0x6a, 0xcd, 0x13, 0x1e, 0x19, 0xe7, 0xf2, 0x76, 0x55, 0x70, 0x78, 0xb7, 0x65,
+  0x20, 0x6d, 0x64, 0x87, 0x07, 0x96, 0x14, 0x9c, 0x84, 0x1c, 0xfd, 0xc8, 0x95, 0x45, 0x34, 0x5a,
+  0x61, 0x91, 0x80, 0x51, 0x10, 0x9a, 0xb1, 0xc0, 0x1d, 0x98, 0x1c, 0x90, 0x31, 0xb7, 0xfa, 0xe9,
+  0x2e, 0x44, 0xe1, 0xdb, 0x0a, 0xcd, 0xbe, 0xb6, 0x27, 0xe1, 0xd9, 0xdc, 0x2c, 0x3e, 0x5b, 0xd1,
+  0xc2, 0x7e, 0x82, 0x82, 0xc6, 0xce, 0x1c, 0x60, 0x61, 0x35, 0xb7, 0x91, 0x68, 0x1f, 0x2d, 0x4f,
+  0x3e, 0xb6, 0x80, 0xb7, 0xe7, 0x6d, 0xf8, 0x7a, 0x7a, 0x86, 0x5e, 0x81, 0xa0, 0x35, 0x6d, 0xe9,
+  0x63, 0xbd, 0xc5, 0x1d, 0xb1, 0x71, 0xff, 0x01, 0xe1, 0x91, 0x73, 0x45, 0xa0, 0x4f, 0xa5, 0x31,
+  0x32, 0xb5, 0xbb, 0x8c, 0xcc, 0xe1, 0x55, 0x81, 0x3e, 0xa2, 0x79, 0x19, 0x85, 0xe5, 0x0e, 0x09,
+  0x65, 0xd8, 0x34, 0xe1, 0xd5, 0xca, 0x8e, 0x43, 0xf4, 0xad, 0xf6, 0x84, 0x39, 0xf1, 0xfe, 0x8e,
+  0x78, 0x0e, 0xc0, 0xd7, 0x26, 0x9c, 0x5d, 0xb5, 0xeb, 0x1e, 0xb1, 0x6e, 0x5b, 0x98, 0x42, 0x61,
+  0x87, 0x73, 0xbe, 0x59, 0x44, 0xea, 0x07, 0x85, 0x99, 0xb7, 0x9d, 0xe4, 0xcc, 0xee, 0x07, 0x59,
+  0x31, 0x86, 0x20, 0xc5, 0xa9, 0x04, 0xb5, 0x1a, 0x7b, 0x90, 0x49, 0x81, 0x51, 0x46, 0x64, 0x90,
+  0x08, 0xc4, 0x0d, 0x23, 0xcf, 0xd8, 0x43, 0xd8, 0x82, 0x4a, 0x21, 0x1e, 0xe5, 0x52, 0xdd, 0x18,
+  0xce, 0x44, 0xe6, 0x63, 0xd9, 0x4c, 0x28, 0x4d, 0x91, 0x88, 0x27, 0x71, 0xcb, 0x6b, 0xee, 0x99,
+  0x3a, 0xaa, 0xd5, 0x2e, 0xaa, 0xbe, 0xc3, 0x0f, 0x48, 0x69, 0x75, 0xdd, 0xdd, 0x92, 0xee, 0x5e,
+  0x2b, 0x02, 0xdc, 0xae, 0xe0, 0x17, 0x6e, 0xb0, 0x56, 0x06, 0x74, 0x87, 0xdd, 0x16, 0xf4, 0xba,
+  0xc3, 0x83, 0xc3, 0xf6, 0x61, 0x0b, 0xfa, 0xdd, 0xe1, 0x31, 0x8e, 0xdb, 0xed, 0x76, 0xe9, 0xfc,
+  0x3f, 0x28, 0x93, 0x41, 0xaf, 0x0f, 0xb9, 0x44, 0x19, 0x34, 0xc8, 0x99, 0x8f, 0xef, 0x55, 0x58,
+  0xf2, 0xe0, 0x20, 0x84, 0x88, 0xf4, 0xd0, 0xe3, 0xd8, 0x82, 0x99, 0xc2, 0x49, 0x7a, 0x4e, 0xda,
+  0xda, 0xd3, 0xb6, 0x7c, 0x06, 0x5b, 0x8e, 0x03, 0xc6, 0x86, 0x94, 0x33, 0x5d, 0xa8, 0xf7, 0x04,
+  0x6f, 0x5f, 0x20, 0x86, 0x28, 0x79, 0x29, 0xe3, 0x0d, 0x31, 0xc1, 0x17, 0x92, 0xa1, 0x0a, 0x70,
+  0xbb, 0x9e, 0x47, 0x85, 0x5b, 0x0c, 0x0a, 0x73, 0xae, 0x3a, 0x3c, 0x5a, 0x48, 0x68, 0x7e, 0x39,
+  0xdb, 0x9f, 0xdc, 0x74, 0x3f, 0xb6, 0xe0, 0xaf, 0x93, 0xef, 0xf6, 0xdb, 0x25, 0x66, 0xa4, 0x98,
+  0x43, 0x6f, 0x5b, 0x88, 0x98, 0x70, 0x85, 0xb7, 0x95, 0x16, 0xb0, 0x02, 0xb1, 0x92, 0x85, 0x21,
+  0x55, 0x34, 0x9f, 0x10, 0xe8, 0x6f, 0x0b, 0x07, 0x81, 0x00, 0x4e, 0x2a, 0xfe, 0xaf, 0x82, 0xeb,
+  0xe7, 0xfb, 0x0f, 0x3e, 0xbc, 0xe0, 0xa8, 0x0e, 0xbb, 0xcb, 0x02, 0xd7, 0xa7, 0xcc, 0x44, 0x0b,
+  0x8b, 0xb7, 0x5d, 0x8e, 0xc9, 0x12, 0xab, 0xd6, 0x2a, 0x08, 0xe3, 0x64, 0x81, 0x57, 0x1f, 0x70,
+  0x27, 0xd9, 0x35, 0x9a, 0xa2, 0xba, 0x33, 0x4a, 0x4a, 0xb4, 0x4b, 0x81, 0x7b, 0x3e, 0xc1, 0xf9,
+  0xd9, 0x97, 0xab, 0xce, 0xed, 0x4f, 0xda, 0x37, 0x3e, 0x6a, 0xc1, 0xed, 0xcd, 0xd7, 0xbf, 0x74,
+  0x6e, 0xdc, 0xf0, 0x70, 0x77, 0x65, 0x45, 0x0b, 0x96, 0x65, 0x3c, 0xd1, 0x41, 0x5d, 0xda, 0xf1,
+  0x83, 0xe1, 0xf2, 0x54, 0x32, 0x15, 0xbf, 0xa8, 0xb8, 0x72, 0x8f, 0x57, 0x5d, 0x45, 0xe3, 0x39,
+  0xf2, 0xbd, 0x2d, 0xa0, 0xf6, 0xb7, 0xc4, 0xcf, 0x83, 0xcd, 0x60, 0x4a, 0x85, 0xa0, 0xd4, 0x6d,
+  0x42, 0x07, 0xce, 0x1f, 0xd0, 0x91, 0x33, 0x0a, 0xed, 0x53, 0x59, 0x28, 0x17, 0x3f, 0xb3, 0x7b,
+  0xb4, 0x74, 0xce, 0x10, 0xf9, 0xa5, 0x40, 0xbf, 0x17, 0xe4, 0x21, 0x58, 0x19, 0xa1, 0x87, 0xba,
+  0x1a, 0x66, 0x05, 0xd6, 0x59, 0xd1, 0x37, 0x4c, 0xa1, 0xb2, 0x16, 0x16, 0x3a, 0x90, 0xc9, 0x8c,
+  0x63, 0x86, 0x60, 0xca, 0xa5, 0x0c, 0x89, 0xff, 0x29, 0xbd, 0x07, 0x74, 0x14, 0x15, 0x3e, 0xcf,
+  0x14, 0x44, 0xcb, 0x1d, 0x0b, 0x6f, 0x82, 0xbf, 0x0e, 0x61, 0xaf, 0xba, 0x3b, 0xd5, 0x74, 0x42,
+  0xc2, 0xf5, 0x4a, 0xff, 0xe9, 0x97, 0x3a, 0xb0, 0xba, 0x86, 0xba, 0x26, 0xdc, 0xca, 0x10, 0x74,
+  0xdd, 0xb6, 0x27, 0x58, 0x1e, 0x36, 0x46, 0xe3, 0x8d, 0x4a, 0xe8, 0x21, 0xd2, 0xe3, 0xdf, 0x36,
+  0x3e, 0xa5, 0xbd, 0xc7, 0x5b, 0x94, 0x74, 0xf3, 0xf3, 0xb9, 0x96, 0xac, 0x7d, 0xae, 0x31, 0x49,
+  0xc0, 0x95, 0x4c, 0xba, 0xc1, 0x7f, 0x9d, 0x49, 0x5f, 0x07, 0xbc, 0x31, 0xc1, 0xb9, 0xd5, 0xbd,
+  0xf5, 0x9a, 0xb2, 0xb7, 0xbd, 0xa8, 0xc4, 0x58, 0xdb, 0x02, 0x5b, 0xc4, 0x61, 0x4a, 0xdb, 0xa5,
+  0x00, 0xec, 0xad, 0x55, 0x80, 0xbd, 0x57, 0x4a, 0x40, 0x0a, 0xe9, 0x55, 0xa4, 0x9f, 0x51, 0x01,
+  0xea, 0xc2, 0xff, 0x9b, 0x6d, 0xb0, 0xbf, 0xd1, 0x06, 0xfb, 0xa5, 0x0d, 0x1e, 0xbc, 0x62, 0x83,
+  0xfd, 0xba, 0x0d, 0xf6, 0xff, 0x47, 0x6d, 0xb0, 0x5f, 0xb7, 0xc1, 0xfe, 0xff, 0xa7, 0x0d, 0xf6,
+  0xd7, 0x6d, 0xb0, 0xff, 0x07, 0xd9, 0x60, 0x7f, 0xcd, 0x06, 0xfb, 0x7f, 0x88, 0x0d, 0xae, 0x99,
+  0x1b, 0x13, 0xea, 0x96, 0xa7, 0x38, 0x79, 0x22, 0x14, 0xd0, 0x37, 0x8e, 0xf7, 0x14, 0x2c, 0x3f,
+  0xa0, 0xf9, 0x6b, 0xcc, 0xe7, 0x9f, 0xcf, 0x76, 0xbe, 0x4b, 0x05, 0x82, 0x5e, 0x8e, 0x72, 0x68,
+  0x05, 0xd9, 0xff, 0x18, 0x44, 0x39, 0x3e, 0x7c, 0xd2, 0xcc, 0x51, 0x72, 0x4a, 0x57, 0x93, 0xfa,
+  0x21, 0xd1, 0x82, 0x47, 0xf7, 0x53, 0xf9, 0xe8, 0xdb, 0x36, 0x76, 0x45, 0xe8, 0xdb, 0xb8, 0xe5,
+  0xa1, 0x58, 0x72, 0x39, 0x86, 0xc1, 0x78, 0xd2, 0x3b, 0x3e, 0xed, 0x77, 0x6d, 0x4e, 0xee, 0x43,
+  0x95, 0x42, 0x6d, 0x72, 0x98, 0x70, 0xe3, 0x12, 0x8b, 0xce, 0x39, 0xdd, 0xd9, 0x66, 0x98, 0x73,
+  0x0a, 0x2c, 0x47, 0x9b, 0x08, 0x21, 0x9e, 0x89, 0x88, 0x1e, 0xc3, 0x2f, 0x80, 0x00, 0x80, 0x17,
+  0xdd, 0xdd, 0xb5, 0x43, 0x2f, 0x0f, 0xb7, 0x58, 0xbb, 0xa2, 0x1b, 0x8d, 0xbd, 0xf4, 0x2d, 0x17,
+  0x3c, 0xc3, 0x9c, 0x05, 0x96, 0x17, 0x2c, 0x6c, 0xf5, 0x12, 0xd3, 0xd5, 0x3b, 0xae, 0xdc, 0x05,
+  0x56, 0xc9, 0x8d, 0xd1, 0xb5, 0x6d, 0x21, 0xd0, 0xe9, 0xbe, 0x9f, 0xb0, 0x2b, 0xf0, 0x8e, 0x4e,
+  0xb0, 0x52, 0x37, 0x58, 0xb3, 0xd1, 0x03, 0x72, 0xbd, 0x9a, 0x6b, 0xce, 0x44, 0x62, 0x78, 0x59,
+  0x06, 0xfa, 0xd1, 0x0b, 0x65, 0xe0, 0x25, 0xc7, 0x62, 0x3d, 0xdb, 0x52, 0xe4, 0x61, 0x9d, 0x98,
+  0xa6, 0x08, 0x08, 0x2a, 0x23, 0xdb, 0x58, 0x3d, 0x38, 0xf9, 0x98, 0x22, 0xf8, 0xb1, 0xcc, 0x8e,
+  0xe1, 0xa8, 0x0b, 0x29, 0x4e, 0xe4, 0x74, 0x05, 0xa6, 0x5b, 0x41, 0x24, 0xd3, 0xa9, 0xc8, 0xf0,
+  0x81, 0xbd, 0x11, 0x50, 0x6e, 0x57, 0x0e, 0x88, 0xf7, 0x74, 0x31, 0xb0, 0xe2, 0x6b, 0x54, 0x8d,
+  0x19, 0x42, 0x35, 0xb4, 0x66, 0x2f, 0x14, 0x8a, 0xbb, 0x33, 0xb6, 0x96, 0x60, 0x19, 0x01, 0xec,
+  0x60, 0x0d, 0xdb, 0xfe, 0x6f, 0xb6, 0x2f, 0x94, 0xa1, 0x28, 0x33, 0xba, 0xd5, 0x30, 0x6a, 0xd7,
+  0x60, 0xed, 0xb9, 0x0b, 0xfd, 0x93, 0x39, 0x5f, 0x3b, 0xc2, 0x8e, 0xd7, 0x35, 0x78, 0x84, 0x01,
+  0xe0, 0x59, 0xff, 0xa9, 0x47, 0x07, 0xe3, 0x10, 0x3d, 0x5f, 0xad, 0x02, 0x68, 0xc4, 0x01, 0x75,
+  0x25, 0x3e, 0x23, 0x1f, 0x84, 0x39, 0x7b, 0xc0, 0xa2, 0x49, 0xe1, 0x23, 0x09, 0x4b, 0x76, 0xcf,
+  0xf7, 0x8b, 0xfc, 0x1d, 0xa6, 0x1a, 0x23, 0xed, 0x29, 0xea, 0x8a, 0xa0, 0xb5, 0xf7, 0x44, 0x16,
+  0x8c, 0xd5, 0x39, 0x43, 0xd5, 0xf1, 0xbb, 0xa4, 0x5e, 0xd5, 0xae, 0x28, 0x97, 0xe4, 0x3d, 0x0a,
+  0xd5, 0x78, 0x2d, 0x0a, 0xf6, 0x9e, 0x46, 0xc1, 0x5f, 0xe8, 0xda, 0x84, 0xf2, 0x26, 0x18, 0x0c,
+  0x8c, 0x87, 0xe1, 0x8d, 0x47, 0x52, 0xb5, 0x69, 0xa6, 0x9c, 0x95, 0x8e, 0x53, 0x9b, 0x70, 0xd0,
+  0x87, 0x53, 0x8f, 0x0e, 0x0f, 0x0f, 0x0e, 0xb7, 0x34, 0xff, 0xa2, 0x44, 0x6a, 0x54, 0xbc, 0xc1,
+  0xdc, 0xee, 0xca, 0x78, 0x7f, 0xad, 0x4d, 0x88, 0x27, 0x77, 0xad, 0xb6, 0x8d, 0x22, 0x6e, 0x7d,
+  0x20, 0x93, 0xc6, 0x9a, 0x4b, 0x1b, 0xba, 0x2f, 0x69, 0x6f, 0x77, 0xd5, 0x24, 0x72, 0x79, 0x92,
+  0x30, 0x95, 0x62, 0x20, 0xa7, 0x0f, 0xc0, 0x07, 0x72, 0xb9, 0xab, 0x02, 0x4a, 0x22, 0x1e, 0x8c,
+  0x6a, 0xfc, 0x4c, 0x01, 0x84, 0x7a, 0xfd, 0xfc, 0x05, 0x16, 0xff, 0x9e, 0x01, 0x52, 0x06, 0x25,
+  0xa5, 0x5d, 0x4f, 0xaf, 0x48, 0x04, 0x5d, 0x54, 0x13, 0x2f, 0x9f, 0xef, 0x40, 0x3a, 0x53, 0x52,
+  0x6b, 0x6b, 0xf2, 0x19, 0x30, 0x2b, 0x7c, 0x12, 0xba, 0xce, 0xce, 0x23, 0x9d, 0x27, 0xb4, 0x6c,
+  0x92, 0xa0, 0x48, 0xbf, 0x64, 0x82, 0xde, 0x41, 0xd8, 0x37, 0x36, 0xae, 0x37, 0x85, 0xde, 0x46,
+  0x9a, 0xa0, 0x30, 0x84, 0xc4, 0xed, 0x8d, 0x84, 0x9e, 0xa4, 0x98, 0x24, 0x66, 0xbb, 0xeb, 0x02,
+  0xcf, 0xa0, 0xac, 0x35, 0xba, 0x0b, 0x3e, 0x91, 0xbb, 0x77, 0x14, 0x94, 0x38, 0x32, 0x45, 0x77,
+  0xa2, 0xf5, 0x0e, 0x45, 0x2d, 0x26, 0xfb, 0xad, 0x1e, 0x80, 0x40, 0xe8, 0x79, 0xc8, 0xbd, 0xe4,
+  0x6a, 0xce, 0x01, 0xef, 0xc3, 0x05, 0x1a, 0xd5, 0x8c, 0x42, 0x9a, 0x86, 0x26, 0x35, 0x7f, 0x11,
+  0x81, 0x24, 0x58, 0x91, 0xde, 0x78, 0xb1, 0x46, 0xfc, 0xc6, 0x4a, 0xe6, 0xee, 0x9a, 0x95, 0xc4,
+  0x74, 0xab, 0xb6, 0x44, 0x36, 0x46, 0x6f, 0xd7, 0xec, 0x38, 0x0e, 0x47, 0x11, 0x82, 0x16, 0xbe,
+  0x98, 0x27, 0x82, 0x0c, 0xf7, 0x1d, 0xcd, 0x8a, 0x04, 0xb9, 0xdd, 0x9a, 0xf0, 0xdd, 0x8a, 0xd0,
+  0xa5, 0x70, 0xcb, 0xe1, 0x94, 0x19, 0x43, 0x8e, 0x42, 0xb7, 0xc0, 0x4f, 0x78, 0x3c, 0x4a, 0x6c,
+  0x1f, 0xa1, 0xc1, 0x9b, 0x25, 0xe7, 0x59, 0x29, 0xfb, 0xd3, 0xec, 0x7f, 0x87, 0x51, 0x4f, 0x93,
+  0x2d, 0x3c, 0xed, 0x99, 0xb7, 0xbc, 0x03, 0x92, 0xf2, 0x2d, 0x29, 0xfc, 0x3a, 0x67, 0x22, 0x6b,
+  0xc3, 0x1d, 0xde, 0xfb, 0x61, 0xdc, 0x25, 0xc9, 0x6f, 0x26, 0xb7, 0x54, 0x0d, 0xa0, 0x06, 0xa9,
+  0x5b, 0x4b, 0x34, 0x32, 0x34, 0xaa, 0x64, 0x45, 0x59, 0x8b, 0x6e, 0xa3, 0xb9, 0x0b, 0x80, 0xa7,
+  0x57, 0x57, 0xb7, 0xa4, 0xe6, 0x05, 0x4f, 0x62, 0x8b, 0x0f, 0xc6, 0x66, 0x70, 0xad, 0x55, 0x97,
+  0x17, 0x72, 0x7a, 0x41, 0x45, 0xb6, 0x47, 0x04, 0xdf, 0xd3, 0xeb, 0xc2, 0xf5, 0x97, 0xf6, 0xf5,
+  0x52, 0x24, 0x55, 0x0c, 0x13, 0x1a, 0x6b, 0x48, 0x64, 0x36, 0xf7, 0xb1, 0x67, 0x57, 0xa7, 0x0b,
+  0x14, 0xcb, 0x4e, 0x98, 0x1f, 0xae, 0x07, 0x3f, 0xd7, 0x3b, 0x1c, 0x51, 0xc2, 0x0e, 0xc5, 0x14,
+  0xbd, 0xeb, 0xc8, 0x19, 0xbd, 0x95, 0xa5, 0x4a, 0xca, 0x36, 0x52, 0x18, 0xf5, 0x0a, 0x25, 0x9a,
+  0x15, 0x45, 0xb8, 0x44, 0x68, 0x0a, 0x78, 0x08, 0x78, 0x87, 0xe5, 0xa2, 0xa3, 0x1d, 0xa7, 0xb6,
+  0x4e, 0x5b, 0x2e, 0x70, 0xd6, 0x42, 0x64, 0x7d, 0xac, 0xc8, 0xdf, 0x11, 0xee, 0x78, 0xbc, 0xd5,
+  0x76, 0xe8, 0x79, 0x08, 0x62, 0xb4, 0x14, 0xce, 0x33, 0xf2, 0x39, 0xf8, 0x76, 0x3e, 0x86, 0x29,
+  0xbd, 0x08, 0x27, 0x1d, 0x34, 0x45, 0x16, 0x8b, 0x88, 0xd1, 0x9b, 0x22, 0xf7, 0x8e, 0x9d, 0x54,
+  0xb7, 0x94, 0x8a, 0x1e, 0x7e, 0xa8, 0xec, 0xe7, 0xed, 0xda, 0xd1, 0x02, 0x8f, 0xb2, 0x6f, 0x9f,
+  0x27, 0x93, 0xaf, 0x63, 0xb8, 0x46, 0x33, 0x13, 0x8f, 0xaf, 0x76, 0x22, 0x69, 0x57, 0x80, 0xdf,
+  0x7e, 0x5f, 0xeb, 0x43, 0xde, 0x9d, 0xdc, 0x9e, 0xdf, 0xfc, 0x3e, 0x39, 0xff, 0x3e, 0xb9, 0xba,
+  0xf9, 0xdd, 0xaa, 0xc3, 0x75, 0x52, 0xdd, 0xe5, 0x27, 0x68, 0x83, 0x8e, 0x5b, 0x0a, 0x74, 0xfd,
+  0x29, 0x7a, 0xc5, 0xdf, 0x73, 0x7b, 0xf0, 0x3f, 0x7e, 0xda, 0x3f, 0xd0, 0x44, 0xd3, 0x44, 0x85,
+  0xf8, 0x91, 0x28, 0x85, 0xbd, 0x3c, 0x39, 0x7b, 0xc7, 0x6b, 0x07, 0xd2, 0x39, 0x62, 0x14, 0x04,
+  0xbd, 0xf6, 0xc3, 0x57, 0x5f, 0xba, 0x86, 0x6d, 0xa1, 0x80, 0x2f, 0xc7, 0x6b, 0xd2, 0x7e, 0x61,
+  0x2a, 0x0e, 0x24, 0x7b, 0xfd, 0x83, 0x8f, 0xd6, 0x10, 0x83, 0xc0, 0xc7, 0x6b, 0xe2, 0x1f, 0x54,
+  0xef, 0x61, 0x6c, 0x9b, 0x8f, 0x6a, 0xf0, 0x50, 0x03, 0x1c, 0x03, 0xc6, 0x58, 0xc5, 0x22, 0xea,
+  0xb7, 0x5a, 0xef, 0x78, 0x22, 0x67, 0x9d, 0x47, 0x5d, 0x4c, 0x53, 0x81, 0x5c, 0xfa, 0xd0, 0x38,
+  0xc1, 0x4a, 0xa9, 0xfa, 0x11, 0xc5, 0xaf, 0x2c, 0xcd, 0x3f, 0x63, 0x91, 0x33, 0x95, 0x12, 0x6b,
+  0xf4, 0x01, 0x0b, 0x3f, 0x97, 0x28, 0x5d, 0x69, 0x6a, 0x32, 0xc0, 0x7f, 0xfb, 0xae, 0x2c, 0x60,
+  0x6a, 0xe5, 0xaf, 0xf8, 0xf4, 0x56, 0x3c, 0x29, 0x2f, 0xf8, 0x67, 0x76, 0x38, 0xe8, 0x30, 0x64,
+  0x80, 0x80, 0xc5, 0x0f, 0xfa, 0xe1, 0x04, 0xfd, 0x8a, 0x82, 0x7e, 0x0c, 0xf2, 0x6f, 0xd4, 0x77,
+  0x67, 0xd8, 0x22, 0x22, 0x00, 0x00,
+};
+constexpr WebAsset WEB_UPDATE_HTML = {"text/html", "\"c3173a86\"", WEB_UPDATE_HTML_GZ, sizeof(WEB_UPDATE_HTML_GZ)};
+
+// sensor.html: 1167 bytes, 1118 minified, 522 gzip'd
+constexpr uint8_t WEB_SENSOR_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0x4d, 0x6f, 0xdb, 0x30,
+  0x0c, 0xfd, 0x2b, 0x9c, 0x2e, 0xb9, 0xcc, 0x35, 0xd6, 0x43, 0x31, 0x14, 0xb2, 0x81, 0xa5, 0x0d,
+  0xb0, 0x43, 0xd1, 0x74, 0x6d, 0xb1, 0x62, 0x47, 0x45, 0x66, 0x62, 0xad, 0xb2, 0x24, 0x48, 0xb4,
+  0x83, 0x00, 0xfb, 0xf1, 0xa3, 0x3f, 0xd2, 0x39, 0xed, 0x21, 0xd8, 0xc1, 0x86, 0xfd, 0xc8, 0xf7,
+  0xf8, 0x28, 0x93, 0x96, 0x9f, 0x6e, 0xd7, 0x37, 0xcf, 0xbf, 0x1e, 0x56, 0x50, 0x53, 0x63, 0x4b,
+  0x39, 0xdd, 0x51, 0x55, 0xa5, 0x6c, 0x90, 0x14, 0x38, 0xd5, 0x60, 0xb1, 0xe8, 0x0c, 0xee, 0x83,
+  0x8f, 0xb4, 0x00, 0xed, 0x1d, 0xa1, 0xa3, 0x62, 0xb1, 0x37, 0x15, 0xd5, 0x45, 0x85, 0x9d, 0xd1,
+  0x98, 0x0d, 0x2f, 0x9f, 0x8d, 0x33, 0x64, 0x94, 0xcd, 0x92, 0x56, 0x16, 0x8b, 0x2f, 0x8b, 0xbc,
+  0x94, 0x64, 0xc8, 0x62, 0xb9, 0x7a, 0x7a, 0xf8, 0x7a, 0x79, 0x75, 0x05, 0x2f, 0x8a, 0x30, 0xc2,
+  0x1d, 0x76, 0x68, 0xe1, 0x09, 0x5d, 0xf2, 0x11, 0x32, 0xb8, 0x33, 0x1d, 0xc2, 0x23, 0x57, 0x34,
+  0x6e, 0x27, 0xf3, 0x91, 0x20, 0xad, 0x71, 0xaf, 0x10, 0xd1, 0x16, 0x22, 0xd1, 0xc1, 0x62, 0xaa,
+  0x11, 0x49, 0x40, 0x1d, 0x71, 0x5b, 0x88, 0x7c, 0x80, 0x2e, 0x74, 0x4a, 0xa2, 0x94, 0x49, 0x47,
+  0x13, 0x08, 0x52, 0xd4, 0x1c, 0x50, 0x21, 0x5c, 0xfc, 0x4e, 0x02, 0x2a, 0xdc, 0x62, 0x2c, 0x65,
+  0x3e, 0x06, 0xf9, 0x61, 0x6c, 0x68, 0xe3, 0xab, 0x03, 0x54, 0x8a, 0x54, 0x16, 0xd4, 0x0e, 0x59,
+  0x7a, 0xb0, 0xc0, 0x22, 0xf5, 0xe5, 0xff, 0x58, 0xe4, 0x6c, 0x59, 0x99, 0x0e, 0xb4, 0x55, 0x29,
+  0x15, 0xc2, 0xb8, 0xad, 0x67, 0x8d, 0xc0, 0xfa, 0xe5, 0x4d, 0x1b, 0x23, 0x9f, 0xce, 0x89, 0xca,
+  0xc4, 0xbb, 0x96, 0xf9, 0x86, 0x9d, 0x84, 0x29, 0x93, 0xeb, 0x65, 0xf7, 0xeb, 0x17, 0x78, 0x22,
+  0x45, 0x6d, 0x1a, 0x82, 0x20, 0x53, 0x50, 0x0e, 0x4c, 0x55, 0x08, 0x4c, 0xe1, 0xde, 0xef, 0x45,
+  0xdf, 0x02, 0x43, 0x23, 0x2d, 0xe7, 0x9a, 0x27, 0x85, 0xdf, 0xec, 0xcf, 0x30, 0x3b, 0x94, 0xdc,
+  0x98, 0x9d, 0x18, 0x74, 0xf6, 0xbd, 0x8f, 0xc1, 0x86, 0x38, 0x0a, 0x84, 0x63, 0xaa, 0x66, 0xa3,
+  0xc8, 0xf4, 0xb9, 0xd7, 0x3f, 0x70, 0x6b, 0x12, 0x29, 0xa7, 0xf1, 0x7a, 0xe6, 0xa6, 0x9a, 0xb0,
+  0x37, 0x3f, 0xa0, 0x1b, 0x4e, 0x5d, 0x2a, 0x6e, 0xd6, 0xc2, 0x77, 0x34, 0xbb, 0x9a, 0xe6, 0xf9,
+  0x9b, 0x21, 0x30, 0xe2, 0x73, 0xce, 0xd8, 0xfd, 0xfb, 0xfa, 0x3f, 0xbd, 0x6d, 0x9b, 0x93, 0x7a,
+  0xdd, 0x80, 0x9c, 0x76, 0xff, 0x81, 0xb6, 0xd2, 0xb5, 0x87, 0x1f, 0xad, 0xb2, 0x86, 0x0e, 0x73,
+  0x32, 0x32, 0x7e, 0x86, 0xfa, 0xcc, 0xdf, 0xa8, 0x9a, 0x73, 0xa8, 0x07, 0xce, 0x90, 0xd6, 0x54,
+  0xf3, 0x31, 0x8d, 0x23, 0x91, 0xe6, 0x64, 0xdf, 0x07, 0x26, 0xfc, 0xcc, 0x17, 0x3b, 0x6a, 0x49,
+  0x75, 0x1c, 0x65, 0x71, 0x0c, 0x6d, 0xc8, 0x01, 0x5f, 0x59, 0x88, 0xa6, 0x51, 0xf1, 0x20, 0xca,
+  0xa5, 0xd2, 0xaf, 0x40, 0x9e, 0x2b, 0x12, 0xf1, 0xf8, 0x24, 0x99, 0x2b, 0x9e, 0x9b, 0x96, 0xc8,
+  0xbb, 0xf7, 0x9c, 0xd4, 0x6a, 0x8d, 0xbc, 0x0d, 0x83, 0x1d, 0xd6, 0x8d, 0xbc, 0x2f, 0x4b, 0x72,
+  0xa2, 0x7c, 0x1c, 0x9f, 0xff, 0x8d, 0xee, 0xc8, 0xff, 0x38, 0x0a, 0x2a, 0x90, 0xf1, 0xae, 0x5f,
+  0xa7, 0x46, 0x59, 0x5b, 0x7e, 0x6b, 0xc9, 0x67, 0x93, 0x10, 0xf3, 0x80, 0x67, 0x23, 0x1e, 0xe6,
+  0x67, 0xdc, 0xbf, 0xcf, 0x7a, 0x1d, 0x59, 0x63, 0xcf, 0xfd, 0x92, 0xf5, 0x1b, 0xd7, 0xff, 0x48,
+  0xfe, 0x02, 0x40, 0x65, 0x7b, 0x60, 0x5e, 0x04, 0x00, 0x00,
+};
+constexpr WebAsset WEB_SENSOR_HTML = {"text/html", "\"8243474f\"", WEB_SENSOR_HTML_GZ, sizeof(WEB_SENSOR_HTML_GZ)};
+
+// debugmac.html: 1084 bytes, 1034 minified, 542 gzip'd
+constexpr uint8_t WEB_DEBUGMAC_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x53, 0x4d, 0x6f, 0xdb, 0x30,
+  0x0c, 0xfd, 0x2b, 0x9c, 0x2f, 0xb9, 0x2c, 0xf1, 0x9a, 0x02, 0xc5, 0x30, 0xd8, 0x06, 0xd2, 0xa6,
+  0x05, 0x72, 0x58, 0x53, 0x20, 0x19, 0x8a, 0x9d, 0x06, 0x45, 0xa2, 0x63, 0xae, 0xb2, 0x64, 0x48,
+  0x74, 0x82, 0xfc, 0xfb, 0x51, 0x4e, 0xb2, 0x65, 0xc3, 0xd2, 0x83, 0x3f, 0x24, 0xf2, 0x3d, 0x51,
+  0x8f, 0x8f, 0xc5, 0x87, 0xf9, 0xf2, 0x61, 0xfd, 0xfd, 0xe5, 0x11, 0x1a, 0x6e, 0x6d, 0x55, 0x9c,
+  0xde, 0xa8, 0x4c, 0x55, 0xb4, 0xc8, 0x0a, 0x9c, 0x6a, 0xb1, 0x1c, 0xed, 0x08, 0xf7, 0x9d, 0x0f,
+  0x3c, 0x02, 0xed, 0x1d, 0xa3, 0xe3, 0x72, 0xb4, 0x27, 0xc3, 0x4d, 0x69, 0x70, 0x47, 0x1a, 0xc7,
+  0xc3, 0xe2, 0x23, 0x39, 0x62, 0x52, 0x76, 0x1c, 0xb5, 0xb2, 0x58, 0xde, 0x8c, 0xf2, 0xaa, 0x60,
+  0x62, 0x8b, 0xd5, 0xe3, 0xea, 0xe5, 0xf3, 0xf4, 0xee, 0x0e, 0xbe, 0xce, 0x1e, 0x60, 0x66, 0x4c,
+  0xc0, 0x18, 0x61, 0x8e, 0x9b, 0x7e, 0x5b, 0xe4, 0xc7, 0x84, 0xc2, 0x92, 0x7b, 0x83, 0x80, 0xb6,
+  0xcc, 0x22, 0x1f, 0x2c, 0xc6, 0x06, 0x91, 0x33, 0x68, 0x02, 0xd6, 0x65, 0x96, 0x0f, 0x5b, 0x13,
+  0x1d, 0x63, 0x56, 0x15, 0x51, 0x07, 0xea, 0x18, 0x62, 0xd0, 0x12, 0x50, 0x5d, 0x37, 0xf9, 0x19,
+  0x33, 0x30, 0x58, 0x63, 0xa8, 0x8a, 0xfc, 0x18, 0x94, 0x9f, 0xe3, 0x05, 0x36, 0xde, 0x1c, 0xc0,
+  0x28, 0x56, 0xe3, 0x4e, 0x6d, 0xb1, 0xcc, 0x4c, 0x3a, 0xb2, 0x55, 0x5a, 0x68, 0x9a, 0xe9, 0x7b,
+  0x45, 0x49, 0xb4, 0x30, 0xb4, 0x03, 0x6d, 0x55, 0x8c, 0x65, 0x26, 0x90, 0x31, 0xb9, 0xda, 0x27,
+  0xdc, 0x6d, 0x35, 0xb3, 0x16, 0x66, 0x3b, 0x45, 0x56, 0x6d, 0x2c, 0x5e, 0xa2, 0x31, 0x7e, 0x11,
+  0xe8, 0x6d, 0x55, 0x74, 0x52, 0x26, 0x07, 0xef, 0xb6, 0xd5, 0x2b, 0x3d, 0x51, 0x4a, 0x91, 0xc0,
+  0x69, 0x07, 0x8a, 0xd8, 0x29, 0x07, 0x64, 0xca, 0x6c, 0x4f, 0x35, 0x65, 0xa9, 0x6a, 0xd9, 0x90,
+  0x4f, 0x77, 0x09, 0x5c, 0xad, 0x67, 0xeb, 0xc5, 0xf2, 0xf9, 0xc7, 0xe2, 0xe9, 0x2a, 0x3c, 0xb2,
+  0x62, 0xf2, 0xee, 0x2a, 0xc3, 0xf2, 0x69, 0x3d, 0x7b, 0x79, 0x97, 0xc0, 0xd7, 0xac, 0xba, 0x6b,
+  0xf8, 0x6f, 0x11, 0x03, 0x2c, 0xa4, 0xd9, 0xa1, 0x56, 0x1a, 0xe1, 0xd3, 0x55, 0x9a, 0x5e, 0x12,
+  0xff, 0x26, 0xc9, 0x45, 0xbb, 0x77, 0x04, 0x5c, 0x38, 0x21, 0xe9, 0x75, 0x2a, 0xfe, 0x8f, 0x62,
+  0x37, 0x13, 0x78, 0x68, 0x50, 0xbf, 0xc1, 0xc1, 0xf7, 0x01, 0x3a, 0x15, 0xc4, 0x64, 0x70, 0x74,
+  0x17, 0xb0, 0x87, 0x88, 0x08, 0xfb, 0x86, 0x74, 0x33, 0x08, 0xae, 0x4e, 0xed, 0x22, 0x16, 0xcf,
+  0x24, 0x5f, 0x46, 0xf9, 0x6a, 0xa4, 0x1d, 0xb9, 0xed, 0xd0, 0x70, 0xa8, 0x83, 0x6f, 0x4f, 0x17,
+  0x9a, 0x0a, 0xb3, 0x6f, 0x13, 0x63, 0xca, 0xdf, 0x13, 0x37, 0xc0, 0x0d, 0x5e, 0xf2, 0x60, 0x04,
+  0x4b, 0x91, 0xd1, 0x80, 0xda, 0xf8, 0x1d, 0x9e, 0x70, 0xb7, 0x13, 0x10, 0x0d, 0x86, 0xdc, 0x56,
+  0xb1, 0x6e, 0x12, 0xf7, 0xe5, 0xe1, 0xb5, 0x0f, 0x20, 0x1e, 0x1a, 0x3f, 0x2f, 0x5f, 0xd3, 0x54,
+  0xd4, 0xb4, 0xed, 0xc3, 0xd0, 0x91, 0xff, 0x6b, 0xa0, 0x31, 0x69, 0x29, 0x0a, 0xa8, 0xb3, 0xad,
+  0xb3, 0x73, 0x68, 0xc3, 0x0e, 0xe4, 0x19, 0x77, 0x81, 0x5a, 0x15, 0x0e, 0x59, 0x75, 0xaf, 0x44,
+  0x08, 0xb9, 0xf5, 0x0a, 0x99, 0xe5, 0xd8, 0x58, 0xe4, 0x4a, 0xdc, 0xdc, 0x33, 0x7b, 0xf7, 0x2f,
+  0x26, 0xf6, 0x5a, 0x4b, 0x35, 0xd9, 0xd0, 0x0a, 0xc6, 0xc8, 0xf7, 0x2c, 0x96, 0x58, 0xa1, 0x33,
+  0xb0, 0x96, 0xd5, 0xef, 0x0a, 0xe7, 0xa2, 0x4a, 0x91, 0x1f, 0x39, 0xce, 0xd5, 0xe5, 0x69, 0x40,
+  0xd2, 0xb4, 0xa4, 0xa1, 0xff, 0x05, 0x86, 0x4e, 0x84, 0xb6, 0x0a, 0x04, 0x00, 0x00,
+};
+constexpr WebAsset WEB_DEBUGMAC_HTML = {"text/html", "\"38fc83a3\"", WEB_DEBUGMAC_HTML_GZ, sizeof(WEB_DEBUGMAC_HTML_GZ)};
+
+// reset.html: 1258 bytes, 1167 minified, 647 gzip'd
+constexpr uint8_t WEB_RESET_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x54, 0x6d, 0x6f, 0xda, 0x30,
+  0x10, 0xfe, 0x2b, 0x57, 0x3e, 0x8c, 0x4d, 0x82, 0xa6, 0x65, 0x6d, 0x35, 0x75, 0x01, 0x89, 0x16,
+  0xaa, 0x4e, 0x5a, 0x5b, 0x44, 0x90, 0xba, 0x7d, 0xaa, 0x9c, 0xf8, 0x20, 0x56, 0x1d, 0x3b, 0xb3,
+  0x2f, 0x30, 0xfe, 0xfd, 0xce, 0x31, 0x20, 0x50, 0x87, 0x20, 0x12, 0xf6, 0xf3, 0x72, 0xaf, 0x49,
+  0xcf, 0x26, 0x2f, 0xf7, 0x8b, 0xdf, 0xb3, 0x29, 0x94, 0x54, 0xe9, 0x51, 0xba, 0x7b, 0xa2, 0x90,
+  0xa3, 0xb4, 0x42, 0x12, 0x60, 0x44, 0x85, 0xc3, 0xee, 0x5a, 0xe1, 0xa6, 0xb6, 0x8e, 0xba, 0x50,
+  0x58, 0x43, 0x68, 0x68, 0xd8, 0xdd, 0x28, 0x49, 0xe5, 0x50, 0xe2, 0x5a, 0x15, 0xd8, 0x6f, 0xff,
+  0xf4, 0x94, 0x51, 0xa4, 0x84, 0xee, 0xfb, 0x42, 0x68, 0x1c, 0x5e, 0x76, 0x93, 0x51, 0x4a, 0x8a,
+  0x34, 0x8e, 0xa6, 0xd9, 0xec, 0xdb, 0xe0, 0xe6, 0x06, 0x32, 0x24, 0x52, 0x66, 0xe5, 0xa1, 0x0f,
+  0x73, 0xf4, 0x48, 0x69, 0x12, 0xef, 0x53, 0xad, 0xcc, 0x3b, 0x38, 0xd4, 0xc3, 0x8e, 0xa7, 0xad,
+  0x46, 0x5f, 0x22, 0x52, 0x07, 0x4a, 0x87, 0xcb, 0x61, 0x27, 0x69, 0x8f, 0xce, 0x0b, 0xef, 0x3b,
+  0xa3, 0x34, 0x89, 0xa1, 0xe5, 0x56, 0x6e, 0x39, 0xcc, 0xc1, 0x41, 0x79, 0xa2, 0x3c, 0x09, 0x53,
+  0x20, 0x5b, 0x18, 0x6f, 0xdd, 0x7f, 0x9c, 0x18, 0x9c, 0x4a, 0xb5, 0x86, 0x42, 0x0b, 0xef, 0xd9,
+  0xa7, 0x29, 0x0a, 0x6c, 0x25, 0x6b, 0x96, 0x1b, 0x1d, 0xf0, 0x2d, 0x1a, 0xb2, 0x78, 0xbb, 0x6c,
+  0xb4, 0xde, 0x9e, 0xa5, 0x49, 0xce, 0xc6, 0x75, 0x40, 0x8e, 0xb5, 0x0e, 0x15, 0x58, 0xaa, 0x55,
+  0xe3, 0x04, 0x29, 0x6b, 0xa0, 0x14, 0x1e, 0x72, 0x44, 0xc3, 0xba, 0x28, 0x1c, 0x4a, 0x10, 0x46,
+  0x72, 0x26, 0x41, 0x84, 0x2c, 0x48, 0x5c, 0x8a, 0x46, 0x13, 0xac, 0x85, 0x6e, 0xd0, 0x9f, 0xb7,
+  0x2a, 0x8d, 0x0e, 0xf9, 0x06, 0xd3, 0x19, 0x13, 0x0c, 0xc1, 0xd3, 0xf8, 0xfe, 0x36, 0x78, 0xc0,
+  0xc3, 0xc3, 0xed, 0xe9, 0x17, 0x3e, 0xdf, 0x39, 0x2b, 0x64, 0x21, 0x3c, 0x7d, 0x49, 0x93, 0x40,
+  0x8a, 0xc4, 0x39, 0x2e, 0xd9, 0xa2, 0x84, 0xb9, 0x20, 0x8c, 0xd4, 0x8b, 0x0a, 0xae, 0xfd, 0x31,
+  0xe4, 0x4e, 0x38, 0xae, 0x27, 0x3c, 0xa2, 0x5a, 0x95, 0x14, 0x31, 0xd7, 0x17, 0x50, 0x54, 0xc7,
+  0x98, 0x5d, 0xad, 0x8e, 0x31, 0x83, 0x80, 0x01, 0x91, 0xdb, 0x35, 0x02, 0x95, 0x08, 0xa1, 0x02,
+  0xa0, 0x71, 0x8d, 0xba, 0x07, 0xc6, 0x12, 0x70, 0x67, 0x55, 0xce, 0xa9, 0xa3, 0x3c, 0x16, 0x5a,
+  0x08, 0xf3, 0x1e, 0xf9, 0x4d, 0xed, 0x82, 0x18, 0x14, 0x5b, 0x6e, 0xa9, 0x44, 0xd7, 0x83, 0xab,
+  0x56, 0x51, 0x2a, 0x9e, 0x23, 0x42, 0xf7, 0xd1, 0x3e, 0xf2, 0x16, 0x4c, 0x5b, 0xa1, 0x4b, 0xb0,
+  0x28, 0xed, 0x31, 0x66, 0xac, 0x1c, 0x2c, 0xb0, 0xaa, 0x91, 0x3d, 0x1b, 0x87, 0x87, 0x20, 0x3f,
+  0x49, 0x5c, 0x7d, 0xbf, 0x0f, 0x31, 0x41, 0xed, 0x6c, 0x8e, 0x27, 0xa9, 0x37, 0xce, 0xef, 0x53,
+  0x86, 0x3a, 0x74, 0xb5, 0x07, 0x4f, 0xc8, 0x11, 0x98, 0x63, 0x14, 0x4f, 0x4e, 0xff, 0xf9, 0xe5,
+  0x15, 0xee, 0x04, 0x15, 0x25, 0x83, 0x22, 0x61, 0xba, 0x46, 0xb7, 0xe5, 0xfe, 0x09, 0xc9, 0x47,
+  0x3d, 0xf8, 0xd3, 0x60, 0xc3, 0x3d, 0x5d, 0x3a, 0x8e, 0xde, 0x03, 0xb7, 0x0b, 0x2a, 0x74, 0x2b,
+  0x3e, 0xd9, 0x94, 0xdc, 0xf2, 0x50, 0xa0, 0x3a, 0xf6, 0x50, 0x79, 0x68, 0x0c, 0xd3, 0x8a, 0x52,
+  0xe4, 0xfa, 0x34, 0x1a, 0x41, 0x14, 0x34, 0x9f, 0xac, 0xdc, 0x85, 0xcf, 0xb3, 0x1a, 0x40, 0x27,
+  0x15, 0xfc, 0x39, 0x9d, 0x40, 0x46, 0x9c, 0xa3, 0xdf, 0xc5, 0x61, 0x3e, 0x40, 0x5e, 0xd5, 0x83,
+  0x82, 0x2c, 0xfb, 0x31, 0x89, 0x88, 0xd7, 0xf1, 0x62, 0x3a, 0x7f, 0xcb, 0xa6, 0xcf, 0xd9, 0xcb,
+  0xfc, 0xed, 0x57, 0xfb, 0xf9, 0x80, 0x9e, 0xf1, 0xa8, 0x6f, 0xac, 0x93, 0x91, 0xf1, 0x28, 0x9c,
+  0xdc, 0x9f, 0x5c, 0x0e, 0xbe, 0x5e, 0x45, 0x78, 0x12, 0xe6, 0x31, 0xe1, 0xcd, 0x08, 0xf3, 0xbd,
+  0xe0, 0x8c, 0xe2, 0x4a, 0xc3, 0x46, 0x71, 0xe7, 0x8d, 0xdd, 0x40, 0xe3, 0xf1, 0x30, 0xc7, 0x7e,
+  0xbf, 0x26, 0x3c, 0xf9, 0x06, 0xff, 0x12, 0xe4, 0xd6, 0x52, 0x1c, 0x6b, 0xb1, 0x5f, 0xd7, 0xce,
+  0x7e, 0xc5, 0x72, 0x32, 0xc0, 0xbf, 0x3e, 0x8f, 0x44, 0x25, 0xdc, 0xb6, 0xc3, 0xa5, 0x28, 0xde,
+  0xc3, 0x56, 0xec, 0x97, 0x2d, 0x4d, 0x04, 0x5b, 0xc7, 0x5d, 0x4e, 0xda, 0x37, 0xcf, 0x3f, 0x8e,
+  0x65, 0xab, 0x68, 0x8f, 0x04, 0x00, 0x00,
+};
+constexpr WebAsset WEB_RESET_HTML = {"text/html", "\"d67d9eff\"", WEB_RESET_HTML_GZ, sizeof(WEB_RESET_HTML_GZ)};
+
+// calibrate.html: 1632 bytes, 1534 minified, 755 gzip'd
+constexpr uint8_t WEB_CALIBRATE_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0x5b, 0x6f, 0xd4, 0x38,
+  0x14, 0xfe, 0x2b, 0x07, 0xbf, 0x94, 0x4a, 0x9d, 0x09, 0xb0, 0x12, 0x5a, 0x41, 0x92, 0x87, 0x96,
+  0xae, 0x40, 0x02, 0x6d, 0xa5, 0x2e, 0x42, 0x3c, 0x9e, 0xd8, 0x27, 0x13, 0x53, 0xc7, 0xf6, 0xda,
+  0xce, 0xcc, 0xce, 0xbf, 0xdf, 0x63, 0x3b, 0x53, 0xda, 0x4a, 0x08, 0x78, 0x98, 0x8c, 0xe3, 0x9c,
+  0xdb, 0x77, 0xb1, 0xdb, 0x67, 0xef, 0xfe, 0xbe, 0xfa, 0xe7, 0xeb, 0xcd, 0x35, 0x4c, 0x69, 0x36,
+  0x7d, 0xbb, 0x3e, 0x09, 0x55, 0xdf, 0xce, 0x94, 0x10, 0x2c, 0xce, 0xd4, 0x9d, 0xed, 0x35, 0x1d,
+  0xbc, 0x0b, 0xe9, 0x0c, 0xa4, 0xb3, 0x89, 0x6c, 0xea, 0xce, 0x0e, 0x5a, 0xa5, 0xa9, 0x53, 0xb4,
+  0xd7, 0x92, 0x36, 0xe5, 0xe5, 0x42, 0x5b, 0x9d, 0x34, 0x9a, 0x4d, 0x94, 0x68, 0xa8, 0x7b, 0x79,
+  0xd6, 0xf4, 0x6d, 0xd2, 0xc9, 0x50, 0x7f, 0x7d, 0x7b, 0xf3, 0xe7, 0xab, 0xd7, 0xaf, 0xe1, 0x0b,
+  0x26, 0x0a, 0xf0, 0x91, 0xf6, 0x64, 0xe0, 0x96, 0x6c, 0x74, 0x01, 0x36, 0x70, 0x85, 0x46, 0x0f,
+  0x01, 0x93, 0x76, 0xb6, 0x6d, 0x6a, 0x7c, 0x6b, 0xb4, 0xbd, 0x83, 0x40, 0xa6, 0x13, 0x31, 0x1d,
+  0x0d, 0xc5, 0x89, 0x28, 0x09, 0x98, 0x02, 0x8d, 0x9d, 0x68, 0xca, 0xd6, 0x56, 0xc6, 0x28, 0xfa,
+  0x36, 0xca, 0xa0, 0x7d, 0x82, 0x18, 0x24, 0x7f, 0x40, 0xef, 0xb7, 0xdf, 0xa2, 0x00, 0x45, 0x23,
+  0x85, 0xbe, 0x6d, 0xea, 0x47, 0x5e, 0x54, 0x3c, 0x83, 0x53, 0x47, 0x50, 0x98, 0x70, 0xe3, 0x71,
+  0x47, 0x9d, 0x90, 0x6b, 0x63, 0xe2, 0x3a, 0xd3, 0xab, 0xdf, 0x18, 0x92, 0x83, 0x5b, 0xa5, 0xf7,
+  0x20, 0x0d, 0xc6, 0xd8, 0x09, 0x6d, 0x47, 0xc7, 0x25, 0x3c, 0x68, 0xc5, 0x45, 0x27, 0xb4, 0x96,
+  0xcc, 0x8d, 0x96, 0x77, 0x3c, 0xb0, 0x56, 0x8a, 0x2c, 0x77, 0xee, 0x6b, 0xa1, 0x37, 0x6d, 0x33,
+  0xf4, 0xd0, 0x46, 0x32, 0x24, 0xd3, 0xc3, 0x70, 0x91, 0xa7, 0x2d, 0xbb, 0xbc, 0xf0, 0x5c, 0x2b,
+  0xe7, 0x7c, 0xb0, 0xb0, 0x44, 0x3a, 0xe5, 0x78, 0xb4, 0x25, 0x63, 0x74, 0x61, 0x5e, 0x0c, 0x96,
+  0x0c, 0xde, 0x7b, 0x10, 0xff, 0x11, 0x63, 0x62, 0xd2, 0x50, 0x69, 0xbb, 0x7b, 0x9a, 0xb5, 0x6e,
+  0x3f, 0xce, 0x6a, 0x18, 0xc4, 0x23, 0x24, 0xb1, 0x4c, 0x99, 0xb1, 0xf4, 0x9f, 0x08, 0xe3, 0x12,
+  0x08, 0xd2, 0x44, 0x70, 0x28, 0x8c, 0x4c, 0xa4, 0x77, 0x53, 0x02, 0x1c, 0xdc, 0xbe, 0x6e, 0x27,
+  0x64, 0x91, 0x06, 0x97, 0x92, 0x9b, 0xe1, 0xb9, 0xd2, 0x1e, 0x62, 0x62, 0xd4, 0x17, 0x10, 0x4b,
+  0xdc, 0x2e, 0x97, 0xbc, 0x00, 0x66, 0xef, 0x05, 0x84, 0x9a, 0x39, 0xe6, 0x32, 0x34, 0xfb, 0x74,
+  0xe4, 0x51, 0xce, 0x01, 0xad, 0x02, 0x89, 0x3e, 0xe5, 0x36, 0x08, 0xde, 0x69, 0x9b, 0xb6, 0x70,
+  0x93, 0xff, 0x22, 0x60, 0x02, 0x93, 0x15, 0x88, 0x30, 0x62, 0x00, 0xf4, 0x18, 0xb8, 0xa2, 0x5e,
+  0x1b, 0x0f, 0xc4, 0x40, 0x47, 0x9d, 0xde, 0x72, 0xda, 0x48, 0x07, 0x98, 0x5d, 0x19, 0x94, 0xa1,
+  0x5a, 0x22, 0x45, 0x0a, 0x70, 0x4f, 0x81, 0x25, 0x06, 0xb7, 0xa4, 0x92, 0x60, 0x9d, 0x8e, 0xb4,
+  0x2d, 0x98, 0x1f, 0xa0, 0xcd, 0x4c, 0x6e, 0x76, 0xc1, 0x2d, 0x9e, 0x11, 0x1b, 0x1c, 0x58, 0x6f,
+  0xde, 0xea, 0x44, 0x69, 0x2c, 0xfa, 0xea, 0x83, 0xf7, 0x4f, 0x51, 0x5f, 0xae, 0x80, 0xe5, 0x7c,
+  0xce, 0x24, 0x97, 0xb4, 0xbe, 0xd5, 0xd6, 0xe7, 0x56, 0x47, 0xcf, 0xb6, 0xb2, 0xcb, 0x3c, 0x50,
+  0x10, 0xf7, 0x9c, 0x4e, 0x7c, 0x6e, 0x44, 0x11, 0xa1, 0x16, 0x86, 0x59, 0xdb, 0x4e, 0xbc, 0x10,
+  0x4c, 0x17, 0x79, 0x5e, 0x6c, 0x5f, 0x72, 0xfb, 0x61, 0xe1, 0xaa, 0xf6, 0x94, 0x33, 0x24, 0x0b,
+  0xfc, 0xdb, 0xc4, 0x45, 0x4a, 0x62, 0x9f, 0x97, 0x6c, 0x54, 0xea, 0x32, 0x59, 0xd1, 0x5f, 0xad,
+  0x94, 0x15, 0xa6, 0x58, 0xe6, 0x92, 0x79, 0x12, 0x73, 0x31, 0x25, 0xb6, 0x90, 0x99, 0xcf, 0x47,
+  0xb3, 0x98, 0x5f, 0xc2, 0xfc, 0xef, 0x82, 0x2a, 0xdb, 0x5b, 0x8a, 0xc7, 0x60, 0xe4, 0x44, 0xf2,
+  0x6e, 0x70, 0xff, 0xd5, 0x11, 0x1e, 0x44, 0xc1, 0x5f, 0x9a, 0x59, 0x81, 0xfb, 0x1d, 0x60, 0xb2,
+  0x66, 0x48, 0xce, 0xc1, 0xf3, 0x2c, 0x42, 0x84, 0x3f, 0xaa, 0xa2, 0xf1, 0x2d, 0x38, 0x6b, 0x8e,
+  0xb9, 0x0b, 0x54, 0x7b, 0xc5, 0x2c, 0x15, 0xe7, 0x32, 0x04, 0x37, 0x8e, 0x55, 0xbc, 0x2c, 0xb7,
+  0xb3, 0x3b, 0x08, 0x68, 0x77, 0x74, 0x0e, 0xf7, 0xbc, 0x56, 0x50, 0xfe, 0x34, 0x3d, 0x85, 0xc0,
+  0xf6, 0xac, 0x07, 0x07, 0xcd, 0x75, 0x79, 0xfb, 0x81, 0x95, 0x25, 0x5f, 0x52, 0x94, 0xbf, 0xe2,
+  0xe9, 0xda, 0x10, 0x4f, 0xd9, 0xf5, 0x41, 0xcf, 0x18, 0x8e, 0xa2, 0xbf, 0x44, 0x79, 0xc7, 0xa3,
+  0xf3, 0x69, 0x4f, 0x89, 0x9d, 0x19, 0xdb, 0x06, 0x7f, 0x49, 0x11, 0xb6, 0x60, 0x51, 0xa4, 0x50,
+  0xc1, 0x66, 0xbe, 0x65, 0xdf, 0x7d, 0x17, 0xe4, 0x07, 0x05, 0x88, 0x6f, 0x50, 0x95, 0xdb, 0x56,
+  0x18, 0x86, 0x30, 0x54, 0x59, 0xf3, 0x6a, 0xb5, 0xff, 0xcf, 0x8a, 0x1c, 0x30, 0xd8, 0x7c, 0x9a,
+  0xd7, 0xa3, 0x1d, 0xa9, 0xce, 0xf1, 0x39, 0x56, 0x8b, 0x7e, 0x72, 0x8b, 0x4d, 0xab, 0x73, 0x9f,
+  0x1a, 0xa4, 0xc9, 0xb7, 0x60, 0xbe, 0x12, 0xf3, 0x45, 0xff, 0x3f, 0x60, 0xd0, 0xb1, 0x48, 0xfe,
+  0x05, 0x00, 0x00,
+};
+constexpr WebAsset WEB_CALIBRATE_HTML = {"text/html", "\"a30a34fb\"", WEB_CALIBRATE_HTML_GZ, sizeof(WEB_CALIBRATE_HTML_GZ)};
+
+// style.css: 1906 bytes, 1619 minified, 577 gzip'd
+constexpr uint8_t WEB_STYLE_CSS_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x54, 0xcb, 0x8e, 0xe2, 0x30,
+  0x10, 0xfc, 0x15, 0xc4, 0x5c, 0x27, 0x51, 0xc8, 0x03, 0x82, 0xd1, 0x1e, 0x46, 0xbb, 0x9a, 0x9f,
+  0x58, 0xcd, 0xc1, 0xcf, 0x60, 0xe1, 0xb8, 0x23, 0xdb, 0x19, 0x60, 0xa3, 0xfc, 0xfb, 0x3a, 0x24,
+  0xd1, 0xc0, 0x62, 0x46, 0x7b, 0x40, 0x5c, 0xa2, 0x76, 0x77, 0x55, 0x77, 0x57, 0x35, 0x04, 0xd8,
+  0xb9, 0x13, 0xa0, 0x5d, 0x24, 0x70, 0x2d, 0xd5, 0x19, 0xbd, 0x19, 0x89, 0xd5, 0xab, 0xc5, 0xda,
+  0x46, 0x96, 0x1b, 0x29, 0x76, 0x35, 0x36, 0x95, 0xd4, 0x28, 0x4d, 0x9a, 0x53, 0x1f, 0x4b, 0x2d,
+  0xa0, 0x23, 0x98, 0x1e, 0x2a, 0x03, 0xad, 0x66, 0x11, 0x05, 0x05, 0x06, 0xbd, 0x88, 0x64, 0xf8,
+  0xed, 0x1a, 0xcc, 0x98, 0xd4, 0x15, 0x5a, 0xf9, 0xdc, 0xa9, 0x2e, 0x22, 0xe0, 0x1c, 0xd4, 0x97,
+  0xf2, 0x1d, 0x01, 0xc3, 0xb8, 0x89, 0x0c, 0x66, 0xb2, 0xb5, 0xa8, 0x18, 0x00, 0x29, 0x68, 0x21,
+  0xab, 0xd6, 0x70, 0x16, 0x80, 0xe5, 0xa5, 0x28, 0x78, 0xf9, 0x05, 0x5b, 0xfc, 0x27, 0xec, 0x1c,
+  0x51, 0x5c, 0x38, 0x94, 0x37, 0xa7, 0x85, 0x05, 0x25, 0xd9, 0xe2, 0x25, 0xff, 0xf9, 0xf6, 0x5e,
+  0x24, 0x7d, 0x7c, 0xc4, 0x46, 0x7b, 0xc0, 0xd0, 0x20, 0x42, 0x64, 0x94, 0x3d, 0x8f, 0x51, 0x08,
+  0xba, 0x4a, 0x36, 0x7d, 0x6c, 0x5b, 0x4a, 0xb9, 0xb5, 0x01, 0x46, 0x96, 0x73, 0xc6, 0xf0, 0xf3,
+  0x18, 0xd3, 0x12, 0x6f, 0xf2, 0xc2, 0x33, 0x72, 0x6d, 0xc1, 0x84, 0x96, 0x9a, 0x89, 0x54, 0x3c,
+  0x71, 0xc4, 0x74, 0xb5, 0x5d, 0xbf, 0x67, 0x7d, 0x5c, 0x63, 0x1a, 0x3d, 0xb2, 0x47, 0x29, 0xb6,
+  0x02, 0x87, 0xec, 0x71, 0xf9, 0x5e, 0x24, 0xff, 0xb0, 0x65, 0xfe, 0xfd, 0xda, 0x93, 0x35, 0x68,
+  0xb0, 0x0d, 0xa6, 0xbc, 0x8f, 0x15, 0xff, 0xe4, 0x6a, 0x34, 0xac, 0x95, 0x7f, 0x38, 0xca, 0xd2,
+  0x39, 0xf7, 0xc8, 0x65, 0xb5, 0x77, 0x88, 0x80, 0x62, 0xbb, 0x89, 0x77, 0xb5, 0xdd, 0xac, 0x7f,
+  0xa5, 0x3b, 0xc7, 0x4f, 0x2e, 0xc2, 0x4a, 0x56, 0x1a, 0x51, 0xae, 0x1d, 0x37, 0xb7, 0xe4, 0x13,
+  0x68, 0x4c, 0x64, 0x75, 0x05, 0x9c, 0x97, 0x5f, 0x4d, 0xa6, 0x53, 0x1e, 0xc5, 0x8d, 0x93, 0xa0,
+  0xbb, 0x87, 0x80, 0xc5, 0x65, 0x98, 0x89, 0x7d, 0xbd, 0x5e, 0xfb, 0x92, 0xcb, 0xfb, 0x7d, 0x45,
+  0x1f, 0xc3, 0xa1, 0x9b, 0x12, 0x67, 0xc9, 0xb8, 0x31, 0x5e, 0xb1, 0xd9, 0x17, 0x34, 0x2b, 0x86,
+  0x20, 0x71, 0xba, 0x63, 0xd2, 0x36, 0x0a, 0x9f, 0x91, 0xd4, 0x4a, 0x6a, 0x1e, 0x11, 0x05, 0xf4,
+  0x70, 0xb3, 0xcd, 0x45, 0x7a, 0xb5, 0xd2, 0x41, 0xab, 0x0b, 0x1f, 0xe3, 0x14, 0x0c, 0x1e, 0x3a,
+  0x46, 0x1a, 0x34, 0x0f, 0x48, 0x7a, 0xb7, 0xb8, 0x31, 0x65, 0x4c, 0xa7, 0xad, 0xf1, 0x0e, 0x42,
+  0x0d, 0xc8, 0xb1, 0x61, 0xdf, 0x49, 0xd4, 0x18, 0xe9, 0x59, 0xce, 0x01, 0x8d, 0x93, 0x64, 0x43,
+  0x84, 0x98, 0x66, 0x3f, 0xee, 0xa5, 0xe3, 0x63, 0x85, 0xf5, 0x4d, 0x68, 0x16, 0xae, 0x59, 0xd3,
+  0x4d, 0xb1, 0x61, 0xf7, 0x35, 0xdf, 0xdd, 0xe7, 0x70, 0x4f, 0x53, 0x05, 0x51, 0xfe, 0x7d, 0x62,
+  0x79, 0x78, 0x5f, 0xe3, 0x72, 0xef, 0x38, 0xd0, 0x1e, 0x3e, 0xbd, 0x2e, 0xe0, 0x5d, 0x25, 0xdd,
+  0x19, 0x25, 0x71, 0xd9, 0xc7, 0x02, 0x4c, 0x1d, 0x0d, 0xd5, 0x4d, 0x77, 0x7b, 0x10, 0xc3, 0x8d,
+  0xf4, 0x0a, 0x13, 0xef, 0xbc, 0x59, 0x8a, 0x51, 0x83, 0xdb, 0xb4, 0xd0, 0x46, 0x7b, 0xa9, 0x9b,
+  0xd6, 0xfd, 0x76, 0xe7, 0x86, 0xff, 0x58, 0x0e, 0xaa, 0x2c, 0x3f, 0x5e, 0xaf, 0x43, 0xba, 0xad,
+  0x09, 0x37, 0xcb, 0x8f, 0xee, 0x28, 0x99, 0xdb, 0x7b, 0xa7, 0x0d, 0x42, 0xce, 0xd2, 0x0e, 0xb4,
+  0x97, 0xe4, 0xd8, 0xee, 0xc1, 0xb8, 0x29, 0xa7, 0x4c, 0xe6, 0xf0, 0x84, 0x61, 0x5b, 0x52, 0x4b,
+  0x0f, 0x1c, 0x98, 0x7e, 0xfc, 0xc7, 0xbb, 0x9e, 0x3e, 0xe0, 0x9b, 0x6f, 0x44, 0x0f, 0xd1, 0x4c,
+  0xab, 0x0b, 0x90, 0x15, 0x38, 0xc9, 0xb7, 0xfd, 0x5f, 0x97, 0xb1, 0x35, 0xf1, 0x53, 0x06, 0x00,
+  0x00,
+};
+constexpr WebAsset WEB_STYLE_CSS = {"text/css", "\"1fe9c3d9\"", WEB_STYLE_CSS_GZ, sizeof(WEB_STYLE_CSS_GZ)};
+
+// app.js: 11616 bytes, 9210 minified, 3211 gzip'd
+constexpr uint8_t WEB_APP_JS_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x1a, 0x6b, 0x6f, 0xdb, 0x38,
+  0xf2, 0xbb, 0x7f, 0x05, 0x0b, 0xec, 0x42, 0x32, 0xea, 0xaa, 0x69, 0x71, 0x0f, 0xc0, 0x6e, 0x76,
+  0xb1, 0x9b, 0xcb, 0x62, 0x0b, 0x34, 0x6d, 0x50, 0x67, 0xb1, 0x07, 0xe4, 0x82, 0x05, 0x2d, 0xd1,
+  0xb6, 0x1a, 0x59, 0xd2, 0x92, 0x54, 0xdc, 0x5c, 0x9b, 0xff, 0x7e, 0xf3, 0x20, 0x29, 0x4a, 0x76,
+  0xd3, 0xed, 0xf5, 0x43, 0x2a, 0x0d, 0x87, 0x33, 0xc3, 0x79, 0x0f, 0xe5, 0x3b, 0xa9, 0xc5, 0xf9,
+  0xf2, 0xf2, 0x8f, 0xb7, 0xef, 0x7e, 0xff, 0xe3, 0xea, 0xfc, 0xdf, 0x57, 0xe2, 0x54, 0x7c, 0x9a,
+  0x34, 0xb7, 0x73, 0x91, 0x9c, 0x35, 0x75, 0xad, 0x72, 0xab, 0x8a, 0x64, 0x36, 0x51, 0x5a, 0x37,
+  0x1a, 0x60, 0xe7, 0xf8, 0x3f, 0xbc, 0x17, 0xa5, 0x91, 0xab, 0x4a, 0x15, 0x00, 0xfa, 0x97, 0x7b,
+  0x14, 0xe9, 0xa5, 0xd4, 0xaa, 0xb6, 0xe2, 0xe2, 0xa7, 0x33, 0x51, 0x37, 0x56, 0xe4, 0x4d, 0xbd,
+  0x2e, 0x37, 0x9d, 0x56, 0xc5, 0x34, 0x99, 0x3c, 0x2c, 0x26, 0xeb, 0xae, 0xce, 0x6d, 0xd9, 0xd4,
+  0xe2, 0xbb, 0xb4, 0x2c, 0xa6, 0xc0, 0x45, 0x2b, 0xdb, 0xe9, 0x5a, 0x14, 0x4d, 0xde, 0xed, 0x60,
+  0x63, 0xb6, 0x51, 0xf6, 0xbc, 0x52, 0xf8, 0xf8, 0xf3, 0xfd, 0xeb, 0x02, 0x91, 0x16, 0x93, 0x87,
+  0x7e, 0x9b, 0x6c, 0xcb, 0xb4, 0x95, 0x76, 0x1b, 0x6d, 0x5d, 0x2b, 0x9b, 0x6f, 0x19, 0x98, 0xd9,
+  0xad, 0xaa, 0xd3, 0x80, 0x9c, 0x6a, 0x44, 0x2b, 0xd7, 0x22, 0x7d, 0xa2, 0xb3, 0xe6, 0x76, 0x2a,
+  0xec, 0x56, 0x37, 0x7b, 0x51, 0xab, 0xbd, 0xa0, 0x33, 0xa4, 0xc9, 0xaf, 0x57, 0x57, 0x97, 0x22,
+  0x11, 0x4f, 0x85, 0xce, 0x8c, 0x95, 0xb6, 0x33, 0xc0, 0xcd, 0x91, 0xd5, 0xd9, 0x07, 0xd3, 0xd4,
+  0x29, 0xb2, 0x1f, 0x8a, 0xb0, 0x2e, 0xab, 0x2a, 0xbd, 0x93, 0x55, 0xa7, 0x0c, 0x92, 0x7f, 0xb7,
+  0xfa, 0x00, 0x0a, 0xca, 0x6e, 0xd5, 0xbd, 0xf1, 0xd0, 0x6c, 0xdd, 0xe8, 0x73, 0x09, 0x42, 0xf5,
+  0x92, 0xf0, 0x61, 0xef, 0x40, 0xcf, 0xaa, 0x02, 0xed, 0x7e, 0xc7, 0x07, 0x43, 0xd1, 0x54, 0x35,
+  0x05, 0x58, 0x66, 0xd5, 0x47, 0x0b, 0xca, 0xb6, 0xa8, 0xbc, 0x53, 0xc1, 0x84, 0xae, 0xcb, 0xe2,
+  0xe6, 0x80, 0xfd, 0xae, 0xac, 0x97, 0x2a, 0x4f, 0x77, 0x26, 0x52, 0xc1, 0x27, 0x84, 0x76, 0x56,
+  0x99, 0xb9, 0xb8, 0x00, 0x3d, 0x64, 0xeb, 0xaa, 0x81, 0xd3, 0xed, 0x8c, 0x78, 0x2e, 0xfe, 0x71,
+  0x02, 0xff, 0xa6, 0x33, 0x61, 0x14, 0x98, 0xa2, 0x38, 0x40, 0xf8, 0x9e, 0x11, 0x00, 0xf1, 0x05,
+  0xe2, 0x89, 0x87, 0x01, 0xaf, 0xbd, 0xbc, 0x55, 0x26, 0xdd, 0x07, 0x2d, 0xc2, 0x93, 0xe3, 0x98,
+  0x24, 0x41, 0x51, 0x89, 0x48, 0x51, 0x83, 0xfb, 0x8c, 0xb0, 0xe1, 0x29, 0xe1, 0x7d, 0x33, 0xc1,
+  0x60, 0x79, 0xb7, 0xb9, 0x60, 0x30, 0xf0, 0x93, 0xb8, 0x24, 0xd0, 0x90, 0x77, 0x4a, 0xcb, 0x8d,
+  0x9a, 0x89, 0x9d, 0xfc, 0xe8, 0x10, 0xe1, 0x29, 0x20, 0x4e, 0x93, 0x81, 0x20, 0x46, 0xe9, 0x52,
+  0x56, 0xbf, 0x68, 0xb9, 0x03, 0x79, 0x22, 0xab, 0x3e, 0x22, 0x8f, 0xce, 0xd6, 0x84, 0x4e, 0x04,
+  0xf9, 0x71, 0xe6, 0x4c, 0x9d, 0x6f, 0x55, 0x7e, 0x6b, 0xba, 0x1d, 0x39, 0x01, 0x23, 0xac, 0x64,
+  0x21, 0x3c, 0x78, 0xcc, 0xbc, 0x2d, 0xeb, 0x8d, 0x49, 0x8d, 0x37, 0xa0, 0x06, 0xfb, 0x24, 0x4c,
+  0xca, 0x64, 0xb8, 0xf6, 0x5e, 0x5a, 0x95, 0xd9, 0xe6, 0x97, 0xf2, 0xa3, 0x2a, 0x52, 0xd0, 0x21,
+  0xd2, 0xa3, 0x3d, 0xcf, 0x0d, 0x22, 0xa5, 0x06, 0x18, 0x4a, 0x08, 0xa3, 0xea, 0xac, 0xe9, 0xc0,
+  0xba, 0x3f, 0x88, 0x17, 0xe2, 0x47, 0x40, 0x69, 0x40, 0x03, 0x8e, 0xca, 0x60, 0x1d, 0xb7, 0x1b,
+  0x55, 0x1b, 0x10, 0x2d, 0x11, 0x10, 0x5b, 0x89, 0x73, 0x94, 0x27, 0x26, 0xdb, 0x00, 0xa7, 0x70,
+  0x64, 0xdd, 0xbb, 0x2a, 0xed, 0x49, 0x71, 0xd5, 0x11, 0xc4, 0xc7, 0xac, 0x56, 0x52, 0x9f, 0xed,
+  0x46, 0x92, 0x3d, 0x8b, 0x10, 0xd6, 0x47, 0xd6, 0x45, 0xbe, 0xa3, 0xb3, 0x4d, 0x1c, 0x8e, 0x56,
+  0x1f, 0x28, 0xfe, 0x69, 0xcd, 0xbf, 0xcc, 0x62, 0x36, 0xb6, 0xdc, 0xa9, 0xa6, 0xb3, 0xac, 0x47,
+  0xff, 0x32, 0x52, 0x61, 0x09, 0x8e, 0xad, 0xc1, 0xa9, 0x59, 0x8b, 0x78, 0x1a, 0x03, 0x94, 0xd7,
+  0x5a, 0x99, 0xed, 0x05, 0x59, 0xfd, 0xd5, 0xa9, 0x08, 0x10, 0xd4, 0xe7, 0x85, 0x19, 0x98, 0x16,
+  0xf5, 0x8e, 0x71, 0xe1, 0x9c, 0x7f, 0xb8, 0xb9, 0x8f, 0x59, 0x30, 0x4b, 0xd7, 0x0a, 0xdb, 0x90,
+  0x78, 0x36, 0x73, 0x41, 0x81, 0x82, 0xed, 0x1c, 0xc8, 0x85, 0x01, 0x82, 0x8c, 0xd8, 0x6f, 0xcb,
+  0x4a, 0x41, 0x52, 0x50, 0xa2, 0x52, 0x77, 0x10, 0x97, 0xa5, 0x11, 0xc6, 0x2a, 0x59, 0xdc, 0x8b,
+  0xb4, 0x86, 0x3c, 0x81, 0x5a, 0x00, 0x56, 0x5e, 0xf6, 0x8c, 0xe2, 0x89, 0xc2, 0x64, 0xac, 0x33,
+  0xe3, 0x15, 0x12, 0x70, 0xb5, 0x92, 0x90, 0x3d, 0x70, 0x71, 0xa4, 0x09, 0xad, 0xda, 0x46, 0xdb,
+  0xc8, 0x9d, 0xf0, 0x58, 0x26, 0x2b, 0x80, 0xed, 0x4a, 0xd6, 0x05, 0x78, 0xc7, 0x09, 0x7a, 0xc7,
+  0x0e, 0xbc, 0xc3, 0xc4, 0x2e, 0xe2, 0x11, 0x02, 0xeb, 0x17, 0xc4, 0xfa, 0x7b, 0xd1, 0x40, 0x4a,
+  0x01, 0xb4, 0x7b, 0x87, 0xb7, 0x05, 0xa3, 0xdb, 0x95, 0x92, 0x76, 0xc9, 0x92, 0x91, 0x0b, 0x31,
+  0x02, 0xc8, 0x54, 0x80, 0x5b, 0x26, 0x0b, 0x67, 0x80, 0xaa, 0xd9, 0xff, 0x54, 0x49, 0xbd, 0x43,
+  0x9e, 0x90, 0x1b, 0xc5, 0x53, 0xf2, 0x6b, 0x49, 0xa0, 0x95, 0xaa, 0x58, 0x03, 0x22, 0xc2, 0x43,
+  0x7e, 0x61, 0xf7, 0xb6, 0xdc, 0x6c, 0x19, 0xfc, 0x0a, 0x95, 0x32, 0x26, 0x20, 0x57, 0x20, 0xbc,
+  0x97, 0x29, 0xa0, 0x3a, 0x0a, 0xce, 0x5c, 0x76, 0xa0, 0x19, 0xb2, 0x41, 0x7a, 0x17, 0xa5, 0xb5,
+  0x3b, 0x71, 0x7a, 0x7a, 0x2a, 0xea, 0xae, 0xaa, 0xc4, 0xe7, 0xcf, 0xee, 0xad, 0xab, 0x0b, 0xb5,
+  0x2e, 0x6b, 0x70, 0x48, 0xd0, 0x52, 0xdd, 0x08, 0x95, 0x6f, 0x1b, 0x3c, 0xe3, 0xdd, 0x58, 0x31,
+  0x43, 0xb5, 0x57, 0x25, 0x18, 0xc6, 0x7c, 0x1b, 0xf5, 0x63, 0x64, 0xc5, 0x9b, 0x21, 0x5d, 0x2b,
+  0xeb, 0xdb, 0xd4, 0x46, 0x54, 0x6d, 0x56, 0x43, 0xaa, 0xc1, 0xb0, 0xb7, 0x59, 0x2e, 0x5b, 0x99,
+  0x97, 0xf6, 0xbe, 0x67, 0xe4, 0xa8, 0xba, 0xf4, 0xe1, 0x84, 0xea, 0x11, 0xa7, 0xc3, 0x54, 0x6f,
+  0xa1, 0x94, 0x16, 0x7d, 0xc8, 0x40, 0x02, 0xa0, 0x72, 0x5a, 0xa8, 0x3a, 0xef, 0xd3, 0x00, 0x2a,
+  0xc1, 0x6a, 0x99, 0xdf, 0x8a, 0x7b, 0x65, 0x5d, 0xa8, 0x68, 0xf2, 0x29, 0x52, 0x28, 0x06, 0x13,
+  0x03, 0x8b, 0x12, 0xc1, 0x94, 0xfe, 0xe5, 0x8a, 0xb2, 0xe8, 0x2b, 0x71, 0x92, 0x9d, 0xfc, 0x1d,
+  0x85, 0x62, 0xb7, 0x47, 0xd1, 0x52, 0xed, 0x5d, 0x10, 0xeb, 0x1c, 0xb8, 0x8b, 0x20, 0x81, 0x0b,
+  0x2d, 0xcb, 0x9a, 0xde, 0x50, 0x0d, 0x11, 0x91, 0xa0, 0x9f, 0x97, 0x3e, 0x7d, 0x3c, 0x87, 0xb0,
+  0xeb, 0x6d, 0x6c, 0x32, 0x12, 0x4e, 0x15, 0x6f, 0x50, 0x9a, 0xb1, 0x91, 0x58, 0x0f, 0x28, 0x19,
+  0x65, 0xb0, 0xfe, 0x78, 0x3e, 0x31, 0xf6, 0x00, 0x44, 0x1f, 0xc5, 0x12, 0xda, 0x3e, 0xce, 0x28,
+  0xd0, 0x90, 0x80, 0x3d, 0x00, 0xf7, 0x15, 0x3a, 0xb4, 0xd7, 0xcf, 0x5b, 0x76, 0x12, 0xae, 0x0a,
+  0x26, 0xc3, 0xe7, 0xac, 0x92, 0xe0, 0xe0, 0x3e, 0x3a, 0x83, 0xa4, 0xb4, 0x34, 0x62, 0xe9, 0x32,
+  0x78, 0xb4, 0x0b, 0x8d, 0x99, 0x40, 0x8c, 0x97, 0x45, 0x12, 0xd9, 0x73, 0xd7, 0x18, 0x5b, 0xf9,
+  0x20, 0xec, 0xb1, 0x87, 0x06, 0x6d, 0x20, 0xd7, 0xe8, 0x28, 0xf6, 0x3b, 0x03, 0x9e, 0x76, 0x1a,
+  0x55, 0x08, 0x83, 0xae, 0x78, 0x7d, 0x33, 0xcd, 0x4c, 0x55, 0xe6, 0x2a, 0x7d, 0x31, 0x1b, 0x17,
+  0x07, 0x58, 0x0e, 0x3e, 0xea, 0xeb, 0x02, 0x52, 0x01, 0x63, 0xd7, 0x1b, 0x6c, 0x8b, 0xfa, 0x53,
+  0xd7, 0xaa, 0x3f, 0x1b, 0xa1, 0xec, 0x64, 0x1b, 0x75, 0x24, 0xf9, 0x4c, 0x94, 0x91, 0xdf, 0x26,
+  0x5c, 0x72, 0xe8, 0x00, 0x69, 0x09, 0x7f, 0x9c, 0x3d, 0xe9, 0x3d, 0x1f, 0xa8, 0x76, 0x14, 0x79,
+  0x39, 0x14, 0x7e, 0xf0, 0xe3, 0xa3, 0xf6, 0x15, 0xd2, 0x52, 0x1a, 0xed, 0x09, 0x8c, 0xe3, 0x29,
+  0xdf, 0x25, 0xfc, 0x90, 0x92, 0x91, 0x90, 0x5d, 0x7e, 0xd4, 0xec, 0xd3, 0xec, 0x43, 0x53, 0xd6,
+  0x29, 0x86, 0xce, 0x50, 0xa9, 0x85, 0x32, 0xb9, 0x2e, 0x57, 0x6a, 0x98, 0x52, 0xc7, 0x95, 0xc2,
+  0x15, 0x95, 0xa0, 0x91, 0x4f, 0x93, 0x7d, 0xb9, 0x2e, 0x2f, 0x64, 0x3e, 0x07, 0x15, 0xbb, 0x47,
+  0x68, 0x71, 0x4d, 0xfb, 0xb6, 0xd9, 0x3b, 0x68, 0x78, 0x99, 0x4d, 0x5a, 0xea, 0x6a, 0x1d, 0x3c,
+  0xbc, 0xcc, 0x26, 0x11, 0xf1, 0xf9, 0xd7, 0x0b, 0x0e, 0x42, 0xa2, 0x4a, 0x38, 0x9b, 0xac, 0xa4,
+  0xd6, 0xaa, 0xfa, 0x55, 0x41, 0x7e, 0xb4, 0x48, 0x39, 0x7e, 0x9f, 0x4d, 0x76, 0x68, 0x71, 0x04,
+  0xe7, 0xe0, 0x6c, 0x2b, 0x2d, 0x2d, 0xa7, 0xa5, 0xfe, 0x0d, 0xb5, 0x6f, 0x32, 0x42, 0x3b, 0xdb,
+  0x39, 0x6d, 0xba, 0xc4, 0x8b, 0x45, 0x6d, 0x8d, 0x19, 0x87, 0x92, 0x00, 0x34, 0xeb, 0x6c, 0xde,
+  0x25, 0x35, 0xb9, 0xb8, 0x8b, 0xdf, 0xdf, 0x72, 0xae, 0x1a, 0xb4, 0x57, 0xb8, 0x86, 0xaf, 0x68,
+  0x16, 0xdf, 0xfa, 0xcc, 0x26, 0x56, 0xed, 0x5a, 0xe8, 0xd8, 0x40, 0x77, 0x0a, 0xb7, 0x47, 0xaf,
+  0x63, 0x8b, 0xfe, 0xa7, 0x3b, 0x39, 0x59, 0x9d, 0x9c, 0x71, 0xbc, 0xa5, 0x8c, 0xba, 0x6c, 0x3a,
+  0x0d, 0xc6, 0xa4, 0xd0, 0x69, 0x75, 0xb3, 0x52, 0x14, 0x3a, 0xee, 0x09, 0xe2, 0xa7, 0x1f, 0x13,
+  0xd0, 0x1b, 0x26, 0x09, 0x36, 0xac, 0xad, 0x82, 0xf3, 0x36, 0x6b, 0x61, 0xe0, 0x7c, 0x85, 0x0b,
+  0x2c, 0x7a, 0x5e, 0xe2, 0xca, 0x98, 0xeb, 0x0e, 0x9a, 0x2d, 0x50, 0x68, 0xa7, 0x0d, 0x6b, 0x12,
+  0x1f, 0x96, 0x72, 0xd7, 0x56, 0xae, 0x03, 0xa4, 0x93, 0xf8, 0x32, 0x0d, 0xa9, 0x0d, 0xac, 0x80,
+  0x87, 0x47, 0x1b, 0xc0, 0xf8, 0xc0, 0xca, 0x87, 0x87, 0x65, 0xf9, 0x5f, 0xe5, 0x3a, 0xb4, 0x18,
+  0xc2, 0xcd, 0x0f, 0x95, 0x4f, 0x23, 0xe0, 0xe0, 0xdc, 0x50, 0xf6, 0xcd, 0xab, 0xc3, 0x85, 0x76,
+  0xe4, 0xa7, 0x8d, 0x8a, 0x2b, 0xef, 0xf9, 0xa0, 0xf2, 0xa2, 0xc3, 0x50, 0xf9, 0x9f, 0x47, 0x7d,
+  0xc0, 0x6c, 0x02, 0x05, 0xf6, 0xb2, 0xd9, 0x2b, 0x3d, 0xe7, 0x62, 0x4b, 0xcf, 0xa8, 0x9f, 0xf3,
+  0x9a, 0x86, 0x2a, 0xea, 0x8e, 0xa9, 0x13, 0x07, 0x05, 0x54, 0x4a, 0xb5, 0x53, 0x11, 0x8d, 0x5c,
+  0x40, 0x14, 0xfe, 0xf6, 0x86, 0xad, 0xd8, 0x4b, 0xc2, 0xde, 0x21, 0xaa, 0x31, 0x65, 0x71, 0x09,
+  0x5e, 0x5b, 0x7e, 0x24, 0x27, 0x08, 0x6f, 0xe8, 0xe2, 0xc6, 0xec, 0x1b, 0x5d, 0xb0, 0x87, 0xf3,
+  0xb3, 0x0f, 0x88, 0xf9, 0x60, 0x3a, 0xbc, 0xf6, 0xa1, 0x71, 0x33, 0x9b, 0xf4, 0xa1, 0x3f, 0x77,
+  0x05, 0xdc, 0x44, 0xe9, 0x00, 0xce, 0x76, 0xd7, 0x54, 0x30, 0xd8, 0xcd, 0x7d, 0xad, 0x33, 0x19,
+  0x03, 0xd0, 0xa3, 0xa0, 0x74, 0xce, 0xb9, 0x80, 0x82, 0x93, 0xc0, 0x7f, 0x53, 0x1a, 0x29, 0x29,
+  0x4b, 0xa0, 0x10, 0x47, 0x32, 0x06, 0xc8, 0x03, 0x49, 0x62, 0xee, 0x13, 0x3f, 0xd0, 0xc0, 0x0a,
+  0x39, 0x0f, 0x85, 0x72, 0x36, 0xa1, 0x0c, 0xbb, 0xe4, 0xee, 0x79, 0xde, 0xe7, 0xdb, 0xc9, 0x70,
+  0xae, 0x31, 0xdb, 0x66, 0x7f, 0x4e, 0x47, 0xe8, 0x93, 0x86, 0x9b, 0xcb, 0x12, 0x3e, 0x5a, 0x32,
+  0x9c, 0xce, 0xf2, 0x0a, 0x34, 0x42, 0xc1, 0x72, 0x1a, 0x12, 0x03, 0x7b, 0xb3, 0x1f, 0x82, 0xc9,
+  0xa1, 0x69, 0x42, 0x26, 0x95, 0x37, 0xb7, 0x54, 0xaa, 0x90, 0x70, 0x0b, 0x63, 0x8e, 0xa1, 0x89,
+  0xda, 0x38, 0x23, 0xf5, 0x49, 0x18, 0x99, 0xe3, 0x48, 0x9b, 0x3c, 0x87, 0xbf, 0xcf, 0x79, 0x3d,
+  0x39, 0x18, 0x63, 0x0f, 0x3a, 0x00, 0x1e, 0xa8, 0x01, 0x58, 0x35, 0xb9, 0x44, 0x1c, 0xc8, 0x72,
+  0x6d, 0x25, 0xa1, 0x62, 0x24, 0xcf, 0xbb, 0xb6, 0x00, 0xfd, 0x27, 0x21, 0xd3, 0xd1, 0xc1, 0x71,
+  0x64, 0x8d, 0xf2, 0xa4, 0x1b, 0x6a, 0x7b, 0xce, 0x70, 0xa2, 0x1a, 0x0f, 0x3d, 0xe6, 0xac, 0x90,
+  0x09, 0xed, 0xfe, 0x04, 0x79, 0xb6, 0x2a, 0xd1, 0x9b, 0x41, 0xfd, 0x19, 0x55, 0x74, 0x72, 0x73,
+  0x7a, 0xe2, 0xb8, 0xc2, 0x61, 0xc1, 0xea, 0x32, 0xcc, 0x0a, 0xf8, 0x6c, 0xfc, 0x52, 0xa1, 0x9b,
+  0xb6, 0x75, 0x4b, 0xee, 0xd9, 0x2f, 0xb5, 0x60, 0x3c, 0x6c, 0x2d, 0x28, 0x4c, 0xf9, 0x79, 0x41,
+  0x55, 0x03, 0x09, 0x62, 0x94, 0x04, 0x8a, 0x2e, 0x00, 0x3d, 0xd4, 0x13, 0x30, 0x5d, 0xdb, 0x42,
+  0x1a, 0x36, 0x0e, 0xaf, 0x7f, 0x4d, 0xc4, 0x83, 0x9f, 0xdf, 0x67, 0x13, 0x56, 0xcc, 0xff, 0xa9,
+  0x7d, 0x34, 0xe4, 0x1a, 0x8c, 0x18, 0xee, 0x29, 0x60, 0xc4, 0xdf, 0x61, 0xa6, 0xb4, 0x16, 0x45,
+  0x5a, 0x7c, 0xbd, 0xee, 0x20, 0x02, 0xa6, 0x8b, 0x80, 0x42, 0x4d, 0x14, 0x40, 0x46, 0xd3, 0xcc,
+  0xec, 0x60, 0x10, 0x82, 0xcd, 0xeb, 0xac, 0xdd, 0xc9, 0x3c, 0xa3, 0x6b, 0x01, 0x72, 0xc1, 0x50,
+  0x83, 0x70, 0xcd, 0x95, 0x9d, 0xb0, 0x1c, 0x0a, 0x11, 0x2e, 0xba, 0x02, 0x14, 0x2d, 0x3a, 0x08,
+  0xed, 0x04, 0x8e, 0xa3, 0xcd, 0x00, 0x8a, 0xb7, 0xc3, 0xeb, 0x72, 0x44, 0x01, 0x31, 0x22, 0x1a,
+  0x5c, 0xb4, 0x22, 0xd9, 0xe2, 0x2a, 0x46, 0x24, 0xb0, 0x40, 0x45, 0xeb, 0xae, 0x60, 0x91, 0x70,
+  0x5b, 0xd9, 0xaa, 0x68, 0x09, 0xd3, 0x00, 0x03, 0x71, 0x15, 0xdf, 0x7e, 0x2f, 0x0b, 0x50, 0xd3,
+  0x08, 0x63, 0x8f, 0x40, 0x8f, 0xf1, 0x86, 0x3a, 0x9f, 0x31, 0x0a, 0xf7, 0x43, 0xc4, 0x03, 0x1a,
+  0xd0, 0xf6, 0x80, 0x07, 0x02, 0x59, 0x3d, 0x98, 0x2b, 0xa2, 0x65, 0x06, 0x5c, 0x34, 0x05, 0x89,
+  0xe0, 0xfb, 0xb2, 0x08, 0x21, 0xee, 0xc7, 0x16, 0x93, 0xbe, 0x75, 0x3b, 0x72, 0xeb, 0xe3, 0x7b,
+  0x2c, 0x8a, 0xdd, 0xd2, 0x37, 0x67, 0x40, 0xf7, 0x3a, 0x81, 0xe0, 0xd8, 0x50, 0x3f, 0x70, 0x13,
+  0x48, 0xe7, 0x19, 0x02, 0x69, 0x95, 0x7b, 0xab, 0xd1, 0x2a, 0x02, 0x69, 0x95, 0x15, 0x7c, 0xb0,
+  0x3e, 0xd2, 0xfb, 0x75, 0x42, 0x8a, 0x3e, 0x40, 0x0b, 0xea, 0x7f, 0x20, 0xc7, 0x92, 0xa5, 0xbe,
+  0x82, 0x0a, 0x1d, 0x1d, 0xd0, 0x41, 0xc8, 0xeb, 0xb0, 0x42, 0xf3, 0x7d, 0x09, 0x75, 0xaa, 0x5c,
+  0xcd, 0x2f, 0x11, 0x4a, 0xa6, 0xc7, 0x2a, 0x1b, 0x5b, 0x3e, 0xaa, 0xba, 0xb8, 0xce, 0x75, 0x36,
+  0x42, 0x60, 0x80, 0x57, 0x2e, 0xd5, 0xcc, 0x81, 0xe3, 0xb8, 0x7a, 0x1b, 0x16, 0xa1, 0x9a, 0x8e,
+  0xd7, 0x5d, 0x8d, 0x45, 0x94, 0x30, 0x13, 0xf7, 0x28, 0x1e, 0x84, 0xcb, 0x61, 0x14, 0x8e, 0xd6,
+  0xfb, 0xf1, 0x18, 0x31, 0xfc, 0x64, 0x1b, 0x21, 0x78, 0x10, 0x11, 0xf0, 0x73, 0x6b, 0x4c, 0xc0,
+  0xc3, 0x10, 0xa1, 0xe9, 0xec, 0xaa, 0xf9, 0x18, 0xad, 0x32, 0xe0, 0xb2, 0x81, 0xee, 0xfd, 0x9e,
+  0xbc, 0x0b, 0xcb, 0xf5, 0x40, 0x7f, 0xbe, 0xbe, 0xb3, 0x67, 0xca, 0xaa, 0xba, 0x88, 0x7d, 0xcb,
+  0x41, 0x48, 0x36, 0xe8, 0x71, 0x06, 0x1b, 0x15, 0x1d, 0x0a, 0x4b, 0x76, 0xbc, 0x21, 0x54, 0x70,
+  0x32, 0x97, 0xab, 0xdb, 0x83, 0x44, 0xc1, 0xa0, 0xc5, 0xb0, 0xfa, 0x9d, 0x39, 0xa7, 0xa5, 0x1c,
+  0x08, 0x8e, 0x2b, 0x52, 0xcc, 0x4f, 0x25, 0x6c, 0x79, 0xb1, 0xc0, 0x2a, 0xe8, 0x9c, 0x9a, 0x9c,
+  0x67, 0xba, 0x10, 0x4f, 0x9f, 0x82, 0xf7, 0x8e, 0xc1, 0xa0, 0x8b, 0x02, 0x9a, 0x74, 0xd8, 0x53,
+  0x8a, 0x1f, 0x4e, 0xc5, 0x38, 0x58, 0xa8, 0xf0, 0xf4, 0xb0, 0xa6, 0xc6, 0xc7, 0x0d, 0x49, 0x15,
+  0x09, 0x00, 0x11, 0x34, 0x10, 0x67, 0x71, 0xac, 0x58, 0xb9, 0x0a, 0x84, 0x19, 0x9a, 0x5a, 0x83,
+  0xbe, 0x08, 0x62, 0xd5, 0xfd, 0x0d, 0x13, 0x3b, 0x16, 0x10, 0x0f, 0xa6, 0x92, 0x48, 0x65, 0xf8,
+  0x75, 0x5d, 0x5a, 0x68, 0x65, 0x87, 0x2b, 0x10, 0x86, 0x7f, 0x76, 0xa5, 0xf6, 0xe5, 0x01, 0x8e,
+  0x05, 0x69, 0xbc, 0x6b, 0x93, 0xe8, 0x40, 0x31, 0x0b, 0xc2, 0xc8, 0xb1, 0x13, 0xa9, 0x62, 0x94,
+  0x27, 0x43, 0x1c, 0x57, 0x64, 0x38, 0x7b, 0x8c, 0x8b, 0xcc, 0x40, 0xf5, 0x5c, 0x50, 0x8e, 0x9c,
+  0x72, 0xd0, 0x95, 0xa0, 0xf6, 0xbe, 0xa1, 0x36, 0x3d, 0x5a, 0x7a, 0x1c, 0xd7, 0xa0, 0x47, 0xc5,
+  0x65, 0xbc, 0x9f, 0x57, 0x78, 0xe2, 0xff, 0x0b, 0xf3, 0xcb, 0xfc, 0x00, 0x82, 0xe7, 0x06, 0xf5,
+  0xbd, 0xf6, 0x63, 0xcd, 0x5f, 0xab, 0xae, 0x28, 0x11, 0x29, 0x4c, 0x1c, 0x56, 0x41, 0x16, 0x7b,
+  0xc6, 0x37, 0x6d, 0xae, 0x7c, 0x83, 0x05, 0xdc, 0xea, 0xcf, 0xb6, 0x06, 0x22, 0xe0, 0x4c, 0x10,
+  0x62, 0xb7, 0x70, 0xe8, 0x21, 0x3f, 0x54, 0xc5, 0xca, 0xd6, 0xdc, 0xc9, 0xc5, 0x3b, 0x16, 0x13,
+  0x00, 0x8f, 0x2e, 0xd9, 0x93, 0xf7, 0x8c, 0x00, 0xae, 0x93, 0x65, 0x59, 0xc2, 0x28, 0xbe, 0x9f,
+  0xc3, 0x4a, 0xa9, 0xd1, 0x89, 0xf9, 0x08, 0xd8, 0x7b, 0x24, 0xc7, 0xbf, 0x2f, 0x38, 0xa5, 0x1e,
+  0x76, 0xc2, 0x7a, 0xd0, 0x09, 0x8b, 0x51, 0x27, 0xac, 0x43, 0x27, 0x2c, 0xfa, 0xae, 0x57, 0x1f,
+  0xed, 0x7a, 0xc5, 0x70, 0x4e, 0xd4, 0xa3, 0x39, 0x31, 0xea, 0x89, 0x35, 0x20, 0x0f, 0x7a, 0x62,
+  0x04, 0x1c, 0xed, 0x89, 0x41, 0xf4, 0x87, 0x47, 0xb5, 0x22, 0xde, 0x87, 0xeb, 0xc2, 0x91, 0x5e,
+  0xd6, 0xb2, 0x32, 0x8a, 0x26, 0xf2, 0x1c, 0x13, 0xf2, 0xc8, 0xe4, 0x47, 0x28, 0xd2, 0x3d, 0xbb,
+  0x78, 0x26, 0xce, 0xc8, 0x66, 0xb6, 0x01, 0xd2, 0x56, 0xdf, 0x3f, 0x42, 0x78, 0x41, 0xfd, 0x3a,
+  0x8c, 0x03, 0x6a, 0xd5, 0x6d, 0x76, 0x38, 0x75, 0x7f, 0xc9, 0xad, 0x60, 0xb1, 0x0f, 0x0b, 0x30,
+  0x04, 0xfb, 0x0a, 0xf8, 0xb0, 0x7d, 0xdc, 0x51, 0x1e, 0xb3, 0x2a, 0xad, 0x57, 0x4a, 0xdb, 0x34,
+  0xb9, 0x02, 0x42, 0x02, 0xb2, 0x8b, 0xc4, 0x1b, 0x79, 0xfb, 0x44, 0x9c, 0x61, 0x42, 0x16, 0xf7,
+  0x30, 0xcd, 0x0a, 0xee, 0xc0, 0xa0, 0x2b, 0xbe, 0x2b, 0x61, 0xb2, 0x85, 0x43, 0x19, 0xa5, 0xf0,
+  0x46, 0x39, 0xdf, 0xd2, 0xc7, 0x2f, 0x59, 0x14, 0xd8, 0x83, 0x8a, 0xd2, 0xfa, 0x51, 0x2f, 0xa3,
+  0x7b, 0x8b, 0x43, 0xa5, 0xa9, 0x88, 0x1f, 0x6b, 0xca, 0xb8, 0x86, 0xd8, 0x7a, 0xee, 0x73, 0x6e,
+  0x74, 0xa7, 0xb1, 0x6e, 0xc2, 0x35, 0xc0, 0xe3, 0xc9, 0x26, 0x8f, 0xbb, 0xd7, 0x7c, 0x74, 0x95,
+  0xb0, 0x2e, 0xad, 0xc5, 0xef, 0x77, 0x5b, 0xf2, 0x24, 0x34, 0x15, 0x5d, 0xbf, 0x34, 0xeb, 0x35,
+  0x84, 0xf4, 0xe1, 0xcd, 0x9e, 0xbf, 0x0c, 0xda, 0xc8, 0xb2, 0xf6, 0x17, 0x41, 0xcf, 0xf8, 0x7e,
+  0xf0, 0x29, 0x5d, 0x0c, 0x4e, 0xc2, 0xc5, 0x20, 0x23, 0xf5, 0xb7, 0x83, 0x7f, 0xeb, 0xef, 0x06,
+  0x8a, 0x7f, 0x06, 0x87, 0x77, 0xf4, 0xfe, 0xec, 0x24, 0x89, 0x23, 0xe2, 0xf7, 0xaf, 0xd1, 0x47,
+  0x24, 0xa4, 0x7f, 0xfe, 0xb1, 0x6d, 0x6a, 0xb0, 0x04, 0xa4, 0x79, 0x2f, 0xe9, 0x88, 0x0b, 0x5d,
+  0x48, 0xbc, 0x74, 0xdf, 0x52, 0xf0, 0x4e, 0x3f, 0xcf, 0xa0, 0x77, 0xc7, 0x92, 0x45, 0x1c, 0x20,
+  0x8c, 0xe1, 0x8d, 0x4f, 0x8e, 0x3d, 0xfd, 0xc1, 0xb1, 0xa7, 0x7e, 0xeb, 0x7c, 0x92, 0xd0, 0x37,
+  0xcd, 0xa0, 0xc3, 0xb9, 0x88, 0x6e, 0xcd, 0x42, 0x67, 0x75, 0x78, 0xc5, 0x75, 0xf4, 0x52, 0x06,
+  0xef, 0x36, 0x78, 0x5f, 0x1c, 0xce, 0x87, 0x9f, 0x63, 0x92, 0x90, 0xb7, 0x71, 0xe6, 0xe8, 0x2a,
+  0xf0, 0x86, 0xf5, 0xcc, 0x0f, 0x43, 0x78, 0xfd, 0xf6, 0xe5, 0xab, 0xb5, 0x19, 0x67, 0x25, 0x6f,
+  0x5f, 0xe6, 0xb6, 0x1d, 0xf2, 0xe9, 0xef, 0xe1, 0x66, 0x78, 0xb2, 0x73, 0xf7, 0x91, 0x97, 0x33,
+  0x3b, 0x3a, 0x4e, 0x05, 0xe4, 0x39, 0xa1, 0xb6, 0x4d, 0x59, 0x5b, 0x83, 0x6e, 0x8c, 0xb0, 0x71,
+  0x94, 0x83, 0x9c, 0x79, 0xc6, 0x28, 0x47, 0x5a, 0xe1, 0xd6, 0xb5, 0xc2, 0x4c, 0x31, 0x9e, 0xa4,
+  0x72, 0x38, 0x8a, 0x55, 0xee, 0xa3, 0x6f, 0x9a, 0x54, 0x25, 0x33, 0x18, 0x93, 0xbf, 0x44, 0xca,
+  0xfd, 0xf5, 0x24, 0x8b, 0xcd, 0x81, 0xd1, 0x5e, 0x9f, 0xdc, 0x1c, 0x53, 0xba, 0x75, 0xab, 0x2f,
+  0x8e, 0xad, 0x3a, 0x9d, 0xa4, 0xa8, 0x48, 0xc3, 0xdf, 0x7a, 0xda, 0xeb, 0x97, 0x37, 0xc1, 0x2d,
+  0x9e, 0x06, 0x87, 0x11, 0x08, 0x3f, 0x12, 0x0d, 0x10, 0x26, 0x78, 0x33, 0x49, 0xba, 0x90, 0x2d,
+  0x4e, 0xae, 0x67, 0xdb, 0xb2, 0x2a, 0xd2, 0xaa, 0xec, 0xab, 0x16, 0xa4, 0x01, 0x4e, 0x44, 0x51,
+  0x9a, 0x0b, 0x5a, 0xe2, 0x19, 0x05, 0x39, 0xe6, 0x58, 0x02, 0xe9, 0x84, 0x6e, 0x94, 0x6c, 0x39,
+  0x69, 0x45, 0x2d, 0x17, 0xd0, 0xe3, 0xef, 0x55, 0x29, 0xae, 0x65, 0x4d, 0x8b, 0x7a, 0x0d, 0x34,
+  0x5e, 0x61, 0x6c, 0xbb, 0x26, 0x6a, 0x4a, 0xbb, 0x33, 0x60, 0x9d, 0xe2, 0xa7, 0xee, 0x77, 0x84,
+  0x99, 0x26, 0xcb, 0xe8, 0x82, 0xf7, 0x18, 0x09, 0xd4, 0xe9, 0x4c, 0x1c, 0x59, 0xc1, 0x22, 0x4c,
+  0xe0, 0x7e, 0x86, 0x70, 0xac, 0xb8, 0x35, 0xe2, 0xe7, 0x4b, 0xc0, 0x88, 0xfb, 0xa3, 0x5e, 0x1e,
+  0x10, 0xee, 0xe5, 0xf0, 0x23, 0x7e, 0x6e, 0x53, 0x48, 0x9f, 0x92, 0xbf, 0x61, 0xf3, 0x93, 0xc7,
+  0x1e, 0x1d, 0xda, 0xf1, 0xfc, 0xfc, 0x59, 0x9c, 0x2c, 0x86, 0x1f, 0xfc, 0x39, 0xff, 0x87, 0x58,
+  0x04, 0xef, 0xfd, 0x24, 0x76, 0xca, 0x6e, 0x1b, 0xfc, 0x3d, 0xc2, 0xe5, 0xbb, 0xe5, 0x15, 0x40,
+  0x56, 0x4d, 0x01, 0x7d, 0x0e, 0x2a, 0xe1, 0xb7, 0xf7, 0x6f, 0x96, 0xd0, 0xfa, 0xe7, 0xdb, 0x4b,
+  0xe2, 0x16, 0xd8, 0x3f, 0x1c, 0xaf, 0xe9, 0xe1, 0x37, 0x00, 0xcd, 0x2d, 0xf8, 0x82, 0xff, 0x29,
+  0x40, 0xd4, 0xbb, 0x08, 0x2c, 0xc3, 0xe8, 0xa1, 0xe9, 0x01, 0x01, 0xfc, 0x1a, 0x24, 0x5c, 0xc4,
+  0xf6, 0x01, 0x65, 0x31, 0x9e, 0xfa, 0xeb, 0x88, 0xa8, 0x84, 0xf9, 0x23, 0x60, 0xcf, 0x3a, 0x6c,
+  0x8f, 0x06, 0x8a, 0x88, 0xfa, 0xe7, 0x2f, 0x15, 0xc3, 0x88, 0xd2, 0x8f, 0x6e, 0xe3, 0x29, 0x9a,
+  0xfb, 0x50, 0xa1, 0xa3, 0x36, 0x6c, 0xe8, 0xaa, 0x5f, 0xaa, 0x99, 0x5f, 0x70, 0x67, 0xd7, 0x26,
+  0x81, 0x4d, 0x3f, 0xa1, 0x65, 0x01, 0x1d, 0x0c, 0x00, 0x88, 0xa0, 0xff, 0x8a, 0xdb, 0x21, 0xd8,
+  0xc8, 0xd7, 0xd0, 0xde, 0x9c, 0x0f, 0xc7, 0x6a, 0xae, 0xf8, 0x02, 0x7d, 0xee, 0x0a, 0xc4, 0x43,
+  0x10, 0x14, 0xaa, 0xd6, 0xd7, 0xbb, 0x40, 0x36, 0x30, 0x5e, 0xbb, 0xf5, 0x42, 0xc1, 0xc6, 0x04,
+  0x7f, 0xe1, 0x80, 0xe3, 0x38, 0xd0, 0xc1, 0x0a, 0x82, 0xda, 0xca, 0x81, 0x94, 0x9b, 0xb4, 0xa6,
+  0x6e, 0x5f, 0x16, 0xd6, 0x30, 0xf5, 0x34, 0xf8, 0x3d, 0x2b, 0x72, 0x5a, 0x2f, 0x48, 0x5e, 0x81,
+  0x4b, 0x3d, 0x2a, 0x8a, 0x18, 0xa9, 0x85, 0x76, 0x24, 0xec, 0x0a, 0xae, 0xab, 0x85, 0x4a, 0xfb,
+  0x4d, 0x24, 0x68, 0x47, 0x20, 0xf1, 0x80, 0x57, 0xca, 0x00, 0x18, 0x35, 0x01, 0x0f, 0x28, 0x21,
+  0x5d, 0x3c, 0x5e, 0x87, 0x3c, 0x8b, 0xc1, 0x90, 0x61, 0x37, 0x81, 0xb5, 0x1d, 0xd7, 0x6e, 0x60,
+  0xda, 0xfa, 0x1f, 0xd5, 0x82, 0x4d, 0x1b, 0xfa, 0x23, 0x00, 0x00,
+};
+constexpr WebAsset WEB_APP_JS = {"application/javascript", "\"9c09d52e\"", WEB_APP_JS_GZ, sizeof(WEB_APP_JS_GZ)};
+
+// Total: 30684 bytes of sources, 9824 bytes in flash
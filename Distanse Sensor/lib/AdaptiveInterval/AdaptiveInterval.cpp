@@ -0,0 +1,56 @@
+#include "AdaptiveInterval.h"
+#include <math.h>
+
+void AdaptiveInterval::setLimits(uint32_t floorMs, uint32_t ceilingMs) {
+  floorMs_ = floorMs;
+  ceilingMs_ = ceilingMs > floorMs ? ceilingMs : floorMs;
+  if (intervalMs_ < floorMs_) intervalMs_ = floorMs_;
+  if (intervalMs_ > ceilingMs_) intervalMs_ = ceilingMs_;
+  if (ceilingMs_ == floorMs_) reason_ = IntervalReason::Fixed;
+  else if (reason_ == IntervalReason::Fixed) reason_ = IntervalReason::Unsure;
+}
+
+bool AdaptiveInterval::update(uint8_t confidence, float rateCmPerMin, float scatterCm) {
+  if (ceilingMs_ <= floorMs_) return false;
+
+  // Interval over which the level moves ADAPT_STEP_CM (the ceiling if it hardly moves)
+  float speed = fabsf(rateCmPerMin);
+  float stepMs = speed > 0 ? ADAPT_STEP_CM / speed * 60000.0f : (float)ceilingMs_;
+  uint32_t moveMs = stepMs < (float)ceilingMs_ ? (uint32_t)stepMs : ceilingMs_;
+  if (moveMs < floorMs_) moveMs = floorMs_;
+
+  IntervalReason reason;
+  uint32_t next;
+  if (confidence < ADAPT_MIN_CONFIDENCE) {
+    reason = IntervalReason::Unsure;
+    next = floorMs_;
+  } else if (scatterCm > ADAPT_SCATTER_CM) {
+    reason = IntervalReason::Scattered;
+    next = floorMs_;
+  } else if (moveMs < intervalMs_ - intervalMs_ / 4) {   // some slack, or rate noise keeps nudging it
+    reason = IntervalReason::Moving;
+    next = moveMs;
+  } else {
+    // Back off geometrically (from at least 1 s), but not past a reading per ADAPT_STEP_CM
+    reason = IntervalReason::Steady;
+    uint32_t doubled = intervalMs_ < 500 ? 1000 : intervalMs_ * 2;
+    next = doubled < moveMs ? doubled : moveMs;
+    if (next < intervalMs_) next = intervalMs_;
+  }
+
+  reason_ = reason;
+  if (next == intervalMs_) return false;
+  intervalMs_ = next;
+  if (changes_[(uint8_t)reason] < UINT16_MAX) ++changes_[(uint8_t)reason];
+  return true;
+}
+
+const char* intervalReasonName(IntervalReason reason) {
+  switch (reason) {
+    case IntervalReason::Moving: return "moving";
+    case IntervalReason::Scattered: return "scattered";
+    case IntervalReason::Unsure: return "unsure";
+    case IntervalReason::Steady: return "steady";
+    default: return "fixed";
+  }
+}
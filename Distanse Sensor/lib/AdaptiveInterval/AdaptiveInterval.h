@@ -0,0 +1,63 @@
+#pragma once
+
+/*
+   Reading interval that follows the water level: short while it moves,
+   long while it stays put.
+
+   After each reading the level tracker's rate, scatter and confidence
+   decide the next interval, between a floor and a ceiling:
+
+     moving    the level would move well over ADAPT_STEP_CM in the
+               interval: shorten it so it moves about that much per
+               reading (a fill is caught within a reading or two)
+     scattered readings stray from the track by more than
+               ADAPT_SCATTER_CM on average (waves, a pump switching):
+               back to the floor
+     unsure    the track has not settled (after boot, misses, a restart):
+               back to the floor
+     steady    none of these: double the interval, up to the ceiling
+
+   With the ceiling at the floor the interval is fixed. The state is plain
+   data (battery mode keeps it in RTC memory).
+*/
+
+#include <stdint.h>
+
+constexpr float ADAPT_STEP_CM = 2.0f;        // level change worth a reading (4x the reading noise)
+constexpr float ADAPT_SCATTER_CM = 1.0f;     // mean |reading - track| that counts as unsettled
+constexpr uint8_t ADAPT_MIN_CONFIDENCE = 50; // % below which the track is not trusted
+
+enum class IntervalReason : uint8_t {
+  Fixed = 0,      // ceiling <= floor
+  Moving = 1,
+  Scattered = 2,
+  Unsure = 3,
+  Steady = 4
+};
+constexpr uint8_t INTERVAL_REASONS = 5;
+
+class AdaptiveInterval {
+public:
+  // Set the range; the interval is clamped into it (a new one starts at the floor)
+  void setLimits(uint32_t floorMs, uint32_t ceilingMs);
+
+  // Pick the interval after a reading. Returns true if it changed.
+  bool update(uint8_t confidence, float rateCmPerMin, float scatterCm);
+
+  uint32_t intervalMs() const { return intervalMs_; }
+  uint32_t floorMs() const { return floorMs_; }
+  uint32_t ceilingMs() const { return ceilingMs_; }
+  // Why the last reading left the interval where it is
+  IntervalReason reason() const { return reason_; }
+  // Interval changes made for each reason
+  uint16_t changes(IntervalReason r) const { return changes_[(uint8_t)r]; }
+
+private:
+  uint32_t floorMs_ = 0;
+  uint32_t ceilingMs_ = 0;
+  uint32_t intervalMs_ = 0;
+  uint16_t changes_[INTERVAL_REASONS] = {};
+  IntervalReason reason_ = IntervalReason::Fixed;
+};
+
+const char* intervalReasonName(IntervalReason reason);
@@ -0,0 +1,113 @@
+#include "Calibration.h"
+#include <math.h>
+
+namespace {
+
+constexpr double MIN_SPREAD_CM = 1.0;   // points closer together than this determine nothing
+
+float evaluate(const CalCoeffs& c, float d) {
+  return c.offset + d * (c.gain + d * c.quad);
+}
+
+// Solve the n x n system a x = b (n <= 3) by Gaussian elimination with partial pivoting
+bool solve(double a[3][3], double b[3], uint8_t n, double x[3]) {
+  for (uint8_t col = 0; col < n; ++col) {
+    uint8_t pivot = col;
+    for (uint8_t r = col + 1; r < n; ++r) {
+      if (fabs(a[r][col]) > fabs(a[pivot][col])) pivot = r;
+    }
+    if (fabs(a[pivot][col]) < 1e-9) return false;
+    for (uint8_t k = 0; k < n; ++k) {
+      double t = a[col][k];
+      a[col][k] = a[pivot][k];
+      a[pivot][k] = t;
+    }
+    double t = b[col];
+    b[col] = b[pivot];
+    b[pivot] = t;
+    for (uint8_t r = col + 1; r < n; ++r) {
+      double f = a[r][col] / a[col][col];
+      for (uint8_t k = col; k < n; ++k) a[r][k] -= f * a[col][k];
+      b[r] -= f * b[col];
+    }
+  }
+  for (int8_t r = n - 1; r >= 0; --r) {
+    double s = b[r];
+    for (uint8_t k = r + 1; k < n; ++k) s -= a[r][k] * x[k];
+    x[r] = s / a[r][r];
+  }
+  return true;
+}
+
+} // namespace
+
+bool fitCalibration(const CalPoint* points, uint8_t n, bool quadratic, CalCoeffs& out, float& rmsCm) {
+  uint8_t terms = quadratic ? 3 : 2;
+  if (n < terms || n > CAL_MAX_POINTS) return false;
+
+  // Centre and scale the distances so the normal equations stay well conditioned
+  double mean = 0;
+  for (uint8_t i = 0; i < n; ++i) mean += points[i].distanceCm;
+  mean /= n;
+  double spread = 0;
+  for (uint8_t i = 0; i < n; ++i) spread = fmax(spread, fabs(points[i].distanceCm - mean));
+  if (spread < MIN_SPREAD_CM) return false;
+
+  // Normal equations for height = a + b u + c u², u = (d - mean) / spread
+  double a[3][3] = {}, b[3] = {}, x[3] = {};
+  for (uint8_t i = 0; i < n; ++i) {
+    double u = (points[i].distanceCm - mean) / spread;
+    double powers[3] = {1, u, u * u};
+    for (uint8_t r = 0; r < terms; ++r) {
+      for (uint8_t k = 0; k < terms; ++k) a[r][k] += powers[r] * powers[k];
+      b[r] += powers[r] * points[i].heightCm;
+    }
+  }
+  if (!solve(a, b, terms, x)) return false;
+
+  // Back to powers of d
+  double c2 = x[2] / (spread * spread);
+  CalCoeffs c;
+  c.quad = (float)c2;
+  c.gain = (float)(x[1] / spread - 2 * c2 * mean);
+  c.offset = (float)(x[0] - x[1] * mean / spread + c2 * mean * mean);
+
+  // Must fit the fixed-point form and fall with the distance over the whole range
+  if (fabsf(c.offset) > 32000 || fabsf(c.gain) > 32000 || fabsf(c.quad) > 1) return false;
+  if (c.gain >= 0 || c.gain + 2 * c.quad * CAL_MAX_DISTANCE_CM >= 0) return false;
+
+  double sq = 0;
+  for (uint8_t i = 0; i < n; ++i) {
+    double r = evaluate(c, points[i].distanceCm) - points[i].heightCm;
+    sq += r * r;
+  }
+  rmsCm = (float)sqrt(sq / n);
+  out = c;
+  return true;
+}
+
+void Calibration::set(const CalCoeffs& c) {
+  coeffs_ = c;
+  offsetQ16_ = (int32_t)lroundf(c.offset * 65536.0f);
+  gainQ16_ = (int32_t)lroundf(c.gain * 65536.0f);
+  quadQ30_ = (int32_t)llround((double)c.quad * (1 << 30));
+}
+
+int32_t Calibration::heightQ16(uint32_t distanceQ8) const {
+  // Horner: (quad d + gain) d + offset
+  int64_t slopeQ16 = gainQ16_ + (((int64_t)quadQ30_ * distanceQ8) >> 22);
+  int64_t h = offsetQ16_ + ((slopeQ16 * distanceQ8) >> 8);
+  return h > INT32_MAX ? INT32_MAX : h < INT32_MIN ? INT32_MIN : (int32_t)h;
+}
+
+float Calibration::distanceAt(float heightCm) const {
+  float lo = 0, hi = CAL_MAX_DISTANCE_CM;
+  if (heightCm >= evaluate(coeffs_, lo)) return lo;
+  if (heightCm <= evaluate(coeffs_, hi)) return hi;
+  for (uint8_t i = 0; i < 32; ++i) {
+    float mid = (lo + hi) / 2;
+    if (evaluate(coeffs_, mid) > heightCm) lo = mid;
+    else hi = mid;
+  }
+  return (lo + hi) / 2;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+/*
+   Distance → water height calibration.
+
+   The water height above the tank bottom is a polynomial of the measured
+   distance d:
+
+     height = offset + gain * d + quad * d²
+
+   Uncalibrated this is offset = barrel height + mount height, gain = -1,
+   quad = 0 (the sensor looks straight down from the mount). Calibrating
+   captures the measured distance at a few levels the user knows (a dip
+   stick, a sight glass, "just emptied"), and fitCalibration() solves for
+   the coefficients by least squares, so a sensor with a scale error (a
+   wrong speed of sound, a slanted mount) or a non-linear one reads true.
+
+   The coefficients are stored as floats; set() turns them into fixed
+   point once, and each reading is then two integer multiply-adds
+   (Horner's rule: distance Q8 cm, offset and gain Q16, quad Q30).
+*/
+
+#include <stdint.h>
+
+constexpr uint8_t CAL_MAX_POINTS = 8;
+constexpr float CAL_MAX_DISTANCE_CM = 600;   // sensor range: the fit must be monotonic up to here
+
+struct CalPoint {
+  float distanceCm;   // measured
+  float heightCm;     // true water height above the bottom
+};
+
+struct CalCoeffs {
+  float offset = 70;  // cm
+  float gain = -1;
+  float quad = 0;     // 1/cm
+};
+
+// Least-squares fit of the points (quadratic: with the d² term). False if the
+// points do not determine it (too few, or all at about the same distance), or
+// the result does not fall steadily with the distance up to CAL_MAX_DISTANCE_CM.
+// rmsCm is the residual of the fit.
+bool fitCalibration(const CalPoint* points, uint8_t n, bool quadratic, CalCoeffs& out, float& rmsCm);
+
+class Calibration {
+public:
+  void set(const CalCoeffs& c);
+  const CalCoeffs& coeffs() const { return coeffs_; }
+
+  // Water height above the bottom, cm (fixed point)
+  float heightCm(float distanceCm) const { return (float)heightQ16(toQ8(distanceCm)) / 65536.0f; }
+  int32_t heightQ16(uint32_t distanceQ8) const;
+
+  // The distance at which the water stands at heightCm (config time: bisection)
+  float distanceAt(float heightCm) const;
+
+private:
+  static uint32_t toQ8(float cm) {
+    return cm <= 0 ? 0 : cm >= CAL_MAX_DISTANCE_CM ? (uint32_t)(CAL_MAX_DISTANCE_CM * 256) : (uint32_t)(cm * 256 + 0.5f);
+  }
+
+  CalCoeffs coeffs_;
+  int32_t offsetQ16_ = 70 << 16;
+  int32_t gainQ16_ = -(1 << 16);
+  int32_t quadQ30_ = 0;
+};
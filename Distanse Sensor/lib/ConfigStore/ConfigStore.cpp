@@ -0,0 +1,214 @@
+#include "ConfigStore.h"
+#include "Crc32.h"
+#include <string.h>
+
+namespace {
+
+constexpr uint32_t SECTOR_MAGIC = 0x31474643;   // "CFG1"
+constexpr uint8_t RECORD_MAGIC = 0xC5;
+constexpr size_t SECTOR_HEADER_SIZE = 12;
+constexpr size_t RECORD_HEADER_SIZE = 8;
+
+// Torn writes only clear bits and torn erases only set them, so one of
+// generation/inverted always disagrees after either
+struct SectorHeader {
+  uint32_t generation;
+  uint32_t inverted;    // ~generation
+  uint32_t magic;       // written last, so a torn header never matches
+
+  bool valid() const { return magic == SECTOR_MAGIC && inverted == ~generation; }
+};
+
+size_t align4(size_t n) { return (n + 3) & ~(size_t)3; }
+
+// Newer generation, with wrap-around
+bool newer(uint32_t a, uint32_t b) { return (int32_t)(a - b) > 0; }
+
+} // namespace
+
+/* ---------- flash log ---------------------------------------------------- */
+void ConfigStore::begin(Flash& flash) {
+  flash_ = &flash;
+  active_ = NO_SECTOR;
+  latest_ = NONE;
+  end_ = 0;
+  generation_ = 0;
+
+  for (uint8_t s = 0; s < 2; ++s) {
+    SectorHeader h;
+    if (!flash_->read(s, 0, &h, sizeof(h)) || !h.valid()) continue;
+    if (active_ == NO_SECTOR || newer(h.generation, generation_)) {
+      active_ = s;
+      generation_ = h.generation;
+    }
+  }
+  if (active_ != NO_SECTOR) scan(active_, latest_, end_);
+}
+
+// Walk the records of a sector: the newest valid one, and the end of the log.
+// A header that can't be skipped (torn length) ends the log at the sector end.
+void ConfigStore::scan(uint8_t sector, size_t& latest, size_t& end) const {
+  size_t sectorSize = flash_->sectorSize();
+  alignas(4) uint8_t payload[CONFIG_MAX_PAYLOAD];
+  latest = NONE;
+  end = SECTOR_HEADER_SIZE;
+  while (end + RECORD_HEADER_SIZE <= sectorSize) {
+    Record rec;
+    if (!flash_->read(sector, end, &rec, sizeof(rec))) break;
+    if (rec.length == 0xFFFF && rec.magic == 0xFF) return;   // erased: free space starts here
+    size_t size = RECORD_HEADER_SIZE + align4(rec.length);
+    if (rec.magic != RECORD_MAGIC || rec.length > CONFIG_MAX_PAYLOAD || end + size > sectorSize) break;
+    if (readRecord(sector, end, rec, payload)) latest = end;
+    end += size;
+  }
+  end = sectorSize;
+}
+
+bool ConfigStore::readRecord(uint8_t sector, size_t offset, Record& rec, uint8_t* payload) const {
+  if (!flash_->read(sector, offset, &rec, sizeof(rec)) || rec.magic != RECORD_MAGIC ||
+      rec.length > CONFIG_MAX_PAYLOAD) {
+    return false;
+  }
+  if (!flash_->read(sector, offset + RECORD_HEADER_SIZE, payload, align4(rec.length))) return false;
+  return rec.crc == crc32(payload, rec.length, crc32(&rec, 4));
+}
+
+bool ConfigStore::load(uint8_t* payload, size_t& len, uint8_t& schema) const {
+  if (latest_ == NONE) return false;
+  alignas(4) uint8_t buf[CONFIG_MAX_PAYLOAD];
+  Record rec;
+  if (!readRecord(active_, latest_, rec, buf)) return false;
+  memcpy(payload, buf, rec.length);
+  len = rec.length;
+  schema = rec.schema;
+  return true;
+}
+
+ConfigStore::SaveResult ConfigStore::save(const uint8_t* payload, size_t len, uint8_t schema) {
+  if (!flash_ || len > CONFIG_MAX_PAYLOAD) return SaveResult::Failed;
+
+  // Only write when something changed
+  alignas(4) uint8_t current[CONFIG_MAX_PAYLOAD];
+  size_t currentLen;
+  uint8_t currentSchema;
+  if (load(current, currentLen, currentSchema) && currentSchema == schema && currentLen == len &&
+      memcmp(current, payload, len) == 0) {
+    return SaveResult::Unchanged;
+  }
+
+  // Append to the active sector while there is verified-erased room
+  size_t size = RECORD_HEADER_SIZE + align4(len);
+  if (active_ != NO_SECTOR && end_ + size <= flash_->sectorSize() && isErased(active_, end_, size)) {
+    size_t offset = end_;
+    end_ += size;   // even if the write fails: that space is no longer erased
+    if (writeRecord(active_, offset, payload, len, schema)) {
+      latest_ = offset;
+      return SaveResult::Written;
+    }
+  }
+
+  // Sector full (or a bad write): start the other one with this record, then its header.
+  // With no active sector, sector 1 goes first: sector 0 may still hold the old EEPROM layout.
+  uint8_t target = active_ == NO_SECTOR ? 1 : active_ ^ 1;
+  if (!flash_->eraseSector(target)) return SaveResult::Failed;
+  if (!writeRecord(target, SECTOR_HEADER_SIZE, payload, len, schema)) return SaveResult::Failed;
+  SectorHeader h = {generation_ + 1, ~(generation_ + 1), SECTOR_MAGIC};
+  if (!writeVerified(target, 0, &h, sizeof(h))) return SaveResult::Failed;
+
+  active_ = target;
+  generation_ = h.generation;
+  latest_ = SECTOR_HEADER_SIZE;
+  end_ = SECTOR_HEADER_SIZE + size;
+  return SaveResult::Written;
+}
+
+bool ConfigStore::writeRecord(uint8_t sector, size_t offset, const uint8_t* payload, size_t len, uint8_t schema) {
+  alignas(4) uint8_t buf[RECORD_HEADER_SIZE + CONFIG_MAX_PAYLOAD];
+  Record rec = {(uint16_t)len, schema, RECORD_MAGIC, 0};
+  memset(buf, 0xFF, sizeof(buf));
+  memcpy(buf + RECORD_HEADER_SIZE, payload, len);
+  rec.crc = crc32(payload, len, crc32(&rec, 4));
+  memcpy(buf, &rec, sizeof(rec));
+  return writeVerified(sector, offset, buf, RECORD_HEADER_SIZE + align4(len));
+}
+
+// Write and read back: flash that was not fully erased (a torn write) silently
+// ANDs the new bits into the old ones
+bool ConfigStore::writeVerified(uint8_t sector, size_t offset, const void* data, size_t len) {
+  alignas(4) uint8_t check[RECORD_HEADER_SIZE + CONFIG_MAX_PAYLOAD];
+  if (len > sizeof(check) || !flash_->write(sector, offset, data, len)) return false;
+  return flash_->read(sector, offset, check, len) && memcmp(check, data, len) == 0;
+}
+
+bool ConfigStore::isErased(uint8_t sector, size_t offset, size_t len) const {
+  alignas(4) uint8_t buf[64];
+  while (len) {
+    size_t n = len < sizeof(buf) ? len : sizeof(buf);
+    if (!flash_->read(sector, offset, buf, n)) return false;
+    for (size_t i = 0; i < n; ++i) {
+      if (buf[i] != 0xFF) return false;
+    }
+    offset += n;
+    len -= n;
+  }
+  return true;
+}
+
+void ConfigStore::erase() {
+  flash_->eraseSector(0);
+  flash_->eraseSector(1);
+  begin(*flash_);
+}
+
+size_t ConfigStore::freeBytes() const {
+  return active_ == NO_SECTOR ? 0 : flash_->sectorSize() - end_;
+}
+
+/* ---------- tagged fields ------------------------------------------------ */
+void RecordWriter::put(uint8_t tag, const void* data, size_t len) {
+  if (len > 0xFF || len_ + 2 + len > size_) {
+    ok_ = false;
+    return;
+  }
+  buf_[len_++] = tag;
+  buf_[len_++] = (uint8_t)len;
+  memcpy(buf_ + len_, data, len);
+  len_ += len;
+}
+
+void RecordWriter::putU16(uint8_t tag, uint16_t v) {
+  uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+  put(tag, b, 2);
+}
+
+void RecordWriter::putU32(uint8_t tag, uint32_t v) {
+  uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+  put(tag, b, 4);
+}
+
+void RecordWriter::putFloat(uint8_t tag, float v) {
+  uint32_t bits;
+  memcpy(&bits, &v, 4);
+  putU32(tag, bits);
+}
+
+void RecordWriter::putString(uint8_t tag, const char* s) {
+  put(tag, s, strlen(s));
+}
+
+bool RecordReader::next(uint8_t& tag, const uint8_t*& value, uint8_t& len) {
+  if (pos_ + 2 > len_) return false;
+  tag = data_[pos_];
+  len = data_[pos_ + 1];
+  if (pos_ + 2 + len > len_) return false;
+  value = data_ + pos_ + 2;
+  pos_ += 2 + len;
+  return true;
+}
+
+float RecordReader::toFloat(const uint8_t* v) {
+  uint32_t bits = u32(v);
+  float f;
+  memcpy(&f, &bits, 4);
+  return f;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+   Log-structured, wear-leveled store for the configuration record.
+
+   Two flash sectors (Flash HAL) take turns. The active one starts with a
+   header {generation, ~generation, magic} and is followed by records:
+
+     off  size  field
+       0     2  payload length
+       2     1  schema version
+       3     1  RECORD_MAGIC
+       4     4  CRC-32 of bytes 0..3 and the payload
+       8     n  payload, padded to 4 bytes with 0xFF
+
+   A save appends a record to the erased space of the active sector, so a
+   sector is erased once per ~45 saves instead of on every save. When the
+   sector is full the new record goes into the other (freshly erased)
+   sector, and that sector's header is written last. Until then the old
+   sector stays active, so a power loss at any point leaves either the old
+   or the new record readable. Torn records fail their CRC and are skipped.
+
+   The payload is opaque here; RecordWriter/RecordReader give it tagged
+   fields (tag, length, little-endian value), so fields can be added later
+   without breaking older records.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+
+constexpr size_t CONFIG_MAX_PAYLOAD = 320;
+
+class ConfigStore {
+public:
+  enum class SaveResult : uint8_t { Written, Unchanged, Failed };
+
+  // Scan both sectors for the active one and its newest valid record
+  void begin(Flash& flash);
+
+  // Newest valid record; false if there is none (e.g. erased or never saved)
+  bool load(uint8_t* payload, size_t& len, uint8_t& schema) const;
+
+  // Append a record unless it equals the newest one
+  SaveResult save(const uint8_t* payload, size_t len, uint8_t schema);
+
+  // Erase both sectors
+  void erase();
+
+  bool hasRecord() const { return latest_ != NONE; }
+  uint32_t generation() const { return generation_; }   // sector switches so far
+  size_t freeBytes() const;
+
+private:
+  static constexpr uint8_t NO_SECTOR = 0xFF;
+  static constexpr size_t NONE = (size_t)-1;
+
+  struct Record {
+    uint16_t length;
+    uint8_t schema;
+    uint8_t magic;
+    uint32_t crc;
+  };
+
+  void scan(uint8_t sector, size_t& latest, size_t& end) const;
+  bool readRecord(uint8_t sector, size_t offset, Record& rec, uint8_t* payload) const;
+  bool isErased(uint8_t sector, size_t offset, size_t len) const;
+  bool writeVerified(uint8_t sector, size_t offset, const void* data, size_t len);
+  bool writeRecord(uint8_t sector, size_t offset, const uint8_t* payload, size_t len, uint8_t schema);
+
+  Flash* flash_ = nullptr;
+  uint8_t active_ = NO_SECTOR;
+  uint32_t generation_ = 0;
+  size_t latest_ = NONE;    // offset of the newest valid record in the active sector
+  size_t end_ = 0;          // where the next record goes
+};
+
+// Builds a payload of tagged fields
+class RecordWriter {
+public:
+  RecordWriter(uint8_t* buf, size_t size) : buf_(buf), size_(size) {}
+
+  void put(uint8_t tag, const void* data, size_t len);
+  void putU8(uint8_t tag, uint8_t v) { put(tag, &v, 1); }
+  void putU16(uint8_t tag, uint16_t v);
+  void putU32(uint8_t tag, uint32_t v);
+  void putFloat(uint8_t tag, float v);
+  void putString(uint8_t tag, const char* s);
+
+  size_t length() const { return len_; }
+  bool ok() const { return ok_; }   // false if a field did not fit
+
+private:
+  uint8_t* buf_;
+  size_t size_;
+  size_t len_ = 0;
+  bool ok_ = true;
+};
+
+// Walks the tagged fields of a payload
+class RecordReader {
+public:
+  RecordReader(const uint8_t* data, size_t len) : data_(data), len_(len) {}
+
+  // Next field; false at the end or on a truncated field
+  bool next(uint8_t& tag, const uint8_t*& value, uint8_t& len);
+
+  static uint16_t u16(const uint8_t* v) { return v[0] | (uint16_t)v[1] << 8; }
+  static uint32_t u32(const uint8_t* v) { return v[0] | (uint32_t)v[1] << 8 | (uint32_t)v[2] << 16 | (uint32_t)v[3] << 24; }
+  static float toFloat(const uint8_t* v);
+
+private:
+  const uint8_t* data_;
+  size_t len_;
+  size_t pos_ = 0;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+/*
+   CRC-32 (IEEE 802.3, as zlib and Python's binascii.crc32).
+
+   Nibble-table implementation: 64 bytes of table instead of 1 KB, fast
+   enough for the few hundred bytes of state and config it checks.
+   Pass the previous result as `crc` to continue over several buffers.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc = 0);
@@ -0,0 +1,67 @@
+#include "EchoCapture.h"
+
+void EchoCapture::begin(uint32_t cpuMhz) {
+  cyclesPerUs_ = cpuMhz ? cpuMhz : 80;
+  pending_ = false;
+  armTicket_.store(0, std::memory_order_release);
+}
+
+void EchoCapture::arm(uint32_t nowCycles, const RangeGate& gate) {
+  currentTicket_ = nextTicket_++;
+  if (nextTicket_ == 0) nextTicket_ = 1; // 0 is reserved for "disarmed"
+
+  armCycles_ = nowCycles;
+  timeoutCycles_ = gate.timeoutUs * cyclesPerUs_;
+  nearUs_ = gate.nearUs;
+  farUs_ = gate.farUs;
+  pending_ = true;
+  armTicket_.store(currentTicket_, std::memory_order_release);
+}
+
+void IRAM_ATTR EchoCapture::onEdge(bool level, uint32_t cycles) {
+  uint32_t ticket = armTicket_.load(std::memory_order_acquire);
+  if (ticket == 0) return;
+
+  if (level) {
+    // Rising edge: start of the echo pulse
+    riseCycles_ = cycles;
+    riseTicket_ = ticket;
+    return;
+  }
+
+  // Falling edge: only valid if the rise belonged to the same ping,
+  // otherwise it is the tail of an echo that started before arm()
+  if (riseTicket_ != ticket) return;
+  riseTicket_ = 0;
+
+  // Unsigned subtraction handles cycle counter wrap-around
+  slot_.durationUs = (cycles - riseCycles_) / cyclesPerUs_;
+  slot_.ticket = ticket;
+  doneTicket_.store(ticket, std::memory_order_release);
+}
+
+EchoCapture::Status EchoCapture::poll(uint32_t nowCycles, EchoSample& out) {
+  if (!pending_) return Status::Idle;
+
+  if (doneTicket_.load(std::memory_order_acquire) == currentTicket_) {
+    out = slot_;
+    pending_ = false;
+    armTicket_.store(0, std::memory_order_release);
+    return inGate(out) ? Status::Ready : Status::Rejected;
+  }
+
+  if (nowCycles - armCycles_ < timeoutCycles_) return Status::Pending;
+
+  armTicket_.store(0, std::memory_order_release);
+  // The echo may have completed between the check above and the disarm
+  if (doneTicket_.load(std::memory_order_acquire) == currentTicket_) {
+    out = slot_;
+    pending_ = false;
+    return inGate(out) ? Status::Ready : Status::Rejected;
+  }
+
+  out.durationUs = 0;
+  out.ticket = currentTicket_;
+  pending_ = false;
+  return Status::Timeout;
+}
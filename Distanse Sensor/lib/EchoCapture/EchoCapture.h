@@ -0,0 +1,89 @@
+#pragma once
+
+/*
+   Interrupt-driven echo capture for the ultrasonic sensor.
+
+   Replaces pulseIn(): a CHANGE interrupt on ECHO_PIN timestamps the rising
+   and falling edge with the CPU cycle counter, and the finished pulse width
+   is handed to loop() through a single-slot, lock-free SPSC mailbox.
+   The ISR is the only producer, loop() is the only consumer.
+
+   Each ping has a range gate: pulse widths outside [nearUs, farUs] are
+   rejected as soon as the pulse ends, and the ping times out once the
+   gate closes, instead of always listening for the sensor's full range.
+*/
+
+#include <stdint.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+// One finished trigger/echo cycle
+struct EchoSample {
+  uint32_t durationUs = 0;  // echo pulse width, 0 on timeout
+  uint32_t ticket = 0;      // arm() ticket the sample belongs to
+};
+
+// Echo pulse widths a ping accepts, and when it gives up (counted from arm(),
+// so it includes the sensor's trigger-to-echo latency)
+struct RangeGate {
+  uint32_t nearUs = 0;         // shorter: blanking (ringing, closer than possible)
+  uint32_t farUs = 30000;      // longer: beyond the far cutoff
+  uint32_t timeoutUs = 30000;
+};
+
+class EchoCapture {
+public:
+  enum class Status : uint8_t {
+    Idle,     // nothing armed
+    Pending,  // waiting for the echo
+    Ready,    // sample delivered
+    Rejected, // echo outside the gate (sample has its width)
+    Timeout   // no complete echo before the gate closed
+  };
+
+  // cpuMhz converts cycle counter ticks to microseconds
+  void begin(uint32_t cpuMhz);
+
+  // Consumer side: call right after the trigger pulse
+  void arm(uint32_t nowCycles, const RangeGate& gate);
+
+  // Producer side: call from the ECHO pin CHANGE interrupt
+  void IRAM_ATTR onEdge(bool level, uint32_t cycles);
+
+  // Consumer side, never blocks. Ready/Rejected/Timeout fill `out` and disarm.
+  Status poll(uint32_t nowCycles, EchoSample& out);
+
+  bool busy() const { return pending_; }
+
+private:
+  bool inGate(const EchoSample& s) const { return s.durationUs >= nearUs_ && s.durationUs <= farUs_; }
+
+  uint32_t cyclesPerUs_ = 80;
+
+  // Consumer-owned
+  bool pending_ = false;
+  uint32_t nextTicket_ = 1;
+  uint32_t currentTicket_ = 0;
+  uint32_t armCycles_ = 0;
+  uint32_t timeoutCycles_ = 0;
+  uint32_t nearUs_ = 0;
+  uint32_t farUs_ = 0;
+
+  // Producer-owned
+  uint32_t riseCycles_ = 0;
+  uint32_t riseTicket_ = 0;
+
+  // Shared: armTicket_ is written by the consumer only (0 = disarmed),
+  // slot_/doneTicket_ by the producer only. slot_ is published by the
+  // release store to doneTicket_.
+  std::atomic<uint32_t> armTicket_{0};
+  std::atomic<uint32_t> doneTicket_{0};
+  EchoSample slot_;
+};
@@ -0,0 +1,59 @@
+#include "EchoQuality.h"
+#include <math.h>
+#include <string.h>
+
+void EchoQuality::beginBurst() {
+  memset(burst_, 0, sizeof(burst_));
+}
+
+EchoClass EchoQuality::classify(const EchoExpect& expect, uint32_t raw, float distanceCm, float heightCm) {
+  EchoClass c = EchoClass::Valid;
+  if (distanceCm < 0) {
+    c = EchoClass::Timeout;
+  } else {
+    if (raw == lastRaw_) {
+      if (run_ < 255) ++run_;
+    } else {
+      lastRaw_ = raw;
+      run_ = 1;
+    }
+    if (distanceCm < expect.nearCm) c = EchoClass::UnderRange;
+    else if (distanceCm > expect.farCm) c = EchoClass::OverRange;
+    else if (run_ >= ECHO_STUCK_PINGS) c = EchoClass::Stuck;
+    else if (expect.tracked && fabsf(heightCm - expect.heightCm) > expect.toleranceCm) c = EchoClass::Jump;
+  }
+  if (burst_[(uint8_t)c] < 255) ++burst_[(uint8_t)c];
+  if (counts_[(uint8_t)c] < UINT16_MAX) ++counts_[(uint8_t)c];
+  return c;
+}
+
+uint8_t EchoQuality::endBurst(float spreadCm) {
+  uint16_t pings = 0;
+  uint8_t worst = 0;
+  for (uint8_t c = 0; c < ECHO_CLASSES; ++c) {
+    pings += burst_[c];
+    if (c && burst_[c] && (!worst || burst_[c] > burst_[worst])) worst = c;
+  }
+  label_ = (EchoClass)worst;
+  if (!pings) {
+    confidence_ = 0;
+    label_ = EchoClass::Timeout;
+    return 0;
+  }
+  float score = 100.0f * burst_[(uint8_t)EchoClass::Valid] / pings;
+  if (spreadCm > ECHO_SPREAD_CM) score *= ECHO_SPREAD_CM / spreadCm;
+  confidence_ = (uint8_t)(score + 0.5f);
+  return confidence_;
+}
+
+const char* echoClassName(EchoClass c) {
+  switch (c) {
+    case EchoClass::Valid: return "valid";
+    case EchoClass::Timeout: return "timeout";
+    case EchoClass::UnderRange: return "under-range";
+    case EchoClass::OverRange: return "over-range";
+    case EchoClass::Jump: return "jump";
+    case EchoClass::Stuck: return "stuck";
+  }
+  return "?";
+}
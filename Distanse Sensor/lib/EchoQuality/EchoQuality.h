@@ -0,0 +1,79 @@
+#pragma once
+
+/*
+   Sample quality: labels each ping of a burst and scores the reading.
+
+   A ping is
+     timeout      no echo at all (a dead or disconnected sensor, foam)
+     under-range  closer than the full level allows (ringing, a spider, condensation)
+     over-range   farther than the bottom (a side lobe off a pipe, the module's
+                  no-echo value in the serial modes; in trigger/echo mode the
+                  capture stops listening at the far end of the gate, so these
+                  mostly show up as timeouts)
+     stuck        the same raw value (echo µs or serial mm) for ECHO_STUCK_PINGS
+                  pings in a row: a live echo always wobbles by a count or two
+     jump         farther from the tracked level than the level could have moved
+                  (the tracker's own outlier band)
+     valid        otherwise
+
+   The confidence of a reading is the share of valid pings in its burst,
+   scaled down when the pings it was computed from scatter by more than
+   ECHO_SPREAD_CM. A reading without an echo scores 0, so a dead sensor no
+   longer looks like an empty tank with full confidence.
+
+   Each ping costs a few compares and no loops, the score one division.
+   The state is plain data (battery mode keeps it in RTC memory, so the
+   stuck-value run spans wakes).
+*/
+
+#include <stdint.h>
+
+constexpr uint8_t ECHO_STUCK_PINGS = 16;
+constexpr float ECHO_SPREAD_CM = 1.0f;     // middle-half spread of a burst that still scores full
+constexpr uint8_t ECHO_JUMP_CONFIDENCE = 50;   // tracker confidence from which jumps are labelled
+
+enum class EchoClass : uint8_t {
+  Valid = 0,
+  Timeout = 1,
+  UnderRange = 2,
+  OverRange = 3,
+  Jump = 4,
+  Stuck = 5
+};
+constexpr uint8_t ECHO_CLASSES = 6;
+
+// What the pings of a burst are checked against
+struct EchoExpect {
+  float nearCm = 0;          // the range gate
+  float farCm = 600;
+  bool tracked = false;      // a confident track to check jumps against
+  float heightCm = 0;        // its predicted water height ...
+  float toleranceCm = 0;     // ... and how far a reading may be from it
+};
+
+class EchoQuality {
+public:
+  void beginBurst();
+  // raw: echo width µs or serial mm; distanceCm < 0: no echo.
+  // heightCm is the ping's water height (only used with a track).
+  EchoClass classify(const EchoExpect& expect, uint32_t raw, float distanceCm, float heightCm);
+  // Score the burst; spreadCm is the spread of the pings the reading came from
+  uint8_t endBurst(float spreadCm);
+
+  // Last reading: 0..100 %, and its most frequent problem (Valid if none)
+  uint8_t confidence() const { return confidence_; }
+  EchoClass label() const { return label_; }
+  uint8_t burstCount(EchoClass c) const { return burst_[(uint8_t)c]; }
+  // Pings per class since boot (they stop at 65535)
+  uint16_t count(EchoClass c) const { return counts_[(uint8_t)c]; }
+
+private:
+  uint32_t lastRaw_ = 0;
+  uint16_t counts_[ECHO_CLASSES] = {};
+  uint8_t burst_[ECHO_CLASSES] = {};
+  uint8_t run_ = 0;          // pings in a row with lastRaw_
+  uint8_t confidence_ = 0;
+  EchoClass label_ = EchoClass::Timeout;
+};
+
+const char* echoClassName(EchoClass c);
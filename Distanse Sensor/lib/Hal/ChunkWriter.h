@@ -0,0 +1,77 @@
+#pragma once
+
+/*
+   Buffered writer for chunked HTTP responses.
+
+   Collects small pieces in a fixed stack buffer and hands them to the
+   server as chunks, so large responses never exist as one String.
+*/
+
+#include "Hal.h"
+#include <stdarg.h>
+#include <string.h>
+
+class ChunkWriter {
+public:
+  ChunkWriter(HttpServer& server, int code, const char* contentType) : server_(server) {
+    server_.beginChunked(code, contentType);
+  }
+  ~ChunkWriter() { end(); }
+
+  void write(const char* data, size_t len) {
+    while (len) {
+      size_t n = len < sizeof(buf_) - used_ ? len : sizeof(buf_) - used_;
+      memcpy(buf_ + used_, data, n);
+      used_ += n;
+      data += n;
+      len -= n;
+      if (used_ == sizeof(buf_)) flush();
+    }
+  }
+  void print(const char* s) { write(s, strlen(s)); }
+  void print(const String& s) { write(s.c_str(), s.length()); }
+
+  // printf-style formatting, straight into the buffer. Output that does not fit
+  // in what is left of it is formatted again after a flush, or on the heap when
+  // it is longer than the whole buffer.
+  void printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args, again;
+    va_start(args, fmt);
+    va_copy(again, args);
+    int n = vsnprintf(buf_ + used_, sizeof(buf_) - used_, fmt, args);
+    va_end(args);
+    if (n > 0 && (size_t)n < sizeof(buf_) - used_) {
+      used_ += (size_t)n;
+    } else if (n > 0) {
+      flush();
+      if ((size_t)n < sizeof(buf_)) {
+        vsnprintf(buf_, sizeof(buf_), fmt, again);
+        used_ = (size_t)n;
+      } else {
+        char* tmp = new char[n + 1];
+        vsnprintf(tmp, (size_t)n + 1, fmt, again);
+        server_.sendChunk(tmp, (size_t)n);
+        delete[] tmp;
+      }
+    }
+    va_end(again);
+  }
+
+  void flush() {
+    if (used_) server_.sendChunk(buf_, used_);
+    used_ = 0;
+  }
+
+  void end() {
+    if (ended_) return;
+    flush();
+    server_.endChunked();
+    ended_ = true;
+  }
+
+private:
+  HttpServer& server_;
+  char buf_[256];
+  size_t used_ = 0;
+  bool ended_ = false;
+};
@@ -0,0 +1,184 @@
+#pragma once
+
+/*
+   Hardware abstraction layer.
+
+   All hardware access of the firmware (GPIO, sensor UART, temperature probe, time, flash, RTC memory,
+   ESP-NOW radio, HTTP server, Wi-Fi, sleep, heap) goes through these interfaces, so the same logic
+   builds for the D1 mini (HalEsp8266.cpp) and for the host [env:native]
+   (lib/HalNative: mock implementations driven by a simulated clock).
+
+   The active implementation is the global `hal`; tests and simulations
+   may swap individual members before calling setup().
+*/
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+
+enum class PinMode : uint8_t { Input, Output, InputPullup };
+
+// Called from interrupt context with the new pin level and the CPU cycle counter
+using EdgeCallback = void (*)(bool level, uint32_t cycles);
+
+class Gpio {
+public:
+  virtual ~Gpio() = default;
+  virtual void mode(uint8_t pin, PinMode mode) = 0;
+  virtual void write(uint8_t pin, uint8_t value) = 0;
+  virtual int read(uint8_t pin) = 0;
+  virtual void attachEdgeInterrupt(uint8_t pin, EdgeCallback cb) = 0;
+};
+
+// Serial link to the distance sensor (JSN-SR04M serial modes). Reads never block
+// and return what the RX buffer holds.
+class Uart {
+public:
+  virtual ~Uart() = default;
+  virtual void begin(uint32_t baud, uint8_t rxPin, uint8_t txPin) = 0;
+  virtual size_t available() = 0;
+  virtual size_t read(uint8_t* data, size_t size) = 0;
+  virtual size_t write(const uint8_t* data, size_t size) = 0;
+};
+
+// 1-Wire temperature probe (a single DS18B20). A conversion runs on the probe for up
+// to 750 ms; read() returns the last finished one.
+class TempProbe {
+public:
+  virtual ~TempProbe() = default;
+  virtual bool begin(uint8_t pin) = 0;             // false if no probe answers
+  virtual bool startConversion() = 0;
+  virtual bool read(int16_t& sixteenths) = 0;      // °C in 1/16; false if missing or bad CRC
+};
+
+class Clock {
+public:
+  virtual ~Clock() = default;
+  virtual uint32_t millis() = 0;
+  virtual uint32_t micros() = 0;
+  virtual uint32_t cycleCount() = 0;
+  virtual uint32_t cpuMhz() = 0;
+  virtual void delayMs(uint32_t ms) = 0;
+  virtual void delayUs(uint32_t us) = 0;
+  virtual void yield() = 0;
+};
+
+// Raw NOR flash sectors for persistent data. Erasing sets a sector to 0xFF,
+// writes can only clear bits. Offsets and sizes are multiples of 4, data is
+// 4-byte aligned. Sector 0 is the one the EEPROM library used.
+class Flash {
+public:
+  virtual ~Flash() = default;
+  virtual size_t sectorSize() = 0;
+  virtual size_t sectorCount() = 0;
+  virtual bool read(size_t sector, size_t offset, void* data, size_t size) = 0;
+  virtual bool write(size_t sector, size_t offset, const void* data, size_t size) = 0;
+  virtual bool eraseSector(size_t sector) = 0;
+};
+
+// RTC user memory: survives deep sleep and resets, not power loss (then it holds garbage).
+// Offsets and sizes are bytes, multiples of 4; data must be 4-byte aligned.
+class Rtc {
+public:
+  virtual ~Rtc() = default;
+  virtual size_t size() = 0;
+  virtual bool read(size_t offset, void* data, size_t size) = 0;
+  virtual bool write(size_t offset, const void* data, size_t size) = 0;
+};
+
+// ESP-NOW transport
+using RadioSendCallback = void (*)(uint8_t* mac, uint8_t status);
+
+class Radio {
+public:
+  virtual ~Radio() = default;
+  // All calls return 0 on success, like the esp_now_* API
+  virtual int init() = 0;
+  virtual int setControllerRole() = 0;
+  virtual int registerSendCallback(RadioSendCallback cb) = 0;
+  virtual int addPeer(const uint8_t* mac, uint8_t channel) = 0;
+  virtual int send(const uint8_t* mac, const uint8_t* data, size_t len) = 0;
+};
+
+enum class HttpMethod : uint8_t { Any, Get, Post };
+using HttpHandler = void (*)();
+// Called before (done = false) and after (done = true) a registered handler runs, with
+// the path it was registered for
+using RequestHook = void (*)(const char* path, bool done);
+
+class HttpServer {
+public:
+  virtual ~HttpServer() = default;
+  virtual void on(const char* path, HttpHandler handler) = 0;
+  virtual void on(const char* path, HttpMethod method, HttpHandler handler) = 0;
+  virtual void begin() = 0;
+  virtual void handleClient() = 0;
+  virtual bool hasArg(const char* name) = 0;
+  virtual String arg(const char* name) = 0;
+  // Path of the request being (or last) handled
+  virtual String uri() = 0;
+  // Request headers must be registered before begin() to be readable via header()
+  virtual void collectHeaders(const char* names[], size_t count) = 0;
+  virtual String header(const char* name) = 0;
+  virtual void sendHeader(const char* name, const char* value) = 0;
+  virtual void send(int code, const char* contentType, const String& body) = 0;
+  // Body straight from flash (PROGMEM), e.g. the gzip'd assets of WebAssets.h
+  virtual void sendP(int code, const char* contentType, PGM_P data, size_t len) = 0;
+  // Chunked transfer for responses of unknown length (see ChunkWriter.h)
+  virtual void beginChunked(int code, const char* contentType) = 0;
+  virtual void sendChunk(const char* data, size_t len) = 0;
+  virtual void endChunked() = 0;
+  // One hook around every handler, registered before or after it; nullptr: none
+  virtual void setRequestHook(RequestHook hook) = 0;
+};
+
+// Soft-AP and MAC addresses
+class Wifi {
+public:
+  virtual ~Wifi() = default;
+  // Wi-Fi off → AP mode with the given IP/gateway/netmask, nothing persisted
+  virtual void beginAccessPoint(const uint8_t ip[4], const uint8_t gateway[4], const uint8_t subnet[4]) = 0;
+  virtual bool softAP(const char* ssid, const char* password, uint8_t channel, bool hidden, uint8_t maxConn) = 0;
+  virtual String softAPSSID() = 0;
+  virtual String softAPPSK() = 0;
+  virtual String softAPIP() = 0;
+  // Wi-Fi on without an AP or a connection, just for ESP-NOW on a fixed channel
+  virtual void beginStation(uint8_t channel) = 0;
+  virtual bool isApMode() = 0;
+  virtual int channel() = 0;
+  virtual void macAddress(uint8_t mac[6]) = 0;
+  virtual void stationMac(uint8_t mac[6]) = 0;
+  virtual void softApMac(uint8_t mac[6]) = 0;
+};
+
+class System {
+public:
+  virtual ~System() = default;
+  virtual void restart() = 0;
+  // Power down until the RTC wakes the chip (D0 wired to RST), which then boots
+  // from scratch. radioOnWake = false keeps the RF off during the next wake.
+  virtual void deepSleep(uint64_t us, bool radioOnWake) = 0;
+  // Free heap in bytes; cheap, the allocator keeps count
+  virtual uint32_t freeHeap() = 0;
+  // Lowest free heap since the last call (or boot), then start over from the current one;
+  // catches what was allocated and freed again in between
+  virtual uint32_t heapLowWater() = 0;
+  // Free heap, the largest block malloc() can still return and fragmentation in %
+  // (0: all free memory in one block). Walks the heap.
+  virtual void heapStats(uint32_t& freeBytes, uint32_t& maxBlock, uint8_t& fragmentation) = 0;
+};
+
+struct Hal {
+  Gpio* gpio;
+  Uart* uart;
+  TempProbe* probe;
+  Clock* clock;
+  Flash* flash;
+  Rtc* rtc;
+  Radio* radio;
+  HttpServer* http;
+  Wifi* wifi;
+  System* system;
+};
+
+extern Hal hal;
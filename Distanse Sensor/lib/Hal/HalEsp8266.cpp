@@ -0,0 +1,260 @@
+#ifdef ARDUINO
+
+#include "Hal.h"
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+#include <SoftwareSerial.h>
+#include <OneWire.h>
+#include <user_interface.h>
+#include <espnow.h>
+#include <umm_malloc/umm_malloc.h>
+
+namespace {
+
+/* ---------- GPIO --------------------------------------------------------- */
+constexpr uint8_t MAX_PINS = 17;
+EdgeCallback edgeCallbacks[MAX_PINS] = {};
+
+void IRAM_ATTR edgeTrampoline(void* arg) {
+  uint8_t pin = (uint8_t)(uintptr_t)arg;
+  edgeCallbacks[pin](digitalRead(pin) == HIGH, ESP.getCycleCount());
+}
+
+class Esp8266Gpio : public Gpio {
+public:
+  void mode(uint8_t pin, PinMode m) override {
+    pinMode(pin, m == PinMode::Output ? OUTPUT : (m == PinMode::InputPullup ? INPUT_PULLUP : INPUT));
+  }
+  void write(uint8_t pin, uint8_t value) override { digitalWrite(pin, value); }
+  int read(uint8_t pin) override { return digitalRead(pin); }
+  void attachEdgeInterrupt(uint8_t pin, EdgeCallback cb) override {
+    if (pin >= MAX_PINS) return;
+    edgeCallbacks[pin] = cb;
+    attachInterruptArg(digitalPinToInterrupt(pin), edgeTrampoline, (void*)(uintptr_t)pin, CHANGE);
+  }
+};
+
+/* ---------- sensor UART -------------------------------------------------- */
+// UART0 is the USB console and UART1 can only send, so the sensor gets a software
+// UART: RX is interrupt-driven into a ring buffer, TX bit-bangs (one byte per ping
+// in Controlled mode, ~1 ms at 9600 baud)
+class Esp8266Uart : public Uart {
+public:
+  void begin(uint32_t baud, uint8_t rxPin, uint8_t txPin) override {
+    serial_.begin(baud, SWSERIAL_8N1, rxPin, txPin, false, 64);
+  }
+  size_t available() override { return serial_.available(); }
+  size_t read(uint8_t* data, size_t size) override { return serial_.read(data, size); }
+  size_t write(const uint8_t* data, size_t size) override { return serial_.write(data, size); }
+
+private:
+  SoftwareSerial serial_;
+};
+
+/* ---------- temperature probe -------------------------------------------- */
+// DS18B20 alone on the bus: ROM commands are skipped
+class Esp8266TempProbe : public TempProbe {
+public:
+  bool begin(uint8_t pin) override {
+    wire_.begin(pin);
+    return wire_.reset();
+  }
+  bool startConversion() override {
+    if (!wire_.reset()) return false;
+    wire_.skip();
+    wire_.write(0x44, 1);   // Convert T; keep the line driven for parasite power
+    return true;
+  }
+  bool read(int16_t& sixteenths) override {
+    uint8_t scratchpad[9];
+    if (!wire_.reset()) return false;
+    wire_.skip();
+    wire_.write(0xBE);      // Read scratchpad
+    wire_.read_bytes(scratchpad, sizeof(scratchpad));
+    if (OneWire::crc8(scratchpad, 8) != scratchpad[8]) return false;
+    sixteenths = (int16_t)(scratchpad[1] << 8 | scratchpad[0]);
+    return true;
+  }
+
+private:
+  OneWire wire_;
+};
+
+/* ---------- clock -------------------------------------------------------- */
+class Esp8266Clock : public Clock {
+public:
+  uint32_t millis() override { return ::millis(); }
+  uint32_t micros() override { return ::micros(); }
+  uint32_t cycleCount() override { return ESP.getCycleCount(); }
+  uint32_t cpuMhz() override { return ESP.getCpuFreqMHz(); }
+  void delayMs(uint32_t ms) override { ::delay(ms); }
+  void delayUs(uint32_t us) override { ::delayMicroseconds(us); }
+  void yield() override { ::yield(); }
+};
+
+/* ---------- flash --------------------------------------------------------- */
+// Sector 0 is the EEPROM sector from the linker script, sector 1 the one below it
+// (the last sector of the filesystem area, which this firmware does not use)
+extern "C" uint32_t _EEPROM_start;
+
+class Esp8266Flash : public Flash {
+public:
+  size_t sectorSize() override { return SPI_FLASH_SEC_SIZE; }
+  size_t sectorCount() override { return 2; }
+  bool read(size_t sector, size_t offset, void* data, size_t size) override {
+    return sector < 2 && ESP.flashRead(address(sector) + offset, (uint32_t*)data, size);
+  }
+  bool write(size_t sector, size_t offset, const void* data, size_t size) override {
+    return sector < 2 && ESP.flashWrite(address(sector) + offset, (uint32_t*)data, size);
+  }
+  bool eraseSector(size_t sector) override {
+    return sector < 2 && ESP.flashEraseSector(address(sector) / SPI_FLASH_SEC_SIZE);
+  }
+
+private:
+  static uint32_t address(size_t sector) {
+    return ((uint32_t)&_EEPROM_start - 0x40200000) - sector * SPI_FLASH_SEC_SIZE;
+  }
+};
+
+/* ---------- RTC user memory -------------------------------------------- */
+// The first 128 of the 512 bytes are used by eboot for OTA updates
+constexpr size_t RTC_OTA_RESERVED = 128;
+
+class Esp8266Rtc : public Rtc {
+public:
+  size_t size() override { return 512 - RTC_OTA_RESERVED; }
+  bool read(size_t offset, void* data, size_t size) override {
+    return ESP.rtcUserMemoryRead((RTC_OTA_RESERVED + offset) / 4, (uint32_t*)data, size);
+  }
+  bool write(size_t offset, const void* data, size_t size) override {
+    return ESP.rtcUserMemoryWrite((RTC_OTA_RESERVED + offset) / 4, (uint32_t*)data, size);
+  }
+};
+
+/* ---------- ESP-NOW ------------------------------------------------------ */
+class Esp8266Radio : public Radio {
+public:
+  int init() override { return esp_now_init(); }
+  int setControllerRole() override { return esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER); }
+  int registerSendCallback(RadioSendCallback cb) override { return esp_now_register_send_cb(cb); }
+  int addPeer(const uint8_t* mac, uint8_t channel) override {
+    return esp_now_add_peer(const_cast<uint8_t*>(mac), ESP_NOW_ROLE_SLAVE, channel, NULL, 0);
+  }
+  int send(const uint8_t* mac, const uint8_t* data, size_t len) override {
+    return esp_now_send(const_cast<uint8_t*>(mac), const_cast<uint8_t*>(data), len);
+  }
+};
+
+/* ---------- web server --------------------------------------------------- */
+ESP8266WebServer server(80);
+RequestHook requestHook = nullptr;
+
+// The handler between the two hook calls. Captures two pointers (path is a literal),
+// small enough for std::function to keep without allocating.
+std::function<void()> hooked(const char* path, HttpHandler handler) {
+  return [path, handler] {
+    if (requestHook) requestHook(path, false);
+    handler();
+    if (requestHook) requestHook(path, true);
+  };
+}
+
+class Esp8266HttpServer : public HttpServer {
+public:
+  void on(const char* path, HttpHandler handler) override { server.on(path, hooked(path, handler)); }
+  void on(const char* path, HttpMethod method, HttpHandler handler) override {
+    HTTPMethod m = method == HttpMethod::Post ? HTTP_POST : (method == HttpMethod::Get ? HTTP_GET : HTTP_ANY);
+    server.on(path, m, hooked(path, handler));
+  }
+  void begin() override { server.begin(); }
+  void handleClient() override { server.handleClient(); }
+  bool hasArg(const char* name) override { return server.hasArg(name); }
+  String arg(const char* name) override { return server.arg(name); }
+  String uri() override { return server.uri(); }
+  void collectHeaders(const char* names[], size_t count) override { server.collectHeaders(names, count); }
+  String header(const char* name) override { return server.header(name); }
+  void sendHeader(const char* name, const char* value) override { server.sendHeader(name, value); }
+  void send(int code, const char* contentType, const String& body) override { server.send(code, contentType, body); }
+  void sendP(int code, const char* contentType, PGM_P data, size_t len) override { server.send_P(code, contentType, data, len); }
+  void beginChunked(int code, const char* contentType) override {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+  }
+  void sendChunk(const char* data, size_t len) override { server.sendContent(data, len); }
+  void endChunked() override { server.sendContent(""); }
+  void setRequestHook(RequestHook hook) override { requestHook = hook; }
+};
+
+/* ---------- Wi-Fi -------------------------------------------------------- */
+class Esp8266Wifi : public Wifi {
+public:
+  void beginAccessPoint(const uint8_t ip[4], const uint8_t gateway[4], const uint8_t subnet[4]) override {
+    WiFi.persistent(false);   // don't write Wi-Fi settings to flash
+    WiFi.mode(WIFI_OFF);
+    delay(50);
+    WiFi.mode(WIFI_AP);
+    WiFi.softAPConfig(IPAddress(ip[0], ip[1], ip[2], ip[3]),
+                      IPAddress(gateway[0], gateway[1], gateway[2], gateway[3]),
+                      IPAddress(subnet[0], subnet[1], subnet[2], subnet[3]));
+  }
+  bool softAP(const char* ssid, const char* password, uint8_t channel, bool hidden, uint8_t maxConn) override {
+    return WiFi.softAP(ssid, password, channel, hidden, maxConn);
+  }
+  void beginStation(uint8_t channel) override {
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.disconnect();
+    wifi_set_channel(channel);
+  }
+  String softAPSSID() override { return WiFi.softAPSSID(); }
+  String softAPPSK() override { return WiFi.softAPPSK(); }
+  String softAPIP() override { return WiFi.softAPIP().toString(); }
+  bool isApMode() override { return WiFi.getMode() == WIFI_AP; }
+  int channel() override { return WiFi.channel(); }
+  void macAddress(uint8_t mac[6]) override { WiFi.macAddress(mac); }
+  void stationMac(uint8_t mac[6]) override { wifi_get_macaddr(STATION_IF, mac); }
+  void softApMac(uint8_t mac[6]) override { wifi_get_macaddr(SOFTAP_IF, mac); }
+};
+
+class Esp8266System : public System {
+public:
+  void restart() override { ESP.restart(); }
+  void deepSleep(uint64_t us, bool radioOnWake) override {
+    ESP.deepSleep(us, radioOnWake ? WAKE_RF_DEFAULT : WAKE_RF_DISABLED);
+  }
+  uint32_t freeHeap() override { return ESP.getFreeHeap(); }
+  // umm_malloc's own low-water mark, which the core only keeps with -DUMM_STATS_FULL
+  // (set for d1_mini in platformio.ini); without it, just the free heap right now
+  uint32_t heapLowWater() override {
+#ifdef UMM_STATS_FULL
+    uint32_t low = umm_free_heap_size_lw_min();
+    umm_free_heap_size_min_reset();
+    return low;
+#else
+    return ESP.getFreeHeap();
+#endif
+  }
+  void heapStats(uint32_t& freeBytes, uint32_t& maxBlock, uint8_t& fragmentation) override {
+    freeBytes = ESP.getFreeHeap();
+    maxBlock = ESP.getMaxFreeBlockSize();
+    fragmentation = ESP.getHeapFragmentation();
+  }
+};
+
+Esp8266Gpio espGpio;
+Esp8266Uart espUart;
+Esp8266TempProbe espProbe;
+Esp8266Clock espClock;
+Esp8266Flash espFlash;
+Esp8266Rtc espRtc;
+Esp8266Radio espRadio;
+Esp8266HttpServer espHttp;
+Esp8266Wifi espWifi;
+Esp8266System espSystem;
+
+} // namespace
+
+Hal hal = { &espGpio, &espUart, &espProbe, &espClock, &espFlash, &espRtc, &espRadio, &espHttp, &espWifi, &espSystem };
+
+#endif // ARDUINO
@@ -0,0 +1,121 @@
+#pragma once
+
+/*
+   Minimal Arduino core surface for the host [env:native] build.
+
+   Only language-level pieces live here (String, Serial, pin names,
+   attribute macros). Anything that touches hardware must go through
+   lib/Hal so the simulation controls it; for that reason pinMode(),
+   digitalWrite(), millis(), delay() etc. are deliberately not provided.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define PGM_P const char*
+#define F(s) (s)
+#define memcpy_P memcpy
+
+#define HIGH 0x1
+#define LOW  0x0
+
+// Wemos D1 mini pin names
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+#define RX 3
+
+class String {
+public:
+  String() = default;
+  String(const char* s) : s_(s ? s : "") {}
+  String(const std::string& s) : s_(s) {}
+  explicit String(char c) : s_(1, c) {}
+  explicit String(unsigned char v) : s_(std::to_string(v)) {}
+  explicit String(int v) : s_(std::to_string(v)) {}
+  explicit String(unsigned int v) : s_(std::to_string(v)) {}
+  explicit String(long v) : s_(std::to_string(v)) {}
+  explicit String(unsigned long v) : s_(std::to_string(v)) {}
+  explicit String(float v, unsigned char decimals = 2) { fromDouble(v, decimals); }
+  explicit String(double v, unsigned char decimals = 2) { fromDouble(v, decimals); }
+
+  const char* c_str() const { return s_.c_str(); }
+  unsigned int length() const { return s_.length(); }
+  bool reserve(unsigned int size) { s_.reserve(size); return true; }
+  long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(s_.c_str(), nullptr); }
+  char operator[](unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+
+  void replace(const String& find, const String& with) {
+    if (find.s_.empty()) return;
+    size_t pos = 0;
+    while ((pos = s_.find(find.s_, pos)) != std::string::npos) {
+      s_.replace(pos, find.s_.size(), with.s_);
+      pos += with.s_.size();
+    }
+  }
+
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* o) { s_ += o; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* o) const { return s_ == o; }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String& a, const char* b) { return String(a.s_ + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.s_); }
+
+private:
+  void fromDouble(double v, unsigned char decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    s_ = buf;
+  }
+
+  std::string s_;
+};
+
+// Debug console. Silent unless the simulation enables it.
+class HardwareSerial {
+public:
+  void begin(unsigned long) {}
+  void setEnabled(bool on) { enabled_ = on; }
+  bool enabled() const { return enabled_; }
+
+  size_t print(const char* s) { return enabled_ ? fputs(s, stdout), strlen(s) : 0; }
+  size_t print(const String& s) { return print(s.c_str()); }
+  size_t println() { return print("\n"); }
+  size_t println(const char* s) { return print(s) + println(); }
+  size_t println(const String& s) { return println(s.c_str()); }
+  int availableForWrite() const { return 128; }   // an empty UART FIFO
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    if (!enabled_) return 0;
+    va_list args;
+    va_start(args, fmt);
+    int n = vprintf(fmt, args);
+    va_end(args);
+    return n > 0 ? n : 0;
+  }
+
+private:
+  bool enabled_ = false;
+};
+
+extern HardwareSerial Serial;
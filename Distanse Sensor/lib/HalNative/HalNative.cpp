@@ -0,0 +1,531 @@
+#include "HalNative.h"
+#include <algorithm>
+#include <math.h>
+
+HardwareSerial Serial;
+NativeSim sim;
+Hal hal = { &sim.gpio, &sim.uart, &sim.probe, &sim.clock, &sim.flash, &sim.rtc, &sim.radio, &sim.http, &sim.wifi, &sim.system };
+
+/* ---------- clock -------------------------------------------------------- */
+void MockClock::advanceUs(uint64_t us) {
+  uint64_t target = nowUs_ + us;
+  while (!events_.empty() && events_.top().atUs <= target) {
+    Event ev = events_.top();
+    events_.pop();
+    if (ev.atUs > nowUs_) nowUs_ = ev.atUs;
+    ev.fn();
+  }
+  nowUs_ = target;
+}
+
+void MockClock::schedule(uint64_t atUs, std::function<void()> fn) {
+  MockHeap::Untracked untracked(sim.heap);
+  events_.push(Event{atUs, seq_++, std::move(fn)});
+}
+
+/* ---------- GPIO --------------------------------------------------------- */
+void MockGpio::mode(uint8_t pin, PinMode m) {
+  if (pin >= MAX_PINS) return;
+  modes[pin] = m;
+  if (m == PinMode::InputPullup) levels[pin] = pressed[pin] ? LOW : HIGH; // e.g. BOOT button
+}
+
+void MockGpio::write(uint8_t pin, uint8_t value) {
+  if (pin >= MAX_PINS) return;
+  ++writes;
+  levels[pin] = value ? HIGH : LOW;
+  if (onWrite) onWrite(pin, levels[pin]);
+}
+
+void MockGpio::setInput(uint8_t pin, uint8_t value) {
+  if (pin >= MAX_PINS) return;
+  uint8_t level = value ? HIGH : LOW;
+  if (levels[pin] == level) return;
+  levels[pin] = level;
+  if (isr[pin]) isr[pin](level == HIGH, sim.clock.cycleCount());
+}
+
+/* ---------- ultrasonic sensor -------------------------------------------- */
+namespace {
+std::vector<MockUltrasonic*> attachedSensors;
+}
+
+void MockUltrasonic::attach(uint8_t trigPin, uint8_t echoPin) {
+  trigPin_ = trigPin;
+  echoPin_ = echoPin;
+  if (std::find(attachedSensors.begin(), attachedSensors.end(), this) == attachedSensors.end()) {
+    attachedSensors.push_back(this);
+  }
+  sim.gpio.onWrite = [](uint8_t pin, uint8_t value) {
+    for (MockUltrasonic* s : attachedSensors) {
+      if (pin == s->trigPin_) s->onTrigWrite(value);
+    }
+  };
+}
+
+void MockUltrasonic::onTrigWrite(uint8_t value) {
+  bool high = value == HIGH;
+  bool fallingEdge = trigHigh_ && !high;
+  trigHigh_ = high;
+  if (!fallingEdge) return;
+
+  uint64_t now = sim.clock.nowUs();
+  if (now < busyUntilUs_) {
+    ++ignoredTriggers; // still listening for the previous ping
+    return;
+  }
+  ++pings;
+  float cm = jittered(distanceCm(now));
+
+  uint64_t rise = now + echoDelayUs;
+  uint64_t fall = rise + (cm > 0 ? (uint64_t)(cm * 2.0 / (soundSpeedMs(now) * 1e-4)) : noEchoPulseUs);
+  listenFromUs_ = rise;
+  busyUntilUs_ = fall;
+  uint8_t pin = echoPin_;
+  sim.clock.schedule(rise, [pin] { sim.gpio.setInput(pin, HIGH); });
+
+  // A neighbour's echo still in the air ends this ping early...
+  for (MockUltrasonic* s : attachedSensors) {
+    if (s != this && s->crosstalkTailUs && s->airUntilUs_ >= rise && s->airFromUs_ < busyUntilUs_) {
+      hear(s->airFromUs_, s->airUntilUs_);
+    }
+  }
+  scheduleFall(busyUntilUs_);
+
+  // ... and this one's echo ends theirs
+  if (cm <= 0 || !crosstalkTailUs) return;
+  airFromUs_ = fall;
+  airUntilUs_ = fall + crosstalkTailUs;
+  for (MockUltrasonic* s : attachedSensors) {
+    if (s != this && s->busyUntilUs_ > airFromUs_ && s->listenFromUs_ <= airUntilUs_) {
+      s->hear(airFromUs_, airUntilUs_);
+      s->scheduleFall(s->busyUntilUs_);
+    }
+  }
+}
+
+// Another sensor's echo is audible from fromUs to untilUs: the first of it that
+// falls into this sensor's listening ends it
+void MockUltrasonic::hear(uint64_t fromUs, uint64_t untilUs) {
+  uint64_t at = fromUs > listenFromUs_ ? fromUs : listenFromUs_;
+  if (at > untilUs || at >= busyUntilUs_) return;
+  busyUntilUs_ = at;
+  ++crosstalkHits;
+}
+
+void MockUltrasonic::scheduleFall(uint64_t atUs) {
+  uint32_t gen = ++fallGen_;
+  uint8_t pin = echoPin_;
+  sim.clock.schedule(atUs, [this, gen, pin] {
+    if (gen == fallGen_) sim.gpio.setInput(pin, LOW);
+  });
+}
+
+float MockUltrasonic::jittered(float cm) {
+  if (cm <= 0 || jitterCm <= 0) return cm;
+  rng_ = rng_ * 1103515245u + 12345u;
+  return cm + jitterCm * ((float)(rng_ >> 16) / 32768.0f - 1.0f);
+}
+
+void MockUltrasonic::attachSerial(bool autoOutput) {
+  if (autoOutput) {
+    sim.clock.schedule(sim.clock.nowUs() + framePeriodUs, [this] {
+      sendFrame();
+      attachSerial(true);
+    });
+    return;
+  }
+  sim.uart.onWrite = [this](uint8_t b) {
+    if (b == 0x55) sendFrame();
+  };
+}
+
+// Range now and send the result: 0xFF, mm high, mm low, checksum at 9600 baud.
+// No echo is reported as 0 mm.
+void MockUltrasonic::sendFrame() {
+  // RX on the sensor's TX (ECHO) wire and TX on its RX (TRIG) wire, or nothing gets through
+  if (sim.uart.rxPin != echoPin_ || sim.uart.txPin != trigPin_) return;
+  ++pings;
+  uint64_t now = sim.clock.nowUs();
+  float cm = jittered(distanceCm(now));
+  uint16_t mm = cm > 0 ? (uint16_t)(cm * 10.0f + 0.5f) : 0;
+  uint8_t frame[4] = {0xFF, (uint8_t)(mm >> 8), (uint8_t)mm, 0};
+  frame[3] = (uint8_t)(frame[0] + frame[1] + frame[2]);
+
+  // First byte once the echo is back; then one byte per 10 bits
+  uint64_t at = now + echoDelayUs + (cm > 0 ? (uint64_t)(cm * 2.0f / 0.0343f) : 30000);
+  for (uint8_t b : frame) {
+    rng_ = rng_ * 1103515245u + 12345u;
+    if ((rng_ >> 16) % 100 < noisePercent) {
+      ++noisyBytes;
+      uint32_t kind = (rng_ >> 8) % 3;
+      if (kind == 0) b ^= (uint8_t)(1 << ((rng_ >> 4) % 8));   // flipped bit
+      else if (kind == 1) continue;                              // lost byte
+      else sendByte(at, (uint8_t)(rng_ >> 20)), at += 1042;      // extra byte
+    }
+    sendByte(at, b);
+    at += 1042;
+  }
+}
+
+void MockUltrasonic::sendByte(uint64_t atUs, uint8_t b) {
+  sim.clock.schedule(atUs, [b] { sim.uart.receive(b); });
+}
+
+/* ---------- temperature probe -------------------------------------------- */
+bool MockTempProbe::startConversion() {
+  if (!present) return false;
+  ++conversions;
+  uint64_t now = sim.clock.nowUs();
+  converting_ = (int16_t)lroundf(airTempC(now) * 16.0f);
+  readyUs_ = now + 750000;
+  return true;
+}
+
+bool MockTempProbe::read(int16_t& sixteenths) {
+  if (!present) return false;
+  ++reads;
+  if (readyUs_ && sim.clock.nowUs() >= readyUs_) {
+    scratchpad_ = converting_;
+    readyUs_ = 0;
+  }
+  sixteenths = scratchpad_;
+  return true;
+}
+
+/* ---------- sensor UART -------------------------------------------------- */
+size_t MockUart::read(uint8_t* data, size_t size) {
+  size_t n = 0;
+  while (n < size && !rx.empty()) {
+    data[n++] = rx.front();
+    rx.pop_front();
+  }
+  return n;
+}
+
+size_t MockUart::write(const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    if (onWrite) onWrite(data[i]);
+  }
+  return size;
+}
+
+void MockUart::receive(uint8_t b) {
+  if (!started) return;
+  MockHeap::Untracked untracked(sim.heap);
+  if (rx.size() >= 64) {
+    ++overruns;
+    return;
+  }
+  rx.push_back(b);
+}
+
+/* ---------- flash -------------------------------------------------------- */
+bool MockFlash::read(size_t sector, size_t offset, void* data, size_t size) {
+  if (sector >= SECTORS || offset % 4 || size % 4 || offset + size > SECTOR_SIZE) return false;
+  memcpy(data, &storage[sector * SECTOR_SIZE + offset], size);
+  return true;
+}
+
+// Count one unit of work; true if the power fails right here
+bool MockFlash::powerFails() {
+  if (powerLossAfter < 0) return false;
+  if (powerLossAfter-- > 0) return false;
+  powerLost = true;
+  return true;
+}
+
+bool MockFlash::write(size_t sector, size_t offset, const void* data, size_t size) {
+  if (powerLost || sector >= SECTORS || offset % 4 || size % 4 || offset + size > SECTOR_SIZE) return false;
+  const uint8_t* src = (const uint8_t*)data;
+  uint8_t* dst = &storage[sector * SECTOR_SIZE + offset];
+  for (size_t i = 0; i < size; ++i) {
+    if (powerFails()) {
+      // The interrupted byte only got some of its bits cleared
+      rng_ = rng_ * 1103515245u + 12345u;
+      dst[i] &= src[i] | (uint8_t)(rng_ >> 16);
+      return false;
+    }
+    dst[i] &= src[i];
+    ++bytesWritten;
+  }
+  return true;
+}
+
+bool MockFlash::eraseSector(size_t sector) {
+  if (powerLost || sector >= SECTORS) return false;
+  uint8_t* dst = &storage[sector * SECTOR_SIZE];
+  if (powerFails()) {
+    // Interrupted erase: some bits of the sector are set, the rest keep their value
+    for (size_t i = 0; i < SECTOR_SIZE; ++i) {
+      rng_ = rng_ * 1103515245u + 12345u;
+      dst[i] |= (uint8_t)(rng_ >> 16);
+    }
+    return false;
+  }
+  ++erases[sector];
+  memset(dst, 0xFF, SECTOR_SIZE);
+  return true;
+}
+
+/* ---------- RTC memory --------------------------------------------------- */
+bool MockRtc::read(size_t offset, void* data, size_t size) {
+  if (offset % 4 || offset + size > sizeof(memory)) return false;
+  memcpy(data, memory + offset, size);
+  return true;
+}
+
+bool MockRtc::write(size_t offset, const void* data, size_t size) {
+  if (offset % 4 || offset + size > sizeof(memory)) return false;
+  ++writes;
+  memcpy(memory + offset, data, size);
+  return true;
+}
+
+void MockRtc::powerLoss() {
+  for (uint8_t& b : memory) {
+    rng_ = rng_ * 1103515245u + 12345u;
+    b = (uint8_t)(rng_ >> 16);
+  }
+}
+
+/* ---------- radio -------------------------------------------------------- */
+int MockRadio::addPeer(const uint8_t* mac, uint8_t) {
+  memcpy(peer, mac, 6);
+  return 0;
+}
+
+int MockRadio::send(const uint8_t* mac, const uint8_t* data, size_t len) {
+  if (!initialized || len > 250) return 1;
+  MockHeap::Untracked untracked(sim.heap);   // the SDK's buffers are not in the model
+
+  ++framesSent;
+  bytesSent += len;
+  lastFrame.assign(data, data + len);
+
+  // Deterministic LCG so simulation runs are reproducible
+  rng_ = rng_ * 1103515245u + 12345u;
+  bool delivered = !down && ((rng_ >> 16) % 100) >= lossPercent;
+  rng_ = rng_ * 1103515245u + 12345u;
+  uint8_t status = delivered && ((rng_ >> 16) % 100) >= ackLossPercent ? 0 : 1;
+  if (delivered && onFrame) onFrame(data, len);
+  if (status == 0) ++framesAcked;
+
+  RadioSendCallback cb = callback_;
+  uint8_t to[6];
+  memcpy(to, mac, 6);
+  if (cb) {
+    sim.clock.schedule(sim.clock.nowUs() + ackLatencyUs, [cb, to, status]() mutable { cb(to, status); });
+  }
+  return 0;
+}
+
+/* ---------- HTTP --------------------------------------------------------- */
+// The mock keeps every response whole; its buffers stay out of the heap model
+// (the device hands them to the TCP stack chunk by chunk)
+void MockHttpServer::on(const char* path, HttpMethod method, HttpHandler handler) {
+  MockHeap::Untracked untracked(sim.heap);
+  routes_[path] = Route{method, handler};
+}
+
+String MockHttpServer::arg(const char* name) {
+  auto it = args_.find(name);
+  return it == args_.end() ? String() : String(it->second);
+}
+
+String MockHttpServer::header(const char* name) {
+  auto it = headers_.find(name);
+  return it == headers_.end() ? String() : String(it->second);
+}
+
+void MockHttpServer::sendHeader(const char* name, const char* value) {
+  MockHeap::Untracked untracked(sim.heap);
+  response_.headers.emplace_back(name, value);
+}
+
+void MockHttpServer::send(int code, const char* contentType, const String& body) {
+  MockHeap::Untracked untracked(sim.heap);
+  response_.code = code;
+  response_.contentType = contentType;
+  response_.body.assign(body.c_str(), body.length());
+}
+
+void MockHttpServer::sendP(int code, const char* contentType, PGM_P data, size_t len) {
+  MockHeap::Untracked untracked(sim.heap);
+  response_.code = code;
+  response_.contentType = contentType;
+  response_.body.assign(data, len);
+}
+
+void MockHttpServer::beginChunked(int code, const char* contentType) {
+  MockHeap::Untracked untracked(sim.heap);
+  response_.code = code;
+  response_.contentType = contentType;
+  response_.body.clear();
+}
+
+void MockHttpServer::sendChunk(const char* data, size_t len) {
+  MockHeap::Untracked untracked(sim.heap);
+  ++response_.chunks;
+  response_.body.append(data, len);
+}
+
+const MockHttpServer::Response& MockHttpServer::request(const char* path, HttpMethod method,
+                                                        const std::map<std::string, std::string>& args,
+                                                        const std::map<std::string, std::string>& headers) {
+  auto it = routes_.find(path);
+  {
+    MockHeap::Untracked untracked(sim.heap);
+    response_ = Response();
+    if (it == routes_.end() || (it->second.method != HttpMethod::Any && it->second.method != method)) {
+      response_.code = 404;
+      return response_;
+    }
+    args_ = args;
+    headers_ = headers;
+    uri_ = path;
+  }
+  if (hook_) hook_(it->first.c_str(), false);
+  it->second.handler();
+  if (hook_) hook_(it->first.c_str(), true);
+  args_.clear();
+  headers_.clear();
+  return response_;
+}
+
+void MockHttpServer::handleClient() {
+  if (queued_.empty()) return;
+  std::string path;
+  {
+    MockHeap::Untracked untracked(sim.heap);
+    path = queued_.front();
+    queued_.pop_front();
+  }
+  request(path.c_str());
+}
+
+std::string MockHttpServer::responseHeader(const Response& r, const char* name) {
+  for (const auto& h : r.headers) {
+    if (h.first == name) return h.second;
+  }
+  return std::string();
+}
+
+/* ---------- Wi-Fi -------------------------------------------------------- */
+bool MockWifi::softAP(const char* s, const char* p, uint8_t channel, bool, uint8_t) {
+  ssid = s;
+  password = p;
+  channel_ = channel;
+  return true;
+}
+
+/* ---------- system and heap ---------------------------------------------- */
+uint32_t MockSystem::freeHeap() { return sim.heap.freeBytes(); }
+uint32_t MockSystem::heapLowWater() { return sim.heap.lowWater(); }
+void MockSystem::heapStats(uint32_t& freeBytes, uint32_t& maxBlock, uint8_t& fragmentation) {
+  sim.heap.stats(freeBytes, maxBlock, fragmentation);
+}
+
+void MockHeap::reset(size_t bytes) {
+  size_t n = bytes / BLOCK;
+  blocks_ = (uint16_t)(n < MAX_BLOCKS ? n : MAX_BLOCKS);
+  next_[0] = blocks_;
+  prev_[0] = 0;
+  prev_[blocks_] = 0;
+  isFree_[0] = true;
+  freeNext_[0] = freePrev_[0] = NONE;
+  freeHead_ = 0;
+  freeBlocks_ = lowBlocks_ = blocks_;
+  ++generation_;
+  allocs = frees = failures = 0;
+  used = 0;
+}
+
+void MockHeap::unlinkFree(uint16_t b) {
+  if (freePrev_[b] != NONE) freeNext_[freePrev_[b]] = freeNext_[b];
+  else freeHead_ = freeNext_[b];
+  if (freeNext_[b] != NONE) freePrev_[freeNext_[b]] = freePrev_[b];
+  isFree_[b] = false;
+}
+
+// Freed runs go to the front, like umm_malloc's free list
+void MockHeap::linkFree(uint16_t b) {
+  freePrev_[b] = NONE;
+  freeNext_[b] = freeHead_;
+  if (freeHead_ != NONE) freePrev_[freeHead_] = b;
+  freeHead_ = b;
+  isFree_[b] = true;
+}
+
+int32_t MockHeap::alloc(size_t n) {
+  ++allocs;
+  size_t need = (n + HEADER + BLOCK - 1) / BLOCK;
+  uint16_t best = NONE;
+  uint32_t bestSize = UINT32_MAX;
+  for (uint16_t b = freeHead_; b != NONE; b = freeNext_[b]) {
+    uint32_t size = next_[b] - b;
+    if (size >= need && size < bestSize) {
+      best = b;
+      bestSize = size;
+      if (size == need) break;
+    }
+  }
+  if (best == NONE) {
+    ++failures;
+    return -1;
+  }
+  unlinkFree(best);
+  if (bestSize > need) {   // the rest stays free
+    uint16_t rest = (uint16_t)(best + need);
+    next_[rest] = next_[best];
+    prev_[rest] = best;
+    prev_[next_[best]] = rest;
+    next_[best] = rest;
+    linkFree(rest);
+  }
+  freeBlocks_ -= (uint32_t)need;
+  if (freeBlocks_ < lowBlocks_) lowBlocks_ = freeBlocks_;
+  ++used;
+  return best;
+}
+
+void MockHeap::free(int32_t block) {
+  if (block < 0 || block >= blocks_ || isFree_[block]) return;
+  uint16_t b = (uint16_t)block;
+  ++frees;
+  --used;
+  freeBlocks_ += next_[b] - b;
+  uint16_t after = next_[b];
+  if (after < blocks_ && isFree_[after]) {   // absorb the free run after it
+    unlinkFree(after);
+    next_[b] = next_[after];
+    prev_[next_[b]] = b;
+  }
+  if (b > 0 && isFree_[prev_[b]]) {          // and merge into the free run before it
+    uint16_t before = prev_[b];
+    next_[before] = next_[b];
+    prev_[next_[b]] = before;
+    return;
+  }
+  linkFree(b);
+}
+
+uint32_t MockHeap::lowWater() {
+  uint32_t low = lowBlocks_;
+  lowBlocks_ = freeBlocks_;
+  return low * BLOCK;
+}
+
+// The same figures as ESP.getFreeHeap(), getMaxFreeBlockSize() and getHeapFragmentation()
+void MockHeap::stats(uint32_t& freeBytes, uint32_t& maxBlock, uint8_t& fragmentation) const {
+  uint32_t largest = 0;
+  double squares = 0;
+  for (uint16_t b = freeHead_; b != NONE; b = freeNext_[b]) {
+    uint32_t size = next_[b] - b;
+    if (size > largest) largest = size;
+    squares += (double)size * size;
+  }
+  freeBytes = freeBlocks_ * BLOCK;
+  maxBlock = largest ? largest * BLOCK - HEADER : 0;
+  fragmentation = freeBlocks_ ? (uint8_t)(100 - (uint32_t)sqrt(squares) * 100 / freeBlocks_) : 0;
+}
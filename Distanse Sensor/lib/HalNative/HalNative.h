@@ -0,0 +1,410 @@
+#pragma once
+
+/*
+   Mock hardware for the host [env:native] build.
+
+   Everything runs on a simulated microsecond clock: delays, yield() and
+   MockClock::advanceUs() move it forward and fire scheduled events (echo edges,
+   sensor UART bytes, ESP-NOW send callbacks) in time order, so millions of loop() ticks can
+   be simulated in seconds and profiled with host tools.
+*/
+
+#include "Hal.h"
+#include <deque>
+#include <functional>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+
+class MockClock : public Clock {
+public:
+  uint32_t millis() override { return (uint32_t)((nowUs_ - epochUs_) / 1000); }
+  uint32_t micros() override { return (uint32_t)(nowUs_ - epochUs_); }
+  uint32_t cycleCount() override { return (uint32_t)(nowUs_ * cpuMhz_); }
+  uint32_t cpuMhz() override { return cpuMhz_; }
+  void delayMs(uint32_t ms) override { advanceUs((uint64_t)ms * 1000); }
+  void delayUs(uint32_t us) override { advanceUs(us); }
+  void yield() override { advanceUs(yieldUs); }
+
+  uint64_t nowUs() const { return nowUs_; }
+  // millis()/micros() restart from 0, like after a deep-sleep wake
+  void restartEpoch() { epochUs_ = nowUs_; }
+  // Move time forward, firing every event that falls due on the way
+  void advanceUs(uint64_t us);
+  void schedule(uint64_t atUs, std::function<void()> fn);
+
+  uint32_t yieldUs = 10;  // simulated cost of one yield()
+
+private:
+  struct Event {
+    uint64_t atUs;
+    uint64_t seq;
+    std::function<void()> fn;
+    bool operator>(const Event& o) const { return atUs != o.atUs ? atUs > o.atUs : seq > o.seq; }
+  };
+
+  uint64_t nowUs_ = 0;
+  uint64_t epochUs_ = 0;
+  uint64_t seq_ = 0;
+  uint32_t cpuMhz_ = 80;
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+};
+
+class MockGpio : public Gpio {
+public:
+  static constexpr uint8_t MAX_PINS = 17;
+
+  void mode(uint8_t pin, PinMode m) override;
+  void write(uint8_t pin, uint8_t value) override;
+  int read(uint8_t pin) override { return pin < MAX_PINS ? levels[pin] : LOW; }
+  void attachEdgeInterrupt(uint8_t pin, EdgeCallback cb) override { if (pin < MAX_PINS) isr[pin] = cb; }
+
+  // Drive an input pin from the outside world, firing its edge interrupt
+  void setInput(uint8_t pin, uint8_t value);
+
+  std::function<void(uint8_t pin, uint8_t value)> onWrite;
+  PinMode modes[MAX_PINS] = {};
+  uint8_t levels[MAX_PINS] = {};
+  EdgeCallback isr[MAX_PINS] = {};
+  bool pressed[MAX_PINS] = {};  // pulled low from outside (held button), wins over the pull-up
+  uint64_t writes = 0;
+};
+
+// Sensor side of the UART: bytes the sensor sent wait in rx until read
+class MockUart : public Uart {
+public:
+  void begin(uint32_t baud, uint8_t rxPin, uint8_t txPin) override {
+    this->baud = baud;
+    this->rxPin = rxPin;
+    this->txPin = txPin;
+    started = true;
+    rx.clear();
+  }
+  size_t available() override { return rx.size(); }
+  size_t read(uint8_t* data, size_t size) override;
+  size_t write(const uint8_t* data, size_t size) override;
+
+  // Byte arriving from the sensor; dropped (like an overrun) when the 64-byte buffer is full
+  void receive(uint8_t b);
+
+  std::function<void(uint8_t b)> onWrite;  // byte sent to the sensor
+  std::deque<uint8_t> rx;
+  uint32_t baud = 0;
+  uint8_t rxPin = 0;   // a sensor only hears and is heard on the pins it is attached to
+  uint8_t txPin = 0;
+  bool started = false;
+  uint64_t overruns = 0;
+};
+
+// DS18B20: a conversion samples airTempC and is readable 750 ms later; until the
+// first one the scratchpad holds the power-on value 85 °C
+class MockTempProbe : public TempProbe {
+public:
+  bool begin(uint8_t) override { return present; }
+  bool startConversion() override;
+  bool read(int16_t& sixteenths) override;
+
+  bool present = false;
+  std::function<float(uint64_t nowUs)> airTempC = [](uint64_t) { return 20.0f; };
+  uint64_t conversions = 0;
+  uint64_t reads = 0;
+
+private:
+  int16_t scratchpad_ = 85 * 16;
+  int16_t converting_ = 0;
+  uint64_t readyUs_ = 0;
+};
+
+// HC-SR04 / JSN-SR04M in trigger/echo mode, or the JSN-SR04M serial modes.
+// Several can be attached to different pins; a sensor listening while another
+// one's echo comes back takes that echo for its own (crosstalkTailUs).
+class MockUltrasonic {
+public:
+  void attach(uint8_t trigPin, uint8_t echoPin);
+  void onTrigWrite(uint8_t value);
+
+  // Serial modes: frames on sim.uart every framePeriodUs (autoOutput) or in reply
+  // to each trigger byte
+  void attachSerial(bool autoOutput);
+
+  // Target distance at a given simulated time; <= 0 means no echo, and like
+  // the HC-SR04 the module then holds ECHO high for noEchoPulseUs
+  std::function<float(uint64_t nowUs)> distanceCm = [](uint64_t) { return 45.0f; };
+  // Speed of sound in m/s at a given simulated time (the air temperature)
+  std::function<double(uint64_t nowUs)> soundSpeedMs = [](uint64_t) { return 343.2; };
+  uint32_t echoDelayUs = 450;  // trigger → echo rise (burst transmit time)
+  uint32_t noEchoPulseUs = 38000;
+  uint32_t framePeriodUs = 100000;
+  uint32_t noisePercent = 0;   // serial bytes hit by line noise: flipped bit, lost, or an extra byte
+  float jitterCm = 0;          // each ping reads up to this much off (air turbulence, ringing)
+  // How long this sensor's echo (and its reverberation) stays audible to the other
+  // attached sensors once it is back; 0: they are too far apart to hear it
+  uint32_t crosstalkTailUs = 0;
+  uint64_t pings = 0;
+  uint64_t ignoredTriggers = 0;  // triggered while ECHO was still high
+  uint64_t noisyBytes = 0;
+  uint64_t crosstalkHits = 0;    // pings cut short by another sensor's echo
+
+private:
+  float jittered(float cm);
+  void scheduleFall(uint64_t atUs);
+  void hear(uint64_t fromUs, uint64_t untilUs);
+  void sendFrame();
+  void sendByte(uint64_t atUs, uint8_t b);
+
+  uint8_t trigPin_ = 0;
+  uint8_t echoPin_ = 0;
+  bool trigHigh_ = false;
+  uint64_t listenFromUs_ = 0;   // ECHO high from here to busyUntilUs_
+  uint64_t busyUntilUs_ = 0;
+  uint64_t airFromUs_ = 0;      // own echo audible to the others
+  uint64_t airUntilUs_ = 0;
+  uint32_t fallGen_ = 0;        // only the latest scheduled ECHO fall counts
+  uint32_t rng_ = 99;
+};
+
+// NOR flash: writes AND into the stored bits, erases set a sector to 0xFF.
+// Power loss can be injected at any byte of a write or during an erase.
+class MockFlash : public Flash {
+public:
+  static constexpr size_t SECTOR_SIZE = 4096;
+  static constexpr size_t SECTORS = 2;
+
+  size_t sectorSize() override { return SECTOR_SIZE; }
+  size_t sectorCount() override { return SECTORS; }
+  bool read(size_t sector, size_t offset, void* data, size_t size) override;
+  bool write(size_t sector, size_t offset, const void* data, size_t size) override;
+  bool eraseSector(size_t sector) override;
+
+  // Power fails once this many more bytes have been programmed (an erase counts
+  // as one); the byte or sector being worked on is left half-done. -1: never.
+  int64_t powerLossAfter = -1;
+  bool powerLost = false;    // everything after the loss fails until cleared
+
+  std::vector<uint8_t> storage = std::vector<uint8_t>(SECTOR_SIZE * SECTORS, 0xFF);
+  uint64_t bytesWritten = 0;
+  uint64_t erases[SECTORS] = {};
+
+private:
+  bool powerFails();
+  uint32_t rng_ = 4242;
+};
+
+// RTC user memory: kept across deep sleep, random after powerLoss()
+class MockRtc : public Rtc {
+public:
+  size_t size() override { return sizeof(memory); }
+  bool read(size_t offset, void* data, size_t size) override;
+  bool write(size_t offset, const void* data, size_t size) override;
+  void powerLoss();
+
+  uint8_t memory[384] = {};
+  uint64_t writes = 0;
+
+private:
+  uint32_t rng_ = 777;
+};
+
+class MockRadio : public Radio {
+public:
+  int init() override { if (!rfEnabled) return 1; initialized = true; return 0; }
+  int setControllerRole() override { return 0; }
+  int registerSendCallback(RadioSendCallback cb) override { callback_ = cb; return 0; }
+  int addPeer(const uint8_t* mac, uint8_t channel) override;
+  int send(const uint8_t* mac, const uint8_t* data, size_t len) override;
+
+  bool initialized = false;
+  bool rfEnabled = true;            // false after a wake with the RF disabled
+  uint32_t ackLatencyUs = 2000;
+  uint32_t lossPercent = 0;         // frames lost (reported as failed)
+  uint32_t ackLossPercent = 0;      // frames delivered but reported as failed (receiver sees a duplicate on retry)
+  bool down = false;                // parent unreachable: every frame fails
+  uint64_t framesSent = 0;
+  uint64_t bytesSent = 0;
+  uint64_t framesAcked = 0;
+  std::vector<uint8_t> lastFrame;
+  uint8_t peer[6] = {};
+  // Receiver side: called with every frame that gets acknowledged
+  std::function<void(const uint8_t* data, size_t len)> onFrame;
+
+private:
+  RadioSendCallback callback_ = nullptr;
+  uint32_t rng_ = 12345;
+};
+
+class MockHttpServer : public HttpServer {
+public:
+  struct Response {
+    int code = 0;
+    std::string contentType;
+    std::string body;
+    size_t chunks = 0;
+    std::vector<std::pair<std::string, std::string>> headers;
+  };
+
+  void on(const char* path, HttpHandler handler) override { on(path, HttpMethod::Any, handler); }
+  void on(const char* path, HttpMethod method, HttpHandler handler) override;
+  void begin() override {}
+  // Serves the oldest queued request, if any
+  void handleClient() override;
+  bool hasArg(const char* name) override { return args_.count(name) != 0; }
+  String arg(const char* name) override;
+  String uri() override { return String(uri_.c_str()); }
+  void collectHeaders(const char*[], size_t) override {}
+  String header(const char* name) override;
+  void sendHeader(const char* name, const char* value) override;
+  void send(int code, const char* contentType, const String& body) override;
+  void sendP(int code, const char* contentType, PGM_P data, size_t len) override;
+  void beginChunked(int code, const char* contentType) override;
+  void sendChunk(const char* data, size_t len) override;
+  void endChunked() override {}
+  void setRequestHook(RequestHook hook) override { hook_ = hook; }
+
+  // Dispatch a request to the registered handler; code 404 if none matches
+  const Response& request(const char* path, HttpMethod method = HttpMethod::Get,
+                          const std::map<std::string, std::string>& args = {},
+                          const std::map<std::string, std::string>& headers = {});
+
+  // Queue a GET request for the next handleClient() (from loop(), like a client's would be)
+  void queue(const char* path) { queued_.push_back(path); }
+
+  // Value of a response header, "" if it was not sent
+  static std::string responseHeader(const Response& r, const char* name);
+
+private:
+  struct Route {
+    HttpMethod method;
+    HttpHandler handler;
+  };
+
+  std::map<std::string, Route> routes_;
+  std::map<std::string, std::string> args_;
+  std::map<std::string, std::string> headers_;
+  std::string uri_;
+  std::deque<std::string> queued_;
+  Response response_;
+  RequestHook hook_ = nullptr;
+};
+
+class MockWifi : public Wifi {
+public:
+  void beginAccessPoint(const uint8_t*, const uint8_t*, const uint8_t*) override { apMode = true; }
+  bool softAP(const char* ssid, const char* password, uint8_t channel, bool, uint8_t) override;
+  String softAPSSID() override { return String(ssid); }
+  String softAPPSK() override { return String(password); }
+  String softAPIP() override { return String("192.168.4.1"); }
+  void beginStation(uint8_t channel) override { apMode = false; channel_ = channel; }
+  bool isApMode() override { return apMode; }
+  int channel() override { return channel_; }
+  void macAddress(uint8_t mac[6]) override { memcpy(mac, staMac, 6); }
+  void stationMac(uint8_t mac[6]) override { memcpy(mac, staMac, 6); }
+  void softApMac(uint8_t mac[6]) override { memcpy(mac, apMac, 6); }
+
+  uint8_t staMac[6] = {0x5C, 0xCF, 0x7F, 0x12, 0x34, 0x56};
+  uint8_t apMac[6] = {0x5E, 0xCF, 0x7F, 0x12, 0x34, 0x56};
+  std::string ssid;
+  std::string password;
+  bool apMode = false;
+
+private:
+  int channel_ = 1;
+};
+
+// Model of the ESP8266 heap (umm_malloc as the core builds it): 8-byte blocks, an
+// allocation takes whole blocks including a 4-byte header, malloc() picks the
+// smallest free run that fits (best fit) and splits it, free() merges a run with
+// its free neighbours. While tracking, the simulation's operator new mirrors every
+// allocation here, so the firmware's fragmentation of a 40 KB heap can be measured
+// on the host; the mocks allocate for the simulated world inside an Untracked scope.
+class MockHeap {
+public:
+  static constexpr size_t BLOCK = 8;
+  static constexpr size_t HEADER = 4;
+  static constexpr size_t MAX_BLOCKS = 8192;   // 64 KB
+
+  // Stops tracking for its lifetime (nests)
+  class Untracked {
+  public:
+    explicit Untracked(MockHeap& heap) : heap_(heap) { ++heap_.paused_; }
+    ~Untracked() { --heap_.paused_; }
+  private:
+    MockHeap& heap_;
+  };
+
+  MockHeap() { reset(40 * 1024); }
+  // One free run of bytes (up to MAX_BLOCKS blocks), counters cleared. Blocks
+  // allocated before belong to an older generation and are no longer freed here.
+  void reset(size_t bytes);
+  void setTracking(bool on) { tracking_ = on; }
+  bool tracking() const { return tracking_ && !paused_; }
+  uint32_t generation() const { return generation_; }
+
+  // First block of the run for n bytes; -1 (counted as a failure) if no free run fits
+  int32_t alloc(size_t n);
+  void free(int32_t block);
+
+  uint32_t freeBytes() const { return freeBlocks_ * BLOCK; }
+  uint32_t lowWater();
+  void stats(uint32_t& freeBytes, uint32_t& maxBlock, uint8_t& fragmentation) const;
+
+  uint64_t allocs = 0;
+  uint64_t frees = 0;
+  uint64_t failures = 0;
+  uint32_t used = 0;             // allocated runs
+
+private:
+  static constexpr uint16_t NONE = 0xFFFF;
+  void unlinkFree(uint16_t b);
+  void linkFree(uint16_t b);
+
+  uint16_t blocks_ = 0;
+  uint16_t next_[MAX_BLOCKS + 1];   // run start → start of the run after it (blocks_ at the end)
+  uint16_t prev_[MAX_BLOCKS + 1];   // run start → start of the run before it
+  uint16_t freeNext_[MAX_BLOCKS];   // free list, in no particular order
+  uint16_t freePrev_[MAX_BLOCKS];
+  bool isFree_[MAX_BLOCKS];
+  uint16_t freeHead_ = NONE;
+  uint32_t freeBlocks_ = 0;
+  uint32_t lowBlocks_ = 0;
+  uint32_t generation_ = 0;
+  uint32_t paused_ = 0;
+  bool tracking_ = false;
+};
+
+class MockSystem : public System {
+public:
+  void restart() override { restartRequested = true; ++restarts; }
+  // Returns (the device would not): the simulation advances the clock and boots again
+  void deepSleep(uint64_t us, bool radio) override { sleepRequested = true; sleepUs = us; radioOnWake = radio; ++sleeps; }
+  // From sim.heap: an idle 40 KB heap unless the simulation tracks allocations
+  uint32_t freeHeap() override;
+  uint32_t heapLowWater() override;
+  void heapStats(uint32_t& freeBytes, uint32_t& maxBlock, uint8_t& fragmentation) override;
+
+  bool restartRequested = false;
+  uint32_t restarts = 0;
+  bool sleepRequested = false;
+  uint64_t sleepUs = 0;
+  bool radioOnWake = true;
+  uint32_t sleeps = 0;
+};
+
+// The simulated board. `hal` points at these members in the native build.
+struct NativeSim {
+  MockClock clock;
+  MockGpio gpio;
+  MockUart uart;
+  MockTempProbe probe;
+  MockFlash flash;
+  MockRtc rtc;
+  MockRadio radio;
+  MockHttpServer http;
+  MockWifi wifi;
+  MockSystem system;
+  MockHeap heap;
+  MockUltrasonic sensor;
+  MockUltrasonic moreSensors[2];   // further sensors of a multi-tank board
+};
+
+extern NativeSim sim;
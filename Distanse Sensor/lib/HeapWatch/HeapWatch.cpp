@@ -0,0 +1,55 @@
+#include "HeapWatch.h"
+#include <string.h>
+
+void HeapMarks::add(const HeapSample& s) {
+  if (s.freeBytes < minFree) minFree = s.freeBytes;
+  if (s.maxBlock < minMaxBlock) minMaxBlock = s.maxBlock;
+  if (s.fragmentation > maxFragmentation) maxFragmentation = s.fragmentation;
+}
+
+void HeapWatch::lowWater(uint32_t freeBytes) {
+  if (freeBytes < marks_.minFree) marks_.minFree = freeBytes;
+}
+
+void HeapWatch::tick(System& system) {
+  lowWater(system.heapLowWater());
+  ++ticks_;
+}
+
+const HeapSample& HeapWatch::sample(System& system) {
+  system.heapStats(last_.freeBytes, last_.maxBlock, last_.fragmentation);
+  marks_.add(last_);
+  ++samples_;
+  return last_;
+}
+
+void HeapWatch::beginRequest(System& system) {
+  lowWater(system.heapLowWater());   // the mark starts over here
+  requestFree_ = system.freeHeap();
+}
+
+void HeapWatch::endRequest(const char* path, System& system) {
+  uint32_t low = system.heapLowWater();
+  lowWater(low);
+  const HeapSample& s = sample(system);
+  HeapRoute* r = find(path);
+  if (!r) {
+    ++unlisted_;
+    return;
+  }
+  ++r->requests;
+  if (requestFree_ > low && requestFree_ - low > r->maxPeakBytes) r->maxPeakBytes = requestFree_ - low;
+  r->retainedBytes = (int32_t)(requestFree_ - s.freeBytes);
+  if (r->retainedBytes > r->maxRetainedBytes) r->maxRetainedBytes = r->retainedBytes;
+  r->after.add(s);
+}
+
+// The route's statistics, added on its first request; nullptr once the table is full
+HeapRoute* HeapWatch::find(const char* path) {
+  for (uint8_t i = 0; i < routeCount_; ++i) {
+    if (routes_[i].path == path || strcmp(routes_[i].path, path) == 0) return &routes_[i];
+  }
+  if (routeCount_ >= HEAP_ROUTES) return nullptr;
+  routes_[routeCount_].path = path;
+  return &routes_[routeCount_++];
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+/*
+   Heap telemetry: free heap, largest free block and fragmentation, and
+   their worst values since boot.
+
+   The web handlers build Strings on a heap of about 40 KB. A heap can
+   have plenty of memory free and still fail a malloc() when the free
+   memory is scattered in small runs, so three figures are kept: free
+   bytes, the largest block malloc() can still return, and fragmentation
+   (the core's metric: 0 % when all free memory is one run, near 100 %
+   when it is dust).
+
+   Free bytes are cheap, the allocator counts them, and built with
+   UMM_STATS_FULL (see platformio.ini) it also keeps a low-water mark:
+   tick() folds that into the marks on every loop() pass, so a dip that
+   was allocated and freed within one pass is not missed.
+   The largest block and fragmentation take a walk of the heap, so
+   sample() is called once a second and after every web request.
+
+   Around each request (the HTTP server's request hook) the watch notes
+   the free heap before, the low-water mark during and a sample after,
+   per route: the most heap one request took at once, what it left
+   allocated, and the worst heap it left behind.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+
+constexpr uint8_t HEAP_ROUTES = 24;   // routes with their own statistics; more are only counted
+
+struct HeapSample {
+  uint32_t freeBytes = 0;
+  uint32_t maxBlock = 0;         // largest allocation that would succeed
+  uint8_t fragmentation = 0;     // %
+};
+
+// The worst values seen
+struct HeapMarks {
+  uint32_t minFree = UINT32_MAX;
+  uint32_t minMaxBlock = UINT32_MAX;
+  uint8_t maxFragmentation = 0;
+
+  void add(const HeapSample& s);
+};
+
+struct HeapRoute {
+  const char* path = nullptr;    // as registered (a literal)
+  uint32_t requests = 0;
+  uint32_t maxPeakBytes = 0;     // most heap one request had allocated at once
+  int32_t retainedBytes = 0;     // left allocated by the last request (negative: it freed more)
+  int32_t maxRetainedBytes = 0;
+  HeapMarks after;               // the heap right after its requests
+};
+
+class HeapWatch {
+public:
+  // Every loop() pass: the allocator's low-water mark since the last call
+  void tick(System& system);
+  // Full sample (walks the heap), into the marks
+  const HeapSample& sample(System& system);
+
+  // Around a request: path is the route it was registered for
+  void beginRequest(System& system);
+  void endRequest(const char* path, System& system);
+
+  const HeapSample& last() const { return last_; }
+  const HeapMarks& marks() const { return marks_; }
+  uint32_t ticks() const { return ticks_; }
+  uint32_t samples() const { return samples_; }
+  uint8_t routeCount() const { return routeCount_; }
+  const HeapRoute& route(uint8_t i) const { return routes_[i]; }
+  uint32_t unlistedRequests() const { return unlisted_; }
+
+private:
+  HeapRoute* find(const char* path);
+  void lowWater(uint32_t freeBytes);
+
+  HeapSample last_;
+  HeapMarks marks_;
+  uint32_t ticks_ = 0;
+  uint32_t samples_ = 0;
+  uint32_t requestFree_ = 0;     // free heap when the current request began
+  HeapRoute routes_[HEAP_ROUTES];
+  uint8_t routeCount_ = 0;
+  uint32_t unlisted_ = 0;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+/*
+   In-RAM history of sensor readings.
+
+   Raw samples are packed into 6 bytes (16-bit time delta, distance and
+   level in 16-bit fixed point) inside a power-of-two ring, so ~1000
+   readings cost 6 KB. Every insert also updates 1-minute and 1-hour
+   min/max/avg rollups of the water level in O(1), so long trends survive
+   after the raw ring has wrapped.
+
+   Written and read from loop() context only, so no locking is needed.
+*/
+
+#include <stdint.h>
+
+// Fixed-point scales of the packed fields
+constexpr uint16_t HISTORY_DIST_SCALE = 10;     // 0.1 cm
+constexpr uint16_t HISTORY_LEVEL_SCALE = 100;   // 0.01 %
+constexpr uint16_t HISTORY_INVALID = 0xFFFF;    // distance of a failed reading
+
+// Fixed-capacity ring that overwrites its oldest entry; N must be a power of two
+template <typename T, uint16_t N>
+class Ring {
+  static_assert(N && (N & (N - 1)) == 0, "Ring capacity must be a power of two");
+
+public:
+  void push(const T& v) {
+    items_[head_] = v;
+    head_ = (head_ + 1) & (N - 1);
+    if (size_ < N) ++size_;
+  }
+
+  uint16_t size() const { return size_; }
+  static constexpr uint16_t capacity() { return N; }
+
+  // i = 0 is the oldest entry
+  const T& operator[](uint16_t i) const { return items_[(head_ - size_ + i) & (N - 1)]; }
+  const T& newest() const { return items_[(head_ - 1) & (N - 1)]; }
+  T& newest() { return items_[(head_ - 1) & (N - 1)]; }
+  void clear() { head_ = size_ = 0; }
+
+private:
+  T items_[N];
+  uint16_t head_ = 0;
+  uint16_t size_ = 0;
+};
+
+struct RawSample {
+  uint16_t dtSec;       // seconds since the previous sample (saturates)
+  uint16_t distance;    // cm * HISTORY_DIST_SCALE, HISTORY_INVALID if no echo
+  uint16_t level;       // % * HISTORY_LEVEL_SCALE
+};
+
+// Water level rollup over one minute or one hour
+struct Rollup {
+  uint32_t startSec;    // history clock at the bucket start
+  uint32_t sum;         // sum of level, HISTORY_LEVEL_SCALE units
+  uint16_t count;       // valid samples
+  uint16_t min;
+  uint16_t max;
+
+  uint16_t avg() const { return count ? (uint16_t)(sum / count) : 0; }
+};
+
+template <uint16_t RAW_N, uint16_t MINUTE_N, uint16_t HOUR_N>
+class History {
+public:
+  // distanceCm < 0 marks a failed reading (kept in raw, skipped by rollups)
+  void add(uint32_t nowMs, float distanceCm, float levelPercent) {
+    uint32_t now = advance(nowMs);
+
+    RawSample s;
+    uint32_t dt = raw_.size() ? now - lastSampleSec_ : 0;
+    s.dtSec = dt > 0xFFFF ? 0xFFFF : (uint16_t)dt;
+    s.distance = distanceCm < 0 ? HISTORY_INVALID : pack(distanceCm, HISTORY_DIST_SCALE);
+    s.level = pack(levelPercent, HISTORY_LEVEL_SCALE);
+    raw_.push(s);
+    lastSampleSec_ = now;
+
+    if (s.distance == HISTORY_INVALID) return;
+    roll(minutes_, now, 60, s.level);
+    roll(hours_, now, 3600, s.level);
+  }
+
+  // Seconds on the history clock (uptime, immune to millis() wrap)
+  uint32_t nowSec(uint32_t nowMs) const { return sec_ + (carryMs_ + (nowMs - lastMs_)) / 1000; }
+  uint32_t lastSampleSec() const { return lastSampleSec_; }
+
+  const Ring<RawSample, RAW_N>& raw() const { return raw_; }
+  const Ring<Rollup, MINUTE_N>& minutes() const { return minutes_; }
+  const Ring<Rollup, HOUR_N>& hours() const { return hours_; }
+
+  // Calls fn(timeSec, sample) for every raw sample, oldest first
+  template <typename Fn>
+  void forEachRaw(Fn fn) const {
+    // Oldest sample time = newest minus the sum of the later deltas
+    uint32_t t = lastSampleSec_;
+    for (uint16_t i = raw_.size(); i > 1; --i) t -= raw_[i - 1].dtSec;
+    for (uint16_t i = 0; i < raw_.size(); ++i) {
+      if (i) t += raw_[i].dtSec;
+      fn(t, raw_[i]);
+    }
+  }
+
+  void clear() {
+    raw_.clear();
+    minutes_.clear();
+    hours_.clear();
+  }
+
+private:
+  static uint16_t pack(float v, uint16_t scale) {
+    float f = v * scale + 0.5f;
+    if (f < 0) return 0;
+    if (f > 0xFFFE) return 0xFFFE;
+    return (uint16_t)f;
+  }
+
+  uint32_t advance(uint32_t nowMs) {
+    if (started_) carryMs_ += nowMs - lastMs_;
+    started_ = true;
+    lastMs_ = nowMs;
+    sec_ += carryMs_ / 1000;
+    carryMs_ %= 1000;
+    return sec_;
+  }
+
+  template <uint16_t N>
+  static void roll(Ring<Rollup, N>& ring, uint32_t now, uint32_t period, uint16_t level) {
+    uint32_t start = now - now % period;
+    if (!ring.size() || ring.newest().startSec != start) {
+      ring.push(Rollup{start, level, 1, level, level});
+      return;
+    }
+    Rollup& r = ring.newest();
+    r.sum += level;
+    ++r.count;
+    if (level < r.min) r.min = level;
+    if (level > r.max) r.max = level;
+  }
+
+  Ring<RawSample, RAW_N> raw_;
+  Ring<Rollup, MINUTE_N> minutes_;
+  Ring<Rollup, HOUR_N> hours_;
+
+  bool started_ = false;
+  uint32_t lastMs_ = 0;
+  uint32_t carryMs_ = 0;
+  uint32_t sec_ = 0;
+  uint32_t lastSampleSec_ = 0;
+};
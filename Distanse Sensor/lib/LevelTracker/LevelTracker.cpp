@@ -0,0 +1,141 @@
+#include "LevelTracker.h"
+#include <Arduino.h>
+
+namespace {
+
+constexpr size_t GAIN_STEPS = 65;          // λ = 2^((i - 32) / 2)
+constexpr int32_t Q16 = 65536;
+
+// log2 of a compile-time constant
+constexpr double log2Frac(double x, double bit, int i) {  // x in [1, 2)
+  return i == 30 ? 0.0 : x * x >= 2.0 ? bit + log2Frac(x * x / 2.0, bit / 2.0, i + 1)
+                                      : log2Frac(x * x, bit / 2.0, i + 1);
+}
+constexpr double log2Const(double x) {
+  return x < 1.0 ? log2Const(x * 2.0) - 1.0 : x >= 2.0 ? log2Const(x / 2.0) + 1.0 : log2Frac(x, 0.5, 0);
+}
+
+// Table position of λ for dt = 1 ms, Q8: i = 2·log2(λ) + 32, and λ ∝ dt²
+constexpr int32_t GAIN_POS_1MS_Q8 =
+    (int32_t)((2.0 * log2Const(TRACK_ACCEL_CM_MIN2 / TRACK_MEAS_NOISE_CM / 3.6e9) + 32.0) * 256.0 - 0.5);
+
+struct GainTable {
+  uint16_t alpha[GAIN_STEPS];  // Q15
+  uint16_t beta[GAIN_STEPS];   // Q15
+};
+
+constexpr uint16_t q15(double v) {
+  return v * 32768.0 + 0.5 > 65535.0 ? 65535 : (uint16_t)(v * 32768.0 + 0.5);
+}
+
+constexpr GainTable makeGains() {
+  GainTable t = {};
+  double lambda = 1.0 / 65536.0;
+  for (size_t i = 0; i < GAIN_STEPS; ++i, lambda *= 1.4142135623730951) {
+    t.alpha[i] = q15(trackAlpha(lambda) < 32767.0 / 32768.0 ? trackAlpha(lambda) : 32767.0 / 32768.0);
+    t.beta[i] = q15(trackBeta(lambda) > 0.0 ? trackBeta(lambda) : 0.0);
+  }
+  return t;
+}
+
+const GainTable GAINS PROGMEM = makeGains();
+
+constexpr int32_t OUTLIER_Q16 = (int32_t)(TRACK_OUTLIER_CM * Q16);
+constexpr int32_t MAX_RATE_Q16 = (int32_t)(TRACK_MAX_RATE_CM_MIN * Q16);
+constexpr uint16_t NOISE_Q8 = (uint16_t)(TRACK_MEAS_NOISE_CM * 256);
+
+uint16_t lerp(uint16_t a, uint16_t b, uint32_t frac) {
+  return (uint16_t)(a + (((int32_t)b - a) * (int32_t)frac + 128) / 256);
+}
+
+} // namespace
+
+void LevelTracker::gains(uint32_t dtMs, uint16_t& alphaQ15, uint16_t& betaQ15, uint8_t boost) {
+  if (dtMs == 0) dtMs = 1;
+  // log2(dt) in Q8: the top bit plus the next 8, with log2(1 + m) ≈ m + 0.347·m·(1 - m)
+  int32_t top = 31 - __builtin_clz(dtMs);
+  uint32_t mantissa = top >= 8 ? (dtMs >> (top - 8)) & 0xFF : (dtMs << (8 - top)) & 0xFF;
+  mantissa += (mantissa * (256 - mantissa) * 89) >> 16;
+  int32_t pos = GAIN_POS_1MS_Q8 + 4 * ((top << 8) + (int32_t)mantissa) + (boost << 8);
+  if (pos < 0) pos = 0;
+  if (pos > (int32_t)(GAIN_STEPS - 1) * 256) pos = (GAIN_STEPS - 1) * 256;
+
+  size_t i = pos >> 8;
+  uint32_t frac = pos & 0xFF;
+  size_t n = frac ? 2 : 1;   // no entry past the end
+  uint16_t a[2] = {}, b[2] = {};
+  memcpy_P(a, &GAINS.alpha[i], n * sizeof(a[0]));
+  memcpy_P(b, &GAINS.beta[i], n * sizeof(b[0]));
+  alphaQ15 = frac ? lerp(a[0], a[1], frac) : a[0];
+  betaQ15 = frac ? lerp(b[0], b[1], frac) : b[0];
+}
+
+void LevelTracker::restart(uint32_t nowMs, int32_t levelQ16) {
+  level_ = levelQ16;
+  rate_ = 0;
+  lastMs_ = nowMs;
+  residual_ = 0;
+  samples_ = 1;
+  strays_ = 0;
+  outlierRun_ = 0;
+}
+
+void LevelTracker::update(uint32_t nowMs, float levelCm) {
+  int32_t z = (int32_t)(levelCm * Q16);
+  uint32_t dt = nowMs - lastMs_;
+  if (!valid() || dt > TRACK_MAX_GAP_MS) {
+    restart(nowMs, z);
+    return;
+  }
+  if (dt == 0) dt = 1;
+
+  int32_t predicted = level_ + (int32_t)((int64_t)rate_ * dt / 60000);
+  int32_t r = z - predicted;
+  uint32_t absR = r < 0 ? -(uint32_t)r : (uint32_t)r;
+
+  // Farther than noise plus the fastest fill/drain could have moved it
+  if (absR > OUTLIER_Q16 + (uint64_t)MAX_RATE_Q16 * dt / 60000) {
+    ++outliers_;
+    if (strays_ < 255) ++strays_;
+    if (++outlierRun_ >= TRACK_RESTART_OUTLIERS) restart(nowMs, z);
+    return;
+  }
+
+  // Readings keep missing the track (a pump or tap switched): raise σa,
+  // λ ×2 per doubling of the mean residual past twice the noise
+  uint8_t boost = 0;
+  for (uint32_t m = residual_; m > 2u * NOISE_Q8 && boost < TRACK_MAX_BOOST; m >>= 1) boost += 2;
+
+  uint16_t alpha, beta;
+  gains(dt, alpha, beta, boost);
+  level_ = predicted + (int32_t)(((int64_t)r * alpha) >> 15);
+  rate_ += (int32_t)(((int64_t)r * beta * 60000 / (int64_t)dt) >> 15);
+  lastMs_ = nowMs;
+
+  uint32_t absQ8 = absR >> 8;
+  if (absQ8 > 0xFFFF) absQ8 = 0xFFFF;
+  residual_ = (uint16_t)(residual_ + ((int32_t)absQ8 - residual_) / 8);
+  if (samples_ < 255) ++samples_;
+  strays_ = 0;
+  outlierRun_ = 0;
+}
+
+float LevelTracker::levelCm(uint32_t nowMs) const {
+  uint32_t dt = nowMs - lastMs_;
+  if (dt > TRACK_MAX_GAP_MS) dt = TRACK_MAX_GAP_MS;
+  return (level_ + (int32_t)((int64_t)rate_ * dt / 60000)) * (1.0f / Q16);
+}
+
+float LevelTracker::toleranceCm(uint32_t nowMs) const {
+  uint32_t dt = nowMs - lastMs_;
+  if (dt > TRACK_MAX_GAP_MS) dt = TRACK_MAX_GAP_MS;
+  return TRACK_OUTLIER_CM + TRACK_MAX_RATE_CM_MIN * dt / 60000.0f;
+}
+
+uint8_t LevelTracker::confidence() const {
+  if (!samples_) return 0;
+  uint32_t c = 100u * (samples_ < TRACK_WARMUP ? samples_ : TRACK_WARMUP) / TRACK_WARMUP;
+  // Full while readings stay within the reading noise of the track
+  if (residual_ > NOISE_Q8) c = c * NOISE_Q8 / residual_;
+  return (uint8_t)(c >> (strays_ < 7 ? strays_ : 7));
+}
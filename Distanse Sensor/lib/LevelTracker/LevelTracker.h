@@ -0,0 +1,90 @@
+#pragma once
+
+/*
+   Alpha-beta tracker for the water level: a smoothed level (cm above the
+   barrel bottom) and its rate of change (cm/min) from noisy readings.
+
+     predict   x += v·T
+     correct   r = z - x,  x += α·r,  v += β·r / T
+
+   α and β are the steady-state Kalman gains of a constant-velocity model
+   with white-noise acceleration. They depend only on the tracking index
+
+     λ = σa·T² / σm
+
+   (σa: how fast the fill/drain rate changes, σm: reading noise). A table
+   over λ = 2^-16 .. 2^16 in half-octave steps is computed at compile time
+   and kept in flash. Each update interpolates it for the actual time since
+   the last reading. Close readings are averaged over many samples, sparse
+   ones (battery mode) are followed almost directly. While the readings
+   keep missing the track by more than twice the noise (a pump started or
+   stopped) λ is raised, so the rate catches up in a few readings.
+
+   The state is fixed point (Q16 cm, Q16 cm/min) and plain data, so battery
+   mode can keep it in RTC memory. A missing reading coasts on the
+   prediction. A reading farther from the prediction than the level could
+   have moved is an outlier; TRACK_RESTART_OUTLIERS in a row restart the
+   track there (the barrel was emptied or topped up by hand).
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+constexpr float TRACK_MEAS_NOISE_CM = 0.5f;    // σm, after the burst filter
+constexpr float TRACK_ACCEL_CM_MIN2 = 2.0f;    // σa: rate changes per minute (a pump or tap switching)
+constexpr float TRACK_OUTLIER_CM = 5.0f;       // off the prediction by more than this ...
+constexpr float TRACK_MAX_RATE_CM_MIN = 20.0f; // ... plus the fastest plausible fill/drain over T
+constexpr uint8_t TRACK_RESTART_OUTLIERS = 3;
+constexpr uint8_t TRACK_MAX_BOOST = 8;         // half-octaves of λ while readings miss the track
+constexpr uint8_t TRACK_WARMUP = 8;            // readings until full confidence
+constexpr uint32_t TRACK_MAX_GAP_MS = 6UL * 3600 * 1000;  // a longer gap starts a new track
+
+// Kalata's steady-state gains for tracking index λ (double, for the table and tests)
+constexpr double trackRoot(double x, double r = 1.0, int i = 0) {
+  return i == 40 ? r : trackRoot(x, 0.5 * (r + x / r), i + 1);
+}
+constexpr double trackAlpha(double lambda) {
+  return 1.0 - ((4.0 + lambda - trackRoot(8.0 * lambda + lambda * lambda)) / 4.0) *
+               ((4.0 + lambda - trackRoot(8.0 * lambda + lambda * lambda)) / 4.0);
+}
+constexpr double trackBeta(double lambda) {
+  return 2.0 * (2.0 - trackAlpha(lambda)) - 4.0 * trackRoot(1.0 - trackAlpha(lambda));
+}
+
+class LevelTracker {
+public:
+  // New reading at nowMs: level in cm above the bottom (not clamped)
+  void update(uint32_t nowMs, float levelCm);
+  // Reading without an echo
+  void miss() { if (strays_ < 255) ++strays_; }
+  void reset() { *this = LevelTracker(); }
+
+  bool valid() const { return samples_ > 0; }
+  // Level predicted for nowMs (coasts over misses)
+  float levelCm(uint32_t nowMs) const;
+  float rateCmPerMin() const { return rate_ * (1.0f / 65536); }
+  // How far a reading at nowMs may be from levelCm(nowMs) without being an outlier
+  float toleranceCm(uint32_t nowMs) const;
+  // 0..100 %: ramps up over TRACK_WARMUP readings, drops when readings stray
+  // from the track and halves with each miss or outlier in a row
+  uint8_t confidence() const;
+  // Mean distance of the readings from the track, cm
+  float scatterCm() const { return residual_ * (1.0f / 256); }
+  uint32_t outliers() const { return outliers_; }
+
+  // Gains for an interval, Q15, with λ raised by boost half-octaves
+  // (exposed for the host checks)
+  static void gains(uint32_t dtMs, uint16_t& alphaQ15, uint16_t& betaQ15, uint8_t boost = 0);
+
+private:
+  void restart(uint32_t nowMs, int32_t levelQ16);
+
+  int32_t level_ = 0;       // Q16 cm
+  int32_t rate_ = 0;        // Q16 cm/min
+  uint32_t lastMs_ = 0;     // time of the state
+  uint32_t outliers_ = 0;
+  uint16_t residual_ = 0;   // mean |reading - prediction|, Q8 cm
+  uint8_t samples_ = 0;     // readings in the track (saturates)
+  uint8_t strays_ = 0;      // misses and outliers in a row
+  uint8_t outlierRun_ = 0;
+};
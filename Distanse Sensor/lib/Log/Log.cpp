@@ -0,0 +1,110 @@
+#include "Log.h"
+#include <stdio.h>
+
+LogRing logRing;
+
+void LogRing::write(uint8_t level, uint8_t id, uint32_t ms, const LogWord* args, uint8_t argc) {
+  if (argc > LOG_MAX_ARGS) argc = LOG_MAX_ARGS;
+  uint8_t rec[LOG_MAX_RECORD];
+  rec[0] = (uint8_t)(level << 4 | argc);
+  rec[1] = id;
+  memcpy(rec + 2, &ms, sizeof(ms));
+  memcpy(rec + LOG_RECORD_HEADER, args, argc * sizeof(LogWord));
+  size_t n = LOG_RECORD_HEADER + argc * sizeof(LogWord);
+
+  // Make room first: a reader that sees the new tail stops trusting what it copied
+  uint32_t tail = tail_;
+  while (head_ + n - tail > LOG_RING_SIZE) {
+    tail += recordSize(tail);
+    ++overwritten_;
+  }
+  tail_ = tail;
+  for (size_t i = 0; i < n; ++i) buf_[(head_ + i) & (LOG_RING_SIZE - 1)] = rec[i];
+  head_ = head_ + n;
+  ++written_;
+}
+
+size_t LogRing::recordSize(uint32_t at) const {
+  return LOG_RECORD_HEADER + (buf_[at & (LOG_RING_SIZE - 1)] & 0x0F) * sizeof(LogWord);
+}
+
+void LogRing::copyOut(uint32_t at, uint8_t* dst, size_t n) const {
+  for (size_t i = 0; i < n; ++i) dst[i] = buf_[(at + i) & (LOG_RING_SIZE - 1)];
+}
+
+bool LogRing::read(uint32_t& cursor, LogRecord& out) const {
+  for (;;) {
+    if ((int32_t)(cursor - tail_) < 0) cursor = tail_;   // fell behind
+    if (cursor == head_) return false;
+    uint8_t rec[LOG_MAX_RECORD];
+    size_t n = recordSize(cursor);
+    copyOut(cursor, rec, n < LOG_MAX_RECORD ? n : LOG_MAX_RECORD);
+    if ((int32_t)(cursor - tail_) < 0) continue;   // overwritten while copying
+    out.level = rec[0] >> 4;
+    out.argc = (rec[0] & 0x0F) < LOG_MAX_ARGS ? rec[0] & 0x0F : LOG_MAX_ARGS;
+    out.id = rec[1];
+    memcpy(&out.ms, rec + 2, sizeof(out.ms));
+    memcpy(out.args, rec + LOG_RECORD_HEADER, out.argc * sizeof(LogWord));
+    cursor += n;
+    return true;
+  }
+}
+
+char logLevelChar(uint8_t level) {
+  return level < 5 ? "-EWID"[level] : '?';
+}
+
+size_t logFormat(char* out, size_t size, const char* fmt, const LogRecord& r) {
+  if (!size) return 0;
+  size_t len = 0;
+  uint8_t arg = 0;
+  auto room = [&] { return len < size ? size - len : 0; };
+  auto advance = [&](int n) { if (n > 0) len = len + n < size ? len + n : size - 1; };
+
+  while (*fmt && len + 1 < size) {
+    if (*fmt != '%') {
+      out[len++] = *fmt++;
+      continue;
+    }
+    // One conversion: flags, width, precision, then the letter; length modifiers dropped
+    char spec[16] = "%";
+    size_t k = 1;
+    ++fmt;
+    while (*fmt && strchr("-+ #0123456789.", *fmt) && k < sizeof(spec) - 3) spec[k++] = *fmt++;
+    while (*fmt && strchr("hlLzjt", *fmt)) ++fmt;
+    char conv = *fmt ? *fmt++ : '%';
+    spec[k++] = conv;
+    spec[k] = '\0';
+    if (conv == '%') {
+      out[len++] = '%';
+      continue;
+    }
+    if (arg >= r.argc) {
+      advance(snprintf(out + len, room(), "?"));
+      continue;
+    }
+    LogWord w = r.args[arg++];
+    switch (conv) {
+      case 'd': case 'i':
+        advance(snprintf(out + len, room(), spec, (int)(int32_t)(uint32_t)w));
+        break;
+      case 'u': case 'x': case 'X': case 'o': case 'c':
+        advance(snprintf(out + len, room(), spec, (unsigned)(uint32_t)w));
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+        uint32_t u = (uint32_t)w;
+        float v;
+        memcpy(&v, &u, sizeof(v));
+        advance(snprintf(out + len, room(), spec, (double)v));
+        break;
+      }
+      case 's':
+        advance(snprintf(out + len, room(), spec, w ? (const char*)w : "(null)"));
+        break;
+      default:
+        advance(snprintf(out + len, room(), "?"));
+    }
+  }
+  out[len] = '\0';
+  return len;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+/*
+   Binary in-RAM log for the hot paths.
+
+   Serial.printf at 74880 baud blocks once the 128-byte UART FIFO is full
+   (about 0.13 ms per character), so a few lines per reading cost loop()
+   milliseconds. LOG_INFO/LOG_DEBUG store a record instead: level, message
+   ID, timestamp and the raw argument words, a few bytes and no formatting.
+   The text is only made when loop() is idle (drained to Serial) or when
+   /logs is fetched, from a table of printf formats indexed by the ID.
+
+   Levels are filtered at compile time: a statement above LOG_LEVEL (build
+   flag, default LOG_LEVEL_INFO) becomes dead code that the compiler drops;
+   its arguments are still type-checked but never evaluated.
+
+   The ring overwrites its oldest records. Each reader keeps its own cursor,
+   a byte position that only grows, so the Serial drain and /logs see the
+   same records; a reader that fell behind skips to the oldest one left.
+   The one writer publishes a record by moving head after it is complete,
+   and a reader checks after copying one that tail has not passed it, so
+   neither side locks. Logging is for loop() and SDK callback context, not
+   for interrupts.
+
+   Arguments are integers, enums, floats (stored as float) and %s strings.
+   A string is stored as its pointer, so it must outlive the ring: literals
+   and static name tables only.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+#include "Hal.h"
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+using LogWord = uintptr_t;   // one argument; a pointer fits (%s)
+
+constexpr uint8_t LOG_MAX_ARGS = 6;
+constexpr size_t LOG_RING_SIZE = 1024;   // bytes; a power of two
+constexpr size_t LOG_RECORD_HEADER = 6;  // level/argc, ID, ms
+constexpr size_t LOG_MAX_RECORD = LOG_RECORD_HEADER + LOG_MAX_ARGS * sizeof(LogWord);
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two");
+
+struct LogRecord {
+  uint32_t ms;
+  uint8_t level;
+  uint8_t id;
+  uint8_t argc;
+  LogWord args[LOG_MAX_ARGS];
+};
+
+class LogRing {
+public:
+  void write(uint8_t level, uint8_t id, uint32_t ms, const LogWord* args, uint8_t argc);
+
+  // The record at cursor (or the oldest one, if it was overwritten) and move
+  // cursor past it; false once the reader has caught up
+  bool read(uint32_t& cursor, LogRecord& out) const;
+
+  uint32_t head() const { return head_; }   // cursor of the next record written
+  uint32_t tail() const { return tail_; }   // cursor of the oldest record kept
+  uint32_t written() const { return written_; }
+  uint32_t overwritten() const { return overwritten_; }
+
+private:
+  size_t recordSize(uint32_t at) const;
+  void copyOut(uint32_t at, uint8_t* dst, size_t n) const;
+
+  uint8_t buf_[LOG_RING_SIZE];
+  volatile uint32_t head_ = 0;
+  volatile uint32_t tail_ = 0;
+  uint32_t written_ = 0;
+  uint32_t overwritten_ = 0;
+};
+
+extern LogRing logRing;
+
+// Text of a record: fmt is its message's printf format, whose conversions take
+// the stored words in order (length modifiers are ignored; 32-bit values). Returns
+// the length written, truncated to size - 1.
+size_t logFormat(char* out, size_t size, const char* fmt, const LogRecord& r);
+
+// Single-letter level name: E, W, I, D
+char logLevelChar(uint8_t level);
+
+inline LogWord logWord(float v) {
+  uint32_t u;
+  memcpy(&u, &v, sizeof(u));
+  return u;
+}
+inline LogWord logWord(double v) { return logWord((float)v); }
+inline LogWord logWord(const char* s) { return (LogWord)s; }
+template <typename T>
+inline LogWord logWord(T v) {
+  static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Log arguments are numbers or static strings");
+  return (LogWord)(intptr_t)v;
+}
+
+template <typename... Args>
+inline void logWrite(uint8_t level, uint8_t id, Args... args) {
+  static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments");
+  const LogWord words[sizeof...(Args) + 1] = {logWord(args)...};
+  logRing.write(level, id, hal.clock->millis(), words, sizeof...(Args));
+}
+
+// A disabled statement: type-checked, never evaluated, no code
+#define LOG_OFF(level, id, ...) \
+  do {                          \
+    if (false) logWrite(level, (uint8_t)(id), ##__VA_ARGS__); \
+  } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(id, ...) logWrite(LOG_LEVEL_ERROR, (uint8_t)(id), ##__VA_ARGS__)
+#else
+#define LOG_ERROR(id, ...) LOG_OFF(LOG_LEVEL_ERROR, id, ##__VA_ARGS__)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(id, ...) logWrite(LOG_LEVEL_WARN, (uint8_t)(id), ##__VA_ARGS__)
+#else
+#define LOG_WARN(id, ...) LOG_OFF(LOG_LEVEL_WARN, id, ##__VA_ARGS__)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(id, ...) logWrite(LOG_LEVEL_INFO, (uint8_t)(id), ##__VA_ARGS__)
+#else
+#define LOG_INFO(id, ...) LOG_OFF(LOG_LEVEL_INFO, id, ##__VA_ARGS__)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(id, ...) logWrite(LOG_LEVEL_DEBUG, (uint8_t)(id), ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(id, ...) LOG_OFF(LOG_LEVEL_DEBUG, id, ##__VA_ARGS__)
+#endif
@@ -0,0 +1,45 @@
+#include "LoopWatch.h"
+#include <string.h>
+
+void StallLog::add(const StallRecord& r) {
+  if (next >= STALL_RECORDS) next = 0;
+  records[next] = r;
+  next = (uint8_t)((next + 1) % STALL_RECORDS);
+  if (count < STALL_RECORDS) ++count;
+  ++total;
+}
+
+const StallRecord& StallLog::newest(uint8_t i) const {
+  return records[(next + STALL_RECORDS - 1 - i) % STALL_RECORDS];
+}
+
+void LoopWatch::beginIteration(uint32_t nowUs) {
+  startUs_ = nowUs;
+  blamed_ = nullptr;
+  blamedUs_ = 0;
+}
+
+void LoopWatch::blame(const char* name, uint32_t us) {
+  if (blamed_ && us <= blamedUs_) return;
+  blamed_ = name;
+  blamedUs_ = us;
+}
+
+bool LoopWatch::endIteration(uint32_t nowUs, uint32_t nowMs, StallLog& log) {
+  uint32_t us = nowUs - startUs_;
+  ++iterations_;
+  if (us > maxUs_) maxUs_ = us;
+  uint8_t b = us ? 31 - __builtin_clz(us) : 0;
+  ++buckets_[b < LOOP_BUCKETS ? b : LOOP_BUCKETS - 1];
+  if (us < thresholdUs_) return false;
+
+  ++stalls_;
+  StallRecord r = {};
+  r.atMs = nowMs;
+  r.loopUs = us;
+  r.spanUs = blamedUs_;
+  r.boot = log.boots;
+  strncpy(r.name, blamed_ ? blamed_ : "loop", STALL_NAME - 1);
+  log.add(r);
+  return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/*
+   Loop-latency watchdog: how long loop() iterations take, and what made
+   the slow ones slow.
+
+   Each iteration's length goes into a log2 histogram (bucket i: 2^i to
+   2^(i+1) - 1 µs, the last one everything longer). During the iteration
+   the caller blames its parts: the web request it served, the slowest
+   timer task. An iteration that reaches the threshold is a stall; it is
+   recorded with the part that took longest, the time and the boot it
+   happened in.
+
+   The records are a StallLog, a plain struct the firmware keeps in RTC
+   memory, so they survive a reset, a watchdog reset among them. A stall
+   is only recorded once its iteration ends: one that the watchdog cuts
+   short is not, but the stalls leading up to it are.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+constexpr uint8_t LOOP_BUCKETS = 20;   // up to 2^20 µs (1 s) apart
+constexpr uint8_t STALL_RECORDS = 8;
+constexpr uint8_t STALL_NAME = 16;     // including the terminating zero
+
+struct StallRecord {
+  uint32_t atMs;                // millis() when the iteration ended
+  uint32_t loopUs;              // the whole iteration
+  uint32_t spanUs;              // the part that took longest
+  uint16_t boot;                // StallLog::boots when it happened
+  uint16_t reserved;
+  char name[STALL_NAME];        // what that part was: a web request path or a task name
+};
+
+// Newest STALL_RECORDS stalls, oldest overwritten
+struct StallLog {
+  uint32_t total;               // stalls recorded since the log was created
+  uint16_t boots;               // boots since then (the first is 1)
+  uint8_t next;                 // where the next record goes
+  uint8_t count;
+  StallRecord records[STALL_RECORDS];
+
+  void add(const StallRecord& r);
+  // The i-th newest record (0: the last one), i < count
+  const StallRecord& newest(uint8_t i) const;
+};
+
+class LoopWatch {
+public:
+  void setThreshold(uint32_t us) { thresholdUs_ = us; }
+  uint32_t thresholdUs() const { return thresholdUs_; }
+
+  void beginIteration(uint32_t nowUs);
+
+  // A part of this iteration took us; name must stay valid until endIteration()
+  void blame(const char* name, uint32_t us);
+
+  // Record the iteration; a stall also goes into log. True if it was one.
+  bool endIteration(uint32_t nowUs, uint32_t nowMs, StallLog& log);
+
+  uint32_t iterations() const { return iterations_; }
+  uint32_t stalls() const { return stalls_; }
+  uint32_t maxUs() const { return maxUs_; }
+  uint32_t bucket(uint8_t i) const { return buckets_[i]; }
+
+private:
+  uint32_t thresholdUs_ = 100000;
+  uint32_t startUs_ = 0;
+  const char* blamed_ = nullptr;
+  uint32_t blamedUs_ = 0;
+
+  uint32_t iterations_ = 0;
+  uint32_t stalls_ = 0;
+  uint32_t maxUs_ = 0;
+  uint32_t buckets_[LOOP_BUCKETS] = {};
+};
@@ -0,0 +1,117 @@
+#include "Outbox.h"
+
+void Outbox::begin(uint32_t backoffMinMs, uint32_t backoffMaxMs, uint32_t ackTimeoutMs, uint32_t seed) {
+  backoffMinMs_ = backoffMinMs;
+  backoffMaxMs_ = backoffMaxMs;
+  ackTimeoutMs_ = ackTimeoutMs;
+  rng_ = seed ? seed : 1;
+  head_ = count_ = 0;
+  inFlight_ = false;
+  stats_ = OutboxStats();
+}
+
+bool Outbox::push(uint16_t seq, const uint8_t* frame, size_t len, uint32_t nowMs) {
+  if (len > WIRE_MAX_FRAME) return false;
+  for (uint8_t i = 0; i < count_; ++i) {
+    if (at(i).seq == seq) {
+      ++stats_.duplicates;
+      return false;
+    }
+  }
+
+  if (count_ == OUTBOX_CAPACITY && !(policy_ == OutboxPolicy::Coalesce && coalesce())) {
+    // Drop the oldest frame that is not on the air
+    remove(inFlight_ ? 1 : 0);
+    ++stats_.dropped;
+  }
+
+  Entry& e = at(count_++);
+  e.seq = seq;
+  e.attempts = 0;
+  e.len = (uint8_t)len;
+  e.dueMs = nowMs;
+  memcpy(e.data, frame, len);
+  ++stats_.queued;
+  return true;
+}
+
+void Outbox::onResult(bool ok, uint32_t nowMs) {
+  if (!inFlight_) return;   // late callback after an ack timeout
+  inFlight_ = false;
+  if (ok) {
+    ++stats_.acked;
+    remove(0);
+  } else {
+    retryLater(at(0), nowMs);
+  }
+}
+
+bool Outbox::nextDue(uint32_t& atMs) const {
+  if (inFlight_) {
+    atMs = sentMs_ + ackTimeoutMs_;
+    return true;
+  }
+  if (count_ == 0) return false;
+  atMs = entries_[head_].dueMs;
+  return true;
+}
+
+void Outbox::remove(uint8_t i) {
+  if (i == 0) {
+    head_ = (head_ + 1) % OUTBOX_CAPACITY;
+  } else {
+    for (; i + 1 < count_; ++i) at(i) = at(i + 1);
+  }
+  --count_;
+}
+
+// Merge the oldest pair of adjacent frames (not on the air) whose readings fit into
+// one frame. The result keeps the newer sequence number and header and is flagged
+// WIRE_FLAG_COALESCED, so the receiver knows the skipped sequence numbers were merged.
+bool Outbox::coalesce() {
+  for (uint8_t i = inFlight_ ? 1 : 0; i + 1 < count_; ++i) {
+    Entry& older = at(i);
+    Entry& newer = at(i + 1);
+    if (older.len + newer.len - WIRE_HEADER_SIZE > WIRE_MAX_FRAME) continue;
+
+    WireFrame a, b;
+    if (decodeFrame(older.data, older.len, a) != WireResult::Ok ||
+        decodeFrame(newer.data, newer.len, b) != WireResult::Ok) continue;
+
+    // Older readings first; their ages move to the newer frame's time base
+    uint32_t shift = b.header.uptimeSec - a.header.uptimeSec;
+    WireFrame merged;
+    merged.header = b.header;
+    merged.header.flags |= WIRE_FLAG_COALESCED | (a.header.flags & WIRE_FLAG_BOOT);
+    merged.header.count = a.header.count + b.header.count;
+    for (uint8_t k = 0; k < a.header.count; ++k) {
+      merged.samples[k] = a.samples[k];
+      uint32_t age = a.samples[k].ageSec + shift;
+      merged.samples[k].ageSec = age > 0xFFFF ? 0xFFFF : (uint16_t)age;
+    }
+    memcpy(merged.samples + a.header.count, b.samples, b.header.count * sizeof(WireSample));
+
+    newer.len = (uint8_t)encodeFrame(merged, newer.data, sizeof(newer.data));
+    newer.attempts = older.attempts;
+    newer.dueMs = older.dueMs;
+    remove(i);
+    ++stats_.coalesced;
+    return true;
+  }
+  return false;
+}
+
+void Outbox::retryLater(Entry& e, uint32_t nowMs) {
+  uint8_t shift = e.attempts > 16 ? 15 : (e.attempts ? e.attempts - 1 : 0);
+  uint32_t delay = backoffMinMs_ << shift;
+  if (delay > backoffMaxMs_ || delay < backoffMinMs_) delay = backoffMaxMs_;
+  e.dueMs = nowMs + delay / 2 + random() % (delay / 2 + 1);
+}
+
+// xorshift32: cheap jitter, seeded per device so senders don't retry in lockstep
+uint32_t Outbox::random() {
+  rng_ ^= rng_ << 13;
+  rng_ ^= rng_ >> 17;
+  rng_ ^= rng_ << 5;
+  return rng_;
+}
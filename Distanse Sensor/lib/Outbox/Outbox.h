@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+   Bounded outbox of ESP-NOW frames waiting for delivery.
+
+   Frames are sent oldest first, one at a time, because the ESP-NOW send
+   callback only reports a status and not which frame it belongs to. A
+   failed or unacknowledged frame is retried with exponential backoff
+   and jitter (half the delay fixed, half random). Frames stay queued
+   through an outage until the queue is full. Then the policy decides:
+   drop the oldest frame, or coalesce two adjacent frames into one
+   (lib/WireProtocol) so no reading is lost until every frame is full.
+
+   Used from loop() and the send callback, which do not preempt each
+   other on the ESP8266, so no locking is needed.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "WireProtocol.h"
+
+constexpr uint8_t OUTBOX_CAPACITY = 8;
+static_assert(WIRE_MAX_FRAME <= 0xFF, "Outbox stores frame lengths in one byte");
+
+enum class OutboxPolicy : uint8_t {
+  DropOldest = 0,
+  Coalesce = 1    // merge frames, drop only when nothing fits together
+};
+
+struct OutboxStats {
+  uint32_t queued = 0;      // frames accepted
+  uint32_t sent = 0;        // transmissions, including retries
+  uint32_t acked = 0;
+  uint32_t retried = 0;     // transmissions of a frame that failed before
+  uint32_t dropped = 0;     // frames discarded because the queue was full
+  uint32_t coalesced = 0;   // frames merged into a neighbour
+  uint32_t duplicates = 0;  // frames rejected because their sequence number was queued already
+};
+
+class Outbox {
+public:
+  void begin(uint32_t backoffMinMs, uint32_t backoffMaxMs, uint32_t ackTimeoutMs, uint32_t seed);
+  void setPolicy(OutboxPolicy policy) { policy_ = policy; }
+
+  // Queue a frame (applying the policy if full); false if rejected as a duplicate
+  bool push(uint16_t seq, const uint8_t* frame, size_t len, uint32_t nowMs);
+
+  // Send the oldest frame if it is due and nothing is on the air.
+  // send(data, len, seq, attempt) returns 0 on success, like Radio::send().
+  template <typename SendFn>
+  void service(uint32_t nowMs, SendFn send);
+
+  // Result of the frame on the air (ESP-NOW send callback)
+  void onResult(bool ok, uint32_t nowMs);
+
+  // When service() next has something to do: the ack timeout of the frame on
+  // the air, or the oldest frame's send time; false with nothing queued
+  bool nextDue(uint32_t& atMs) const;
+
+  uint8_t size() const { return count_; }
+  bool inFlight() const { return inFlight_; }
+  const OutboxStats& stats() const { return stats_; }
+
+private:
+  struct Entry {
+    uint16_t seq;
+    uint8_t attempts;
+    uint8_t len;
+    uint32_t dueMs;
+    uint8_t data[WIRE_MAX_FRAME];
+  };
+
+  Entry& at(uint8_t i) { return entries_[(head_ + i) % OUTBOX_CAPACITY]; }
+  void remove(uint8_t i);
+  bool coalesce();
+  void retryLater(Entry& e, uint32_t nowMs);
+  uint32_t random();
+
+  Entry entries_[OUTBOX_CAPACITY];
+  uint8_t head_ = 0;
+  uint8_t count_ = 0;
+  bool inFlight_ = false;
+  uint32_t sentMs_ = 0;
+
+  OutboxPolicy policy_ = OutboxPolicy::Coalesce;
+  uint32_t backoffMinMs_ = 250;
+  uint32_t backoffMaxMs_ = 30000;
+  uint32_t ackTimeoutMs_ = 500;
+  uint32_t rng_ = 1;
+  OutboxStats stats_;
+};
+
+template <typename SendFn>
+void Outbox::service(uint32_t nowMs, SendFn send) {
+  // No callback in time counts as a failure
+  if (inFlight_ && nowMs - sentMs_ >= ackTimeoutMs_) onResult(false, nowMs);
+  if (inFlight_ || count_ == 0) return;
+
+  Entry& e = at(0);
+  if ((int32_t)(nowMs - e.dueMs) < 0) return;
+
+  if (e.attempts) ++stats_.retried;
+  if (e.attempts < 0xFF) ++e.attempts;
+  ++stats_.sent;
+  if (send(e.data, (size_t)e.len, e.seq, e.attempts) == 0) {
+    inFlight_ = true;
+    sentMs_ = nowMs;
+  } else {
+    retryLater(e, nowMs);
+  }
+}
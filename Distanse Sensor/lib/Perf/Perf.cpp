@@ -0,0 +1,69 @@
+#include "Perf.h"
+
+namespace {
+
+PerfSection* sections = nullptr;
+PerfSection** sectionsEnd = &sections;
+uint32_t counterMhz = 0;   // 0: the CPU clock's
+
+uint32_t cpuCycles() {
+  return hal.clock->cycleCount();
+}
+
+}  // namespace
+
+uint32_t (*perfCycles)() = cpuCycles;
+
+PerfSection::PerfSection(const char* name) : name_(name), next_(nullptr) {
+  *sectionsEnd = this;
+  sectionsEnd = &next_;
+}
+
+void PerfSection::record(uint32_t cycles) {
+  ++count_;
+  total_ += cycles;
+  if (cycles < min_) min_ = cycles;
+  if (cycles > max_) max_ = cycles;
+  uint8_t b = cycles ? 31 - __builtin_clz(cycles) : 0;
+  ++buckets_[b < PERF_BUCKETS ? b : PERF_BUCKETS - 1];
+}
+
+void PerfSection::reset() {
+  count_ = 0;
+  min_ = UINT32_MAX;
+  max_ = 0;
+  total_ = 0;
+  for (uint32_t& b : buckets_) b = 0;
+}
+
+uint32_t PerfSection::percentile(float fraction) const {
+  if (!count_) return 0;
+  uint32_t need = (uint32_t)(fraction * count_ + 0.5f);
+  if (need < 1) need = 1;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < PERF_BUCKETS - 1; ++i) {
+    seen += buckets_[i];
+    if (seen >= need) {
+      uint32_t edge = (2u << i) - 1;
+      return edge < max_ ? edge : max_;
+    }
+  }
+  return max_;
+}
+
+const PerfSection* perfSections() {
+  return sections;
+}
+
+void perfResetAll() {
+  for (PerfSection* s = sections; s; s = s->next_) s->reset();
+}
+
+void perfUseCounter(uint32_t (*cycles)(), uint32_t mhz) {
+  perfCycles = cycles ? cycles : cpuCycles;
+  counterMhz = cycles ? mhz : 0;
+}
+
+uint32_t perfMhz() {
+  return counterMhz ? counterMhz : hal.clock->cpuMhz();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+/*
+   Cycle-counter profiler for the hot paths.
+
+   A section is a named log2 latency histogram: bucket i counts the runs
+   that took 2^i to 2^(i+1) - 1 CPU cycles (the last one everything
+   longer), next to the count, the minimum, the maximum and the total. A
+   probe is a scoped object that reads the cycle counter when it is made
+   and records the difference into its section when it goes out of scope,
+   so every return path is timed:
+
+     PERF_SECTION(perfRead, "measureDistanceCM");
+     float measureDistanceCM(...) {
+       PERF_SCOPE(perfRead);
+       ...
+
+   A probe costs two counter reads and a few adds (no division: the
+   bucket comes from counting leading zeros). Building with PERF_PROBES=0
+   removes the sections and probes altogether.
+
+   Cycles come from hal.clock->cycleCount() (ESP.getCycleCount() on the
+   device, simulated time in the native build). perfUseCounter() swaps in
+   another counter, e.g. the host clock for benchmarks; the counter wraps
+   after 2^32 cycles (53 s at 80 MHz), so longer runs are not measured
+   right.
+*/
+
+#include <stdint.h>
+#include "Hal.h"
+
+#ifndef PERF_PROBES
+#define PERF_PROBES 1
+#endif
+
+constexpr uint8_t PERF_BUCKETS = 24;   // up to 2^24 cycles (0.2 s at 80 MHz) apart
+
+class PerfSection {
+public:
+  explicit PerfSection(const char* name);
+
+  void record(uint32_t cycles);
+  void reset();
+
+  const char* name() const { return name_; }
+  uint32_t count() const { return count_; }
+  uint32_t minCycles() const { return count_ ? min_ : 0; }
+  uint32_t maxCycles() const { return max_; }
+  uint64_t totalCycles() const { return total_; }
+  uint32_t bucket(uint8_t i) const { return buckets_[i]; }
+  const PerfSection* next() const { return next_; }
+
+  // Smallest duration (cycles) that at least fraction of the runs took no longer
+  // than, to the upper edge of its bucket
+  uint32_t percentile(float fraction) const;
+
+private:
+  friend void perfResetAll();
+  const char* name_;
+  PerfSection* next_;
+  uint32_t count_ = 0;
+  uint32_t min_ = UINT32_MAX;
+  uint32_t max_ = 0;
+  uint64_t total_ = 0;
+  uint32_t buckets_[PERF_BUCKETS] = {};
+};
+
+// Every section, in the order they were constructed
+const PerfSection* perfSections();
+void perfResetAll();
+
+// Count with cycles() at mhz per microsecond instead of the CPU cycle counter;
+// nullptr goes back to it
+void perfUseCounter(uint32_t (*cycles)(), uint32_t mhz);
+uint32_t perfMhz();
+
+extern uint32_t (*perfCycles)();
+
+class PerfProbe {
+public:
+  explicit PerfProbe(PerfSection& section) : section_(section), start_(perfCycles()) {}
+  ~PerfProbe() { section_.record(perfCycles() - start_); }
+  PerfProbe(const PerfProbe&) = delete;
+  PerfProbe& operator=(const PerfProbe&) = delete;
+
+private:
+  PerfSection& section_;
+  uint32_t start_;
+};
+
+#define PERF_CONCAT2(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT2(a, b)
+
+#if PERF_PROBES
+#define PERF_SECTION(var, name) PerfSection var(name)
+#define PERF_SCOPE(var) PerfProbe PERF_CONCAT(perfProbe_, __LINE__)(var)
+#else
+#define PERF_SECTION(var, name) static_assert(true, "profiler off")
+#define PERF_SCOPE(var) do {} while (0)
+#endif
@@ -0,0 +1,51 @@
+#include "PingScheduler.h"
+
+void PingScheduler::setWindow(uint8_t channel, uint32_t windowUs) {
+  if (channel < PING_MAX_CHANNELS) windowUs_[channel] = windowUs;
+}
+
+void PingScheduler::start(uint8_t channels, uint8_t pingsEach, uint32_t nowUs) {
+  channels_ = channels > PING_MAX_CHANNELS ? PING_MAX_CHANNELS : channels;
+  for (uint8_t c = 0; c < PING_MAX_CHANNELS; ++c) left_[c] = c < channels_ ? pingsEach : 0;
+  cursor_ = 0;
+  last_ = -1;
+  startUs_ = lastUs_ = nowUs;
+}
+
+uint32_t PingScheduler::gapUs(uint8_t from, uint8_t to) const {
+  uint32_t w = windowUs_[from];
+  if (to != from && windowUs_[to] > w) w = windowUs_[to];
+  return w + guardUs_;
+}
+
+int8_t PingScheduler::next(uint32_t nowUs, uint8_t busyMask) const {
+  for (uint8_t k = 0; k < channels_; ++k) {
+    uint8_t c = (cursor_ + k) % channels_;
+    if (left_[c] == 0 || (busyMask & (1u << c))) continue;
+    if (last_ >= 0 && nowUs - lastUs_ < gapUs((uint8_t)last_, c)) return -1;
+    return (int8_t)c;
+  }
+  return -1;
+}
+
+void PingScheduler::fired(uint8_t channel, uint32_t nowUs) {
+  if (channel >= channels_ || left_[channel] == 0) return;
+  --left_[channel];
+  last_ = (int8_t)channel;
+  lastUs_ = nowUs;
+  cursor_ = (channel + 1) % channels_;
+}
+
+bool PingScheduler::done() const {
+  for (uint8_t c = 0; c < channels_; ++c) {
+    if (left_[c]) return false;
+  }
+  return true;
+}
+
+float PingScheduler::maxRate(uint8_t channels) const {
+  if (channels == 0 || channels > PING_MAX_CHANNELS) return 0;
+  uint32_t roundUs = 0;
+  for (uint8_t c = 0; c < channels; ++c) roundUs += gapUs(c, (c + 1) % channels);
+  return roundUs ? channels * 1e6f / roundUs : 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+   Round-robin ping order for several ultrasonic sensors on one board.
+
+   Sensors over adjacent tanks hear each other: the echo of one ping comes
+   back to every transducer near it, and one that is listening at the time
+   reads it as its own (a short, false echo). So only one sensor pings at a
+   time, and the next one waits until the sound of the last ping has died
+   down:
+
+     gap(c → d) = max(window(c), window(d)) + guard
+
+   window is a channel's listening time (its range gate timeout). The
+   larger of the two covers a ping that reaches the deeper tank next door
+   and comes back from there; guard is the ring-down after it. A channel
+   that pings again after itself only waits for its own window.
+
+   A round is pingsEach pings on every channel, taken in turn
+   (0, 1, 2, 0, 1, 2, ...). A channel whose module still holds ECHO high
+   (it ignores triggers until it drops) is passed over for the next one
+   and gets its turn back later.
+*/
+
+#include <stdint.h>
+
+constexpr uint8_t PING_MAX_CHANNELS = 3;
+
+class PingScheduler {
+public:
+  void setWindow(uint8_t channel, uint32_t windowUs);
+  void setGuard(uint32_t guardUs) { guardUs_ = guardUs; }
+
+  // Start a round on channels 0..channels-1
+  void start(uint8_t channels, uint8_t pingsEach, uint32_t nowUs);
+
+  // The channel to ping now, or -1: not yet time, or nothing left. busyMask has
+  // a bit set for each channel whose ECHO is still high.
+  int8_t next(uint32_t nowUs, uint8_t busyMask) const;
+  // The channel's trigger went out at nowUs
+  void fired(uint8_t channel, uint32_t nowUs);
+
+  bool done() const;
+  uint8_t pingsLeft(uint8_t channel) const { return channel < channels_ ? left_[channel] : 0; }
+  uint8_t channels() const { return channels_; }
+  uint32_t roundStartUs() const { return startUs_; }
+
+  // Earliest time from a ping on `from` to one on `to`, µs
+  uint32_t gapUs(uint8_t from, uint8_t to) const;
+  // Pings per second over all channels when every gap is kept exactly
+  float maxRate(uint8_t channels) const;
+
+private:
+  uint32_t windowUs_[PING_MAX_CHANNELS] = {};
+  uint32_t guardUs_ = 0;
+  uint8_t left_[PING_MAX_CHANNELS] = {};
+  uint8_t channels_ = 0;
+  uint8_t cursor_ = 0;       // whose turn it is
+  int8_t last_ = -1;         // channel of the last ping this round
+  uint32_t lastUs_ = 0;
+  uint32_t startUs_ = 0;
+};
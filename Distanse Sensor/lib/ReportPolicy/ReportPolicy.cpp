@@ -0,0 +1,96 @@
+#include "ReportPolicy.h"
+#include <math.h>
+
+ReportZone reportZone(float levelPct, ReportZone current, const ReportSettings& s) {
+  if (levelPct < 0) return current;   // no echo: the alarm state stays
+  // Leaving an alarm zone takes REPORT_ALARM_HYSTERESIS_PCT more than entering it
+  float low = s.lowAlarmPct + (current == ReportZone::Low ? REPORT_ALARM_HYSTERESIS_PCT : 0);
+  float high = s.highAlarmPct - (current == ReportZone::High ? REPORT_ALARM_HYSTERESIS_PCT : 0);
+  if (s.lowAlarmPct > 0 && levelPct < low) return ReportZone::Low;
+  if (s.highAlarmPct < 100 && levelPct > high) return ReportZone::High;
+  return ReportZone::Normal;
+}
+
+void ReportPolicy::report(uint32_t nowSec, float levelPct, ReportZone zone, ReportReason reason) {
+  lastLevel_ = levelPct;
+  lastSec_ = nowSec;
+  started_ = true;
+  zone_ = zone;
+  tally(reason);
+}
+
+void ReportPolicy::tally(ReportReason reason) {
+  if (counts_[(uint8_t)reason] < UINT16_MAX) ++counts_[(uint8_t)reason];
+}
+
+ReportReason ReportPolicy::check(uint32_t nowSec, float levelPct, const ReportSettings& s) {
+  ReportZone zone = reportZone(levelPct, zone_, s);
+  ReportReason reason = ReportReason::Suppressed;
+  if (!started_) {
+    reason = ReportReason::First;
+  } else if (zone != zone_) {
+    reason = ReportReason::Alarm;
+  } else if ((levelPct < 0) != (lastLevel_ < 0)) {
+    reason = ReportReason::Echo;
+  } else if (levelPct >= 0 && (s.deadbandPct <= 0 || fabsf(levelPct - lastLevel_) > s.deadbandPct)) {
+    reason = ReportReason::Moved;
+  } else if (nowSec - lastSec_ >= s.heartbeatS) {
+    reason = ReportReason::Heartbeat;
+  }
+
+  if (reason == ReportReason::Suppressed) {
+    tally(ReportReason::Suppressed);
+  } else {
+    report(nowSec, levelPct, zone, reason);
+  }
+  return reason;
+}
+
+void ReportPolicy::reportAnyway(uint32_t nowSec, float levelPct, const ReportSettings& s) {
+  report(nowSec, levelPct, reportZone(levelPct, zone_, s), ReportReason::Manual);
+}
+
+uint32_t ReportPolicy::reported() const {
+  uint32_t n = 0;
+  for (uint8_t r = 1; r < REPORT_REASONS; ++r) n += counts_[r];
+  return n;
+}
+
+void ChannelReport::report(float levelPct, ReportZone zone) {
+  lastLevel_ = levelPct < 0 ? -1 : (int16_t)lroundf(fminf(levelPct, 300.0f) * 100);
+  zone_ = zone;
+  started_ = true;
+}
+
+ReportReason ChannelReport::check(float levelPct, const ReportSettings& s) {
+  ReportZone zone = reportZone(levelPct, zone_, s);
+  float last = lastLevel_ / 100.0f;
+  ReportReason reason = ReportReason::Suppressed;
+  if (!started_) {
+    reason = ReportReason::First;
+  } else if (zone != zone_) {
+    reason = ReportReason::Alarm;
+  } else if ((levelPct < 0) != (lastLevel_ < 0)) {
+    reason = ReportReason::Echo;
+  } else if (levelPct >= 0 && (s.deadbandPct <= 0 || fabsf(levelPct - last) > s.deadbandPct)) {
+    reason = ReportReason::Moved;
+  }
+  if (reason != ReportReason::Suppressed) report(levelPct, zone);
+  return reason;
+}
+
+void ChannelReport::sent(float levelPct, const ReportSettings& s) {
+  report(levelPct, reportZone(levelPct, zone_, s));
+}
+
+const char* reportReasonName(ReportReason reason) {
+  switch (reason) {
+    case ReportReason::First: return "first";
+    case ReportReason::Moved: return "moved";
+    case ReportReason::Echo: return "echo";
+    case ReportReason::Alarm: return "alarm";
+    case ReportReason::Heartbeat: return "heartbeat";
+    case ReportReason::Manual: return "manual";
+    default: return "suppressed";
+  }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+/*
+   Decides which readings go out over ESP-NOW. Dozens of sensors can share
+   channel 1, and a reading that says the same as the last one only costs
+   airtime.
+
+   A reading is reported when
+     - it is the first one since boot,
+     - the level moved more than the deadband from the last reported one,
+     - the echo was lost or came back,
+     - the level crossed the low or high alarm level (urgent: the caller
+       sends it at once instead of batching it), or
+     - nothing was reported for the heartbeat interval, so the parent can
+       tell a quiet sensor from a dead one.
+   Everything else is suppressed (it still goes into the local history).
+   The alarm levels have a little hysteresis so a level sitting on one
+   does not report every reading.
+
+   With a deadband of 0 every reading is reported. The state is plain data
+   (battery mode keeps it in RTC memory).
+
+   The additional sensors of a multi-sensor board each have a ChannelReport:
+   the same first/moved/echo/alarm rules in 4 bytes, but no heartbeat of
+   their own. Their readings ride along in every frame the main sensor's
+   policy reports, which is heartbeat enough.
+*/
+
+#include <stdint.h>
+
+constexpr float REPORT_ALARM_HYSTERESIS_PCT = 1.0f;
+
+struct ReportSettings {
+  float deadbandPct = 0;       // of the barrel; 0 reports every reading
+  uint32_t heartbeatS = 600;
+  float lowAlarmPct = 0;       // 0: off
+  float highAlarmPct = 100;    // 100: off
+};
+
+enum class ReportReason : uint8_t {
+  Suppressed = 0,
+  First = 1,
+  Moved = 2,       // beyond the deadband (or no deadband)
+  Echo = 3,        // echo lost or back
+  Alarm = 4,       // alarm level crossed: send now
+  Heartbeat = 5,
+  Manual = 6       // reported regardless of the policy
+};
+constexpr uint8_t REPORT_REASONS = 7;
+
+enum class ReportZone : uint8_t { Low, Normal, High };
+
+// The alarm zone of levelPct, leaving the current one with hysteresis (no echo: stays)
+ReportZone reportZone(float levelPct, ReportZone current, const ReportSettings& settings);
+
+class ReportPolicy {
+public:
+  // Decide about a reading at nowSec; levelPct < 0 means no echo.
+  // Counts it as reported or suppressed.
+  ReportReason check(uint32_t nowSec, float levelPct, const ReportSettings& settings);
+  // A reading that is sent anyway (manual /read): restarts deadband and heartbeat from it
+  void reportAnyway(uint32_t nowSec, float levelPct, const ReportSettings& settings);
+
+  static bool urgent(ReportReason r) { return r == ReportReason::Alarm; }
+
+  uint32_t lastReportSec() const { return lastSec_; }
+  // Readings per reason (they stop at 65535: RTC memory is tight)
+  uint16_t count(ReportReason r) const { return counts_[(uint8_t)r]; }
+  uint16_t suppressed() const { return counts_[(uint8_t)ReportReason::Suppressed]; }
+  uint32_t reported() const;
+
+private:
+  void report(uint32_t nowSec, float levelPct, ReportZone zone, ReportReason reason);
+  void tally(ReportReason reason);
+
+  float lastLevel_ = 0;      // last reported, % (< 0: no echo)
+  uint32_t lastSec_ = 0;
+  bool started_ = false;
+  ReportZone zone_ = ReportZone::Normal;
+  uint16_t counts_[REPORT_REASONS] = {};
+};
+
+class ChannelReport {
+public:
+  // Decide about a reading of an additional sensor (no heartbeat)
+  ReportReason check(float levelPct, const ReportSettings& settings);
+  // The reading went out anyway, along with another one
+  void sent(float levelPct, const ReportSettings& settings);
+
+private:
+  void report(float levelPct, ReportZone zone);
+
+  int16_t lastLevel_ = 0;    // last reported, 0.01 % (< 0: no echo)
+  ReportZone zone_ = ReportZone::Normal;
+  bool started_ = false;
+};
+
+const char* reportReasonName(ReportReason reason);
@@ -0,0 +1,41 @@
+#include "SampleFilter.h"
+
+bool SampleFilter::add(float value) {
+  if (count_ >= MAX_BURST_SAMPLES) return false;
+
+  // Shift larger samples up one slot and drop the new one into the gap
+  uint8_t i = count_++;
+  while (i > 0 && sorted_[i - 1] > value) {
+    sorted_[i] = sorted_[i - 1];
+    --i;
+  }
+  sorted_[i] = value;
+  return true;
+}
+
+float SampleFilter::median() const {
+  if (count_ == 0) return 0.0f;
+  uint8_t mid = count_ / 2;
+  if (count_ & 1) return sorted_[mid];
+  return (sorted_[mid - 1] + sorted_[mid]) * 0.5f;
+}
+
+float SampleFilter::trimmedMean() const {
+  if (count_ == 0) return 0.0f;
+  uint8_t trim = count_ / 4;
+  float sum = 0.0f;
+  for (uint8_t i = trim; i < count_ - trim; ++i) {
+    sum += sorted_[i];
+  }
+  return sum / (count_ - 2 * trim);
+}
+
+float SampleFilter::spread() const {
+  if (count_ == 0) return 0.0f;
+  uint8_t trim = count_ / 4;
+  return sorted_[count_ - 1 - trim] - sorted_[trim];
+}
+
+const char* filterModeName(FilterMode mode) {
+  return mode == FilterMode::TrimmedMean ? "Trimmed mean" : "Median";
+}
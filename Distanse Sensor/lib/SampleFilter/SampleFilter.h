@@ -0,0 +1,38 @@
+#pragma once
+
+/*
+   Fixed-size robust reducer for a burst of distance pings.
+
+   Samples are kept sorted as they arrive (insertion into a fixed array,
+   no heap), so the median is a lookup and the trimmed mean a short sum.
+*/
+
+#include <stdint.h>
+
+constexpr uint8_t MAX_BURST_SAMPLES = 32;
+
+enum class FilterMode : uint8_t {
+  Median = 0,
+  TrimmedMean = 1   // mean of the middle half (drops lowest and highest quarter)
+};
+
+class SampleFilter {
+public:
+  void reset() { count_ = 0; }
+
+  // Returns false once MAX_BURST_SAMPLES are stored
+  bool add(float value);
+
+  uint8_t count() const { return count_; }
+  float median() const;
+  float trimmedMean() const;
+  float reduce(FilterMode mode) const { return mode == FilterMode::TrimmedMean ? trimmedMean() : median(); }
+  // Spread of the middle half (the samples the trimmed mean keeps)
+  float spread() const;
+
+private:
+  float sorted_[MAX_BURST_SAMPLES];
+  uint8_t count_ = 0;
+};
+
+const char* filterModeName(FilterMode mode);
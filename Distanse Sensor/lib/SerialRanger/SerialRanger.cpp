@@ -0,0 +1,71 @@
+#include "SerialRanger.h"
+#include <string.h>
+
+/* ---------- frame parser ------------------------------------------------- */
+bool RangerFrameParser::feed(uint8_t b, uint16_t& distanceMm) {
+  if (len_ == 0 && b != HEADER) {
+    ++stats_.skippedBytes;
+    return false;
+  }
+  buf_[len_++] = b;
+  if (len_ < FRAME_SIZE) return false;
+
+  if ((uint8_t)(buf_[0] + buf_[1] + buf_[2]) == buf_[3]) {
+    distanceMm = (uint16_t)(buf_[1] << 8 | buf_[2]);
+    len_ = 0;
+    ++stats_.frames;
+    return true;
+  }
+
+  // Misaligned or corrupted: the real frame may start at a later header byte
+  // of this window, so keep everything from there on instead of dropping it all
+  ++stats_.checksumErrors;
+  uint8_t start = 1;
+  while (start < FRAME_SIZE && buf_[start] != HEADER) ++start;
+  stats_.skippedBytes += start;
+  len_ = FRAME_SIZE - start;
+  memmove(buf_, buf_ + start, len_);
+  return false;
+}
+
+/* ---------- ranger ------------------------------------------------------- */
+void SerialRanger::begin(Uart& uart, RangerMode mode) {
+  uart_ = &uart;
+  mode_ = mode;
+  pending_ = false;
+  parser_.reset();
+}
+
+// Drop everything buffered so far (frames measured before the ping started)
+void SerialRanger::drain() {
+  uint8_t buf[32];
+  while (uart_->available() && uart_->read(buf, sizeof(buf))) {}
+  parser_.reset();
+}
+
+void SerialRanger::start(uint32_t nowMs, uint32_t timeoutMs) {
+  if (!uart_) return;
+  drain();
+  if (mode_ == RangerMode::Controlled) uart_->write(&TRIGGER_BYTE, 1);
+  pending_ = true;
+  startMs_ = nowMs;
+  timeoutMs_ = timeoutMs;
+}
+
+SerialRanger::Status SerialRanger::poll(uint32_t nowMs, uint16_t& distanceMm) {
+  if (!pending_) return Status::Idle;
+
+  // Byte by byte, so nothing after the frame is consumed: the next ping drains it anyway
+  uint8_t b;
+  while (uart_->available() && uart_->read(&b, 1)) {
+    if (parser_.feed(b, distanceMm)) {
+      pending_ = false;
+      return Status::Ready;
+    }
+  }
+  if (nowMs - startMs_ >= timeoutMs_) {
+    pending_ = false;
+    return Status::Timeout;
+  }
+  return Status::Pending;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+   JSN-SR04M serial output modes.
+
+   Besides trigger/echo, the module can range by itself and report the
+   distance over UART (9600 8N1; it sends on its ECHO/TX pin and listens
+   on TRIG/RX, so the wiring stays the same):
+
+     Auto        a frame about every 100 ms
+     Controlled  a frame in reply to each TRIGGER_BYTE
+
+   A frame is 4 bytes: HEADER, distance in mm (high, low byte), checksum =
+   low byte of the sum of the first three.
+
+   RangerFrameParser takes the bytes as they come out of the UART RX
+   buffer, in any chunking. After noise, a dropped byte or a start in
+   mid-frame it resyncs on the next header. SerialRanger wraps it into a
+   non-blocking ping with the same start/poll shape as EchoCapture.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+
+enum class RangerMode : uint8_t { Auto, Controlled };
+
+struct RangerStats {
+  uint32_t frames = 0;          // valid frames
+  uint32_t checksumErrors = 0;  // 4 bytes after a header that did not add up
+  uint32_t skippedBytes = 0;    // bytes dropped while looking for a header
+};
+
+class RangerFrameParser {
+public:
+  static constexpr uint8_t HEADER = 0xFF;
+  static constexpr size_t FRAME_SIZE = 4;
+
+  // Feed one received byte; true when it completed a valid frame
+  bool feed(uint8_t b, uint16_t& distanceMm);
+
+  void reset() { len_ = 0; }
+  const RangerStats& stats() const { return stats_; }
+
+private:
+  uint8_t buf_[FRAME_SIZE];
+  uint8_t len_ = 0;
+  RangerStats stats_;
+};
+
+class SerialRanger {
+public:
+  enum class Status : uint8_t {
+    Idle,     // nothing started
+    Pending,  // waiting for a frame
+    Ready,    // frame received
+    Timeout   // no valid frame within the timeout
+  };
+
+  static constexpr uint32_t BAUD = 9600;
+  static constexpr uint8_t TRIGGER_BYTE = 0x55;
+
+  void begin(Uart& uart, RangerMode mode);
+
+  // Start a ping: drop frames received before it, and in Controlled mode send
+  // the trigger byte. Only a frame that arrives afterwards completes it.
+  void start(uint32_t nowMs, uint32_t timeoutMs);
+
+  // Never blocks: parses whatever the RX buffer holds. Ready/Timeout end the ping.
+  Status poll(uint32_t nowMs, uint16_t& distanceMm);
+
+  bool busy() const { return pending_; }
+  RangerMode mode() const { return mode_; }
+  const RangerStats& stats() const { return parser_.stats(); }
+
+private:
+  void drain();
+
+  Uart* uart_ = nullptr;
+  RangerMode mode_ = RangerMode::Auto;
+  RangerFrameParser parser_;
+  bool pending_ = false;
+  uint32_t startMs_ = 0;
+  uint32_t timeoutMs_ = 0;
+};
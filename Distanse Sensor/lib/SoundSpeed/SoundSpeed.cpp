@@ -0,0 +1,37 @@
+#include "SoundSpeed.h"
+#include <Arduino.h>
+
+namespace {
+
+constexpr size_t TABLE_SIZE = SOUND_TEMP_MAX - SOUND_TEMP_MIN + 1;
+
+struct HalfSpeedTable {
+  uint16_t q[TABLE_SIZE];
+};
+
+// c/2 in mm/µs, Q18: 0.5 * c[m/s] / 1000 * 2^18, rounded
+constexpr HalfSpeedTable makeTable() {
+  HalfSpeedTable t = {};
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    t.q[i] = (uint16_t)(soundSpeedMs(SOUND_TEMP_MIN + (int)i) * (0.5 / 1000.0) * (1 << SOUND_SPEED_Q) + 0.5);
+  }
+  return t;
+}
+
+const HalfSpeedTable HALF_SPEED PROGMEM = makeTable();
+
+} // namespace
+
+void SoundSpeed::setTemperature(int16_t sixteenths) {
+  if (sixteenths < SOUND_TEMP_MIN * 16) sixteenths = SOUND_TEMP_MIN * 16;
+  if (sixteenths > SOUND_TEMP_MAX * 16) sixteenths = SOUND_TEMP_MAX * 16;
+  temp16_ = sixteenths;
+
+  // Linear between the two whole degrees around the temperature
+  int offset = sixteenths - SOUND_TEMP_MIN * 16;
+  size_t i = offset >> 4;
+  uint32_t frac = offset & 15;
+  uint16_t q[2] = {};
+  memcpy_P(q, &HALF_SPEED.q[i], frac ? sizeof(q) : sizeof(q[0]));   // no entry past the end at 85 °C
+  halfSpeedQ_ = frac ? q[0] + (((uint32_t)(q[1] - q[0]) * frac + 8) >> 4) : q[0];
+}
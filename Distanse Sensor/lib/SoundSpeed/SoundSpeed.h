@@ -0,0 +1,61 @@
+#pragma once
+
+/*
+   Speed of sound in air over temperature, for turning echo times into
+   distances.
+
+     c(T) = 331.3 m/s * sqrt(1 + T / 273.15 °C)
+
+   That is 331.3 m/s at 0 °C and 343.2 m/s at 20 °C. The old fixed 0.034
+   cm/µs is right at about 15 °C and off by 3-4 % in summer or winter.
+
+   A table of c/2 per whole °C from SOUND_TEMP_MIN to SOUND_TEMP_MAX (the
+   DS18B20 range) is computed at compile time and kept in flash. Changing
+   the temperature interpolates the table once (the temperature is in
+   1/16 °C, the DS18B20 raw unit). After that a distance costs one integer
+   and one float multiply.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+constexpr int SOUND_TEMP_MIN = -40;  // °C
+constexpr int SOUND_TEMP_MAX = 85;
+constexpr int SOUND_SPEED_Q = 18;    // fixed point of the table: c/2 in mm/µs, Q18
+
+// Reference model (double), for tests and the table
+constexpr double soundSpeedRoot(double x, double r = 1.0, int i = 0) {
+  return i == 8 ? r : soundSpeedRoot(x, 0.5 * (r + x / r), i + 1);
+}
+constexpr double soundSpeedMs(double tempC) { return 331.3 * soundSpeedRoot(1.0 + tempC / 273.15); }
+
+static_assert(soundSpeedMs(SOUND_TEMP_MAX) * (0.5 / 1000.0) * (1 << SOUND_SPEED_Q) < 65535.5,
+              "table entries must fit 16 bits");
+
+class SoundSpeed {
+public:
+  SoundSpeed() { setTemperature(20 * 16); }
+
+  // Air temperature in 1/16 °C; clamped to the table range
+  void setTemperature(int16_t sixteenths);
+  int16_t temperature16() const { return temp16_; }
+  float temperatureC() const { return temp16_ / 16.0f; }
+
+  // Half the speed of sound, mm/µs in Q18
+  uint32_t halfSpeedQ() const { return halfSpeedQ_; }
+  float metersPerSecond() const { return halfSpeedQ_ * (2000.0f / (1 << SOUND_SPEED_Q)); }
+
+  // Round-trip echo time (µs, < 65536) → one-way distance
+  float distanceCm(uint32_t echoUs) const {
+    return (float)(echoUs * halfSpeedQ_) * (1.0f / (10 << SOUND_SPEED_Q));
+  }
+
+  // One-way distance → round-trip echo time (µs), the inverse of distanceCm
+  uint32_t echoUs(float cm) const {
+    return (uint32_t)(cm * (float)(10 << SOUND_SPEED_Q) / halfSpeedQ_ + 0.5f);
+  }
+
+private:
+  int16_t temp16_ = 0;
+  uint32_t halfSpeedQ_ = 0;
+};
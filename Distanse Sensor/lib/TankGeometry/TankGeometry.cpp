@@ -0,0 +1,168 @@
+#include "TankGeometry.h"
+#include <math.h>
+#include <stdlib.h>
+
+namespace {
+
+constexpr float PI_F = 3.14159265f;
+
+// Cross-section of a lying cylinder of radius r filled to h, cm²
+float segmentArea(float r, float h) {
+  if (h <= 0) return 0;
+  if (h >= 2 * r) return PI_F * r * r;
+  float d = r - h;
+  return r * r * acosf(d / r) - d * sqrtf(2 * r * h - h * h);
+}
+
+bool positive(float v) { return v > 0 && v < 100000; }
+
+float strapLiters(const TankDims& dims, float levelCm) {
+  const StrapPoint* p = dims.strap;
+  uint8_t n = dims.strapPoints;
+  if (n == 0) return 0;
+  float level = levelCm * TANK_LEVEL_SCALE;
+  if (level <= p[0].level) return (float)p[0].volume / TANK_VOLUME_SCALE;
+  for (uint8_t i = 1; i < n; ++i) {
+    if (level <= p[i].level) {
+      float f = (level - p[i - 1].level) / (float)(p[i].level - p[i - 1].level);
+      return ((float)p[i - 1].volume + f * (float)(p[i].volume - p[i - 1].volume)) / TANK_VOLUME_SCALE;
+    }
+  }
+  return (float)p[n - 1].volume / TANK_VOLUME_SCALE;
+}
+
+} // namespace
+
+float tankModelLiters(const TankDims& dims, float levelCm) {
+  if (dims.shape == TankShape::Strapped) return strapLiters(dims, levelCm);
+  float h = levelCm < 0 ? 0 : (levelCm > dims.heightCm ? dims.heightCm : levelCm);
+  float cm3 = 0;
+  switch (dims.shape) {
+    case TankShape::Upright:
+      cm3 = PI_F * dims.widthCm * dims.widthCm / 4 * h;
+      break;
+    case TankShape::Lying:
+      cm3 = segmentArea(dims.heightCm / 2, h) * dims.lengthCm;
+      break;
+    case TankShape::Box:
+      cm3 = dims.widthCm * dims.lengthCm * h;
+      break;
+    case TankShape::Tapered: {
+      // Frustum from the bottom to h: the radius grows linearly with the height
+      float r0 = dims.widthCm / 2;
+      float r = r0 + (dims.lengthCm / 2 - r0) * h / dims.heightCm;
+      cm3 = PI_F * h / 3 * (r0 * r0 + r0 * r + r * r);
+      break;
+    }
+    default:
+      break;
+  }
+  return cm3 / 1000;
+}
+
+bool TankGeometry::compile(const TankDims& dims) {
+  points_ = 0;
+  if (dims.shape == TankShape::Strapped) {
+    if (dims.strapPoints < 2 || dims.strapPoints > TANK_MAX_STRAP_POINTS) return false;
+    for (uint8_t i = 0; i < dims.strapPoints; ++i) {
+      if (i && (dims.strap[i].level <= dims.strap[i - 1].level || dims.strap[i].volume < dims.strap[i - 1].volume)) {
+        return false;
+      }
+      level_[i] = dims.strap[i].level;
+      volume_[i] = dims.strap[i].volume;
+    }
+    points_ = dims.strapPoints;
+    return true;
+  }
+
+  if ((uint8_t)dims.shape >= TANK_SHAPES || !positive(dims.heightCm) || dims.heightCm * TANK_LEVEL_SCALE > UINT16_MAX) {
+    return false;
+  }
+  bool needsLength = dims.shape == TankShape::Lying || dims.shape == TankShape::Box || dims.shape == TankShape::Tapered;
+  bool needsWidth = dims.shape != TankShape::Lying;
+  if ((needsWidth && !positive(dims.widthCm)) || (needsLength && !positive(dims.lengthCm))) return false;
+
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < TANK_TABLE_POINTS; ++i) {
+    float t = (float)i / (TANK_TABLE_POINTS - 1);
+    // Lying cylinder: equal steps of the angle at the centre, h = r (1 - cos θ)
+    if (dims.shape == TankShape::Lying) t = (1 - cosf(PI_F * t)) / 2;
+    float h = t * dims.heightCm;
+    uint16_t level = (uint16_t)lroundf(h * TANK_LEVEL_SCALE);
+    if (n && level <= level_[n - 1]) continue;   // a tiny tank: fewer, distinct points
+    level_[n] = level;
+    volume_[n] = (uint32_t)lroundf(tankModelLiters(dims, (float)level / TANK_LEVEL_SCALE) * TANK_VOLUME_SCALE);
+    if (n && volume_[n] < volume_[n - 1]) volume_[n] = volume_[n - 1];
+    ++n;
+  }
+  if (n < 2) return false;
+  points_ = n;
+  return true;
+}
+
+uint32_t TankGeometry::volumeAt(uint32_t levelQ8) const {
+  if (points_ < 2) return 0;
+  if (levelQ8 <= (uint32_t)level_[0] << 8) return volume_[0];
+  if (levelQ8 >= (uint32_t)level_[points_ - 1] << 8) return volume_[points_ - 1];
+
+  // First point above the level; the one before it is at or below
+  uint8_t lo = 1, hi = points_ - 1;
+  while (lo < hi) {
+    uint8_t mid = (lo + hi) / 2;
+    if ((uint32_t)level_[mid] << 8 > levelQ8) hi = mid;
+    else lo = mid + 1;
+  }
+  uint32_t x0 = (uint32_t)level_[lo - 1] << 8;
+  uint32_t dx = ((uint32_t)level_[lo] << 8) - x0;
+  uint32_t dv = volume_[lo] - volume_[lo - 1];
+  return volume_[lo - 1] + (uint32_t)(((uint64_t)dv * (levelQ8 - x0) + dx / 2) / dx);
+}
+
+float TankGeometry::liters(float levelCm) const {
+  if (points_ < 2) return -1.0f;
+  if (levelCm < 0) levelCm = 0;
+  float q = levelCm * (TANK_LEVEL_SCALE * 256);
+  uint32_t levelQ8 = q < 4294967040.0f ? (uint32_t)q : UINT32_MAX;
+  return (float)volumeAt(levelQ8) / TANK_VOLUME_SCALE;
+}
+
+float TankGeometry::capacityLiters() const {
+  return points_ >= 2 ? (float)volume_[points_ - 1] / TANK_VOLUME_SCALE : -1.0f;
+}
+
+bool parseStrapTable(const char* text, TankDims& dims) {
+  uint8_t n = 0;
+  const char* p = text;
+  for (;;) {
+    while (*p == ' ' || *p == ',' || *p == ';' || *p == '\n' || *p == '\r' || *p == '\t') ++p;
+    if (!*p) break;
+    char* end;
+    float cm = strtof(p, &end);
+    if (end == p || *end != '=') return false;
+    p = end + 1;
+    float liters = strtof(p, &end);
+    if (end == p) return false;
+    p = end;
+    if (n == TANK_MAX_STRAP_POINTS || cm < 0 || cm * TANK_LEVEL_SCALE > UINT16_MAX || liters < 0 || liters > 1e8f) {
+      return false;
+    }
+    StrapPoint& s = dims.strap[n];
+    s.level = (uint16_t)lroundf(cm * TANK_LEVEL_SCALE);
+    s.volume = (uint32_t)lroundf(liters * TANK_VOLUME_SCALE);
+    if (n && (s.level <= dims.strap[n - 1].level || s.volume < dims.strap[n - 1].volume)) return false;
+    ++n;
+  }
+  if (n < 2) return false;
+  dims.strapPoints = n;
+  return true;
+}
+
+const char* tankShapeName(TankShape shape) {
+  switch (shape) {
+    case TankShape::Lying: return "lying cylinder";
+    case TankShape::Box: return "box";
+    case TankShape::Tapered: return "tapered";
+    case TankShape::Strapped: return "strapping table";
+    default: return "upright cylinder";
+  }
+}
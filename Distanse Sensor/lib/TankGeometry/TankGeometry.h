@@ -0,0 +1,84 @@
+#pragma once
+
+/*
+   Water volume from the water level, for tanks that are not upright
+   cylinders.
+
+   The shape is an analytic model or a strapping table measured by the
+   user (level in cm, volume in liters, e.g. from the tank's data sheet):
+
+     upright cylinder      diameter
+     lying cylinder        length; the diameter is the tank height
+     box (IBC tote)        width x length
+     tapered (cistern)     bottom and top diameter
+     strapping table       up to TANK_MAX_STRAP_POINTS points
+
+   compile() turns any of them into one monotonic fixed-point table, so a
+   reading only costs a binary search and a linear interpolation. Analytic
+   shapes get TANK_TABLE_POINTS points; the lying cylinder's are spaced by
+   angle, so they crowd where its cross-section changes fastest (the bottom
+   and the top).
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+constexpr uint8_t TANK_TABLE_POINTS = 33;
+constexpr uint8_t TANK_MAX_STRAP_POINTS = 12;
+constexpr uint16_t TANK_LEVEL_SCALE = 10;   // table levels: 0.1 cm
+constexpr uint16_t TANK_VOLUME_SCALE = 10;  // table volumes: 0.1 L
+
+enum class TankShape : uint8_t {
+  Upright = 0,
+  Lying = 1,
+  Box = 2,
+  Tapered = 3,
+  Strapped = 4
+};
+constexpr uint8_t TANK_SHAPES = 5;
+
+// A strapping table point, in the fixed-point units of the lookup table
+struct StrapPoint {
+  uint16_t level;    // 0.1 cm above the bottom
+  uint32_t volume;   // 0.1 L
+};
+
+struct TankDims {
+  TankShape shape = TankShape::Upright;
+  float heightCm = 50;
+  float widthCm = 40;    // upright / lying: diameter; box: width; tapered: bottom diameter
+  float lengthCm = 40;   // lying / box: length; tapered: top diameter
+  StrapPoint strap[TANK_MAX_STRAP_POINTS] = {};
+  uint8_t strapPoints = 0;
+};
+
+class TankGeometry {
+public:
+  // Build the lookup table; false (and no table) if the dimensions make no tank
+  bool compile(const TankDims& dims);
+  bool valid() const { return points_ >= 2; }
+
+  // Liters at a level in cm above the bottom (clamped to the table), -1 without a table
+  float liters(float levelCm) const;
+  float capacityLiters() const;
+  uint8_t points() const { return points_; }
+
+  // The fixed-point lookup: volume (0.1 L) at a level in 1/256 of 0.1 cm
+  uint32_t volumeAt(uint32_t levelQ8) const;
+
+private:
+  static constexpr uint8_t MAX_POINTS = TANK_TABLE_POINTS > TANK_MAX_STRAP_POINTS ? TANK_TABLE_POINTS : TANK_MAX_STRAP_POINTS;
+
+  uint16_t level_[MAX_POINTS];   // 0.1 cm, strictly increasing
+  uint32_t volume_[MAX_POINTS];  // 0.1 L, never decreasing
+  uint8_t points_ = 0;
+};
+
+// Analytic volume in liters at a level (what the table approximates)
+float tankModelLiters(const TankDims& dims, float levelCm);
+
+// "cm=liters" pairs separated by commas, spaces or new lines, levels increasing.
+// Returns false on a syntax error, too many points or a table that is not monotonic.
+bool parseStrapTable(const char* text, TankDims& dims);
+
+const char* tankShapeName(TankShape shape);
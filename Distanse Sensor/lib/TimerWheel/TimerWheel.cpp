@@ -0,0 +1,79 @@
+#include "TimerWheel.h"
+
+void TimerWheel::unlink(TimerLink& l) {
+  l.prev->next = l.next;
+  l.next->prev = l.prev;
+  l.prev = l.next = &l;
+}
+
+void TimerWheel::append(TimerLink& head, TimerLink& l) {
+  l.prev = head.prev;
+  l.next = &head;
+  head.prev->next = &l;
+  head.prev = &l;
+}
+
+void TimerWheel::schedule(TimerTask& task, uint32_t dueMs) {
+  if (!task.listed_) {
+    task.listed_ = true;
+    task.nextTask_ = tasks_;
+    tasks_ = &task;
+  }
+  unlink(task);
+  task.dueMs_ = dueMs;
+  // A deadline run() has already passed goes into the next tick's slot
+  uint32_t tick = (int32_t)(dueMs - cursor_) > 0 ? dueMs : cursor_ + 1;
+  append(slots_[tick & (TIMER_SLOTS - 1)], task);
+}
+
+void TimerWheel::cancel(TimerTask& task) {
+  unlink(task);
+}
+
+// Move the slot's tasks that are due to the ready list
+void TimerWheel::collect(TimerLink& slot, uint32_t nowMs) {
+  TimerLink* l = slot.next;
+  while (l != &slot) {
+    TimerLink* next = l->next;
+    TimerTask& task = static_cast<TimerTask&>(*l);
+    if ((int32_t)(nowMs - task.dueMs_) >= 0) {
+      unlink(task);
+      append(ready_, task);
+    }
+    l = next;
+  }
+}
+
+void TimerWheel::run(uint32_t nowMs, Clock& clock) {
+  slowest_ = nullptr;
+  slowestUs_ = 0;
+  uint32_t ticks = nowMs - cursor_;
+  if ((int32_t)ticks <= 0) return;
+  if (ticks > TIMER_SLOTS) ticks = TIMER_SLOTS;
+  for (uint32_t i = 1; i <= ticks; ++i) collect(slots_[(nowMs - ticks + i) & (TIMER_SLOTS - 1)], nowMs);
+  cursor_ = nowMs;
+
+  while (ready_.next != &ready_) {
+    TimerTask& task = static_cast<TimerTask&>(*ready_.next);
+    unlink(task);
+    uint32_t lateMs = nowMs - task.dueMs_;
+    if (task.periodMs_) {
+      uint32_t next = task.dueMs_ + task.periodMs_;
+      schedule(task, (int32_t)(next - nowMs) > 0 ? next : nowMs + task.periodMs_);
+    }
+    uint32_t t0 = clock.micros();
+    task.fn_();
+    uint32_t us = clock.micros() - t0;
+
+    TimerStats& s = task.stats_;
+    ++s.runs;
+    s.totalUs += us;
+    if (us > s.maxUs) s.maxUs = us;
+    if (!slowest_ || us > slowestUs_) {
+      slowest_ = &task;
+      slowestUs_ = us;
+    }
+    if (lateMs > s.maxLateMs) s.maxLateMs = lateMs;
+    if (lateMs >= TIMER_LATE_MS) ++s.late;
+  }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+   Cooperative timer wheel for the jobs of loop().
+
+   Each task sits in one of TIMER_SLOTS lists, picked by its deadline
+   (due & (TIMER_SLOTS - 1), 1 ms ticks). Scheduling and cancelling link
+   and unlink it there, O(1). run() visits the slots of the ticks that
+   passed since the last call (all of them once, after a stall longer
+   than a turn of the wheel) and runs the tasks whose deadline has come;
+   a task due in a later turn stays where it is. Deadlines are compared
+   as signed differences, so they survive millis() wrapping after 49
+   days.
+
+   A task with a period is re-armed one period after its deadline before
+   it runs (once behind by more than a period, one period from now, so
+   it does not run in a burst to catch up); its function may reschedule
+   or cancel it instead. Due tasks are moved to a ready list first, so a
+   task can schedule or cancel any other, itself included, while run()
+   is going.
+
+   Per task the wheel counts runs, run time (µs, max and total) and how
+   late it started: a task that starts TIMER_LATE_MS or more after its
+   deadline was held up by something else in loop().
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Hal.h"
+
+constexpr uint8_t TIMER_SLOTS = 32;        // a power of two
+constexpr uint32_t TIMER_LATE_MS = 10;
+static_assert((TIMER_SLOTS & (TIMER_SLOTS - 1)) == 0, "TIMER_SLOTS must be a power of two");
+
+struct TimerLink {
+  TimerLink* prev = this;
+  TimerLink* next = this;
+};
+
+struct TimerStats {
+  uint32_t runs = 0;
+  uint32_t late = 0;         // runs started TIMER_LATE_MS or more after the deadline
+  uint32_t maxLateMs = 0;
+  uint32_t maxUs = 0;
+  uint64_t totalUs = 0;
+};
+
+class TimerTask : public TimerLink {
+public:
+  TimerTask(const char* name, void (*fn)(), uint32_t periodMs = 0) : name_(name), fn_(fn), periodMs_(periodMs) {}
+
+  const char* name() const { return name_; }
+  bool armed() const { return next != this; }
+  uint32_t dueMs() const { return dueMs_; }
+  uint32_t periodMs() const { return periodMs_; }
+  void setPeriod(uint32_t periodMs) { periodMs_ = periodMs; }
+  const TimerStats& stats() const { return stats_; }
+
+private:
+  friend class TimerWheel;
+  const char* name_;
+  void (*fn_)();
+  uint32_t periodMs_;
+  uint32_t dueMs_ = 0;
+  TimerTask* nextTask_ = nullptr;   // registry of every task scheduled once, for stats
+  bool listed_ = false;
+  TimerStats stats_;
+};
+
+class TimerWheel {
+public:
+  void begin(uint32_t nowMs) { cursor_ = nowMs; }
+
+  // Run the task at dueMs (one already past: on the next run()), replacing any
+  // deadline it had
+  void schedule(TimerTask& task, uint32_t dueMs);
+  void cancel(TimerTask& task);
+
+  // Run every task due by nowMs; clock times them
+  void run(uint32_t nowMs, Clock& clock);
+
+  // The task that ran longest in the last run() and for how long (µs); nullptr if none ran
+  const TimerTask* slowest() const { return slowest_; }
+  uint32_t slowestUs() const { return slowestUs_; }
+
+  // Every task ever scheduled, most recent first (for statistics)
+  template <typename Fn>
+  void forEachTask(Fn fn) const {
+    for (const TimerTask* t = tasks_; t; t = t->nextTask_) fn(*t);
+  }
+
+private:
+  static void unlink(TimerLink& l);
+  static void append(TimerLink& head, TimerLink& l);
+  void collect(TimerLink& slot, uint32_t nowMs);
+
+  TimerLink slots_[TIMER_SLOTS];
+  TimerLink ready_;
+  uint32_t cursor_ = 0;              // the last tick run() visited
+  TimerTask* tasks_ = nullptr;
+  const TimerTask* slowest_ = nullptr;
+  uint32_t slowestUs_ = 0;
+};
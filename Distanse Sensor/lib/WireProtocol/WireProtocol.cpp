@@ -0,0 +1,172 @@
+#include "WireProtocol.h"
+#include <string.h>
+
+namespace {
+
+uint16_t saturate(float v) {
+  v += 0.5f;
+  if (v < 0) return 0;
+  if (v > 0xFFFE) return 0xFFFE;
+  return (uint16_t)v;
+}
+
+void put16(uint8_t* p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+void put32(uint8_t* p, uint32_t v) {
+  put16(p, v & 0xFFFF);
+  put16(p + 2, v >> 16);
+}
+
+uint16_t get16(const uint8_t* p) {
+  return p[0] | (uint16_t)p[1] << 8;
+}
+
+uint32_t get32(const uint8_t* p) {
+  return get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+} // namespace
+
+uint16_t wireDistance(float distanceCm) {
+  return distanceCm < 0 ? WIRE_NO_ECHO : saturate(distanceCm * WIRE_DIST_SCALE);
+}
+
+uint16_t wireLevel(float levelPercent) {
+  return saturate(levelPercent * WIRE_LEVEL_SCALE);
+}
+
+int16_t wireRate(float cmPerMin) {
+  float v = cmPerMin * WIRE_RATE_SCALE;
+  if (v < -32767) return -32767;
+  if (v > 32767) return 32767;
+  return (int16_t)lroundf(v);
+}
+
+uint32_t wireVolume(float liters) {
+  if (liters < 0) return WIRE_NO_VOLUME;
+  float v = liters * WIRE_VOLUME_SCALE + 0.5f;
+  return v >= 4294967040.0f ? WIRE_NO_VOLUME - 1 : (uint32_t)v;
+}
+
+size_t encodeFrame(const WireFrame& frame, uint8_t* out, size_t outSize) {
+  const WireHeader& h = frame.header;
+  if (h.count > WIRE_MAX_SAMPLES) return 0;
+  size_t len = WIRE_HEADER_SIZE + h.count * WIRE_SAMPLE_SIZE;
+  if (len > outSize) return 0;
+
+  out[0] = WIRE_MAGIC;
+  out[1] = WIRE_VERSION;
+  out[2] = h.flags;
+  out[3] = h.sensorId;
+  put16(out + 4, h.seq);
+  put32(out + 6, h.uptimeSec);
+  put16(out + 10, h.barrelHeight);
+  out[12] = h.count;
+  put16(out + 13, (uint16_t)h.airTemp);
+  put16(out + 15, h.trackedLevel);
+  put16(out + 17, (uint16_t)h.levelRate);
+  out[19] = h.confidence;
+  put32(out + 20, h.trackedVolume);
+  put32(out + 24, h.capacity);
+
+  uint8_t* p = out + WIRE_HEADER_SIZE;
+  for (uint8_t i = 0; i < h.count; ++i, p += WIRE_SAMPLE_SIZE) {
+    put16(p, frame.samples[i].ageSec);
+    put16(p + 2, frame.samples[i].distance);
+    put16(p + 4, frame.samples[i].level);
+    p[6] = frame.samples[i].quality;
+    p[7] = frame.samples[i].channel;
+  }
+  return len;
+}
+
+WireResult decodeFrame(const uint8_t* data, size_t len, WireFrame& frame) {
+  if (len && data[0] != WIRE_MAGIC) return WireResult::BadMagic;
+  if (len >= 2 && data[1] != WIRE_VERSION) return WireResult::UnsupportedVersion;
+  if (len < WIRE_HEADER_SIZE) return WireResult::Truncated;
+
+  WireHeader& h = frame.header;
+  h.version = data[1];
+  h.flags = data[2];
+  h.sensorId = data[3];
+  h.seq = get16(data + 4);
+  h.uptimeSec = get32(data + 6);
+  h.barrelHeight = get16(data + 10);
+  h.count = data[12];
+  h.airTemp = (int16_t)get16(data + 13);
+  h.trackedLevel = get16(data + 15);
+  h.levelRate = (int16_t)get16(data + 17);
+  h.confidence = data[19];
+  h.trackedVolume = get32(data + 20);
+  h.capacity = get32(data + 24);
+  if (h.count > WIRE_MAX_SAMPLES) return WireResult::TooManySamples;
+  if (len < WIRE_HEADER_SIZE + h.count * WIRE_SAMPLE_SIZE) return WireResult::Truncated;
+
+  const uint8_t* p = data + WIRE_HEADER_SIZE;
+  for (uint8_t i = 0; i < h.count; ++i, p += WIRE_SAMPLE_SIZE) {
+    frame.samples[i].ageSec = get16(p);
+    frame.samples[i].distance = get16(p + 2);
+    frame.samples[i].level = get16(p + 4);
+    frame.samples[i].quality = p[6];
+    frame.samples[i].channel = p[7];
+  }
+  return WireResult::Ok;
+}
+
+const char* wireResultName(WireResult result) {
+  switch (result) {
+    case WireResult::Ok: return "OK";
+    case WireResult::Truncated: return "truncated";
+    case WireResult::BadMagic: return "bad magic";
+    case WireResult::UnsupportedVersion: return "unsupported version";
+    case WireResult::TooManySamples: return "too many samples";
+  }
+  return "?";
+}
+
+bool FrameBatch::add(uint32_t timeSec, float distanceCm, float levelPercent, uint8_t quality, uint8_t channel) {
+  if (full()) return false;
+  if (count_ == 0) baseSec_ = timeSec;
+  uint32_t offset = timeSec - baseSec_;
+  if (offset > 0xFFFF) {
+    uint32_t shift = offset - 0xFFFF;
+    baseSec_ += shift;
+    for (uint8_t i = 0; i < count_; ++i) offset_[i] = offset_[i] > shift ? (uint16_t)(offset_[i] - shift) : 0;
+    offset = 0xFFFF;
+  }
+  offset_[count_] = (uint16_t)offset;
+  distance_[count_] = wireDistance(distanceCm);
+  level_[count_] = wireLevel(levelPercent);
+  quality_[count_] = quality;
+  channel_[count_] = channel;
+  ++count_;
+  return true;
+}
+
+void FrameBatch::dropOldest() {
+  if (count_ == 0) return;
+  --count_;
+  memmove(offset_, offset_ + 1, count_ * sizeof(offset_[0]));
+  memmove(distance_, distance_ + 1, count_ * sizeof(distance_[0]));
+  memmove(level_, level_ + 1, count_ * sizeof(level_[0]));
+  memmove(quality_, quality_ + 1, count_ * sizeof(quality_[0]));
+  memmove(channel_, channel_ + 1, count_ * sizeof(channel_[0]));
+}
+
+size_t FrameBatch::encode(WireHeader header, uint8_t* out, size_t outSize) const {
+  WireFrame frame;
+  header.count = count_;
+  frame.header = header;
+  for (uint8_t i = 0; i < count_; ++i) {
+    uint32_t age = header.uptimeSec - (baseSec_ + offset_[i]);
+    frame.samples[i].ageSec = age > 0xFFFF ? 0xFFFF : (uint16_t)age;
+    frame.samples[i].distance = distance_[i];
+    frame.samples[i].level = level_[i];
+    frame.samples[i].quality = quality_[i];
+    frame.samples[i].channel = channel_[i];
+  }
+  return encodeFrame(frame, out, outSize);
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+/*
+   ESP-NOW wire format, version 6.
+
+   A frame is a 28-byte header followed by up to WIRE_MAX_SAMPLES packed
+   8-byte samples, so one radio wake-up can carry a whole batch of
+   readings. All fields are little-endian and serialized byte by byte,
+   so sender and receiver do not have to agree on struct layout.
+
+     off  size  field
+       0     1  magic (WIRE_MAGIC)
+       1     1  protocol version (WIRE_VERSION)
+       2     1  flags (WIRE_FLAG_*)
+       3     1  sensor id (the firmware sends its station MAC's last byte)
+       4     2  sequence number (per sender, wraps)
+       6     4  sender uptime in seconds when the frame was built
+      10     2  barrel height, 0.1 cm
+      12     1  sample count n
+      13     2  air temperature, 0.1 °C, signed
+      15     2  tracked water level, 0.01 %
+      17     2  fill (+) / drain (-) rate, 0.01 cm/min, signed
+      19     1  tracker confidence, %
+      20     4  tracked volume, 0.1 L
+      24     4  tank capacity, 0.1 L
+      28   8*n  samples: age s, distance 0.1 cm, water level 0.01 %,
+                echo confidence %, sensor channel
+
+   A sample's age is counted back from the header uptime. A distance of
+   WIRE_NO_ECHO marks a reading without an echo. The air temperature is the
+   one the distances were computed with. The tracker fields describe the
+   newest sample, confidence 0 without a track. The volumes follow the tank
+   shape (lib/TankGeometry); they are WIRE_NO_VOLUME without one. The echo
+   confidence scores each reading's burst (lib/EchoQuality), 0 without an
+   echo. A board with several sensors sends the readings of all of them in
+   one frame; the channel says whose a sample is (0 is the main sensor).
+   The header's barrel height and tracker fields are those of channel 0.
+   Frames of any other version are rejected. This header is shared with
+   receivers: a parent device can include it and call decodeFrame().
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+constexpr uint8_t WIRE_MAGIC = 0xA5;
+constexpr uint8_t WIRE_VERSION = 6;
+
+constexpr size_t WIRE_HEADER_SIZE = 28;
+constexpr size_t WIRE_SAMPLE_SIZE = 8;
+constexpr uint8_t WIRE_MAX_SAMPLES = 27;
+constexpr size_t WIRE_MAX_FRAME = WIRE_HEADER_SIZE + WIRE_MAX_SAMPLES * WIRE_SAMPLE_SIZE;
+static_assert(WIRE_MAX_FRAME <= 250, "frame must fit into one ESP-NOW packet");
+
+constexpr uint8_t WIRE_FLAG_BOOT = 0x01;       // first frame since the sender booted
+constexpr uint8_t WIRE_FLAG_COALESCED = 0x02;  // merged from queued frames; the sequence numbers before it were folded in
+
+constexpr uint16_t WIRE_DIST_SCALE = 10;    // 0.1 cm
+constexpr uint16_t WIRE_LEVEL_SCALE = 100;  // 0.01 %
+constexpr uint16_t WIRE_NO_ECHO = 0xFFFF;
+constexpr int16_t WIRE_TEMP_SCALE = 10;     // 0.1 °C
+constexpr int16_t WIRE_RATE_SCALE = 100;    // 0.01 cm/min
+constexpr uint32_t WIRE_VOLUME_SCALE = 10;  // 0.1 L
+constexpr uint32_t WIRE_NO_VOLUME = 0xFFFFFFFF;
+
+struct WireHeader {
+  uint8_t version = WIRE_VERSION;
+  uint8_t flags = 0;
+  uint8_t sensorId = 0;
+  uint16_t seq = 0;
+  uint32_t uptimeSec = 0;
+  uint16_t barrelHeight = 0;  // 0.1 cm
+  uint8_t count = 0;
+  int16_t airTemp = 0;             // 0.1 °C
+  uint16_t trackedLevel = 0;       // 0.01 %
+  int16_t levelRate = 0;           // 0.01 cm/min
+  uint8_t confidence = 0;          // %, 0 without a track
+  uint32_t trackedVolume = WIRE_NO_VOLUME;  // 0.1 L
+  uint32_t capacity = WIRE_NO_VOLUME;       // 0.1 L
+};
+
+struct WireSample {
+  uint16_t ageSec;
+  uint16_t distance;  // 0.1 cm, WIRE_NO_ECHO if the reading failed
+  uint16_t level;     // 0.01 %
+  uint8_t quality;    // echo confidence %, 0 if the reading failed
+  uint8_t channel;    // sensor on the sending board, 0 the main one
+};
+
+struct WireFrame {
+  WireHeader header;
+  WireSample samples[WIRE_MAX_SAMPLES];
+};
+
+enum class WireResult : uint8_t {
+  Ok,
+  Truncated,            // shorter than the header or its sample count
+  BadMagic,             // not a frame of this protocol (e.g. the legacy 12-byte payload)
+  UnsupportedVersion,
+  TooManySamples
+};
+
+// Fixed-point conversions (saturating); distanceCm < 0 encodes WIRE_NO_ECHO
+uint16_t wireDistance(float distanceCm);
+uint16_t wireLevel(float levelPercent);
+inline float wireDistanceCm(uint16_t d) { return d == WIRE_NO_ECHO ? -1.0f : (float)d / WIRE_DIST_SCALE; }
+inline float wireLevelPercent(uint16_t l) { return (float)l / WIRE_LEVEL_SCALE; }
+inline int16_t wireTemp(float tempC) { return (int16_t)lroundf(tempC * WIRE_TEMP_SCALE); }
+int16_t wireRate(float cmPerMin);
+inline float wireRateCmPerMin(int16_t r) { return (float)r / WIRE_RATE_SCALE; }
+// liters < 0 encodes WIRE_NO_VOLUME
+uint32_t wireVolume(float liters);
+inline float wireVolumeLiters(uint32_t v) { return v == WIRE_NO_VOLUME ? -1.0f : (float)v / WIRE_VOLUME_SCALE; }
+
+// Serialize header.count samples; returns the frame length, 0 if out is too small
+size_t encodeFrame(const WireFrame& frame, uint8_t* out, size_t outSize);
+WireResult decodeFrame(const uint8_t* data, size_t len, WireFrame& frame);
+const char* wireResultName(WireResult result);
+
+// Readings collected for the next frame, with their times until encoded.
+// Plain data, so it can be parked in RTC memory across deep sleep: the
+// times are kept as 16-bit offsets from the first reading (a reading more
+// than 18 h later moves the older ones up, their age saturates anyway).
+class FrameBatch {
+public:
+  // Returns false once WIRE_MAX_SAMPLES are queued
+  bool add(uint32_t timeSec, float distanceCm, float levelPercent, uint8_t quality, uint8_t channel = 0);
+  uint8_t count() const { return count_; }
+  bool full() const { return count_ == WIRE_MAX_SAMPLES; }
+  void clear() { count_ = 0; }
+  // Make room for a newer reading when the batch could not be sent
+  void dropOldest();
+  uint32_t oldestSec() const { return baseSec_ + offset_[0]; }
+
+  // Encode the queued samples, ages counted back from header.uptimeSec
+  size_t encode(WireHeader header, uint8_t* out, size_t outSize) const;
+
+private:
+  uint32_t baseSec_ = 0;
+  uint16_t offset_[WIRE_MAX_SAMPLES];
+  uint16_t distance_[WIRE_MAX_SAMPLES];
+  uint16_t level_[WIRE_MAX_SAMPLES];
+  uint8_t quality_[WIRE_MAX_SAMPLES];
+  uint8_t channel_[WIRE_MAX_SAMPLES];
+  uint8_t count_ = 0;
+};
@@ -0,0 +1,129 @@
+"""
+Bundle the web UI (web/) into include/WebAssets.h.
+
+Every file is minified, gzip'd and emitted as a PROGMEM byte array with
+an ETag (CRC32 of the gzip data), so the firmware serves it verbatim with
+"Content-Encoding: gzip" and answers revalidations with 304.
+
+Runs before every build as a PlatformIO pre-script (see platformio.ini)
+and standalone:  python scripts/build_web.py
+The header is only rewritten when its content changes.
+"""
+
+import gzip
+import os
+import re
+import zlib
+
+# (file in web/, content type); the C name is derived from the file name
+ASSETS = [
+    ("index.html", "text/html"),
+    ("update.html", "text/html"),
+    ("sensor.html", "text/html"),
+    ("debugmac.html", "text/html"),
+    ("reset.html", "text/html"),
+    ("calibrate.html", "text/html"),
+    ("style.css", "text/css"),
+    ("app.js", "application/javascript"),
+]
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    text = re.sub(r">\s*\n\s*<", "><", text)
+    return re.sub(r"\s+", " ", text).strip()
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{}:;,>])\s*", r"\1", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    # Conservative: drop comments and indentation, keep line breaks (ASI)
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(line for line in lines if line and not line.startswith("//"))
+
+
+MINIFIERS = {".html": minify_html, ".css": minify_css, ".js": minify_js}
+
+
+def c_name(file_name):
+    return "WEB_" + re.sub(r"[^A-Za-z0-9]", "_", file_name).upper()
+
+
+def byte_lines(data, per_line=16):
+    for i in range(0, len(data), per_line):
+        yield "  " + ", ".join("0x%02x" % b for b in data[i:i + per_line]) + ","
+
+
+def generate(project_dir):
+    web_dir = os.path.join(project_dir, "web")
+    out = [
+        "#pragma once",
+        "",
+        "/*",
+        "   Web UI assets, generated by scripts/build_web.py from web/.",
+        "   Do not edit: change the files in web/ and rebuild.",
+        "*/",
+        "",
+        "#include <Arduino.h>",
+        "#include <stdint.h>",
+        "#include <stddef.h>",
+        "",
+        "struct WebAsset {",
+        "  const char* contentType;",
+        "  const char* etag;      // quoted CRC32 of the gzip data",
+        "  const uint8_t* data;   // gzip stream in PROGMEM",
+        "  size_t size;",
+        "};",
+    ]
+    total_raw = total_gz = 0
+
+    for file_name, content_type in ASSETS:
+        ext = os.path.splitext(file_name)[1]
+        with open(os.path.join(web_dir, file_name), encoding="utf-8") as f:
+            raw = f.read()
+        minified = MINIFIERS[ext](raw).encode("utf-8")
+        packed = gzip.compress(minified, compresslevel=9, mtime=0)
+        etag = '"%08x"' % (zlib.crc32(packed) & 0xFFFFFFFF)
+        name = c_name(file_name)
+        total_raw += len(raw.encode("utf-8"))
+        total_gz += len(packed)
+
+        out += [
+            "",
+            "// %s: %d bytes, %d minified, %d gzip'd" % (file_name, len(raw.encode("utf-8")), len(minified), len(packed)),
+            "constexpr uint8_t %s_GZ[] PROGMEM = {" % name,
+        ]
+        out += byte_lines(packed)
+        out += [
+            "};",
+            "constexpr WebAsset %s = {\"%s\", \"%s\", %s_GZ, sizeof(%s_GZ)};"
+            % (name, content_type, etag.replace('"', '\\"'), name, name),
+        ]
+
+    out += ["", "// Total: %d bytes of sources, %d bytes in flash" % (total_raw, total_gz), ""]
+    text = "\n".join(out)
+
+    header = os.path.join(project_dir, "include", "WebAssets.h")
+    try:
+        with open(header, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    except FileNotFoundError:
+        pass
+    with open(header, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    print("build_web: wrote %s (%d -> %d bytes)" % (header, total_raw, total_gz))
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO/SCons)
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
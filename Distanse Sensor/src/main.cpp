@@ -3,74 +3,392 @@
 
    - Creates AP "WATER_SENSOR_XXXXXX", pwd "1234".
    - Serves http://192.168.4.1  → settings page with configuration options.
-   - Saves settings to EEPROM and restarts.
+   - Saves settings to flash (wear-leveled log, lib/ConfigStore) and restarts.
    - Hold BOOT/IO0 ≥ 4 seconds => clears config and restarts.
+   - Battery mode: deep sleep between readings, the AP only comes up when
+     BOOT is held for 1 s right after reset.
 */
 
-#include <ESP8266WiFi.h>
-#include <ESP8266WebServer.h>
-#include <EEPROM.h>
-#include <user_interface.h>
-#include <espnow.h>
+#include <Arduino.h>
+#include <array>
+#include <stddef.h>
+#include <type_traits>
+#include "Hal.h"
+#include "Crc32.h"
+#include "ConfigStore.h"
+#include "ChunkWriter.h"
+#include "EchoCapture.h"
+#include "SerialRanger.h"
+#include "SoundSpeed.h"
+#include "SampleFilter.h"
+#include "EchoQuality.h"
+#include "PingScheduler.h"
+#include "LevelTracker.h"
+#include "AdaptiveInterval.h"
+#include "ReportPolicy.h"
+#include "TankGeometry.h"
+#include "Calibration.h"
+#include "History.h"
+#include "WireProtocol.h"
+#include "Outbox.h"
+#include "Log.h"
+#include "TimerWheel.h"
+#include "Perf.h"
+#include "LoopWatch.h"
+#include "HeapWatch.h"
+#include "WebAssets.h"
 
 // Board: LOLIN(WEMOS) D1 R2 & mini (ESP8266)
-// Requires: ESP8266WiFi library (bundled with ESP8266 core)
+// All hardware access goes through `hal` (lib/Hal), see [env:native] for the host build
 
 // These will be overridden by config values
 const char* DEFAULT_AP_PASS = "HardPassword1234";    // >= 8 chars
 const char* DEFAULT_AP_PREFIX = "WATER_SENSOR_";  // AP name prefix
 
 // Optional: set AP IP (default is 192.168.4.1)
-IPAddress local_IP(192, 168, 4, 1);
-IPAddress gateway(192, 168, 4, 1);
-IPAddress subnet(255, 255, 255, 0);
+const uint8_t local_IP[4] = {192, 168, 4, 1};
+const uint8_t gateway[4] = {192, 168, 4, 1};
+const uint8_t subnet[4] = {255, 255, 255, 0};
 
 constexpr uint8_t BTN_PIN = 0;          // GPIO0 = FLASH/BOOT
 constexpr uint8_t LED_PIN = 2;          // GPIO2 = built‑in LED (LOW = on)
 constexpr uint32_t BTN_HOLD_MS = 4000;
-constexpr uint16_t EEPROM_SIZE = 64;      // EEPROM size for Wemos D1 Mini (increased for new settings)
 
 // ESP-NOW constants
 constexpr uint8_t WIFI_CH = 1;          // channel used for ESP-NOW
-constexpr uint32_t ESP_NOW_RETRY_MS = 1000; // Retry interval for failed sends
+constexpr uint32_t ESP_NOW_BACKOFF_MIN_MS = 250;    // First retry of a failed frame (doubles per failure)
+constexpr uint32_t ESP_NOW_BACKOFF_MAX_MS = 30000;  // Retry interval cap during an outage
+constexpr uint32_t ESP_NOW_ACK_TIMEOUT_MS = 500;    // No send callback by then counts as a failure
+
+// Battery mode (deep sleep between readings)
+constexpr uint32_t CONFIG_BUTTON_HOLD_MS = 1000;    // BOOT held this long after reset → config AP
+constexpr uint32_t CONFIG_MODE_TIMEOUT_MS = 600000; // then back to sleeping after 10 minutes
+constexpr uint32_t WAKE_ACK_DEADLINE_MS = 30;       // ESP-NOW acks take a few ms; don't stay up for more
+constexpr uint8_t WAKE_SEND_ATTEMPTS = 2;
+constexpr uint32_t MIN_SLEEP_MS = 1000;
+constexpr uint32_t RF_ON_RESTART_US = 100000;       // short sleep to get a wake with the RF on
 
 /* ───── pin definitions ─────────────────────────────── */
 const int TRIG_PIN = D5; // GPIO14
 const int ECHO_PIN = D6; // GPIO12
+const int PROBE_PIN = D2; // GPIO4, optional DS18B20 (4.7k pull-up to 3.3V)
+// Additional trigger/echo sensors (one board over adjacent tanks): any of these, which are
+// free and have an edge interrupt. D8 must stay low at boot (a TRIG output does), and RX
+// gives up the serial console input.
+constexpr uint8_t CHANNEL_PINS[] = {D1, D7, D8, RX};
 /* ───────────────────────────────────────────────────────────── */
 
+constexpr uint8_t SENSOR_CHANNELS = PING_MAX_CHANNELS; // The main sensor and up to two more
+constexpr uint32_t ECHO_TIMEOUT_US = 30000; // Max wait for a complete echo (~5 m)
+constexpr uint32_t SENSOR_REARM_MS = 60;    // Serial modes: min ping-to-ping spacing
+constexpr float SENSOR_MOUNT_CM = 20.0;     // Default sensor height above the full water level
+constexpr float SENSOR_MIN_RANGE_CM = 2.0;  // Closer echoes are transducer ringing
+constexpr float GATE_NEAR_MARGIN_CM = 10.0; // Range gate: accepted above the full level (waves, overfill)
+constexpr float GATE_FAR_MARGIN_CM = 10.0;  // and below the bottom (tilted mount, sloped floor)
+constexpr uint32_t ECHO_RISE_MAX_US = 1000; // Trigger → echo rise, slowest module
+constexpr uint32_t ECHO_SETTLE_US = 2000;   // Ring-down after the gate closes, before the next trigger (any sensor)
+constexpr uint32_t SERIAL_PING_TIMEOUT_MS = 250; // Max wait for a serial frame (Auto mode sends every ~100 ms)
+constexpr uint32_t PROBE_CONVERSION_MS = 750;    // DS18B20 at 12 bits
+constexpr uint32_t PROBE_REFRESH_MS = 60000;     // Air temperature changes slowly
+
+// How the JSN-SR04M is driven (its mode is set by a resistor on the module)
+enum class SensorMode : uint8_t {
+  TriggerEcho = 0,      // TRIG pulse, ECHO pulse width timed by interrupt (also HC-SR04)
+  SerialAuto = 1,       // module ranges by itself and streams frames
+  SerialControlled = 2  // one frame per trigger byte
+};
+
+// An additional sensor over its own tank (trigger/echo only). Channel 0, the main
+// sensor on D5/D6, is configured by the barrel/mount/calibration fields of Config.
+struct ChannelConfig {
+  uint8_t trigPin;
+  uint8_t echoPin;
+  float barrelHeightCm = 50.0;
+  float mountCm = SENSOR_MOUNT_CM;
+  bool calibrated = false;
+  CalCoeffs cal;
+};
+
 // Configuration structure
 struct Config {
   std::array<uint8_t, 6> parentMac = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}; // Default broadcast MAC
   uint32_t refreshRateMs = 5000; // Default 5 seconds
+  uint32_t refreshMaxMs = 5000; // Backed off up to this while the level is steady (<= refresh rate: fixed)
   float barrelHeightCm = 50.0; // Default 50 cm barrel height
   bool ledEnabled = true; // Default LED enabled
   char ssidPrefix[16] = "WATER_SENSOR_"; // Default SSID prefix
   char wifiPassword[32] = "HardPassword1234"; // Default WiFi password
+  uint8_t burstSamples = 5; // Pings per reading (1..MAX_BURST_SAMPLES)
+  FilterMode filterMode = FilterMode::Median; // How a burst is reduced to one distance
+  uint8_t batchSize = 1; // Readings per ESP-NOW frame (1..WIRE_MAX_SAMPLES)
+  uint16_t batchMaxAgeS = 60; // Send a partial batch once its oldest reading is this old
+  OutboxPolicy outboxPolicy = OutboxPolicy::Coalesce; // What to do with frames when the outbox is full
+  bool lowPower = false; // Deep sleep between readings (battery mode)
+  SensorMode sensorMode = SensorMode::TriggerEcho; // Takes effect after a reboot
+  int8_t airTempC = 20; // Air temperature for the speed of sound without a probe (-40..85)
+  bool tempProbe = false; // DS18B20 on PROBE_PIN measures it instead
+  uint16_t reportDeadband = 0; // ESP-NOW: report once the level moved this much, 0.1 % (0: every reading)
+  uint16_t heartbeatS = 600; // ... or when nothing was reported for this long
+  uint8_t lowAlarmPct = 0; // Crossing these is reported at once (0 / 100: off)
+  uint8_t highAlarmPct = 100;
+  TankShape tankShape = TankShape::Upright; // Volume model (lib/TankGeometry); the barrel height is its height
+  float tankWidthCm = 40.0; // Upright / lying cylinder: diameter; box: width; tapered: bottom diameter
+  float tankLengthCm = 40.0; // Lying cylinder / box: length; tapered: top diameter
+  StrapPoint strap[TANK_MAX_STRAP_POINTS] = {}; // Strapping table: level 0.1 cm, volume 0.1 L
+  uint8_t strapPoints = 0;
+  float mountCm = SENSOR_MOUNT_CM; // Sensor height above the full level (uncalibrated)
+  bool calibrated = false; // Fitted distance → height coefficients replace the mount height
+  CalCoeffs cal;
+  uint8_t channels = 1; // Sensors on the board (1..SENSOR_CHANNELS), more than one in trigger/echo mode only
+  ChannelConfig extra[SENSOR_CHANNELS - 1] = {{D1, D7, 50.0, SENSOR_MOUNT_CM, false, {}},
+                                              {D8, RX, 50.0, SENSOR_MOUNT_CM, false, {}}};
+  uint16_t stallMs = 100; // A loop() iteration this long is recorded as a stall (10..10000)
 };
 
-ESP8266WebServer server(80);
 Config config;
+ConfigStore configStore;
 
 // Sensor reading variables
 float currentDistance = 0.0;
 float currentWaterLevel = 0.0;
+float currentTrackedLevel = 0.0;   // smoothed by levelTracker, %
+float currentVolume = -1.0;        // liters, -1 without a tank shape
+TankGeometry tank;                 // level → volume table, compiled from the config
+CalPoint calPoints[CAL_MAX_POINTS]; // captured on the calibration page, until fitted
+uint8_t calPointCount = 0;
+uint8_t calChannel = 0;            // the sensor they were captured with
+float calRmsCm = -1;               // residual of the last fit, -1 before one
 uint32_t lastSensorRead = 0;
+LevelTracker levelTracker;
+AdaptiveInterval readInterval;     // time to the next reading, between refreshRateMs and refreshMaxMs
+ReportPolicy reportPolicy;         // which readings go out over ESP-NOW
+EchoCapture echoCapture;
+SerialRanger serialRanger;
+
+// Air temperature for the speed of sound (trigger/echo mode)
+SoundSpeed soundSpeed;
+bool probeFound = false;
+bool probeOk = false;         // the last probe reading is in use
+bool probeConverting = false;
+uint32_t probeStartMs = 0;
+uint32_t probeErrors = 0;
+
+// One ultrasonic sensor and the tank under it. Channel 0 is the main sensor: the level
+// tracker, the history, the volume and the ESP-NOW header follow it. The others only
+// add their readings to the ESP-NOW frames (and show on the pages).
+struct SensorChannel {
+  uint8_t trigPin = TRIG_PIN;
+  uint8_t echoPin = ECHO_PIN;
+  float barrelHeightCm = 50.0;
+  Calibration calibration;      // distance → water height above the bottom
+  float fullDistanceCm = 0;     // distances of the full and the empty tank (for the range gate)
+  float emptyDistanceCm = 0;
+  RangeGate gate;               // trigger/echo range gate, from the geometry and the speed of sound
+  float gateNearCm = 0;         // the gate in cm, also applied to serial frames
+  float gateFarCm = 0;
+  SampleFilter filter;          // valid pings of the burst (and stuck ones: nothing better to go on)
+  EchoQuality echo;             // ping labels and the confidence of the last reading
+  EchoExpect expect;            // what the pings of the current burst are checked against
+  float distance = 0;           // last reading, cm (-1: no echo)
+  float level = 0;              // %
+  uint32_t pingsValid = 0;
+  uint32_t pingsRejected = 0;   // echo outside the gate
+  uint32_t pingsTimedOut = 0;   // no echo before the gate closed
+};
+SensorChannel channels[SENSOR_CHANNELS];
+uint8_t channelCount = 1;     // in use: config.channels in trigger/echo mode, else 1
+ChannelReport channelReports[SENSOR_CHANNELS - 1];   // report state of the additional sensors
+
+// Burst acquisition state: a burst is config.burstSamples pings on every channel, in turn
+PingScheduler pingScheduler;  // which channel pings next, and when (lib/PingScheduler)
+SampleFilter rangeFilter;     // channel 0: the valid pings plus the ones that jumped off the track
+bool burstActive = false;
+uint8_t activeChannel = 0;    // whose ping is in flight
+volatile uint8_t echoChannel = 0;  // whose ECHO edges reach the capture (read by the ISRs)
+float burstRate = 0;          // pings per second over all channels achieved by the last burst
+
+// Reading history: 1024 raw samples (6 KB), 64 one-minute and 64 one-hour rollups
+History<1024, 64, 64> history;
 
 // ESP-NOW variables
 bool espNowInitialized = false;
 bool espNowSendSuccess = true;
 uint32_t lastEspNowSend = 0;
-uint32_t lastEspNowRetry = 0;
 
-// ESP-NOW payload structure (same as your working example)
-struct Payload { 
-  float distance; 
-  float waterLevel; 
-  float barrelHeight; 
-} payload;
+// ESP-NOW frames (lib/WireProtocol): readings are batched, finished frames wait in the outbox until acked
+FrameBatch espNowBatch;
+uint32_t espNowBatchStartMs = 0;
+uint16_t espNowSeq = 0;
+bool espNowFirstFrame = true;
+Outbox espNowOutbox;
+volatile uint32_t espNowCallbacks = 0;   // send callbacks so far, for waiting on one
+
+// The jobs of loop() (lib/TimerWheel). Each one is scheduled for when it next has
+// something to do; the task functions are with loop() at the end of this file.
+constexpr uint32_t LED_BLINK_MS = 3000;
+constexpr uint32_t BUTTON_POLL_MS = 20;
+constexpr uint32_t LOG_DRAIN_MS = 5;
+constexpr uint32_t HEAP_SAMPLE_MS = 1000;
+void runSensorTask();
+void runProbeTask();
+void runBatchAgeTask();
+void serviceEspNowOutbox();
+void scheduleOutbox();
+void blinkLed();
+void checkButton();
+void endConfigMode();
+void runLogTask();
+void sampleHeap();
+TimerWheel timers;
+TimerTask sensorTask("sensor", runSensorTask);
+TimerTask probeTask("probe", runProbeTask);
+TimerTask batchAgeTask("batchAge", runBatchAgeTask);
+TimerTask outboxTask("espNow", serviceEspNowOutbox);
+TimerTask ledTask("led", blinkLed, LED_BLINK_MS);
+TimerTask buttonTask("button", checkButton, BUTTON_POLL_MS);
+TimerTask configTimeoutTask("configTimeout", endConfigMode);
+TimerTask logTask("log", runLogTask, LOG_DRAIN_MS);
+TimerTask heapTask("heap", sampleHeap, HEAP_SAMPLE_MS);
+
+// Cycle-count histograms of the hot paths (lib/Perf), served at /perf
+PERF_SECTION(perfLoop, "loop");
+PERF_SECTION(perfRoot, "handleRoot");
+PERF_SECTION(perfStatus, "handleApiStatus");
+PERF_SECTION(perfMeasure, "measureDistanceCM");
+PERF_SECTION(perfSend, "sendEspNowData");
+
+// Log messages of the hot paths (lib/Log): records store the ID, the text is made
+// when they are drained to Serial or fetched from /logs
+enum class LogMsg : uint8_t {
+  EspNowAcked, EspNowFailed, EspNowRetry, EspNowRadioError, EspNowRequested, EspNowNotReady,
+  EspNowFrame, EspNowBatch, EspNowAgeLimit, ChannelReported, ReadingSuppressed, ReadingQueued,
+  ReadingTriggered, Reading, Tracked, IntervalChanged, AirTemperature,
+  SerialNoReading, SerialFrame, PingTimeout, PingRejected, PingDistance, PingLabel, Burst, BurstRate,
+  LoopStall,
+  Count
+};
+
+const char* const LOG_FORMATS[] = {
+  "ESP-NOW send: OK",
+  "ESP-NOW send: FAIL (status %u)",
+  "ESP-NOW retry seq=%u, attempt %u",
+  "ESP-NOW send failed with error code: %d",
+  "ESP-NOW send: request sent (waiting for callback)",
+  "ESP-NOW send: skipped (not initialized)",
+  "ESP-NOW frame seq=%u: %u readings, %u bytes (latest: %.1f cm, %.1f%%), %u frames pending",
+  "ESP-NOW batch: %u/%u readings",
+  "ESP-NOW batch: age limit reached",
+  "ESP-NOW: sensor %u reported (%s)",
+  "ESP-NOW: reading suppressed (%u suppressed, %u reported)",
+  "ESP-NOW: queueing reading (%s, %s)",
+  "Reading triggered, %u ms since the last",
+  "Reading: distance %.1f cm, water level %.1f%%, volume %.1f L",
+  "Tracked level: %.1f%%, %+.2f cm/min, confidence %u%%",
+  "Reading interval: %u -> %u ms (%s)",
+  "Air temperature: %.2f C, speed of sound %.1f m/s",
+  "Sensor: no serial reading (%s)",
+  "Sensor: serial frame %u mm",
+  "Sensor %u: timeout or no echo",
+  "Sensor %u: echo at %.2f cm is outside the range gate",
+  "Sensor %u: %u us = %.2f cm (%.1f C)",
+  "Sensor %u: ping labelled %s",
+  "Sensor %u burst: %u/%u valid pings, %.2f cm, confidence %u%% (%s)",
+  "Burst: %u pings on %u sensors, %.1f pings/s",
+  "loop() stalled for %u ms, %u ms of it in one part (see /api/stalls)",
+};
+static_assert(sizeof(LOG_FORMATS) / sizeof(LOG_FORMATS[0]) == (size_t)LogMsg::Count, "One format per LogMsg");
+
+constexpr uint8_t LOG_DRAIN_PER_LOOP = 4;   // records printed per run of the log task
+uint32_t logSerialCursor = 0;               // next record to print on Serial
+
+// Battery mode: state carried across deep sleep in RTC memory, so a wake needs no flash
+// writes. Lost on power loss (the CRC then fails and it starts over).
+constexpr uint32_t WAKE_STATE_MAGIC = 0x57414B45; // "WAKE"
+
+struct WakeState {
+  uint32_t magic;
+  uint32_t crc;            // over everything from clockMs on
+  uint64_t clockMs;        // device time at the start of this wake (uptime across sleeps)
+  uint32_t wakes;
+  uint16_t seq;            // next ESP-NOW sequence number
+  uint8_t frameFlags;      // WIRE_FLAG_BOOT until a frame got through, COALESCED after a failed one
+  bool radioThisWake;      // the last sleep left the RF on because the batch is due
+  bool configNextWake;     // BOOT was held during a wake with the RF off
+  bool probeConverting;    // a DS18B20 conversion was started in the last wake
+  uint32_t lastAwakeMs;    // time-to-sleep: setup() to deep sleep
+  uint32_t maxAwakeMs;
+  uint32_t totalAwakeMs;
+  uint16_t lastSensorMs;   // ... of which taking the reading
+  uint16_t lastRadioMs;    // ... of which Wi-Fi/ESP-NOW start, send and ack
+  uint32_t radioWakes;
+  uint32_t failedSends;
+  LevelTracker tracker;    // level and rate estimate, timed in clockMs
+  AdaptiveInterval interval;  // sleep between wakes
+  ReportPolicy report;     // last reported level and the send/suppress counts
+  EchoQuality echo;        // stuck-value run and ping labels (channel 0)
+  FrameBatch batch;        // readings not yet delivered
+  ChannelReport channels[SENSOR_CHANNELS - 1];  // report state of the additional sensors
+};
+static_assert(std::is_trivially_copyable<WakeState>::value, "WakeState is copied to RTC memory as bytes");
+static_assert(sizeof(WakeState) % 4 == 0 && sizeof(WakeState) <= 384, "WakeState must fit the RTC user memory");
+
+WakeState wakeState;
+bool wakeStateValid = false;
+
+// Stalls of loop() (lib/LoopWatch). Always-on mode keeps them in RTC memory, where
+// battery mode has its WakeState, so they survive a reset; in battery mode's config
+// AP they are only kept in RAM.
+constexpr uint32_t STALL_LOG_MAGIC = 0x5354414C; // "STAL"
+
+struct StallState {
+  uint32_t magic;
+  uint32_t crc;            // over log
+  StallLog log;
+};
+static_assert(std::is_trivially_copyable<StallState>::value, "StallState is copied to RTC memory as bytes");
+static_assert(sizeof(StallState) % 4 == 0 && sizeof(StallState) <= 384, "StallState must fit the RTC user memory");
+
+StallState stallState;
+LoopWatch loopWatch;
+char httpBlame[STALL_NAME];   // path of a slow request, blamed for its iteration
+
+// Free heap, largest block and fragmentation per loop() pass, per second and per
+// web request (lib/HeapWatch), served at /api/heap
+HeapWatch heapWatch;
 
 /* ---------- helpers ------------------------------------------------------ */
+// One logged record as a line of text: seconds since boot, level, message
+size_t formatLogLine(char* out, size_t size, const LogRecord& r) {
+  int n = snprintf(out, size, "%6u.%03u %c ", (unsigned)(r.ms / 1000), (unsigned)(r.ms % 1000), logLevelChar(r.level));
+  if (n < 0 || (size_t)n + 2 > size) return 0;
+  const char* fmt = r.id < (uint8_t)LogMsg::Count ? LOG_FORMATS[r.id] : "unknown message";
+  n += logFormat(out + n, size - n - 1, fmt, r);
+  out[n++] = '\n';
+  out[n] = '\0';
+  return n;
+}
+
+// Print up to maxRecords logged records on Serial. Unless wait is set, stop at the
+// first one the UART buffer can't take without blocking. False once all are out.
+bool drainLog(uint8_t maxRecords, bool wait = false) {
+  LogRecord r;
+  char line[128];
+  for (uint8_t i = 0; i < maxRecords; ++i) {
+    uint32_t cursor = logSerialCursor;
+    if (!logRing.read(cursor, r)) return false;
+    size_t n = formatLogLine(line, sizeof(line), r);
+    if (!wait && Serial.availableForWrite() < (int)n) return true;
+    Serial.print(line);
+    logSerialCursor = cursor;
+  }
+  return true;
+}
+
+// Everything logged, before the CPU stops (deep sleep)
+void flushLog() {
+  while (drainLog(LOG_DRAIN_PER_LOOP, true)) {}
+}
+
 String macToString(const uint8_t* mac) {
   char buf[18];
   sprintf(buf,"%02X:%02X:%02X:%02X:%02X:%02X",
@@ -83,116 +401,338 @@ bool parseMac(const String& s, std::array<uint8_t,6>& out) {
         &out[0],&out[1],&out[2],&out[3],&out[4],&out[5])==6;
 }
 
+const char* sensorModeName(SensorMode mode) {
+  switch (mode) {
+    case SensorMode::SerialAuto: return "Serial, auto";
+    case SensorMode::SerialControlled: return "Serial, on request";
+    default: return "Trigger/echo";
+  }
+}
+
 void blink(uint8_t n, uint16_t d=150){
-  while(n--){ digitalWrite(LED_PIN,LOW); delay(d); digitalWrite(LED_PIN,HIGH); delay(d); }
+  while(n--){ hal.gpio->write(LED_PIN,LOW); hal.clock->delayMs(d); hal.gpio->write(LED_PIN,HIGH); hal.clock->delayMs(d); }
 }
 
 // Function declarations (prototypes)
 String getWiFiMac();
 String getEspNowMac();
 
-// Save configuration to EEPROM
-bool saveConfig(const Config& cfg) {
-  EEPROM.begin(EEPROM_SIZE);
-  
-  // Save parent MAC (6 bytes at address 0)
-  for (uint8_t i = 0; i < 6; ++i) {
-    EEPROM.write(i, cfg.parentMac[i]);
-  }
-  
-  // Save refresh rate (4 bytes at address 6)
-  for (uint8_t i = 0; i < 4; ++i) {
-    EEPROM.write(6 + i, (cfg.refreshRateMs >> (i * 8)) & 0xFF);
-  }
-  
-  // Save barrel height (4 bytes at address 10)
-  union {
-    float f;
-    uint32_t i;
-  } barrelUnion;
-  barrelUnion.f = cfg.barrelHeightCm;
-  for (uint8_t i = 0; i < 4; ++i) {
-    EEPROM.write(10 + i, (barrelUnion.i >> (i * 8)) & 0xFF);
-  }
-  
-  // Save LED setting (1 byte at address 14)
-  EEPROM.write(14, cfg.ledEnabled ? 0x01 : 0x00);
-  
-  // Save SSID prefix (16 bytes at address 15)
-  for (uint8_t i = 0; i < 16; ++i) {
-    EEPROM.write(15 + i, cfg.ssidPrefix[i]);
+// Config record fields (lib/ConfigStore). A tag is never reused: a new setting gets a
+// new tag, and fields missing from an older record keep their defaults.
+enum class ConfigTag : uint8_t {
+  ParentMac = 1,
+  RefreshRateMs = 2,
+  BarrelHeight = 3,
+  Led = 4,
+  SsidPrefix = 5,
+  WifiPassword = 6,
+  BurstSamples = 7,
+  FilterMode = 8,
+  BatchSize = 9,
+  BatchMaxAge = 10,
+  OutboxPolicy = 11,
+  LowPower = 12,
+  SensorMode = 13,
+  AirTemp = 14,
+  TempProbe = 15,
+  RefreshMaxMs = 16,
+  ReportDeadband = 17,
+  Heartbeat = 18,
+  LowAlarm = 19,
+  HighAlarm = 20,
+  TankShape = 21,
+  TankWidth = 22,
+  TankLength = 23,
+  StrapTable = 24,
+  MountHeight = 25,
+  Calibration = 26,
+  Channels = 27,
+  ChannelCalibration = 28,
+  StallThreshold = 29
+};
+
+// Schema of the record payload: 1 was the fixed-offset EEPROM layout (migrated on load)
+constexpr uint8_t CONFIG_SCHEMA = 2;
+
+// The additional sensors' pins are from CHANNEL_PINS, each used once
+bool channelPinsValid(const Config& cfg) {
+  uint8_t used = 0;   // bit per CHANNEL_PINS entry
+  for (uint8_t i = 0; i + 1 < cfg.channels; ++i) {
+    for (uint8_t pin : {cfg.extra[i].trigPin, cfg.extra[i].echoPin}) {
+      uint8_t k = 0;
+      while (k < sizeof(CHANNEL_PINS) && CHANNEL_PINS[k] != pin) ++k;
+      if (k == sizeof(CHANNEL_PINS) || (used & (1 << k))) return false;
+      used |= 1 << k;
+    }
   }
-  
-  // Save WiFi password (32 bytes at address 31)
-  for (uint8_t i = 0; i < 32; ++i) {
-    EEPROM.write(31 + i, cfg.wifiPassword[i]);
+  return true;
+}
+
+// Calibration coefficients as 12 bytes: offset, gain, quad (little-endian floats)
+void putCoeffs(uint8_t* bytes, const CalCoeffs& c) {
+  float cal[3] = {c.offset, c.gain, c.quad};
+  for (uint8_t i = 0; i < 3; ++i) {
+    uint32_t u;
+    memcpy(&u, &cal[i], 4);
+    for (uint8_t b = 0; b < 4; ++b) bytes[i * 4 + b] = (uint8_t)(u >> (8 * b));
   }
-  
-  // Write config marker (1 byte at address 63)
-  EEPROM.write(63, 0xAA); // Config marker
-  
-  bool success = EEPROM.commit();
-  EEPROM.end();
-  return success;
 }
 
-// Load configuration from EEPROM
-bool loadConfig(Config& cfg) {
-  EEPROM.begin(EEPROM_SIZE);
-  
-  // Check if config exists (config marker at address 63)
-  if (EEPROM.read(63) != 0xAA) {
-    EEPROM.end();
-    return false; // No config saved
+CalCoeffs getCoeffs(const uint8_t* v) {
+  CalCoeffs c;
+  c.offset = RecordReader::toFloat(v);
+  c.gain = RecordReader::toFloat(v + 4);
+  c.quad = RecordReader::toFloat(v + 8);
+  return c;
+}
+
+// Parse a field into cfg; out-of-range values keep the default
+void applyConfigField(Config& cfg, ConfigTag tag, const uint8_t* v, uint8_t len) {
+  switch (tag) {
+    case ConfigTag::ParentMac:
+      if (len == 6) memcpy(cfg.parentMac.data(), v, 6);
+      break;
+    case ConfigTag::RefreshRateMs:
+      if (len == 4) cfg.refreshRateMs = RecordReader::u32(v);
+      break;
+    case ConfigTag::BarrelHeight:
+      if (len == 4 && RecordReader::toFloat(v) > 0) cfg.barrelHeightCm = RecordReader::toFloat(v);
+      break;
+    case ConfigTag::Led:
+      if (len == 1) cfg.ledEnabled = v[0] != 0;
+      break;
+    case ConfigTag::SsidPrefix:
+      if (len < sizeof(cfg.ssidPrefix)) { memcpy(cfg.ssidPrefix, v, len); cfg.ssidPrefix[len] = 0; }
+      break;
+    case ConfigTag::WifiPassword:
+      if (len < sizeof(cfg.wifiPassword)) { memcpy(cfg.wifiPassword, v, len); cfg.wifiPassword[len] = 0; }
+      break;
+    case ConfigTag::BurstSamples:
+      if (len == 1 && v[0] >= 1 && v[0] <= MAX_BURST_SAMPLES) cfg.burstSamples = v[0];
+      break;
+    case ConfigTag::FilterMode:
+      if (len == 1) cfg.filterMode = v[0] == (uint8_t)FilterMode::TrimmedMean ? FilterMode::TrimmedMean : FilterMode::Median;
+      break;
+    case ConfigTag::BatchSize:
+      if (len == 1 && v[0] >= 1 && v[0] <= WIRE_MAX_SAMPLES) cfg.batchSize = v[0];
+      break;
+    case ConfigTag::BatchMaxAge:
+      if (len == 2 && RecordReader::u16(v) >= 1 && RecordReader::u16(v) <= 3600) cfg.batchMaxAgeS = RecordReader::u16(v);
+      break;
+    case ConfigTag::OutboxPolicy:
+      if (len == 1) cfg.outboxPolicy = v[0] == (uint8_t)OutboxPolicy::DropOldest ? OutboxPolicy::DropOldest : OutboxPolicy::Coalesce;
+      break;
+    case ConfigTag::LowPower:
+      if (len == 1) cfg.lowPower = v[0] != 0;
+      break;
+    case ConfigTag::SensorMode:
+      if (len == 1 && v[0] <= (uint8_t)SensorMode::SerialControlled) cfg.sensorMode = (SensorMode)v[0];
+      break;
+    case ConfigTag::AirTemp:
+      if (len == 1 && (int8_t)v[0] >= SOUND_TEMP_MIN && (int8_t)v[0] <= SOUND_TEMP_MAX) cfg.airTempC = (int8_t)v[0];
+      break;
+    case ConfigTag::TempProbe:
+      if (len == 1) cfg.tempProbe = v[0] != 0;
+      break;
+    case ConfigTag::RefreshMaxMs:
+      if (len == 4) cfg.refreshMaxMs = RecordReader::u32(v);
+      break;
+    case ConfigTag::ReportDeadband:
+      if (len == 2 && RecordReader::u16(v) <= 1000) cfg.reportDeadband = RecordReader::u16(v);
+      break;
+    case ConfigTag::Heartbeat:
+      if (len == 2 && RecordReader::u16(v) >= 10) cfg.heartbeatS = RecordReader::u16(v);
+      break;
+    case ConfigTag::LowAlarm:
+      if (len == 1 && v[0] <= 100) cfg.lowAlarmPct = v[0];
+      break;
+    case ConfigTag::HighAlarm:
+      if (len == 1 && v[0] <= 100) cfg.highAlarmPct = v[0];
+      break;
+    case ConfigTag::TankShape:
+      if (len == 1 && v[0] < TANK_SHAPES) cfg.tankShape = (TankShape)v[0];
+      break;
+    case ConfigTag::TankWidth:
+      if (len == 4 && RecordReader::toFloat(v) > 0) cfg.tankWidthCm = RecordReader::toFloat(v);
+      break;
+    case ConfigTag::TankLength:
+      if (len == 4 && RecordReader::toFloat(v) > 0) cfg.tankLengthCm = RecordReader::toFloat(v);
+      break;
+    case ConfigTag::MountHeight:
+      if (len == 4 && RecordReader::toFloat(v) >= 0) cfg.mountCm = RecordReader::toFloat(v);
+      break;
+    case ConfigTag::Calibration:
+      if (len == 12) {
+        cfg.cal = getCoeffs(v);
+        cfg.calibrated = cfg.cal.gain < 0;
+      }
+      break;
+    case ConfigTag::Channels:
+      // Count, then per additional sensor: TRIG, ECHO, barrel and mount height 0.1 cm
+      if (len == 1 + 6 * (SENSOR_CHANNELS - 1) && v[0] >= 1 && v[0] <= SENSOR_CHANNELS) {
+        cfg.channels = v[0];
+        for (uint8_t i = 0; i < SENSOR_CHANNELS - 1; ++i, v += 6) {
+          ChannelConfig& c = cfg.extra[i];
+          c.trigPin = v[1];
+          c.echoPin = v[2];
+          if (RecordReader::u16(v + 3) > 0) c.barrelHeightCm = RecordReader::u16(v + 3) / 10.0f;
+          c.mountCm = RecordReader::u16(v + 5) / 10.0f;
+        }
+        if (!channelPinsValid(cfg)) cfg.channels = 1;
+      }
+      break;
+    case ConfigTag::ChannelCalibration:
+      // Per additional sensor as in Calibration; a gain of 0 is not calibrated
+      if (len == 12 * (SENSOR_CHANNELS - 1)) {
+        for (uint8_t i = 0; i < SENSOR_CHANNELS - 1; ++i, v += 12) {
+          cfg.extra[i].cal = getCoeffs(v);
+          cfg.extra[i].calibrated = cfg.extra[i].cal.gain < 0;
+        }
+      }
+      break;
+    case ConfigTag::StallThreshold:
+      if (len == 2 && RecordReader::u16(v) >= 10 && RecordReader::u16(v) <= 10000) cfg.stallMs = RecordReader::u16(v);
+      break;
+    case ConfigTag::StrapTable:
+      if (len % 6 == 0 && len / 6 <= TANK_MAX_STRAP_POINTS) {
+        cfg.strapPoints = len / 6;
+        for (uint8_t i = 0; i < cfg.strapPoints; ++i, v += 6) {
+          cfg.strap[i].level = RecordReader::u16(v);
+          cfg.strap[i].volume = RecordReader::u32(v + 2);
+        }
+      }
+      break;
   }
-  
-  // Load parent MAC (6 bytes at address 0)
-  for (uint8_t i = 0; i < 6; ++i) {
-    cfg.parentMac[i] = EEPROM.read(i);
+}
+
+// Read the fixed-offset layout that older firmware wrote with the EEPROM library
+// (start of flash sector 0): 0 MAC, 6 refresh, 10 barrel, 14 LED, 15 SSID prefix,
+// 31 password, 63 marker 0xAA, 64 burst, 65 filter, 66 batch, 67 batch age, 69 outbox, 70 sleep
+bool loadLegacyConfig(Config& cfg) {
+  alignas(4) uint8_t e[72];
+  if (!hal.flash->read(0, 0, e, sizeof(e)) || e[63] != 0xAA) return false;
+  
+  // Bytes 64..70 are 0xFF (erased) in configs saved before those settings existed
+  applyConfigField(cfg, ConfigTag::ParentMac, e, 6);
+  applyConfigField(cfg, ConfigTag::RefreshRateMs, e + 6, 4);
+  applyConfigField(cfg, ConfigTag::BarrelHeight, e + 10, 4);
+  cfg.ledEnabled = e[14] == 0x01;
+  applyConfigField(cfg, ConfigTag::SsidPrefix, e + 15, strnlen((const char*)e + 15, 15));
+  applyConfigField(cfg, ConfigTag::WifiPassword, e + 31, strnlen((const char*)e + 31, 31));
+  applyConfigField(cfg, ConfigTag::BurstSamples, e + 64, 1);
+  applyConfigField(cfg, ConfigTag::FilterMode, e + 65, 1);
+  applyConfigField(cfg, ConfigTag::BatchSize, e + 66, 1);
+  applyConfigField(cfg, ConfigTag::BatchMaxAge, e + 67, 2);
+  applyConfigField(cfg, ConfigTag::OutboxPolicy, e + 69, 1);
+  cfg.lowPower = e[70] == 0x01;
+  return true;
+}
+
+// Save configuration to flash (only written if a field changed)
+bool saveConfig(const Config& cfg) {
+  uint8_t payload[CONFIG_MAX_PAYLOAD];
+  RecordWriter w(payload, sizeof(payload));
+  w.put((uint8_t)ConfigTag::ParentMac, cfg.parentMac.data(), 6);
+  w.putU32((uint8_t)ConfigTag::RefreshRateMs, cfg.refreshRateMs);
+  w.putFloat((uint8_t)ConfigTag::BarrelHeight, cfg.barrelHeightCm);
+  w.putU8((uint8_t)ConfigTag::Led, cfg.ledEnabled);
+  w.putString((uint8_t)ConfigTag::SsidPrefix, cfg.ssidPrefix);
+  w.putString((uint8_t)ConfigTag::WifiPassword, cfg.wifiPassword);
+  w.putU8((uint8_t)ConfigTag::BurstSamples, cfg.burstSamples);
+  w.putU8((uint8_t)ConfigTag::FilterMode, (uint8_t)cfg.filterMode);
+  w.putU8((uint8_t)ConfigTag::BatchSize, cfg.batchSize);
+  w.putU16((uint8_t)ConfigTag::BatchMaxAge, cfg.batchMaxAgeS);
+  w.putU8((uint8_t)ConfigTag::OutboxPolicy, (uint8_t)cfg.outboxPolicy);
+  w.putU8((uint8_t)ConfigTag::LowPower, cfg.lowPower);
+  w.putU8((uint8_t)ConfigTag::SensorMode, (uint8_t)cfg.sensorMode);
+  w.putU8((uint8_t)ConfigTag::AirTemp, (uint8_t)cfg.airTempC);
+  w.putU8((uint8_t)ConfigTag::TempProbe, cfg.tempProbe);
+  w.putU32((uint8_t)ConfigTag::RefreshMaxMs, cfg.refreshMaxMs);
+  w.putU16((uint8_t)ConfigTag::ReportDeadband, cfg.reportDeadband);
+  w.putU16((uint8_t)ConfigTag::Heartbeat, cfg.heartbeatS);
+  w.putU8((uint8_t)ConfigTag::LowAlarm, cfg.lowAlarmPct);
+  w.putU8((uint8_t)ConfigTag::HighAlarm, cfg.highAlarmPct);
+  w.putU8((uint8_t)ConfigTag::TankShape, (uint8_t)cfg.tankShape);
+  w.putFloat((uint8_t)ConfigTag::TankWidth, cfg.tankWidthCm);
+  w.putFloat((uint8_t)ConfigTag::TankLength, cfg.tankLengthCm);
+  if (cfg.strapPoints) {
+    uint8_t strap[TANK_MAX_STRAP_POINTS * 6];
+    for (uint8_t i = 0; i < cfg.strapPoints; ++i) {
+      uint8_t* p = strap + i * 6;
+      p[0] = cfg.strap[i].level & 0xFF;
+      p[1] = cfg.strap[i].level >> 8;
+      for (uint8_t b = 0; b < 4; ++b) p[2 + b] = (uint8_t)(cfg.strap[i].volume >> (8 * b));
+    }
+    w.put((uint8_t)ConfigTag::StrapTable, strap, cfg.strapPoints * 6);
   }
-  
-  // Load refresh rate (4 bytes at address 6)
-  cfg.refreshRateMs = 0;
-  for (uint8_t i = 0; i < 4; ++i) {
-    cfg.refreshRateMs |= ((uint32_t)EEPROM.read(6 + i)) << (i * 8);
+  w.putFloat((uint8_t)ConfigTag::MountHeight, cfg.mountCm);
+  if (cfg.calibrated) {
+    uint8_t bytes[12];
+    putCoeffs(bytes, cfg.cal);
+    w.put((uint8_t)ConfigTag::Calibration, bytes, sizeof(bytes));
   }
-  
-  // Load barrel height (4 bytes at address 10)
-  union {
-    float f;
-    uint32_t i;
-  } barrelUnion;
-  barrelUnion.i = 0;
-  for (uint8_t i = 0; i < 4; ++i) {
-    barrelUnion.i |= ((uint32_t)EEPROM.read(10 + i)) << (i * 8);
+  if (cfg.channels > 1) {
+    uint8_t bytes[1 + 6 * (SENSOR_CHANNELS - 1)] = {cfg.channels};
+    uint8_t cal[12 * (SENSOR_CHANNELS - 1)] = {};
+    bool calibrated = false;
+    for (uint8_t i = 0; i < SENSOR_CHANNELS - 1; ++i) {
+      const ChannelConfig& c = cfg.extra[i];
+      uint16_t barrel = (uint16_t)lroundf(c.barrelHeightCm * 10);
+      uint16_t mount = (uint16_t)lroundf(c.mountCm * 10);
+      uint8_t* p = bytes + 1 + 6 * i;
+      p[0] = c.trigPin;
+      p[1] = c.echoPin;
+      p[2] = barrel & 0xFF;
+      p[3] = barrel >> 8;
+      p[4] = mount & 0xFF;
+      p[5] = mount >> 8;
+      if (c.calibrated) {
+        putCoeffs(cal + 12 * i, c.cal);
+        calibrated = true;
+      }
+    }
+    w.put((uint8_t)ConfigTag::Channels, bytes, sizeof(bytes));
+    if (calibrated) w.put((uint8_t)ConfigTag::ChannelCalibration, cal, sizeof(cal));
   }
-  cfg.barrelHeightCm = barrelUnion.f;
-  
-  // Load LED setting (1 byte at address 14)
-  cfg.ledEnabled = (EEPROM.read(14) == 0x01);
-  
-  // Load SSID prefix (16 bytes at address 15)
-  for (uint8_t i = 0; i < 16; ++i) {
-    cfg.ssidPrefix[i] = EEPROM.read(15 + i);
+  w.putU16((uint8_t)ConfigTag::StallThreshold, cfg.stallMs);
+  if (!w.ok()) return false;
+  
+  ConfigStore::SaveResult result = configStore.save(payload, w.length(), CONFIG_SCHEMA);
+  Serial.printf("Config save: %s (generation %u, %u bytes free)\n",
+                result == ConfigStore::SaveResult::Written ? "written" :
+                result == ConfigStore::SaveResult::Unchanged ? "unchanged" : "FAILED",
+                configStore.generation(), (unsigned)configStore.freeBytes());
+  return result != ConfigStore::SaveResult::Failed;
+}
+
+// Load configuration from flash, migrating the old EEPROM layout on first boot
+bool loadConfig(Config& cfg) {
+  cfg = Config();
+  configStore.begin(*hal.flash);
+  
+  uint8_t payload[CONFIG_MAX_PAYLOAD];
+  size_t len;
+  uint8_t schema;
+  if (configStore.load(payload, len, schema)) {
+    RecordReader r(payload, len);
+    uint8_t tag, fieldLen;
+    const uint8_t* value;
+    while (r.next(tag, value, fieldLen)) {
+      applyConfigField(cfg, (ConfigTag)tag, value, fieldLen);
+    }
+    return true;
   }
   
-  // Load WiFi password (32 bytes at address 31)
-  for (uint8_t i = 0; i < 32; ++i) {
-    cfg.wifiPassword[i] = EEPROM.read(31 + i);
+  if (loadLegacyConfig(cfg)) {
+    saveConfig(cfg);
+    return true;
   }
-  
-  EEPROM.end();
-  return true;
+  return false; // No config saved
 }
 
 // Clear configuration
 void clearConfig() {
-  EEPROM.begin(EEPROM_SIZE);
-  for (uint8_t i = 0; i < EEPROM_SIZE; ++i) {
-    EEPROM.write(i, 0xFF);
-  }
-  EEPROM.commit();
-  EEPROM.end();
+  configStore.erase();
 }
 
 // Convert milliseconds to minutes and seconds
@@ -209,15 +749,14 @@ uint32_t minSecToMs(uint8_t minutes, uint8_t seconds) {
 // ESP-NOW callback function
 void onEspNowSend(uint8_t* mac, uint8_t status) {
   espNowSendSuccess = (status == 0);
-  
-  // Log the MAC address that was sent to
-  char macStr[18];
-  sprintf(macStr, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  ++espNowCallbacks;
+  espNowOutbox.onResult(espNowSendSuccess, hal.clock->millis());
+  scheduleOutbox();
   
   if (espNowSendSuccess) {
-    Serial.printf("ESP-NOW send: OK → %s\n", macStr);
+    LOG_INFO(LogMsg::EspNowAcked);
   } else {
-    Serial.printf("ESP-NOW send: FAIL → %s (Error code: %d)\n", macStr, status);
+    LOG_WARN(LogMsg::EspNowFailed, status);
   }
 }
 
@@ -225,18 +764,25 @@ void onEspNowSend(uint8_t* mac, uint8_t status) {
 bool initEspNow() {
   Serial.println("=== ESP-NOW INITIALIZATION ===");
   
-  if (esp_now_init() != 0) {
+  if (hal.radio->init() != 0) {
     Serial.println("ESP-NOW init failed");
     return false;
   }
   Serial.println("ESP-NOW init: OK");
   
-  esp_now_set_self_role(ESP_NOW_ROLE_CONTROLLER);
+  hal.radio->setControllerRole();
   Serial.println("ESP-NOW role: CONTROLLER");
   
-  esp_now_register_send_cb(onEspNowSend);
+  hal.radio->registerSendCallback(onEspNowSend);
   Serial.println("ESP-NOW callback: Registered");
   
+  // Seed the retry jitter per device so sensors sharing a parent don't retry in lockstep
+  uint8_t mac[6];
+  hal.wifi->macAddress(mac);
+  espNowOutbox.begin(ESP_NOW_BACKOFF_MIN_MS, ESP_NOW_BACKOFF_MAX_MS, ESP_NOW_ACK_TIMEOUT_MS,
+                     (uint32_t)mac[2] << 24 | mac[3] << 16 | mac[4] << 8 | mac[5]);
+  espNowOutbox.setPolicy(config.outboxPolicy);
+  
   // Check if parent MAC is not default (FF:FF:FF:FF:FF:FF)
   bool isDefaultMac = true;
   for (int i = 0; i < 6; i++) {
@@ -253,7 +799,7 @@ bool initEspNow() {
   }
   
   Serial.printf("Adding peer: %s\n", macToString(config.parentMac.data()).c_str());
-  if (esp_now_add_peer(config.parentMac.data(), ESP_NOW_ROLE_SLAVE, WIFI_CH, NULL, 0) != 0) {
+  if (hal.radio->addPeer(config.parentMac.data(), WIFI_CH) != 0) {
     Serial.println("ESP-NOW add peer failed");
     Serial.println("=== ESP-NOW INIT FAILED ===");
     return false;
@@ -265,76 +811,478 @@ bool initEspNow() {
   return true;
 }
 
-// Send data via ESP-NOW
+// The config of a channel; channel 0's is spread over the main fields of Config
+ChannelConfig channelConfig(const Config& cfg, uint8_t channel) {
+  if (channel) return cfg.extra[channel - 1];
+  return ChannelConfig{(uint8_t)TRIG_PIN, (uint8_t)ECHO_PIN, cfg.barrelHeightCm, cfg.mountCm, cfg.calibrated, cfg.cal};
+}
+
+// Load each channel's pins and distance → height coefficients: the fitted ones, or
+// straight down from the mount
+void applyCalibration() {
+  for (uint8_t i = 0; i < SENSOR_CHANNELS; ++i) {
+    ChannelConfig cc = channelConfig(config, i);
+    SensorChannel& ch = channels[i];
+    CalCoeffs c;
+    if (cc.calibrated) {
+      c = cc.cal;
+    } else {
+      c.offset = cc.barrelHeightCm + cc.mountCm;
+    }
+    ch.trigPin = cc.trigPin;
+    ch.echoPin = cc.echoPin;
+    ch.barrelHeightCm = cc.barrelHeightCm;
+    ch.calibration.set(c);
+    ch.fullDistanceCm = ch.calibration.distanceAt(cc.barrelHeightCm);
+    ch.emptyDistanceCm = ch.calibration.distanceAt(0);
+  }
+}
+
+// Feed the tracker the water height above the bottom, unclamped so the rate stays
+// right near empty and full. No echo, or above the full level (which
+// calculateWaterLevel reads as 0 %), is a miss.
+void trackLevel(uint32_t nowMs, float distance) {
+  float height = distance < 0 ? 0 : channels[0].calibration.heightCm(distance);
+  if (distance < 0 || height > config.barrelHeightCm) {
+    levelTracker.miss();
+  } else {
+    levelTracker.update(nowMs, height);
+  }
+  float level = levelTracker.valid() ? levelTracker.levelCm(nowMs) / config.barrelHeightCm * 100.0f : 0.0f;
+  currentTrackedLevel = level < 0.0f ? 0.0f : level > 100.0f ? 100.0f : level;
+}
+
+// Pick the time to the next reading from the track (lib/AdaptiveInterval)
+void adaptInterval() {
+  uint32_t before = readInterval.intervalMs();
+  if (readInterval.update(levelTracker.confidence(), levelTracker.rateCmPerMin(), levelTracker.scatterCm())) {
+    LOG_INFO(LogMsg::IntervalChanged, before, readInterval.intervalMs(), intervalReasonName(readInterval.reason()));
+  }
+}
+
+// The tank part of the config (lib/TankGeometry)
+TankDims tankDims(const Config& cfg) {
+  TankDims d;
+  d.shape = cfg.tankShape;
+  d.heightCm = cfg.barrelHeightCm;
+  d.widthCm = cfg.tankWidthCm;
+  d.lengthCm = cfg.tankLengthCm;
+  memcpy(d.strap, cfg.strap, sizeof(d.strap));
+  d.strapPoints = cfg.strapPoints;
+  return d;
+}
+
+// Liters at a water level in % of the barrel height, -1 without an echo or a tank shape
+float levelLiters(float levelPct) {
+  if (levelPct < 0) return -1.0f;
+  return tank.liters(levelPct / 100.0f * config.barrelHeightCm);
+}
+
+// Sender id for an ESP-NOW header: the last byte of the station MAC, so a parent
+// can tell its boards apart in logged or forwarded frames
+uint8_t wireSensorId() {
+  uint8_t mac[6];
+  hal.wifi->stationMac(mac);
+  return mac[5];
+}
+
+// Tracker state of the newest reading, for an ESP-NOW header
+void putTrack(WireHeader& header) {
+  header.trackedLevel = wireLevel(currentTrackedLevel);
+  header.levelRate = wireRate(levelTracker.rateCmPerMin());
+  header.confidence = levelTracker.confidence();
+  header.trackedVolume = wireVolume(levelTracker.valid() ? levelLiters(currentTrackedLevel) : -1.0f);
+  header.capacity = wireVolume(tank.capacityLiters());
+}
+
+// Run the outbox task when the outbox next has something to do (a send, a retry or
+// an ack timeout), not at all while it is empty
+void scheduleOutbox() {
+  uint32_t dueMs;
+  if (espNowOutbox.nextDue(dueMs)) {
+    timers.schedule(outboxTask, dueMs);
+  } else {
+    timers.cancel(outboxTask);
+  }
+}
+
+// Transmit the oldest outbox frame if it is due (first try or backoff expired)
+void serviceEspNowOutbox() {
+  espNowOutbox.service(hal.clock->millis(), [](const uint8_t* data, size_t len, uint16_t seq, uint8_t attempt) {
+    if (attempt > 1) {
+      LOG_WARN(LogMsg::EspNowRetry, seq, attempt);
+    }
+    int result = hal.radio->send(config.parentMac.data(), data, len);
+    if (result != 0) {
+      LOG_ERROR(LogMsg::EspNowRadioError, result);
+      espNowSendSuccess = false;
+    } else {
+      LOG_DEBUG(LogMsg::EspNowRequested);
+    }
+    lastEspNowSend = hal.clock->millis();
+    return result;
+  });
+  scheduleOutbox();
+}
+
+// Pack the batched readings into one frame and queue it for sending
 void sendEspNowData() {
+  PERF_SCOPE(perfSend);
   if (!espNowInitialized) {
-    Serial.println("ESP-NOW send: Skipped (not initialized)");
+    LOG_DEBUG(LogMsg::EspNowNotReady);
     return;
   }
+  if (espNowBatch.count() == 0) return;
+  
+  WireHeader header;
+  header.flags = espNowFirstFrame ? WIRE_FLAG_BOOT : 0;
+  header.sensorId = wireSensorId();
+  header.seq = espNowSeq++;
+  header.uptimeSec = history.nowSec(hal.clock->millis());
+  header.barrelHeight = wireDistance(config.barrelHeightCm);
+  header.airTemp = wireTemp(soundSpeed.temperatureC());
+  putTrack(header);
+  uint8_t frame[WIRE_MAX_FRAME];
+  size_t len = espNowBatch.encode(header, frame, sizeof(frame));
+  espNowFirstFrame = false;
+  
+  uint8_t count = espNowBatch.count();
+  espNowBatch.clear();
+  timers.cancel(batchAgeTask);
+  espNowOutbox.push(header.seq, frame, len, hal.clock->millis());
+  LOG_INFO(LogMsg::EspNowFrame, header.seq, count, len, currentDistance, currentWaterLevel, espNowOutbox.size());
+  serviceEspNowOutbox();
+}
+
+// Add a channel's reading to the ESP-NOW batch (sent by the caller once due)
+void batchEspNowReading(float distance, float waterLevel, uint8_t quality, uint8_t channel) {
+  if (espNowBatch.count() == 0) {
+    espNowBatchStartMs = hal.clock->millis();
+    timers.schedule(batchAgeTask, espNowBatchStartMs + config.batchMaxAgeS * 1000UL);
+  }
+  espNowBatch.add(history.lastSampleSec(), distance, waterLevel, quality, channel);
+}
+
+// Send the batch once it holds config.batchSize readings (or no more fit)
+void sendEspNowIfDue() {
+  LOG_DEBUG(LogMsg::EspNowBatch, espNowBatch.count(), config.batchSize);
+  if (espNowBatch.count() >= config.batchSize || espNowBatch.full()) {
+    sendEspNowData();
+  }
+}
+
+// Queue a reading of the main sensor for ESP-NOW; the frame goes out once the batch is full
+void queueEspNowReading(float distance, float waterLevel, uint8_t quality) {
+  batchEspNowReading(distance, waterLevel, quality, 0);
+  sendEspNowIfDue();
+}
+
+// ECHO pin interrupts: both edges arrive timestamped with the CPU cycle counter. Each
+// channel has its own, and only the one whose ping is in flight feeds the capture (a
+// module that ignored its trigger, or still holds ECHO from a ping it was passed over
+// for, must not end another channel's ping).
+void IRAM_ATTR onEchoEdge0(bool level, uint32_t cycles) {
+  if (echoChannel == 0) echoCapture.onEdge(level, cycles);
+}
+
+void IRAM_ATTR onEchoEdge1(bool level, uint32_t cycles) {
+  if (echoChannel == 1) echoCapture.onEdge(level, cycles);
+}
+
+void IRAM_ATTR onEchoEdge2(bool level, uint32_t cycles) {
+  if (echoChannel == 2) echoCapture.onEdge(level, cycles);
+}
+
+const EdgeCallback echoEdgeHandlers[] = {onEchoEdge0, onEchoEdge1, onEchoEdge2};
+static_assert(sizeof(echoEdgeHandlers) / sizeof(echoEdgeHandlers[0]) == SENSOR_CHANNELS, "one ECHO handler per channel");
+
+// Listen only for echoes from the water surface: from GATE_NEAR_MARGIN_CM above the
+// full level down to GATE_FAR_MARGIN_CM below the bottom. Pings then end as soon as
+// that window has passed instead of after the sensor's full 5 m, and the next one
+// follows right after (but never while the module still holds ECHO high). With
+// several sensors the next one waits for the larger window of the two, so neither
+// hears the other's echo (lib/PingScheduler).
+// Serial frames are held to the same window by the sample labels (lib/EchoQuality).
+void updateRangeGate() {
+  bool triggerEcho = config.sensorMode == SensorMode::TriggerEcho;
+  for (uint8_t i = 0; i < SENSOR_CHANNELS; ++i) {
+    SensorChannel& ch = channels[i];
+    float nearCm = ch.fullDistanceCm - GATE_NEAR_MARGIN_CM > SENSOR_MIN_RANGE_CM ?
+                   ch.fullDistanceCm - GATE_NEAR_MARGIN_CM : SENSOR_MIN_RANGE_CM;
+    float farCm = ch.emptyDistanceCm + GATE_FAR_MARGIN_CM;
+    ch.gate.nearUs = soundSpeed.echoUs(nearCm);
+    ch.gate.farUs = soundSpeed.echoUs(farCm);
+    if (ch.gate.farUs > ECHO_TIMEOUT_US - ECHO_RISE_MAX_US) ch.gate.farUs = ECHO_TIMEOUT_US - ECHO_RISE_MAX_US;
+    ch.gate.timeoutUs = ch.gate.farUs + ECHO_RISE_MAX_US;
+    ch.gateNearCm = nearCm;
+    ch.gateFarCm = triggerEcho ? soundSpeed.distanceCm(ch.gate.farUs) : farCm;
+    pingScheduler.setWindow(i, triggerEcho ? ch.gate.timeoutUs : SENSOR_REARM_MS * 1000);
+  }
+  pingScheduler.setGuard(triggerEcho ? ECHO_SETTLE_US : 0);
+}
+
+// The gate is in echo time, so it moves with the speed of sound
+void setAirTemperature(int16_t sixteenths) {
+  soundSpeed.setTemperature(sixteenths);
+  updateRangeGate();
+}
+
+// Start from the configured air temperature; with a probe, the first conversion
+// starts on the next updateTemperature()
+void initTemperature() {
+  setAirTemperature(config.airTempC * 16);
+  probeOk = false;
+  probeConverting = false;
+  probeFound = config.tempProbe && hal.probe->begin(PROBE_PIN);
+  probeStartMs = hal.clock->millis() - PROBE_REFRESH_MS;
+  if (config.tempProbe && !probeFound) {
+    Serial.println("Temperature probe: not found, using the configured air temperature");
+  }
+}
+
+// Take the finished conversion; on failure fall back to the configured temperature
+void readProbe() {
+  int16_t t16;
+  probeConverting = false;
+  if (!hal.probe->read(t16) || t16 < SOUND_TEMP_MIN * 16 || t16 > SOUND_TEMP_MAX * 16) {
+    ++probeErrors;
+    probeOk = false;
+    setAirTemperature(config.airTempC * 16);
+    return;
+  }
+  probeOk = true;
+  if (t16 != soundSpeed.temperature16()) {
+    setAirTemperature(t16);
+    LOG_INFO(LogMsg::AirTemperature, soundSpeed.temperatureC(), soundSpeed.metersPerSecond());
+  }
+}
+
+// Never blocks: starts a conversion every PROBE_REFRESH_MS and reads it once finished
+void updateTemperature() {
+  if (!probeFound) return;
+  uint32_t now = hal.clock->millis();
+  if (probeConverting) {
+    if (now - probeStartMs >= PROBE_CONVERSION_MS) readProbe();
+  } else if (now - probeStartMs >= PROBE_REFRESH_MS) {
+    probeStartMs = now;
+    probeConverting = hal.probe->startConversion();
+    if (!probeConverting) ++probeErrors;
+  }
+}
+
+// Set up the sensor pins for config.sensorMode (the serial modes have one sensor)
+void initSensor() {
+  burstActive = false;
+  channelCount = config.sensorMode == SensorMode::TriggerEcho ? config.channels : 1;
+  updateRangeGate();
+  if (config.sensorMode == SensorMode::TriggerEcho) {
+    echoCapture.begin(hal.clock->cpuMhz());
+    for (uint8_t i = 0; i < channelCount; ++i) {
+      hal.gpio->mode(channels[i].trigPin, PinMode::Output);
+      hal.gpio->mode(channels[i].echoPin, PinMode::Input);
+      hal.gpio->attachEdgeInterrupt(channels[i].echoPin, echoEdgeHandlers[i]);
+    }
+    return;
+  }
+  // Serial modes: the module sends on its ECHO pin and listens on TRIG
+  hal.uart->begin(SerialRanger::BAUD, ECHO_PIN, TRIG_PIN);
+  serialRanger.begin(*hal.uart, config.sensorMode == SensorMode::SerialAuto ? RangerMode::Auto : RangerMode::Controlled);
+}
+
+// Fire the channel's trigger pulse and arm the echo capture (does not wait for the echo).
+// In the serial modes: wait for the next frame, requesting it in Controlled mode.
+void startDistanceMeasurement(uint8_t channel) {
+  activeChannel = channel;
+  if (config.sensorMode != SensorMode::TriggerEcho) {
+    serialRanger.start(hal.clock->millis(), SERIAL_PING_TIMEOUT_MS);
+    return;
+  }
+  const SensorChannel& ch = channels[channel];
+  echoChannel = channel;
   
-  // Prepare payload
-  payload.distance = currentDistance;
-  payload.waterLevel = currentWaterLevel;
-  payload.barrelHeight = config.barrelHeightCm;
+  // Clear the trigger pin
+  hal.gpio->write(ch.trigPin, LOW);
+  hal.clock->delayUs(2);
   
-  Serial.println("=== ESP-NOW SENDING DATA ===");
-  Serial.printf("Target MAC: %s\n", macToString(config.parentMac.data()).c_str());
-  Serial.printf("Payload: Distance=%.1f cm, Water=%.1f%%, Barrel=%.1f cm\n", 
-                payload.distance, payload.waterLevel, payload.barrelHeight);
-  Serial.printf("Payload size: %d bytes\n", sizeof(payload));
+  // Send 10 microsecond pulse
+  hal.gpio->write(ch.trigPin, HIGH);
+  hal.clock->delayUs(10);
+  hal.gpio->write(ch.trigPin, LOW);
   
-  // Send data
-  uint8_t result = esp_now_send(config.parentMac.data(), (uint8_t*)&payload, sizeof(payload));
-  if (result != 0) {
-    Serial.printf("ESP-NOW send failed with error code: %d\n", result);
-    espNowSendSuccess = false;
-  } else {
-    Serial.println("ESP-NOW send: Request sent successfully (waiting for callback)");
+  echoCapture.arm(hal.clock->cycleCount(), ch.gate);
+}
+
+// Serial modes: parse what the UART received so far (the module did the timing)
+bool pollSerialDistanceCM(float& distance, uint32_t& raw) {
+  uint16_t mm;
+  SerialRanger::Status status = serialRanger.poll(hal.clock->millis(), mm);
+  if (status == SerialRanger::Status::Pending || status == SerialRanger::Status::Idle) {
+    return false;
   }
   
-  lastEspNowSend = millis();
+  if (status == SerialRanger::Status::Timeout || mm == 0) {
+    LOG_DEBUG(LogMsg::SerialNoReading, status == SerialRanger::Status::Timeout ? "timeout" : "no echo");
+    distance = -1;
+    return true;
+  }
+  
+  // Over-range frames (the module's own no-echo value) are left to the range
+  // gate: beyond EchoExpect::farCm they are labelled over-range
+  raw = mm;
+  distance = mm / 10.0f;
+  LOG_DEBUG(LogMsg::SerialFrame, mm);
+  return true;
 }
 
-// Measure distance using ultrasonic sensor
-float measureDistanceCM() {
-  // Clear the trigger pin
-  digitalWrite(TRIG_PIN, LOW);
-  delayMicroseconds(2);
-  
-  // Send 10 microsecond pulse
-  digitalWrite(TRIG_PIN, HIGH);
-  delayMicroseconds(10);
-  digitalWrite(TRIG_PIN, LOW);
+// Check the armed measurement of channel ch without blocking.
+// Returns true once it finished; distance is in cm (also outside the range gate), or
+// -1 on timeout. raw is what the sensor gave (echo µs, serial mm) for stuck detection.
+bool pollDistanceCM(SensorChannel& ch, float& distance, uint32_t& raw) {
+  if (config.sensorMode != SensorMode::TriggerEcho) return pollSerialDistanceCM(distance, raw);
+  
+  EchoSample sample;
+  EchoCapture::Status status = echoCapture.poll(hal.clock->cycleCount(), sample);
+  if (status == EchoCapture::Status::Pending || status == EchoCapture::Status::Idle) {
+    return false;
+  }
   
-  // Measure the response with timeout (30ms = 30,000 microseconds)
-  long duration = pulseIn(ECHO_PIN, HIGH, 30000);
+  if (status == EchoCapture::Status::Timeout || sample.durationUs == 0) {
+    LOG_DEBUG(LogMsg::PingTimeout, activeChannel);
+    ++ch.pingsTimedOut;
+    distance = -1; // Timeout/no reading
+    return true;
+  }
   
-  Serial.printf("Sensor Debug - Raw duration: %ld microseconds\n", duration);
+  // Calculate distance in cm at the current air temperature
+  raw = sample.durationUs;
+  distance = soundSpeed.distanceCm(sample.durationUs);
+  if (status == EchoCapture::Status::Rejected) {
+    LOG_DEBUG(LogMsg::PingRejected, activeChannel, distance);
+    ++ch.pingsRejected;
+    return true;
+  }
+  ++ch.pingsValid;
+  LOG_DEBUG(LogMsg::PingDistance, activeChannel, sample.durationUs, distance, soundSpeed.temperatureC());
   
-  if (duration == 0) {
-    Serial.println("Sensor Debug - Timeout or no echo received");
-    return -1; // Timeout/no reading
+  return true;
+}
+
+// Trigger the channel whose turn it is once the gap since the last ping has passed
+// (lib/PingScheduler). After a far or missing echo a module holds ECHO high past the
+// gate and ignores triggers until it drops: it is passed over until then.
+void firePing() {
+  uint32_t now = hal.clock->micros();
+  if (pingScheduler.next(now, 0) < 0) return;
+  uint8_t busy = 0;
+  if (config.sensorMode == SensorMode::TriggerEcho) {
+    for (uint8_t i = 0; i < channelCount; ++i) {
+      if (hal.gpio->read(channels[i].echoPin) == HIGH) busy |= 1 << i;
+    }
+  }
+  int8_t channel = pingScheduler.next(now, busy);
+  if (channel < 0) return;
+  pingScheduler.fired(channel, now);
+  startDistanceMeasurement(channel);
+}
+
+// Start a burst of config.burstSamples pings per channel. Its pings are labelled against
+// each channel's range gate; channel 0's also, once the track is confident, against the
+// level it predicts for trackMs (the tracker's clock: it runs across deep sleeps in
+// battery mode).
+void startBurst(uint32_t trackMs) {
+  for (uint8_t i = 0; i < channelCount; ++i) {
+    SensorChannel& ch = channels[i];
+    ch.expect.nearCm = ch.gateNearCm;
+    ch.expect.farCm = ch.gateFarCm;
+    ch.expect.tracked = false;
+    ch.echo.beginBurst();
+    ch.filter.reset();
+  }
+  EchoExpect& expect = channels[0].expect;
+  expect.tracked = levelTracker.confidence() >= ECHO_JUMP_CONFIDENCE;
+  expect.heightCm = levelTracker.levelCm(trackMs);
+  expect.toleranceCm = levelTracker.toleranceCm(trackMs);
+  rangeFilter.reset();
+  burstActive = true;
+  pingScheduler.start(channelCount, config.burstSamples, hal.clock->micros());
+  firePing();
+}
+
+// Reduce each channel's pings to its reading
+void finishBurst() {
+  burstActive = false;
+  burstRate = channelCount * config.burstSamples * 1e6f / (hal.clock->micros() - pingScheduler.roundStartUs() + 1);
+  for (uint8_t i = 0; i < channelCount; ++i) {
+    SensorChannel& ch = channels[i];
+    const SampleFilter& used = i == 0 && ch.filter.count() * 2 < rangeFilter.count() ? rangeFilter : ch.filter;
+    ch.distance = used.count() ? used.reduce(config.filterMode) : -1;
+    ch.echo.endBurst(used.spread());
+    LOG_INFO(LogMsg::Burst, i, ch.echo.burstCount(EchoClass::Valid), config.burstSamples, ch.distance,
+             ch.echo.confidence(), echoClassName(ch.echo.label()));
+  }
+  LOG_INFO(LogMsg::BurstRate, channelCount * config.burstSamples, channelCount, burstRate);
+}
+
+// Advance the running burst without blocking; one ping is in flight at a time.
+// Returns true once all of them are in; distance is channel 0's filtered value over
+// its valid pings, or -1 if none returned an echo in the range gate (the others are
+// in channels[].distance). Channel 0's pings that jumped off the track are left out
+// unless they are the majority (then the level really moved, and the tracker
+// restarts on it).
+bool pollBurst(float& distance) {
+  if (!burstActive) return false;
+  
+  if (config.sensorMode == SensorMode::TriggerEcho ? echoCapture.busy() : serialRanger.busy()) {
+    SensorChannel& ch = channels[activeChannel];
+    float ping;
+    uint32_t raw = 0;
+    if (!pollDistanceCM(ch, ping, raw)) return false;
+    EchoClass label = ch.echo.classify(ch.expect, raw, ping, ping < 0 ? 0.0f : ch.calibration.heightCm(ping));
+    if (label == EchoClass::Valid || label == EchoClass::Stuck) ch.filter.add(ping);
+    if (activeChannel == 0 && (label == EchoClass::Valid || label == EchoClass::Stuck || label == EchoClass::Jump)) {
+      rangeFilter.add(ping);
+    }
+    if (label != EchoClass::Valid) LOG_DEBUG(LogMsg::PingLabel, activeChannel, echoClassName(label));
+    if (!pingScheduler.done()) return false;
+    
+    finishBurst();
+    distance = channels[0].distance;
+    return true;
   }
   
-  // Calculate distance in cm (speed of sound = 0.034 cm/microsecond)
-  float distance = duration * 0.034 / 2;
-  Serial.printf("Sensor Debug - Calculated distance: %.2f cm\n", distance);
+  firePing();
+  return false;
+}
+
+// Measure a filtered distance and wait for the result (setup, manual /read and battery
+// mode). Picks up an in-flight burst instead of starting a second one.
+float measureDistanceCM(uint32_t trackMs) {
+  PERF_SCOPE(perfMeasure);
+  if (!burstActive) {
+    startBurst(trackMs);
+  }
   
+  float distance;
+  while (!pollBurst(distance)) {
+    hal.clock->yield();
+  }
   return distance;
 }
 
-// Calculate water level percentage
-float calculateWaterLevel(float distance, float barrelHeight) {
-  // If distance is less than 20cm, treat as empty (0%)
-  if (distance < 20.0) {
+// Calculate the water level percentage of a channel's tank
+float calculateWaterLevel(float distance, const SensorChannel& ch) {
+  float barrelHeight = ch.barrelHeightCm;
+  // No echo, or closer than the full level: treat as empty (0%)
+  if (distance < 0) {
+    return 0.0;
+  }
+  float height = ch.calibration.heightCm(distance);
+  if (height > barrelHeight) {
     return 0.0;
   }
   
-  // Adjust distance by subtracting the 20cm offset (sensor mounting height)
-  float adjustedDistance = distance - 20.0;
-  
-  // Calculate water level: ((barrel_height - adjusted_distance) / barrel_height) * 100%
-  float waterLevel = ((barrelHeight - adjustedDistance) / barrelHeight) * 100.0;
+  // Calculate water level: water height above the bottom / barrel height * 100%
+  float waterLevel = height / barrelHeight * 100.0;
   
   // Clamp between 0% and 100%
   if (waterLevel < 0.0) waterLevel = 0.0;
@@ -343,410 +1291,897 @@ float calculateWaterLevel(float distance, float barrelHeight) {
   return waterLevel;
 }
 
-// Update sensor readings based on refresh rate
+// The report policy part of the config (lib/ReportPolicy)
+ReportSettings reportSettings() {
+  ReportSettings s;
+  s.deadbandPct = config.reportDeadband / 10.0f;
+  s.heartbeatS = config.heartbeatS;
+  s.lowAlarmPct = config.lowAlarmPct;
+  s.highAlarmPct = config.highAlarmPct;
+  return s;
+}
+
+// Level the report policy compares: the tracked one (less noise to cross the
+// deadband), -1 without an echo
+float reportLevel(float distance) {
+  if (distance < 0) return -1.0f;
+  return levelTracker.valid() ? currentTrackedLevel : calculateWaterLevel(distance, channels[0]);
+}
+
+// Water levels of the additional sensors' last readings
+void updateChannelLevels() {
+  for (uint8_t i = 1; i < channelCount; ++i) {
+    channels[i].level = calculateWaterLevel(channels[i].distance, channels[i]);
+  }
+}
+
+// Which channels of this burst go out over ESP-NOW, a bit each: channel 0 if the
+// report policy let it through (main), the additional sensors on their own report
+// or along with channel 0. urgent is set if any crossed an alarm level.
+uint8_t reportedChannels(ReportReason main, ChannelReport* reports, bool& urgent) {
+  ReportSettings settings = reportSettings();
+  uint8_t mask = main != ReportReason::Suppressed ? 1 : 0;
+  urgent = ReportPolicy::urgent(main);
+  for (uint8_t i = 1; i < channelCount; ++i) {
+    float level = channels[i].distance < 0 ? -1.0f : channels[i].level;
+    ReportReason reason = reports[i - 1].check(level, settings);
+    if (reason != ReportReason::Suppressed) {
+      mask |= 1 << i;
+      urgent = urgent || ReportPolicy::urgent(reason);
+      LOG_INFO(LogMsg::ChannelReported, i, reportReasonName(reason));
+    } else if (mask & 1) {
+      reports[i - 1].sent(level, settings);
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+}
+
+// Store a finished reading and forward it via ESP-NOW if the report policy wants it
+// (a manual reading always goes out)
+void applySensorReading(float distance, const char* trigger, bool manual = false) {
+  currentDistance = distance;
+  currentWaterLevel = calculateWaterLevel(currentDistance, channels[0]);
+  channels[0].level = currentWaterLevel;
+  updateChannelLevels();
+  currentVolume = currentDistance < 0 ? -1.0f : levelLiters(currentWaterLevel);
+  history.add(hal.clock->millis(), currentDistance, currentWaterLevel);
+  trackLevel(hal.clock->millis(), currentDistance);
+  adaptInterval();
+  
+  LOG_INFO(LogMsg::Reading, currentDistance, currentWaterLevel, currentVolume);
+  LOG_INFO(LogMsg::Tracked, currentTrackedLevel, levelTracker.rateCmPerMin(), levelTracker.confidence());
+  
+  // Send data via ESP-NOW if initialized
+  if (espNowInitialized) {
+    uint32_t nowSec = history.lastSampleSec();
+    ReportReason reason = ReportReason::Manual;
+    if (manual) {
+      reportPolicy.reportAnyway(nowSec, reportLevel(currentDistance), reportSettings());
+    } else {
+      reason = reportPolicy.check(nowSec, reportLevel(currentDistance), reportSettings());
+    }
+    bool urgent;
+    uint8_t reported = reportedChannels(reason, channelReports, urgent);
+    if (!reported) {
+      LOG_INFO(LogMsg::ReadingSuppressed, reportPolicy.suppressed(), reportPolicy.reported());
+      return;
+    }
+    LOG_INFO(LogMsg::ReadingQueued, trigger, reportReasonName(reason));
+    // All sensors' readings of a burst go into one frame
+    if (WIRE_MAX_SAMPLES - espNowBatch.count() < channelCount) sendEspNowData();
+    for (uint8_t i = 0; i < channelCount; ++i) {
+      const SensorChannel& ch = channels[i];
+      if (reported & (1 << i)) batchEspNowReading(ch.distance, ch.level, ch.echo.confidence(), i);
+    }
+    sendEspNowIfDue();
+    if (urgent) sendEspNowData();   // alarm level crossed: don't wait for the batch
+  }
+}
+
+// Update sensor readings at the adaptive interval (the refresh rate while the level moves).
+// Never blocks: the burst is started here and its pings are collected on later calls.
 void updateSensorReadings() {
-  uint32_t currentTime = millis();
+  if (burstActive) {
+    float distance;
+    if (pollBurst(distance)) {
+      applySensorReading(distance, "refresh rate trigger");
+    }
+    return;
+  }
+  
+  uint32_t currentTime = hal.clock->millis();
   
   // Check if it's time to read the sensor
-  if (currentTime - lastSensorRead >= config.refreshRateMs) {
-    Serial.println("=== SENSOR READING TRIGGERED ===");
-    Serial.printf("Time since last read: %u ms\n", currentTime - lastSensorRead);
-    
-    currentDistance = measureDistanceCM();
-    currentWaterLevel = calculateWaterLevel(currentDistance, config.barrelHeightCm);
+  if (currentTime - lastSensorRead >= readInterval.intervalMs()) {
+    LOG_INFO(LogMsg::ReadingTriggered, currentTime - lastSensorRead);
+
     lastSensorRead = currentTime;
-    
-    // Debug output
-    Serial.printf("Sensor Update - Distance: %.1f cm, Water Level: %.1f%%\n", 
-                  currentDistance, currentWaterLevel);
-    
-    // Send data via ESP-NOW if initialized
-    if (espNowInitialized) {
-      Serial.println("Auto-sending data via ESP-NOW (refresh rate trigger)");
-      sendEspNowData();
+    startBurst(currentTime);
+  }
+}
+
+// Run the sensor task again on the next tick while a burst is collecting pings, else
+// when the next reading is due
+void scheduleSensor() {
+  uint32_t dueMs = burstActive ? hal.clock->millis() + 1 : lastSensorRead + readInterval.intervalMs();
+  timers.schedule(sensorTask, dueMs);
+}
+
+/* ---------- battery mode (deep sleep) ----------------------------------- */
+bool loadWakeState() {
+  if (!hal.rtc->read(0, &wakeState, sizeof(wakeState))) return false;
+  return wakeState.magic == WAKE_STATE_MAGIC &&
+         wakeState.crc == crc32((const uint8_t*)&wakeState + offsetof(WakeState, clockMs),
+                                sizeof(wakeState) - offsetof(WakeState, clockMs));
+}
+
+void saveWakeState() {
+  wakeState.magic = WAKE_STATE_MAGIC;
+  wakeState.crc = crc32((const uint8_t*)&wakeState + offsetof(WakeState, clockMs),
+                        sizeof(wakeState) - offsetof(WakeState, clockMs));
+  hal.rtc->write(0, &wakeState, sizeof(wakeState));
+}
+
+// The stall log of the last boots, or a new one; counts this boot
+void loadStallLog() {
+  bool valid = !config.lowPower && hal.rtc->read(0, &stallState, sizeof(stallState)) &&
+               stallState.magic == STALL_LOG_MAGIC && stallState.crc == crc32(&stallState.log, sizeof(stallState.log));
+  if (!valid) memset(&stallState, 0, sizeof(stallState));
+  ++stallState.log.boots;
+}
+
+void saveStallLog() {
+  if (config.lowPower) return;
+  stallState.magic = STALL_LOG_MAGIC;
+  stallState.crc = crc32(&stallState.log, sizeof(stallState.log));
+  hal.rtc->write(0, &stallState, sizeof(stallState));
+}
+
+// BOOT pressed right after reset and held (held during reset it enters the flasher instead)
+bool configButtonHeld() {
+  if (hal.gpio->read(BTN_PIN) != LOW) return false;
+  hal.gpio->write(LED_PIN, LOW);
+  uint32_t t0 = hal.clock->millis();
+  while (hal.gpio->read(BTN_PIN) == LOW) {
+    if (hal.clock->millis() - t0 >= CONFIG_BUTTON_HOLD_MS) return true;
+    hal.clock->delayMs(10);
+  }
+  hal.gpio->write(LED_PIN, HIGH);
+  return false;
+}
+
+// The AP needs the RF, which is off for wakes without a send: sleep for a moment
+// with it on and come up in config mode
+void sleepIntoConfigMode() {
+  wakeState.configNextWake = true;
+  wakeState.radioThisWake = true;
+  saveWakeState();
+  flushLog();
+  hal.system->deepSleep(RF_ON_RESTART_US, true);
+}
+
+// Send the batch kept in RTC memory and wait briefly for the acknowledgement
+bool sendWakeBatch(uint32_t nowSec) {
+  hal.wifi->beginStation(WIFI_CH);
+  espNowInitialized = initEspNow();
+  if (!espNowInitialized) return false;
+  
+  WireHeader header;
+  header.flags = wakeState.frameFlags;
+  header.sensorId = wireSensorId();
+  header.seq = wakeState.seq++;
+  header.uptimeSec = nowSec;
+  header.barrelHeight = wireDistance(config.barrelHeightCm);
+  header.airTemp = wireTemp(soundSpeed.temperatureC());
+  putTrack(header);
+  uint8_t frame[WIRE_MAX_FRAME];
+  size_t len = wakeState.batch.encode(header, frame, sizeof(frame));
+  
+  // A resend keeps the sequence number, so the parent can drop it if the ack was lost
+  for (uint8_t attempt = 0; attempt < WAKE_SEND_ATTEMPTS; ++attempt) {
+    uint32_t callbacks = espNowCallbacks;
+    if (hal.radio->send(config.parentMac.data(), frame, len) != 0) continue;
+    uint32_t t0 = hal.clock->millis();
+    while (espNowCallbacks == callbacks && hal.clock->millis() - t0 < WAKE_ACK_DEADLINE_MS) {
+      hal.clock->yield();
     }
-    
-    Serial.println("=== SENSOR READING COMPLETED ===");
+    if (espNowCallbacks != callbacks && espNowSendSuccess) return true;
   }
+  return false;
 }
 
-/* ---------- Web handlers -------------------------------------------------- */
-void handleRoot(){
-  uint8_t selfMac[6]; WiFi.macAddress(selfMac);
+// One wake in battery mode: take a reading, send the batch if it is due, sleep until the
+// next reading. Serial is not started, the UART would add ~0.13 ms per logged character.
+void runLowPowerWake() {
+  if (!wakeStateValid) {
+    wakeState = WakeState();
+    wakeState.frameFlags = WIRE_FLAG_BOOT;
+    wakeState.radioThisWake = true;   // RF is on after power-up
+  }
+  wakeState.interval.setLimits(config.refreshRateMs, config.refreshMaxMs);   // the config may have changed
+  ++wakeState.wakes;
+  
+  // The probe converts while the chip sleeps: read the conversion started last wake,
+  // and start the one for the next wake
+  if (probeFound) {
+    if (wakeState.probeConverting) readProbe();
+    wakeState.probeConverting = hal.probe->startConversion();
+  }
   
-  // Check if configuration exists (not default values)
-  bool hasConfig = (config.parentMac[0] != 0xFF || config.refreshRateMs != 5000 || config.barrelHeightCm != 50.0 || !config.ledEnabled || 
-                   strcmp(config.ssidPrefix, "WATER_SENSOR_") != 0 || strcmp(config.wifiPassword, "HardPassword1234") != 0);
+  // The tracker and the stuck-value run carry over from the last wake
+  levelTracker = wakeState.tracker;
+  channels[0].echo = wakeState.echo;
+  float distance = measureDistanceCM((uint32_t)(wakeState.clockMs + hal.clock->millis()));
+  wakeState.echo = channels[0].echo;
+  float waterLevel = calculateWaterLevel(distance, channels[0]);
+  channels[0].level = waterLevel;
+  updateChannelLevels();
+  uint32_t sensorDoneMs = hal.clock->millis();
+  uint32_t nowSec = (uint32_t)((wakeState.clockMs + sensorDoneMs) / 1000);
+  readInterval = wakeState.interval;
+  trackLevel((uint32_t)(wakeState.clockMs + sensorDoneMs), distance);
+  adaptInterval();
+  wakeState.tracker = levelTracker;
+  wakeState.interval = readInterval;
+  
+  reportPolicy = wakeState.report;
+  ReportReason reason = reportPolicy.check(nowSec, reportLevel(distance), reportSettings());
+  wakeState.report = reportPolicy;
+  bool urgent;
+  uint8_t reported = reportedChannels(reason, wakeState.channels, urgent);
+  
+  FrameBatch& batch = wakeState.batch;
+  for (uint8_t i = 0; i < channelCount; ++i) {
+    if (!(reported & (1 << i))) continue;
+    if (batch.full()) batch.dropOldest();   // parent unreachable for a whole batch: keep the newest
+    const SensorChannel& ch = channels[i];
+    batch.add(nowSec, ch.distance, ch.level, ch.echo.confidence(), i);
+  }
+  bool due = batch.count() >= config.batchSize || urgent ||
+             (batch.count() && nowSec - batch.oldestSec() >= config.batchMaxAgeS);
+  
+  if (wakeState.radioThisWake && batch.count()) {
+    ++wakeState.radioWakes;
+    if (sendWakeBatch(nowSec)) {
+      wakeState.frameFlags = 0;
+      batch.clear();
+    } else {
+      // Its readings go out with the next frame, which skips this sequence number
+      wakeState.frameFlags |= WIRE_FLAG_COALESCED;
+      ++wakeState.failedSends;
+    }
+  }
   
-  // Convert refresh rate to minutes and seconds
-  uint8_t minutes, seconds;
-  msToMinSec(config.refreshRateMs, minutes, seconds);
+  // Time-to-sleep, counted from setup() (the ROM and SDK boot before it is not included)
+  uint32_t awakeMs = hal.clock->millis();
+  wakeState.lastAwakeMs = awakeMs;
+  wakeState.lastSensorMs = (uint16_t)sensorDoneMs;
+  wakeState.lastRadioMs = (uint16_t)(awakeMs - sensorDoneMs);
+  wakeState.totalAwakeMs += awakeMs;
+  if (awakeMs > wakeState.maxAwakeMs) wakeState.maxAwakeMs = awakeMs;
+  
+  // The batch became due with the RF off (with a deadband nobody knows in advance
+  // which reading gets reported): wake again right away with the RF on
+  if (due && !wakeState.radioThisWake) {
+    wakeState.clockMs += awakeMs + RF_ON_RESTART_US / 1000;
+    wakeState.radioThisWake = true;
+    saveWakeState();
+    flushLog();
+    hal.system->deepSleep(RF_ON_RESTART_US, true);
+    return;
+  }
   
+  // Wake again one reading interval after this wake began. The RF is only left on
+  // for the next wake if its reading will make the batch due (or a send failed).
+  // With a deadband only a heartbeat is sure to be reported.
+  uint32_t intervalMs = readInterval.intervalMs();
+  uint32_t sleepMs = intervalMs > awakeMs + MIN_SLEEP_MS ? intervalMs - awakeMs : MIN_SLEEP_MS;
+  wakeState.clockMs += awakeMs + sleepMs;
+  uint32_t nextSec = (uint32_t)(wakeState.clockMs / 1000);
+  bool nextReported = config.reportDeadband == 0 || nextSec - reportPolicy.lastReportSec() >= config.heartbeatS;
+  uint8_t nextCount = batch.count() + (nextReported ? channelCount : 0);
+  wakeState.radioThisWake = (nextCount && nextCount >= config.batchSize) ||
+                            (batch.count() && nextSec - batch.oldestSec() >= config.batchMaxAgeS);
+  saveWakeState();
+  flushLog();
+  hal.system->deepSleep((uint64_t)sleepMs * 1000, wakeState.radioThisWake);
+}
+
+/* ---------- Web handlers -------------------------------------------------- */
+// Pages, CSS and JS are static gzip'd assets (include/WebAssets.h, built from
+// web/ by scripts/build_web.py); all device values come from the /api/* JSON.
+
+// Send an asset; a browser revalidating with a current ETag gets an empty 304
+void sendAsset(const WebAsset& asset) {
+  hal.http->sendHeader("ETag", asset.etag);
+  hal.http->sendHeader("Cache-Control", "no-cache");
+  String ifNoneMatch = hal.http->header("If-None-Match");
+  if (ifNoneMatch.length() && strstr(ifNoneMatch.c_str(), asset.etag)) {
+    hal.http->send(304, asset.contentType, "");
+    return;
+  }
+  hal.http->sendHeader("Content-Encoding", "gzip");
+  hal.http->sendP(200, asset.contentType, (PGM_P)asset.data, asset.size);
+}
+
+void printMac(ChunkWriter& out, const uint8_t* mac) {
+  out.printf("%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+// Quoted and escaped JSON string
+void printJsonString(ChunkWriter& out, const char* s) {
+  out.print("\"");
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\') {
+      char esc[2] = {'\\', *s};
+      out.write(esc, 2);
+    } else if ((uint8_t)*s < 0x20) {
+      out.printf("\\u%04x", (uint8_t)*s);
+    } else {
+      out.write(s, 1);
+    }
+  }
+  out.print("\"");
+}
+
+// Liters as a JSON number, null when unknown (< 0)
+void printLiters(ChunkWriter& out, float liters) {
+  if (liters < 0) out.print("null");
+  else out.printf("%.1f", liters);
+}
+
+// Water level (%) as a JSON number, null without an echo (distance < 0):
+// calculateWaterLevel() gives 0 then, which would read as an empty tank
+void printLevel(ChunkWriter& out, float distance, float level) {
+  if (distance < 0) out.print("null");
+  else out.printf("%.1f", level);
+}
+
+// True once anything differs from the defaults
+bool isConfigured() {
+  return config.parentMac[0] != 0xFF || config.refreshRateMs != 5000 || config.refreshMaxMs != 5000 || config.barrelHeightCm != 50.0 || !config.ledEnabled || 
+         config.burstSamples != 5 || config.filterMode != FilterMode::Median || 
+         config.batchSize != 1 || config.batchMaxAgeS != 60 || config.outboxPolicy != OutboxPolicy::Coalesce || config.lowPower || 
+         config.sensorMode != SensorMode::TriggerEcho || config.airTempC != 20 || config.tempProbe || 
+         config.reportDeadband != 0 || config.heartbeatS != 600 || config.lowAlarmPct != 0 || config.highAlarmPct != 100 || 
+         config.tankShape != TankShape::Upright || config.tankWidthCm != 40.0 || config.tankLengthCm != 40.0 || config.strapPoints || 
+         config.mountCm != SENSOR_MOUNT_CM || config.calibrated || config.channels != 1 || config.stallMs != 100 || 
+         strcmp(config.ssidPrefix, "WATER_SENSOR_") != 0 || strcmp(config.wifiPassword, "HardPassword1234") != 0;
+}
+
+void handleRoot(){
+  PERF_SCOPE(perfRoot);
+  sendAsset(WEB_INDEX_HTML);
+}
+
+void handleStyle(){
+  sendAsset(WEB_STYLE_CSS);
+}
+
+void handleScript(){
+  sendAsset(WEB_APP_JS);
+}
+
+// JSON API: current reading, settings and status for the static pages
+void handleApiStatus() {
+  PERF_SCOPE(perfStatus);
   // Update sensor readings if needed
   updateSensorReadings();
+  scheduleSensor();
   
-  if (hasConfig) {
-    // Show configured status page
-    String html = R"(
-    <html><head><meta name='viewport' content='width=device-width,initial-scale=1'/>
-    <title>ESP8266 Settings</title>
-    <style>
-      body { font-family: Arial, sans-serif; margin: 20px; }
-      .info { background-color: #e8f5e8; padding: 15px; margin-bottom: 20px; border-radius: 5px; border-left: 4px solid #4CAF50; }
-      .warning { background-color: #fff3cd; padding: 15px; margin-bottom: 20px; border-radius: 5px; border-left: 4px solid #ffc107; }
-             .btn { display: inline-block; padding: 10px 20px; margin: 5px; text-decoration: none; border-radius: 5px; font-weight: bold; }
-       .btn-primary { background-color: #007bff; color: white; }
-       .btn-warning { background-color: #ffc107; color: black; }
-       .btn-success { background-color: #28a745; color: white; }
-       .btn:hover { opacity: 0.8; }
-       .sensor { background-color: #e3f2fd; padding: 15px; margin-bottom: 20px; border-radius: 5px; border-left: 4px solid #2196F3; }
-       .mac-info { background-color: #f8f9fa; padding: 10px; margin: 10px 0; border-radius: 3px; font-family: monospace; }
-    </style>
-    </head><body>
-    <h2>ESP8266 Distance Sensor Settings</h2>
-    
-    <div class="info">
-      <p><b>Device MAC Addresses:</b></p>
-      <div class="mac-info">
-        <strong>WiFi MAC:</strong> %WIFI_MAC%<br>
-        <strong>ESP-NOW MAC:</strong> %ESPNOW_MAC% (Use this for ESP-NOW configuration)
-      </div>
-      <p><b>Status:</b>Wemos is configured already</p>
-    </div>
-    
-         <div class="warning">
-       <p><b>Current Configuration:</b></p>
-       <ul>
-                   <li><b>Parent MAC:</b> %PARENT_MAC%</li>
-          <li><b>Refresh Rate:</b> %MINUTES%m %SECONDS%s</li>
-          <li><b>Barrel Height:</b> %BARREL_HEIGHT% cm</li>
-          <li><b>LED Status:</b> %LED_STATUS%</li>
-          <li><b>WiFi SSID:</b> %SSID_PREFIX%XXXXXX</li>
-          <li><b>WiFi Password:</b> %WIFI_PASSWORD%</li>
-          <li><b>ESP-NOW Status:</b> %ESPNOW_STATUS%</li>
-        </ul>
-     </div>
-    
-          <div class="sensor">
-       <p><b>Current Water Level:</b></p>
-       <div style="font-size: 32px; font-weight: bold; color: #1976D2; text-align: center; margin: 10px 0;">
-         %WATER_LEVEL%%
-       </div>
-       <p style="text-align: center; margin: 5px 0; color: #666;">
-         <small>Distance: %SENSOR_DISTANCE% cm | Barrel Height: %BARREL_HEIGHT% cm</small>
-       </p>
-     </div>
-     
-        <p><b>What would you like to do?</b></p>
-     
-     <a href="/update" class="btn btn-primary">Update Settings</a>
-     <a href="/reset" class="btn btn-warning">Reset to Default</a>
-     <a href="/sensor" class="btn btn-success">View Water Level</a>
-     <a href="/debugmac" class="btn btn-primary">Debug MAC Addresses</a>
-     
-         </body></html>)";
-    
-    html.replace("%WIFI_MAC%", getWiFiMac());
-    html.replace("%ESPNOW_MAC%", getEspNowMac());
-    html.replace("%PARENT_MAC%", macToString(config.parentMac.data()));
-    html.replace("%MINUTES%", String(minutes));
-    html.replace("%SECONDS%", String(seconds));
-    html.replace("%BARREL_HEIGHT%", String((int)config.barrelHeightCm));
-    html.replace("%SENSOR_DISTANCE%", String(currentDistance, 1));
-         html.replace("%WATER_LEVEL%", String(currentWaterLevel, 1));
-     html.replace("%LED_STATUS%", config.ledEnabled ? "Enabled" : "Disabled");
-           html.replace("%SSID_PREFIX%", String(config.ssidPrefix));
-      html.replace("%WIFI_PASSWORD%", String(config.wifiPassword));
-      html.replace("%ESPNOW_STATUS%", espNowInitialized ? (espNowSendSuccess ? "Connected" : "Error") : "Disabled (Parent MAC not configured)");
-       
-      server.send(200,"text/html",html);
+  uint8_t mac[6];
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"configured\":%s", isConfigured() ? "true" : "false");
+  out.printf(",\"distance\":%.1f,\"waterLevel\":", currentDistance);
+  printLevel(out, currentDistance, currentWaterLevel);
+  out.print(",\"volume\":");
+  printLiters(out, currentVolume);
+  out.printf(",\"trackedLevel\":%.1f,\"levelRate\":%.2f", currentTrackedLevel, levelTracker.rateCmPerMin());
+  out.print(",\"trackedVolume\":");
+  printLiters(out, levelTracker.valid() ? levelLiters(currentTrackedLevel) : -1.0f);
+  out.printf(",\"confidence\":%u,\"outliers\":%u", levelTracker.confidence(), levelTracker.outliers());
+  const EchoQuality& eq = config.lowPower && wakeStateValid ? wakeState.echo : channels[0].echo;
+  out.printf(",\"echo\":{\"confidence\":%u,\"label\":\"%s\",\"pings\":{", eq.confidence(), echoClassName(eq.label()));
+  for (uint8_t c = 0; c < ECHO_CLASSES; ++c) {
+    out.printf("%s\"%s\":%u", c ? "," : "", echoClassName((EchoClass)c), eq.count((EchoClass)c));
+  }
+  out.print("}}");
+  out.printf(",\"barrelHeight\":%d,\"refreshRateMs\":%u", (int)config.barrelHeightCm, config.refreshRateMs);
+  out.printf(",\"mountCm\":%.1f,\"calibrated\":%s", config.mountCm, config.calibrated ? "true" : "false");
+  out.printf(",\"refreshMaxMs\":%u", config.refreshMaxMs);
+  out.printf(",\"tank\":{\"shape\":%u,\"name\":\"%s\"", (unsigned)config.tankShape, tankShapeName(config.tankShape));
+  out.printf(",\"width\":%.1f,\"length\":%.1f,\"capacity\":", config.tankWidthCm, config.tankLengthCm);
+  printLiters(out, tank.capacityLiters());
+  out.printf(",\"points\":%u,\"strap\":\"", tank.points());
+  for (uint8_t i = 0; i < config.strapPoints; ++i) {
+    const StrapPoint& p = config.strap[i];
+    out.printf("%s%u.%u=%u.%u", i ? "," : "", p.level / TANK_LEVEL_SCALE, p.level % TANK_LEVEL_SCALE,
+               p.volume / TANK_VOLUME_SCALE, p.volume % TANK_VOLUME_SCALE);
+  }
+  out.print("\"}");
+  const AdaptiveInterval& ri = config.lowPower && wakeStateValid ? wakeState.interval : readInterval;
+  out.printf(",\"interval\":{\"ms\":%u,\"reason\":\"%s\"", ri.intervalMs(), intervalReasonName(ri.reason()));
+  out.printf(",\"changes\":{\"moving\":%u", ri.changes(IntervalReason::Moving));
+  out.printf(",\"scattered\":%u,\"unsure\":%u", ri.changes(IntervalReason::Scattered), ri.changes(IntervalReason::Unsure));
+  out.printf(",\"steady\":%u}}", ri.changes(IntervalReason::Steady));
+  out.printf(",\"burstSamples\":%u,\"filterMode\":%u", config.burstSamples, (unsigned)config.filterMode);
+  out.print(",\"filterName\":");
+  printJsonString(out, filterModeName(config.filterMode));
+  out.printf(",\"batchSize\":%u,\"batchMaxAgeS\":%u", config.batchSize, config.batchMaxAgeS);
+  out.printf(",\"outboxPolicy\":%u", (unsigned)config.outboxPolicy);
+  out.printf(",\"deadband\":%.1f,\"heartbeatS\":%u", config.reportDeadband / 10.0f, config.heartbeatS);
+  out.printf(",\"lowAlarm\":%u,\"highAlarm\":%u", config.lowAlarmPct, config.highAlarmPct);
+  out.printf(",\"lowPower\":%s,\"stallMs\":%u", config.lowPower ? "true" : "false", config.stallMs);
+  out.printf(",\"sensorMode\":%u,\"sensorName\":", (unsigned)config.sensorMode);
+  printJsonString(out, sensorModeName(config.sensorMode));
+  out.printf(",\"airTemp\":%d,\"tempProbe\":%s", config.airTempC, config.tempProbe ? "true" : "false");
+  out.printf(",\"temperature\":%.2f,\"tempSource\":\"%s\"", soundSpeed.temperatureC(), probeOk ? "probe" : "config");
+  out.printf(",\"soundSpeed\":%.1f,\"probeErrors\":%u", soundSpeed.metersPerSecond(), probeErrors);
+  out.printf(",\"pingRate\":%.1f,\"maxPingRate\":%.1f", burstRate, pingScheduler.maxRate(channelCount));
+  const SensorChannel& main = channels[0];
+  if (config.sensorMode == SensorMode::TriggerEcho) {
+    out.printf(",\"gate\":{\"nearCm\":%.1f", soundSpeed.distanceCm(main.gate.nearUs));
+    out.printf(",\"farCm\":%.1f,\"timeoutUs\":%u", soundSpeed.distanceCm(main.gate.farUs), main.gate.timeoutUs);
+    out.printf(",\"valid\":%u,\"rejected\":%u", main.pingsValid, main.pingsRejected);
+    out.printf(",\"timeouts\":%u}", main.pingsTimedOut);
   } else {
-    // Show initial configuration page
-    String html = R"(
-    <html><head><meta name='viewport' content='width=device-width,initial-scale=1'/>
-    <title>ESP8266 Settings</title>
-    <style>
-      body { font-family: Arial, sans-serif; margin: 20px; }
-      .form-group { margin-bottom: 15px; }
-      label { display: block; margin-bottom: 5px; font-weight: bold; }
-      input[type="text"], input[type="number"] { width: 200px; padding: 5px; }
-      input[type="submit"] { background-color: #4CAF50; color: white; padding: 10px 20px; border: none; cursor: pointer; }
-      input[type="submit"]:hover { background-color: #45a049; }
-      .info { background-color: #f0f0f0; padding: 10px; margin-bottom: 20px; border-radius: 5px; }
-      .sensor { background-color: #e3f2fd; padding: 15px; margin-bottom: 20px; border-radius: 5px; border-left: 4px solid #2196F3; }
-      .mac-info { background-color: #f8f9fa; padding: 10px; margin: 10px 0; border-radius: 3px; font-family: monospace; }
-    </style>
-    </head><body>
-    <h2>ESP8266 Distance Sensor Settings</h2>
-    
-    <div class="info">
-      <p><b>Device MAC Addresses:</b></p>
-      <div class="mac-info">
-        <strong>WiFi MAC:</strong> %WIFI_MAC%<br>
-        <strong>ESP-NOW MAC:</strong> %ESPNOW_MAC% (Use this for ESP-NOW configuration)
-      </div>
-      <p><b>Status:</b>Initial configuration required</p>
-    </div>
-    
-         <div class="sensor">
-       <p><b>Current Water Level:</b></p>
-       <div style="font-size: 32px; font-weight: bold; color: #1976D2; text-align: center; margin: 10px 0;">
-         %WATER_LEVEL%%
-       </div>
-       <p style="text-align: center; margin: 5px 0; color: #666;">
-         <small>Distance: %SENSOR_DISTANCE% cm | Barrel Height: %BARREL_HEIGHT% cm</small>
-       </p>
-     </div>
-     
-    <form action='/save' method='post'>
-      <div class="form-group">
-        <label for="pmac">Parent MAC Address:</label>
-        <input type="text" id="pmac" name="pmac" value="%PARENT_MAC%" placeholder="FF:FF:FF:FF:FF:FF">
-      </div>
-      
-      <div class="form-group">
-        <label for="minutes">Refresh Rate:</label>
-        <input type="number" id="minutes" name="minutes" value="%MINUTES%" min="0" max="59" style="width: 80px;"> minutes
-        <input type="number" id="seconds" name="seconds" value="%SECONDS%" min="0" max="59" style="width: 80px;"> seconds
-      </div>
-      
-                     <div class="form-group">
-          <label for="barrel">Barrel Height (cm):</label>
-          <input type="number" id="barrel" name="barrel" value="%BARREL_HEIGHT%" min="1" max="1000" step="1">
-        </div>
-        
-                <div class="form-group">
-          <label for="led">
-            <input type="checkbox" id="led" name="led" %LED_CHECKED%>
-            Enable LED blinking (indicates device is working)
-          </label>
-        </div>
-        
-        <div class="form-group">
-          <label for="ssid">WiFi SSID Prefix:</label>
-          <input type="text" id="ssid" name="ssid" value="%SSID_PREFIX%" placeholder="WATER_SENSOR_" maxlength="15">
-          <small>SSID will be: [prefix]XXXXXX (where XXXXXX is device MAC)</small>
-        </div>
-        
-        <div class="form-group">
-          <label for="password">WiFi Password:</label>
-          <input type="text" id="password" name="password" value="%WIFI_PASSWORD%" placeholder="HardPassword1234" minlength="8" maxlength="31">
-          <small>Must be at least 8 characters long</small>
-        </div>
-        
-                <input type="submit" value="Save Settings & Reboot">
-    </form>
-    </body></html>)";
-    
-    html.replace("%WIFI_MAC%", getWiFiMac());
-    html.replace("%ESPNOW_MAC%", getEspNowMac());
-    html.replace("%PARENT_MAC%", macToString(config.parentMac.data()));
-    html.replace("%MINUTES%", String(minutes));
-    html.replace("%SECONDS%", String(seconds));
-    html.replace("%BARREL_HEIGHT%", String((int)config.barrelHeightCm));
-    html.replace("%SENSOR_DISTANCE%", String(currentDistance, 1));
-    html.replace("%WATER_LEVEL%", String(currentWaterLevel, 1));
-    html.replace("%LED_CHECKED%", config.ledEnabled ? "checked" : "");
-    html.replace("%SSID_PREFIX%", String(config.ssidPrefix));
-    html.replace("%WIFI_PASSWORD%", String(config.wifiPassword));
-    
-    server.send(200,"text/html",html);
+    const RangerStats& rs = serialRanger.stats();
+    out.printf(",\"serial\":{\"frames\":%u,\"checksumErrors\":%u", rs.frames, rs.checksumErrors);
+    out.printf(",\"skippedBytes\":%u}", rs.skippedBytes);
   }
+  // Every sensor: configured (all of them, for the settings form) and, if in use, its last reading
+  out.printf(",\"channelCount\":%u,\"channels\":[", channelCount);
+  for (uint8_t i = 0; i < SENSOR_CHANNELS; ++i) {
+    ChannelConfig cc = channelConfig(config, i);
+    const SensorChannel& ch = channels[i];
+    out.printf("%s{\"trig\":%u,\"echo\":%u,\"barrelHeight\":%.1f", i ? "," : "", cc.trigPin, cc.echoPin,
+               cc.barrelHeightCm);
+    out.printf(",\"mountCm\":%.1f,\"calibrated\":%s", cc.mountCm, cc.calibrated ? "true" : "false");
+    if (i < channelCount) {
+      out.printf(",\"distance\":%.1f,\"waterLevel\":", ch.distance);
+      printLevel(out, ch.distance, ch.level);
+      out.printf(",\"confidence\":%u,\"label\":\"%s\"", ch.echo.confidence(), echoClassName(ch.echo.label()));
+      out.printf(",\"valid\":%u,\"rejected\":%u,\"timeouts\":%u", ch.pingsValid, ch.pingsRejected, ch.pingsTimedOut);
+    }
+    out.print("}");
+  }
+  out.print("]");
+  if (wakeStateValid && wakeState.wakes) {
+    out.printf(",\"sleep\":{\"wakes\":%u,\"radioWakes\":%u", wakeState.wakes, wakeState.radioWakes);
+    out.printf(",\"failedSends\":%u,\"lastMs\":%u", wakeState.failedSends, wakeState.lastAwakeMs);
+    out.printf(",\"sensorMs\":%u,\"radioMs\":%u", wakeState.lastSensorMs, wakeState.lastRadioMs);
+    out.printf(",\"avgMs\":%u,\"maxMs\":%u}", wakeState.totalAwakeMs / wakeState.wakes, wakeState.maxAwakeMs);
+  }
+  out.printf(",\"led\":%s,\"ssidPrefix\":", config.ledEnabled ? "true" : "false");
+  printJsonString(out, config.ssidPrefix);
+  out.print(",\"password\":");
+  printJsonString(out, config.wifiPassword);
+  out.print(",\"parentMac\":\"");
+  printMac(out, config.parentMac.data());
+  out.print("\",\"wifiMac\":\"");
+  hal.wifi->macAddress(mac);
+  printMac(out, mac);
+  out.print("\",\"espNowMac\":\"");
+  out.print(getEspNowMac());
+  out.printf("\",\"espNow\":\"%s\"}", espNowInitialized ? (espNowSendSuccess ? "ok" : "error") : "disabled");
+}
+
+// The log records still in the RAM ring, oldest first, as text
+void handleLogs() {
+  ChunkWriter out(*hal.http, 200, "text/plain");
+  out.printf("# %u records logged, %u overwritten\n", logRing.written(), logRing.overwritten());
+  uint32_t cursor = logRing.tail();
+  LogRecord r;
+  char line[128];
+  while (logRing.read(cursor, r)) {
+    formatLogLine(line, sizeof(line), r);
+    out.print(line);
+  }
+}
+
+// JSON API: ESP-NOW delivery counters (lib/Outbox) and what the report policy let through
+void handleApiEspNow() {
+  const OutboxStats& st = espNowOutbox.stats();
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"pending\":%u,\"inFlight\":%s,\"batched\":%u", espNowOutbox.size(),
+             espNowOutbox.inFlight() ? "true" : "false", espNowBatch.count());
+  out.printf(",\"queued\":%u,\"sent\":%u,\"acked\":%u", st.queued, st.sent, st.acked);
+  out.printf(",\"retried\":%u,\"dropped\":%u", st.retried, st.dropped);
+  out.printf(",\"coalesced\":%u,\"duplicates\":%u", st.coalesced, st.duplicates);
+  const ReportPolicy& rp = config.lowPower && wakeStateValid ? wakeState.report : reportPolicy;
+  out.printf(",\"reported\":%u,\"suppressed\":%u", rp.reported(), rp.suppressed());
+  out.print(",\"reasons\":{");
+  for (uint8_t r = (uint8_t)ReportReason::First; r < REPORT_REASONS; ++r) {
+    out.printf("%s\"%s\":%u", r > 1 ? "," : "", reportReasonName((ReportReason)r), rp.count((ReportReason)r));
+  }
+  out.print("}}");
+}
+
+// JSON API: the loop() tasks (lib/TimerWheel), their run times and how late they started
+void handleApiTasks() {
+  uint32_t now = hal.clock->millis();
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"lateMs\":%u,\"tasks\":[", TIMER_LATE_MS);
+  bool first = true;
+  timers.forEachTask([&](const TimerTask& t) {
+    const TimerStats& st = t.stats();
+    out.printf("%s{\"name\":\"%s\"", first ? "" : ",", t.name());
+    out.printf(",\"periodMs\":%u,\"runs\":%u", t.periodMs(), st.runs);
+    out.printf(",\"avgUs\":%u,\"maxUs\":%u", st.runs ? (unsigned)(st.totalUs / st.runs) : 0, st.maxUs);
+    out.printf(",\"late\":%u,\"maxLateMs\":%u,\"dueInMs\":", st.late, st.maxLateMs);
+    if (t.armed()) {
+      out.printf("%d}", (int)(int32_t)(t.dueMs() - now));
+    } else {
+      out.print("null}");
+    }
+    first = false;
+  });
+  out.print("]}");
+}
+
+// JSON API: the hot-path histograms (lib/Perf); ?reset=1 clears them after reporting.
+// hist[i] counts the runs of 2^i to 2^(i+1) - 1 cycles, up to the last non-empty bucket.
+void handlePerf() {
+  uint32_t mhz = perfMhz();
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"probes\":%s,\"cpuMhz\":%u,\"sections\":[", PERF_PROBES ? "true" : "false", mhz);
+  for (const PerfSection* s = perfSections(); s; s = s->next()) {
+    uint32_t n = s->count();
+    out.printf("%s{\"name\":\"%s\",\"count\":%u", s == perfSections() ? "" : ",", s->name(), n);
+    out.printf(",\"minUs\":%.2f,\"maxUs\":%.2f", (double)s->minCycles() / mhz, (double)s->maxCycles() / mhz);
+    out.printf(",\"avgUs\":%.2f,\"p99Us\":%.2f", n ? (double)s->totalCycles() / n / mhz : 0.0,
+               (double)s->percentile(0.99f) / mhz);
+    uint8_t used = PERF_BUCKETS;
+    while (used && !s->bucket(used - 1)) --used;
+    out.print(",\"hist\":[");
+    for (uint8_t i = 0; i < used; ++i) out.printf("%s%u", i ? "," : "", s->bucket(i));
+    out.print("]}");
+  }
+  out.print("]}");
+  if (hal.http->arg("reset") == "1") perfResetAll();
+}
+
+// JSON API: loop() iteration times (lib/LoopWatch) and the stalls recorded in this
+// and earlier boots, newest first. hist[i] counts the iterations of 2^i to 2^(i+1) - 1 µs.
+void handleApiStalls() {
+  const StallLog& log = stallState.log;
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"thresholdMs\":%u,\"boot\":%u,\"persistent\":%s", config.stallMs, log.boots,
+             config.lowPower ? "false" : "true");
+  out.printf(",\"iterations\":%u,\"stalls\":%u", loopWatch.iterations(), loopWatch.stalls());
+  out.printf(",\"maxUs\":%u,\"hist\":[", loopWatch.maxUs());
+  uint8_t used = LOOP_BUCKETS;
+  while (used && !loopWatch.bucket(used - 1)) --used;
+  for (uint8_t i = 0; i < used; ++i) out.printf("%s%u", i ? "," : "", loopWatch.bucket(i));
+  out.printf("],\"total\":%u,\"records\":[", log.total);
+  for (uint8_t i = 0; i < log.count; ++i) {
+    const StallRecord& r = log.newest(i);
+    out.printf("%s{\"boot\":%u,\"atMs\":%u", i ? "," : "", r.boot, r.atMs);
+    out.printf(",\"loopUs\":%u,\"spanUs\":%u,\"name\":", r.loopUs, r.spanUs);
+    char name[STALL_NAME];
+    memcpy(name, r.name, STALL_NAME);
+    name[STALL_NAME - 1] = '\0';
+    printJsonString(out, name);
+    out.print("}");
+  }
+  out.print("]}");
+}
+
+// JSON API: the heap now (lib/HeapWatch), its worst values since boot, and per route
+// the most one request took, what the last one left allocated and the heap after
+void handleApiHeap() {
+  const HeapSample& now = heapWatch.sample(*hal.system);
+  const HeapMarks& m = heapWatch.marks();
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"free\":%u,\"maxBlock\":%u", now.freeBytes, now.maxBlock);
+  out.printf(",\"fragmentation\":%u,\"minFree\":%u", now.fragmentation, m.minFree);
+  out.printf(",\"minMaxBlock\":%u,\"maxFragmentation\":%u", m.minMaxBlock, m.maxFragmentation);
+  out.printf(",\"ticks\":%u,\"samples\":%u", heapWatch.ticks(), heapWatch.samples());
+  out.printf(",\"unlisted\":%u,\"routes\":[", heapWatch.unlistedRequests());
+  for (uint8_t i = 0; i < heapWatch.routeCount(); ++i) {
+    const HeapRoute& r = heapWatch.route(i);
+    out.print(i ? ",{\"path\":" : "{\"path\":");
+    printJsonString(out, r.path);
+    out.printf(",\"requests\":%u,\"peak\":%u", r.requests, r.maxPeakBytes);
+    out.printf(",\"retained\":%d,\"maxRetained\":%d", (int)r.retainedBytes, (int)r.maxRetainedBytes);
+    out.printf(",\"minFree\":%u,\"minMaxBlock\":%u", r.after.minFree, r.after.minMaxBlock);
+    out.printf(",\"maxFragmentation\":%u}", r.after.maxFragmentation);
+  }
+  out.print("]}");
+}
+
+// JSON API: every MAC address the firmware can see (for /debugmac)
+void handleApiMacs() {
+  uint8_t mac[6];
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.print("{\"wifi\":\"");
+  hal.wifi->macAddress(mac);
+  printMac(out, mac);
+  out.print("\",\"station\":\"");
+  hal.wifi->stationMac(mac);
+  printMac(out, mac);
+  out.print("\",\"softap\":\"");
+  hal.wifi->softApMac(mac);
+  printMac(out, mac);
+  out.print("\",\"user\":\"");
+  hal.wifi->stationMac(mac); // interface 0 is STATION_IF
+  printMac(out, mac);
+  out.print("\"}");
 }
 
 void handleSave(){
-  if(!server.hasArg("pmac") || !server.hasArg("minutes") || !server.hasArg("seconds") || !server.hasArg("barrel")){ 
-    server.send(400,"text/plain","Missing parameters"); 
+  if(!hal.http->hasArg("pmac") || !hal.http->hasArg("minutes") || !hal.http->hasArg("seconds") || !hal.http->hasArg("barrel")){ 
+    hal.http->send(400,"text/plain","Missing parameters"); 
     return;
   }
   
+  // Everything is parsed and checked on a copy; a rejected request leaves the
+  // running config as it was
+  Config next = config;
+  
   // Parse parent MAC
-  String macStr = server.arg("pmac");
-  if(!parseMac(macStr, config.parentMac)){ 
-    server.send(400,"text/plain","Bad MAC format"); 
+  String macStr = hal.http->arg("pmac");
+  if(!parseMac(macStr, next.parentMac)){ 
+    hal.http->send(400,"text/plain","Bad MAC format"); 
     return;
   }
   
   // Parse refresh rate
-  uint8_t minutes = server.arg("minutes").toInt();
-  uint8_t seconds = server.arg("seconds").toInt();
+  uint8_t minutes = hal.http->arg("minutes").toInt();
+  uint8_t seconds = hal.http->arg("seconds").toInt();
   if(minutes > 59 || seconds > 59) {
-    server.send(400,"text/plain","Invalid time format");
+    hal.http->send(400,"text/plain","Invalid time format");
     return;
   }
-  config.refreshRateMs = minSecToMs(minutes, seconds);
+  next.refreshRateMs = minSecToMs(minutes, seconds);
+  
+  // Parse the steady-level interval (optional, same format; at most the refresh rate keeps it fixed)
+  if(hal.http->hasArg("maxMinutes") && hal.http->hasArg("maxSeconds")) {
+    uint8_t maxMinutes = hal.http->arg("maxMinutes").toInt();
+    uint8_t maxSeconds = hal.http->arg("maxSeconds").toInt();
+    if(maxMinutes > 59 || maxSeconds > 59) {
+      hal.http->send(400,"text/plain","Invalid time format");
+      return;
+    }
+    next.refreshMaxMs = minSecToMs(maxMinutes, maxSeconds);
+  }
   
   // Parse barrel height
-  int barrel = server.arg("barrel").toInt();
+  int barrel = hal.http->arg("barrel").toInt();
   if(barrel <= 0 || barrel > 1000) {
-    server.send(400,"text/plain","Invalid barrel height");
+    hal.http->send(400,"text/plain","Invalid barrel height");
     return;
   }
-  config.barrelHeightCm = (float)barrel;
+  next.barrelHeightCm = (float)barrel;
+  
+  // Parse the mount height (optional; a calibration replaces it)
+  if(hal.http->hasArg("mount")) {
+    float mount = hal.http->arg("mount").toFloat();
+    if(mount < 0 || mount > 500) {
+      hal.http->send(400,"text/plain","Sensor height must be 0-500 cm");
+      return;
+    }
+    next.mountCm = mount;
+  }
+  
+  // Parse the tank shape (optional); it must make a volume table with the barrel height
+  if(hal.http->hasArg("shape")) {
+    int shape = hal.http->arg("shape").toInt();
+    if(shape < 0 || shape >= TANK_SHAPES) {
+      hal.http->send(400,"text/plain","Invalid tank shape");
+      return;
+    }
+    next.tankShape = (TankShape)shape;
+  }
+  if(hal.http->hasArg("tankWidth")) {
+    float width = hal.http->arg("tankWidth").toFloat();
+    if(width <= 0 || width > 10000) {
+      hal.http->send(400,"text/plain","Invalid tank width");
+      return;
+    }
+    next.tankWidthCm = width;
+  }
+  if(hal.http->hasArg("tankLength")) {
+    float length = hal.http->arg("tankLength").toFloat();
+    if(length <= 0 || length > 10000) {
+      hal.http->send(400,"text/plain","Invalid tank length");
+      return;
+    }
+    next.tankLengthCm = length;
+  }
+  if(hal.http->hasArg("strap")) {
+    String strap = hal.http->arg("strap");
+    TankDims d;
+    if(strap.length() == 0) {
+      next.strapPoints = 0;
+    } else if(!parseStrapTable(strap.c_str(), d)) {
+      hal.http->send(400,"text/plain","Strapping table must be 2-12 cm=liters pairs, both increasing");
+      return;
+    } else {
+      memcpy(next.strap, d.strap, sizeof(next.strap));
+      next.strapPoints = d.strapPoints;
+    }
+  }
+  TankGeometry check;
+  if(!check.compile(tankDims(next))) {
+    hal.http->send(400,"text/plain","These tank dimensions give no volume");
+    return;
+  }
+  
+  // Parse the additional sensors (optional): pins, barrel and mount height of each
+  if(hal.http->hasArg("channels")) {
+    int count = hal.http->arg("channels").toInt();
+    if(count < 1 || count > SENSOR_CHANNELS) {
+      hal.http->send(400,"text/plain","Invalid number of sensors");
+      return;
+    }
+    next.channels = (uint8_t)count;
+    for(uint8_t i = 1; i < count; ++i) {
+      String n(i);
+      String trig = "trig" + n, echo = "echo" + n, barrelArg = "barrel" + n, mountArg = "mount" + n;
+      if(!hal.http->hasArg(trig.c_str()) || !hal.http->hasArg(echo.c_str()) ||
+         !hal.http->hasArg(barrelArg.c_str()) || !hal.http->hasArg(mountArg.c_str())) {
+        hal.http->send(400,"text/plain","Missing sensor parameters");
+        return;
+      }
+      ChannelConfig& c = next.extra[i - 1];
+      float barrelCm = hal.http->arg(barrelArg.c_str()).toFloat();
+      float mountCm = hal.http->arg(mountArg.c_str()).toFloat();
+      if(barrelCm <= 0 || barrelCm > 1000 || mountCm < 0 || mountCm > 500) {
+        hal.http->send(400,"text/plain","Sensor barrel height must be 1-1000 cm, its height 0-500 cm");
+        return;
+      }
+      c.trigPin = (uint8_t)hal.http->arg(trig.c_str()).toInt();
+      c.echoPin = (uint8_t)hal.http->arg(echo.c_str()).toInt();
+      c.barrelHeightCm = barrelCm;
+      c.mountCm = mountCm;
+    }
+    if(!channelPinsValid(next)) {
+      hal.http->send(400,"text/plain","Sensor pins must be D1, D7, D8 or RX, each used once");
+      return;
+    }
+  }
+  
+  // Parse burst settings (optional, older forms don't send them)
+  if(hal.http->hasArg("burst")) {
+    int burst = hal.http->arg("burst").toInt();
+    if(burst < 1 || burst > MAX_BURST_SAMPLES) {
+      hal.http->send(400,"text/plain","Pings per reading must be 1-32");
+      return;
+    }
+    next.burstSamples = (uint8_t)burst;
+  }
+  if(hal.http->hasArg("filter")) {
+    next.filterMode = hal.http->arg("filter").toInt() == 1 ? FilterMode::TrimmedMean : FilterMode::Median;
+  }
+  
+  // Parse ESP-NOW batching (optional)
+  if(hal.http->hasArg("batch")) {
+    int batch = hal.http->arg("batch").toInt();
+    if(batch < 1 || batch > WIRE_MAX_SAMPLES) {
+      hal.http->send(400,"text/plain","Readings per frame must be 1-" + String(WIRE_MAX_SAMPLES));
+      return;
+    }
+    next.batchSize = (uint8_t)batch;
+  }
+  if(hal.http->hasArg("batchAge")) {
+    int batchAge = hal.http->arg("batchAge").toInt();
+    if(batchAge < 1 || batchAge > 3600) {
+      hal.http->send(400,"text/plain","Batch age must be 1-3600 seconds");
+      return;
+    }
+    next.batchMaxAgeS = (uint16_t)batchAge;
+  }
+  if(hal.http->hasArg("outbox")) {
+    next.outboxPolicy = hal.http->arg("outbox").toInt() == 0 ? OutboxPolicy::DropOldest : OutboxPolicy::Coalesce;
+  }
+  
+  // Parse the stall threshold (optional)
+  if(hal.http->hasArg("stallMs")) {
+    int stallMs = hal.http->arg("stallMs").toInt();
+    if(stallMs < 10 || stallMs > 10000) {
+      hal.http->send(400,"text/plain","Stall threshold must be 10-10000 ms");
+      return;
+    }
+    next.stallMs = (uint16_t)stallMs;
+  }
+  
+  // Parse the report policy (optional)
+  if(hal.http->hasArg("deadband")) {
+    float deadband = hal.http->arg("deadband").toFloat();
+    if(deadband < 0 || deadband > 100) {
+      hal.http->send(400,"text/plain","Deadband must be 0-100 %");
+      return;
+    }
+    next.reportDeadband = (uint16_t)lroundf(deadband * 10);
+  }
+  if(hal.http->hasArg("heartbeat")) {
+    long heartbeat = hal.http->arg("heartbeat").toInt();
+    if(heartbeat < 10 || heartbeat > 65535) {
+      hal.http->send(400,"text/plain","Heartbeat must be 10-65535 seconds");
+      return;
+    }
+    next.heartbeatS = (uint16_t)heartbeat;
+  }
+  if(hal.http->hasArg("lowAlarm") && hal.http->hasArg("highAlarm")) {
+    int lowAlarm = hal.http->arg("lowAlarm").toInt();
+    int highAlarm = hal.http->arg("highAlarm").toInt();
+    if(lowAlarm < 0 || highAlarm > 100 || lowAlarm > highAlarm) {
+      hal.http->send(400,"text/plain","Alarm levels must be 0-100 %, low below high");
+      return;
+    }
+    next.lowAlarmPct = (uint8_t)lowAlarm;
+    next.highAlarmPct = (uint8_t)highAlarm;
+  }
+  
+  // Parse sensor mode (optional)
+  if(hal.http->hasArg("sensor")) {
+    int mode = hal.http->arg("sensor").toInt();
+    if(mode < 0 || mode > (int)SensorMode::SerialControlled) {
+      hal.http->send(400,"text/plain","Invalid sensor mode");
+      return;
+    }
+    next.sensorMode = (SensorMode)mode;
+  }
+  
+  // Parse air temperature (optional) and the probe checkbox
+  if(hal.http->hasArg("airTemp")) {
+    int airTemp = hal.http->arg("airTemp").toInt();
+    if(airTemp < SOUND_TEMP_MIN || airTemp > SOUND_TEMP_MAX) {
+      hal.http->send(400,"text/plain","Air temperature must be -40 to 85 C");
+      return;
+    }
+    next.airTempC = (int8_t)airTemp;
+  }
+  next.tempProbe = hal.http->hasArg("probe");
+  
+  // Parse battery mode (checkbox)
+  next.lowPower = hal.http->hasArg("sleep");
   
   // Parse LED setting (checkbox - if present, LED is enabled)
-  config.ledEnabled = server.hasArg("led");
+  next.ledEnabled = hal.http->hasArg("led");
   
   // Parse SSID prefix
-  String ssidStr = server.arg("ssid");
+  String ssidStr = hal.http->arg("ssid");
   if(ssidStr.length() > 0 && ssidStr.length() <= 15) {
-    strcpy(config.ssidPrefix, ssidStr.c_str());
+    strcpy(next.ssidPrefix, ssidStr.c_str());
   }
   
   // Parse WiFi password
-  String passwordStr = server.arg("password");
+  String passwordStr = hal.http->arg("password");
   if(passwordStr.length() >= 8 && passwordStr.length() <= 31) {
-    strcpy(config.wifiPassword, passwordStr.c_str());
+    strcpy(next.wifiPassword, passwordStr.c_str());
   } else if(passwordStr.length() > 0) {
-    server.send(400,"text/plain","WiFi password must be 8-31 characters long");
+    hal.http->send(400,"text/plain","WiFi password must be 8-31 characters long");
     return;
   }
   
   // Save configuration
+  config = next;
   if(saveConfig(config)) {
-    server.send(200,"text/plain","Settings saved. Rebooting...");
-    delay(800);
-    ESP.restart();
+    hal.http->send(200,"text/plain","Settings saved. Rebooting...");
+    hal.clock->delayMs(800);
+    hal.system->restart();
   } else {
-    server.send(500,"text/plain","Failed to save settings");
+    hal.http->send(500,"text/plain","Failed to save settings");
   }
 }
 
 void handleUpdate(){
-  uint8_t selfMac[6]; WiFi.macAddress(selfMac);
-  
-  // Convert refresh rate to minutes and seconds
-  uint8_t minutes, seconds;
-  msToMinSec(config.refreshRateMs, minutes, seconds);
-  
-  String html = R"(
-  <html><head><meta name='viewport' content='width=device-width,initial-scale=1'/>
-  <title>ESP8266 Settings - Update</title>
-  <style>
-    body { font-family: Arial, sans-serif; margin: 20px; }
-    .form-group { margin-bottom: 15px; }
-    label { display: block; margin-bottom: 5px; font-weight: bold; }
-    input[type="text"], input[type="number"] { width: 200px; padding: 5px; }
-    input[type="submit"] { background-color: #4CAF50; color: white; padding: 10px 20px; border: none; cursor: pointer; }
-    input[type="submit"]:hover { background-color: #45a049; }
-    .info { background-color: #f0f0f0; padding: 10px; margin-bottom: 20px; border-radius: 5px; }
-    .btn { display: inline-block; padding: 8px 16px; margin: 5px; text-decoration: none; border-radius: 5px; font-weight: bold; }
-    .btn-secondary { background-color: #6c757d; color: white; }
-    .btn:hover { opacity: 0.8; }
-    .mac-info { background-color: #f8f9fa; padding: 10px; margin: 10px 0; border-radius: 3px; font-family: monospace; }
-  </style>
-  </head><body>
-  <h2>ESP8266 Distance Sensor Settings - Update</h2>
-  
-  <div class="info">
-    <p><b>Device MAC Addresses:</b></p>
-    <div class="mac-info">
-      <strong>WiFi MAC:</strong> %WIFI_MAC%<br>
-      <strong>ESP-NOW MAC:</strong> %ESPNOW_MAC% (Use this for ESP-NOW configuration)
-    </div>
-    <p><b>Status:</b>Updating configuration</p>
-  </div>
-  
-  <form action='/save' method='post'>
-    <div class="form-group">
-      <label for="pmac">Parent MAC Address:</label>
-      <input type="text" id="pmac" name="pmac" value="%PARENT_MAC%" placeholder="FF:FF:FF:FF:FF:FF">
-    </div>
-    
-    <div class="form-group">
-      <label for="minutes">Refresh Rate:</label>
-      <input type="number" id="minutes" name="minutes" value="%MINUTES%" min="0" max="59" style="width: 80px;"> minutes
-      <input type="number" id="seconds" name="seconds" value="%SECONDS%" min="0" max="59" style="width: 80px;"> seconds
-    </div>
-    
-                         <div class="form-group">
-        <label for="barrel">Barrel Height (cm):</label>
-        <input type="number" id="barrel" name="barrel" value="%BARREL_HEIGHT%" min="1" max="1000" step="1">
-      </div>
-      
-      <div class="form-group">
-        <label for="led">
-          <input type="checkbox" id="led" name="led" %LED_CHECKED%>
-          Enable LED blinking (indicates device is working)
-        </label>
-      </div>
-      
-      <div class="form-group">
-        <label for="ssid">WiFi SSID Prefix:</label>
-        <input type="text" id="ssid" name="ssid" value="%SSID_PREFIX%" placeholder="WATER_SENSOR_" maxlength="15">
-        <small>SSID will be: [prefix]XXXXXX (where XXXXXX is device MAC)</small>
-      </div>
-      
-      <div class="form-group">
-        <label for="password">WiFi Password:</label>
-        <input type="text" id="password" name="password" value="%WIFI_PASSWORD%" placeholder="HardPassword1234" minlength="8" maxlength="31">
-        <small>Must be at least 8 characters long</small>
-      </div>
-      
-            <input type="submit" value="Update Settings & Reboot">
-    <a href="/" class="btn btn-secondary">Cancel</a>
-  </form>
-  </body></html>)";
-  
-  html.replace("%WIFI_MAC%", getWiFiMac());
-  html.replace("%ESPNOW_MAC%", getEspNowMac());
-  html.replace("%PARENT_MAC%", macToString(config.parentMac.data()));
-     html.replace("%MINUTES%", String(minutes));
-   html.replace("%SECONDS%", String(seconds));
-       html.replace("%BARREL_HEIGHT%", String((int)config.barrelHeightCm));
-    html.replace("%LED_CHECKED%", config.ledEnabled ? "checked" : "");
-    html.replace("%SSID_PREFIX%", String(config.ssidPrefix));
-    html.replace("%WIFI_PASSWORD%", String(config.wifiPassword));
-    
-    server.send(200,"text/html",html);
+  sendAsset(WEB_UPDATE_HTML);
 }
 
 void handleReset(){
-  // Reset configuration to defaults
-  config.parentMac = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
-  config.refreshRateMs = 5000;
-  config.barrelHeightCm = 50.0;
-  config.ledEnabled = true;
-  strcpy(config.ssidPrefix, "WATER_SENSOR_");
-  strcpy(config.wifiPassword, "HardPassword1234");
-  
-  // Clear EEPROM
+  // Reset configuration to defaults, every field (strapping table and fit
+  // coefficients too); nothing survives a reset
+  config = Config();
+  
+  // Clear the stored configuration
   clearConfig();
   
   // Send confirmation page
-  String html = R"(
-  <html><head><meta name='viewport' content='width=device-width,initial-scale=1'/>
-  <title>ESP8266 Settings - Reset</title>
-  <style>
-    body { font-family: Arial, sans-serif; margin: 20px; }
-    .success { background-color: #d4edda; padding: 15px; margin-bottom: 20px; border-radius: 5px; border-left: 4px solid #28a745; }
-    .btn { display: inline-block; padding: 10px 20px; margin: 5px; text-decoration: none; border-radius: 5px; font-weight: bold; }
-    .btn-primary { background-color: #007bff; color: white; }
-    .btn:hover { opacity: 0.8; }
-  </style>
-  </head><body>
-  <h2>ESP8266 Distance Sensor Settings - Reset</h2>
-  
-  <div class="success">
-    <p><b>Settings Reset Successfully!</b></p>
-    <p>All configuration has been cleared and reset to default values.</p>
-    <ul>
-             <li><b>Parent MAC:</b> FF:FF:FF:FF:FF:FF (Broadcast)</li>
-       <li><b>Refresh Rate:</b> 0m 5s</li>
-       <li><b>Barrel Height:</b> 50 cm</li>
-       <li><b>LED Status:</b> Enabled</li>
-       <li><b>WiFi SSID:</b> WATER_SENSOR_XXXXXX</li>
-       <li><b>WiFi Password:</b> HardPassword1234</li>
-     </ul>
-  </div>
-  
-  <p>The device will now use default settings on next boot.</p>
-  
-  <a href="/" class="btn btn-primary">Back to Settings</a>
-  
-  </body></html>)";
-  
-  server.send(200,"text/html",html);
+  sendAsset(WEB_RESET_HTML);
 }
 
 // Handle immediate sensor reading endpoint
@@ -754,187 +2189,214 @@ void handleReadSensor() {
   Serial.println("=== MANUAL SENSOR READING TRIGGERED ===");
   
   // Force immediate sensor reading
-  currentDistance = measureDistanceCM();
-  currentWaterLevel = calculateWaterLevel(currentDistance, config.barrelHeightCm);
-  lastSensorRead = millis();
-  
-  // Debug output
-  Serial.printf("Manual sensor reading - Distance: %.1f cm, Water Level: %.1f%%\n", 
-                currentDistance, currentWaterLevel);
-  
-  // Send data via ESP-NOW if initialized
-  if (espNowInitialized) {
-    Serial.println("Manual-sending data via ESP-NOW (button trigger)");
-    sendEspNowData();
-  }
-  
-  // Return JSON response
-  String json = "{\"distance\":" + String(currentDistance, 1) + 
-                ",\"waterLevel\":" + String(currentWaterLevel, 1) + 
-                ",\"barrelHeight\":" + String((int)config.barrelHeightCm) + "}";
+  float distance = measureDistanceCM(hal.clock->millis());
+  lastSensorRead = hal.clock->millis();
+  scheduleSensor();
+  applySensorReading(distance, "button trigger", true);
+  sendEspNowData(); // don't hold a manual reading back for the batch
   
-  Serial.printf("Sending JSON response: %s\n", json.c_str());
+  Serial.printf("Reading: %.1f cm, %.1f%%\n", currentDistance, currentWaterLevel);
   Serial.println("=== MANUAL SENSOR READING COMPLETED ===");
-  
-  server.sendHeader("Access-Control-Allow-Origin", "*");
-  server.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
-  server.sendHeader("Access-Control-Allow-Headers", "Content-Type");
-  server.send(200, "application/json", json);
+
+  // JSON response, streamed; the headers go out with the first chunk
+  hal.http->sendHeader("Access-Control-Allow-Origin", "*");
+  hal.http->sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+  hal.http->sendHeader("Access-Control-Allow-Headers", "Content-Type");
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"distance\":%.1f,\"waterLevel\":", currentDistance);
+  printLevel(out, currentDistance, currentWaterLevel);
+  out.print(",\"volume\":");
+  printLiters(out, currentVolume);
+  out.printf(",\"barrelHeight\":%d,\"trackedLevel\":%.1f", (int)config.barrelHeightCm, currentTrackedLevel);
+  out.printf(",\"levelRate\":%.2f,\"confidence\":%u", levelTracker.rateCmPerMin(), levelTracker.confidence());
+  out.printf(",\"echo\":{\"confidence\":%u,\"label\":\"%s\"}", channels[0].echo.confidence(),
+             echoClassName(channels[0].echo.label()));
+  out.printf(",\"temperature\":%.2f,\"tempSource\":\"%s\"", soundSpeed.temperatureC(), probeOk ? "probe" : "config");
+  out.print(",\"channels\":[");
+  for (uint8_t i = 0; i < channelCount; ++i) {
+    out.printf("%s{\"distance\":%.1f,\"waterLevel\":", i ? "," : "", channels[i].distance);
+    printLevel(out, channels[i].distance, channels[i].level);
+    out.printf(",\"confidence\":%u}", channels[i].echo.confidence());
+  }
+  out.print("]}");
 }
 
-// Debug endpoint to test different MAC addresses
-void handleDebugMac() {
-  String html = R"(
-  <html><head><meta name='viewport' content='width=device-width,initial-scale=1'/>
-  <title>ESP8266 MAC Address Debug</title>
-  <style>
-    body { font-family: Arial, sans-serif; margin: 20px; }
-    .mac-info { background-color: #f8f9fa; padding: 15px; margin: 10px 0; border-radius: 5px; font-family: monospace; }
-    .btn { display: inline-block; padding: 10px 20px; margin: 5px; text-decoration: none; border-radius: 5px; font-weight: bold; }
-    .btn-primary { background-color: #007bff; color: white; }
-    .btn-success { background-color: #28a745; color: white; }
-    .btn:hover { opacity: 0.8; }
-  </style>
-  </head><body>
-  <h2>ESP8266 MAC Address Debug</h2>
-  
-  <div class="mac-info">
-    <h3>All Available MAC Addresses:</h3>
-    <p><strong>WiFi MAC:</strong> %WIFI_MAC%</p>
-    <p><strong>STATION_IF MAC:</strong> %STATION_MAC%</p>
-    <p><strong>SOFTAP_IF MAC:</strong> %SOFTAP_MAC%</p>
-    <p><strong>User Interface 0 MAC:</strong> %USER_MAC%</p>
-  </div>
-  
-  <div class="mac-info">
-    <h3>Instructions:</h3>
-    <p>1. Check your parent device to see which MAC address it reports receiving data from</p>
-    <p>2. Compare it with the MAC addresses listed above</p>
-    <p>3. Use the matching MAC address for ESP-NOW configuration</p>
-  </div>
-  
-  <div style='text-align: center;'>
-    <a href='/' class='btn btn-primary'>Back to Settings</a>
-    <button onclick='sendTestData()' class='btn btn-success'>Send Test ESP-NOW Data</button>
-  </div>
-  
-  <script>
-  function sendTestData() {
-    fetch('/read')
-      .then(response => response.json())
-      .then(data => {
-        alert('Test data sent! Check your parent device to see which MAC address it reports.');
-      })
-      .catch(error => {
-        alert('Error sending test data: ' + error);
-      });
-  }
-  </script>
-  
-  </body></html>)";
-  
-  // Get all MAC addresses
-  uint8_t mac[6];
-  
-  wifi_get_macaddr(STATION_IF, mac);
-  String stationMac = macToString(mac);
-  
-  wifi_get_macaddr(SOFTAP_IF, mac);
-  String softapMac = macToString(mac);
-  
-  WiFi.macAddress(mac);
-  String wifiMac = macToString(mac);
-  
-  uint8_t userMac[6];
-  wifi_get_macaddr(0, userMac);
-  String userMacStr = macToString(userMac);
-  
-  html.replace("%WIFI_MAC%", wifiMac);
-  html.replace("%STATION_MAC%", stationMac);
-  html.replace("%SOFTAP_MAC%", softapMac);
-  html.replace("%USER_MAC%", userMacStr);
-  
-  server.send(200, "text/html", html);
+// The sensor a calibration request is about ("channel", default: the one the
+// captured points belong to)
+uint8_t calibrationChannel() {
+  if (!hal.http->hasArg("channel")) return calChannel;
+  long channel = hal.http->arg("channel").toInt();
+  return channel > 0 && channel < channelCount ? (uint8_t)channel : 0;
 }
 
-// Handle sensor reading endpoint
-void handleSensor() {
-  // Update sensor readings if needed
-  updateSensorReadings();
-  
-  // Convert refresh rate to display text
-  uint8_t minutes, seconds;
-  msToMinSec(config.refreshRateMs, minutes, seconds);
-  String refreshRateText;
-  if (minutes > 0) {
-    refreshRateText = String(minutes) + "m " + String(seconds) + "s";
+// Calibration state of a sensor: coefficients in use, and the captured points with
+// their residual against them
+void handleApiCalibration() {
+  uint8_t channel = calibrationChannel();
+  const SensorChannel& ch = channels[channel];
+  ChannelConfig cc = channelConfig(config, channel);
+  const CalCoeffs& c = ch.calibration.coeffs();
+  bool captured = channel == calChannel;
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"channel\":%u,\"channels\":%u", channel, channelCount);
+  out.printf(",\"calibrated\":%s,\"offset\":%.3f", cc.calibrated ? "true" : "false", c.offset);
+  out.printf(",\"gain\":%.5f,\"quad\":%.8f", c.gain, c.quad);
+  out.printf(",\"mountCm\":%.1f,\"barrelHeight\":%.1f", cc.mountCm, cc.barrelHeightCm);
+  out.printf(",\"rms\":%.2f,\"maxPoints\":%u,\"points\":[", captured ? calRmsCm : -1.0f, CAL_MAX_POINTS);
+  for (uint8_t i = 0; captured && i < calPointCount; ++i) {
+    const CalPoint& p = calPoints[i];
+    out.printf("%s[%.1f,%.1f,%.2f]", i ? "," : "", p.distanceCm, p.heightCm,
+               ch.calibration.heightCm(p.distanceCm) - p.heightCm);
+  }
+  out.printf("],\"distance\":%.1f,\"height\":%.1f}", ch.distance,
+             ch.distance < 0 ? 0.0f : ch.calibration.heightCm(ch.distance));
+}
+
+// Save a sensor's calibration (or its absence) to the config and put it to use
+bool saveChannelCalibration(uint8_t channel, bool calibrated, const CalCoeffs& c) {
+  if (channel) {
+    config.extra[channel - 1].calibrated = calibrated;
+    if (calibrated) config.extra[channel - 1].cal = c;
   } else {
-    refreshRateText = String(seconds) + "s";
-  }
-  
-  String html = "<html><head><meta name='viewport' content='width=device-width,initial-scale=1'/>";
-  html += "<title>ESP8266 Water Level Sensor - Live Reading</title>";
-  html += "<style>";
-  html += "body { font-family: Arial, sans-serif; margin: 20px; }";
-  html += ".sensor { background-color: #e3f2fd; padding: 20px; margin-bottom: 20px; border-radius: 5px; border-left: 4px solid #2196F3; }";
-  html += ".value { font-size: 48px; font-weight: bold; color: #1976D2; text-align: center; margin: 20px 0; }";
-  html += ".btn { display: inline-block; padding: 10px 20px; margin: 5px; text-decoration: none; border-radius: 5px; font-weight: bold; }";
-  html += ".btn-primary { background-color: #007bff; color: white; }";
-  html += ".btn-success { background-color: #28a745; color: white; }";
-  html += ".btn:hover { opacity: 0.8; }";
-  html += ".info { background-color: #f0f0f0; padding: 10px; margin-bottom: 20px; border-radius: 5px; }";
-  html += "</style>";
-  html += "<script>";
-  html += "function refreshReading() {";
-  html += "  console.log('Refresh button clicked - fetching new data...');";
-  html += "  document.getElementById('refreshBtn').textContent = 'Refreshing...';";
-  html += "  document.getElementById('refreshBtn').disabled = true;";
-  html += "  fetch('/read')";
-  html += "    .then(response => {";
-  html += "      console.log('Response status:', response.status);";
-  html += "      return response.json();";
-  html += "    })";
-  html += "    .then(data => {";
-  html += "      console.log('Received data:', data);";
-  html += "      document.getElementById('waterLevel').textContent = data.waterLevel + '%';";
-  html += "      document.getElementById('distance').textContent = data.distance + ' cm';";
-  html += "      document.getElementById('barrelHeight').textContent = data.barrelHeight + ' cm';";
-  html += "      document.getElementById('refreshBtn').textContent = 'Refresh Reading';";
-  html += "      document.getElementById('refreshBtn').disabled = false;";
-  html += "      console.log('Data updated successfully');";
-  html += "    })";
-  html += "    .catch(error => {";
-  html += "      console.error('Error fetching sensor data:', error);";
-  html += "      document.getElementById('refreshBtn').textContent = 'Error - Click to Retry';";
-  html += "      document.getElementById('refreshBtn').disabled = false;";
-  html += "    });";
-  html += "}";
-  html += "setTimeout(refreshReading, " + String(config.refreshRateMs) + ");";
-  html += "</script>";
-  html += "</head><body>";
-  html += "<h2>ESP8266 Water Level Sensor - Live Reading</h2>";
-  html += "<div class='info'>";
-  html += "<p><b>Current Water Level Reading:</b></p>";
-  if (espNowInitialized) {
-    html += "<p style='color: #28a745;'><b>ESP-NOW Status:</b> " + String(espNowSendSuccess ? "Connected" : "Error") + "</p>";
+    config.calibrated = calibrated;
+    if (calibrated) config.cal = c;
+  }
+  if (!saveConfig(config)) return false;
+  applyCalibration();
+  updateRangeGate();
+  return true;
+}
+
+// Calibration page actions (POST /api/calibrate, action=..., channel=sensor):
+//   add    take a reading now at the known water height "level" (cm above the bottom);
+//          the first one for another sensor than the captured points drops them
+//   fit    least-squares fit of the points ("quadratic" adds the d² term), saved to the config
+//   clear  forget the captured points
+//   reset  back to the uncalibrated mount height
+void handleCalibrate() {
+  String action = hal.http->arg("action");
+  uint8_t channel = calibrationChannel();
+  if (action == "add") {
+    float level = hal.http->arg("level").toFloat();
+    if (!hal.http->hasArg("level") || level < 0 || level > channels[channel].barrelHeightCm) {
+      hal.http->send(400, "text/plain", "The water height must be 0 to the barrel height");
+      return;
+    }
+    if (channel != calChannel) {
+      calChannel = channel;
+      calPointCount = 0;
+      calRmsCm = -1;
+    }
+    if (calPointCount == CAL_MAX_POINTS) {
+      hal.http->send(400, "text/plain", "All points are taken: fit or clear them");
+      return;
+    }
+    float distance = measureDistanceCM(hal.clock->millis());
+    if (channel) distance = channels[channel].distance;
+    if (distance < 0) {
+      hal.http->send(400, "text/plain", "No echo, try again");
+      return;
+    }
+    if (!channel) currentDistance = distance;
+    calPoints[calPointCount++] = {distance, level};
+    Serial.printf("Calibration point %u of sensor %u: %.1f cm at a height of %.1f cm\n", calPointCount, channel,
+                  distance, level);
+  } else if (action == "fit") {
+    CalCoeffs c;
+    float rms;
+    if (channel != calChannel ||
+        !fitCalibration(calPoints, calPointCount, hal.http->hasArg("quadratic"), c, rms)) {
+      hal.http->send(400, "text/plain", "No fit: take at least 2 points (3 with the quadratic term) at levels far enough apart");
+      return;
+    }
+    if (!saveChannelCalibration(channel, true, c)) {
+      hal.http->send(500, "text/plain", "Failed to save the calibration");
+      return;
+    }
+    calRmsCm = rms;
+    Serial.printf("Calibration of sensor %u: height = %.3f %+.5f d %+.8f d^2, rms %.2f cm\n", channel, c.offset,
+                  c.gain, c.quad, rms);
+  } else if (action == "clear") {
+    calPointCount = 0;
+  } else if (action == "reset") {
+    if (!saveChannelCalibration(channel, false, CalCoeffs())) {
+      hal.http->send(500, "text/plain", "Failed to save the calibration");
+      return;
+    }
+    if (channel == calChannel) calRmsCm = -1;
   } else {
-    html += "<p style='color: #dc3545;'><b>ESP-NOW Status:</b> Disabled (Parent MAC not configured)</p>";
+    hal.http->send(400, "text/plain", "Unknown action");
+    return;
   }
-  html += "</div>";
-  html += "<div class='sensor'>";
-  html += "<div class='value' id='waterLevel'>" + String(currentWaterLevel, 1) + "%</div>";
-  html += "<p style='text-align: center; margin: 0;'>Water Level | Distance: <span id='distance'>" + String(currentDistance, 1) + "</span> cm | Barrel Height: <span id='barrelHeight'>" + String((int)config.barrelHeightCm) + "</span> cm</p>";
-  html += "</div>";
-  html += "<div style='text-align: center;'>";
-  html += "<a href='/' class='btn btn-primary'>Back to Settings</a>";
-  html += "<button onclick='refreshReading()' class='btn btn-success' id='refreshBtn'>Refresh Reading</button>";
-  html += "</div>";
-  html += "<p style='text-align: center; margin-top: 20px; color: #666;'>";
-  html += "<small>Auto-refreshing every " + refreshRateText + "</small>";
-  html += "</p>";
-  html += "</body></html>";
-  
-  server.send(200,"text/html",html);
+  handleApiCalibration();
+}
+
+// Stream one rollup ring as [[t,min,max,avg,count,minVolume,maxVolume,avgVolume],...]
+// (the volumes are those of the min/max/avg level)
+template <typename RollupRing>
+void streamRollups(ChunkWriter& out, const RollupRing& ring) {
+  for (uint16_t i = 0; i < ring.size(); ++i) {
+    const Rollup& r = ring[i];
+    uint16_t avg = r.avg();
+    out.printf("%s[%u,%u.%02u,%u.%02u,%u.%02u,%u,", i ? "," : "", r.startSec,
+               r.min / HISTORY_LEVEL_SCALE, r.min % HISTORY_LEVEL_SCALE,
+               r.max / HISTORY_LEVEL_SCALE, r.max % HISTORY_LEVEL_SCALE,
+               avg / HISTORY_LEVEL_SCALE, avg % HISTORY_LEVEL_SCALE, r.count);
+    printLiters(out, levelLiters((float)r.min / HISTORY_LEVEL_SCALE));
+    out.print(",");
+    printLiters(out, levelLiters((float)r.max / HISTORY_LEVEL_SCALE));
+    out.print(",");
+    printLiters(out, levelLiters((float)avg / HISTORY_LEVEL_SCALE));
+    out.print("]");
+  }
+}
+
+// History endpoint: /history?res=raw|minute|hour
+// Times are seconds of uptime; "now" is the current uptime for computing ages.
+// The response is streamed in chunks straight from the ring buffers.
+void handleHistory() {
+  // Anything but the two rollups is the raw view; only these names are echoed
+  String arg = hal.http->hasArg("res") ? hal.http->arg("res") : String();
+  const char* res = arg == "minute" ? "minute" : arg == "hour" ? "hour" : "raw";
+  
+  ChunkWriter out(*hal.http, 200, "application/json");
+  out.printf("{\"now\":%u,\"res\":\"%s\",", history.nowSec(hal.clock->millis()), res);
+  
+  if (strcmp(res, "raw") != 0) {
+    out.print("\"fields\":[\"t\",\"min\",\"max\",\"avg\",\"count\",\"minVolume\",\"maxVolume\",\"avgVolume\"],\"samples\":[");
+    if (strcmp(res, "minute") == 0) streamRollups(out, history.minutes());
+    else streamRollups(out, history.hours());
+  } else {
+    out.print("\"fields\":[\"t\",\"distance\",\"waterLevel\",\"volume\"],\"samples\":[");
+    bool first = true;
+    history.forEachRaw([&](uint32_t t, const RawSample& s) {
+      if (s.distance == HISTORY_INVALID) {
+        out.printf("%s[%u,null,null,null]", first ? "" : ",", t);
+      } else {
+        out.printf("%s[%u,%u.%u,%u.%02u,", first ? "" : ",", t,
+                   s.distance / HISTORY_DIST_SCALE, s.distance % HISTORY_DIST_SCALE,
+                   s.level / HISTORY_LEVEL_SCALE, s.level % HISTORY_LEVEL_SCALE);
+        printLiters(out, levelLiters((float)s.level / HISTORY_LEVEL_SCALE));
+        out.print("]");
+      }
+      first = false;
+    });
+  }
+  out.print("]}");
+}
+
+void handleCalibrationPage() {
+  sendAsset(WEB_CALIBRATE_HTML);
+}
+
+// Debug endpoint to test different MAC addresses
+void handleDebugMac() {
+  sendAsset(WEB_DEBUGMAC_HTML);
+}
+
+// Live water level page
+void handleSensor() {
+  sendAsset(WEB_SENSOR_HTML);
 }
 
 // Get the actual MAC address that ESP-NOW uses
@@ -943,20 +2405,20 @@ String getEspNowMac() {
   
   // Try different methods to get the MAC address
   // Method 1: Get from STATION interface
-  wifi_get_macaddr(STATION_IF, mac);
+  hal.wifi->stationMac(mac);
   String stationMac = macToString(mac);
   
   // Method 2: Get from SOFTAP interface
-  wifi_get_macaddr(SOFTAP_IF, mac);
+  hal.wifi->softApMac(mac);
   String softapMac = macToString(mac);
   
   // Method 3: Get from WiFi library
-  WiFi.macAddress(mac);
+  hal.wifi->macAddress(mac);
   String wifiMac = macToString(mac);
   
   // Method 4: Get from user_interface (ESP8266 specific)
   uint8_t userMac[6];
-  wifi_get_macaddr(0, userMac); // Interface 0
+  hal.wifi->stationMac(userMac); // Interface 0
   String userMacStr = macToString(userMac);
   
   // Log all MAC addresses for debugging
@@ -974,69 +2436,142 @@ String getEspNowMac() {
 // Get the MAC address that WiFi uses
 String getWiFiMac() {
   uint8_t mac[6];
-  WiFi.macAddress(mac);
+  hal.wifi->macAddress(mac);
   return macToString(mac);
 }
 
 /* ---------- button long‑press reset -------------------------------------- */
+uint32_t buttonDownMs = 0;    // when BOOT went down, 0 while up
+
 void checkButton(){
-  static uint32_t t0=0;
-  static bool pressed = false;
-  
-  if(digitalRead(BTN_PIN)==LOW){
-    if(!t0) {
-      t0 = millis();
-      pressed = true;
+  if(hal.gpio->read(BTN_PIN)==LOW){
+    if(!buttonDownMs) {
+      buttonDownMs = hal.clock->millis();
     }
-    else if(millis()-t0>=BTN_HOLD_MS){
+    else if(hal.clock->millis()-buttonDownMs>=BTN_HOLD_MS){
       Serial.println("Long press → clearing config");
       clearConfig();
       blink(3,100);
-      ESP.restart();
+      hal.system->restart();
     }
-  } else if(pressed && t0 > 0) {
-    pressed = false;
-    t0 = 0;
+  } else {
+    buttonDownMs = 0;
   }
 }
 
-void setup() {
-  Serial.begin(74880);  // Standard ESP8266 baud rate
-  delay(200);
-  
-  Serial.println("\n\n=== ESP8266 Configuration Mode Starting ===");
-  
+/* ---------- loop() tasks (lib/TimerWheel) -------------------------------- */
+void runSensorTask() {
+  updateSensorReadings();
+  scheduleSensor();
+}
 
-  
+// A conversion is read PROBE_CONVERSION_MS after it started, the next one starts
+// PROBE_REFRESH_MS after that
+void runProbeTask() {
+  updateTemperature();
+  uint32_t waitMs = probeConverting ? PROBE_CONVERSION_MS : PROBE_REFRESH_MS;
+  timers.schedule(probeTask, probeStartMs + waitMs);
+}
+
+// Send a partial batch once its oldest reading reaches the age limit
+void runBatchAgeTask() {
+  LOG_INFO(LogMsg::EspNowAgeLimit);
+  sendEspNowData();
+}
+
+// Blink LED to indicate device is working (only scheduled if enabled)
+bool ledState = false;
+void blinkLed() {
+  ledState = !ledState;
+  hal.gpio->write(LED_PIN, ledState ? LOW : HIGH); // LOW = on, HIGH = off
+}
+
+// Battery mode: the AP was only brought up by the button, go back to sleeping
+void endConfigMode() {
+  Serial.println("Config mode timeout → back to battery mode");
+  hal.system->restart();
+}
+
+// Logged records go out on Serial while no burst is timing pings
+void runLogTask() {
+  if (!burstActive) drainLog(LOG_DRAIN_PER_LOOP);
+}
+
+void sampleHeap() {
+  heapWatch.sample(*hal.system);
+}
+
+// Request hook of the web server: the heap before, during and after every handler
+void watchRequestHeap(const char* path, bool done) {
+  if (done) {
+    heapWatch.endRequest(path, *hal.system);
+  } else {
+    heapWatch.beginRequest(*hal.system);
+  }
+}
+
+void startTasks() {
+  uint32_t now = hal.clock->millis();
+  timers.begin(now);
+  scheduleSensor();
+  if (probeFound) timers.schedule(probeTask, now);
+  if (config.ledEnabled) timers.schedule(ledTask, now + LED_BLINK_MS);
+  timers.schedule(buttonTask, now);
+  if (config.lowPower) timers.schedule(configTimeoutTask, now + CONFIG_MODE_TIMEOUT_MS);
+  timers.schedule(logTask, now);
+  timers.schedule(heapTask, now + HEAP_SAMPLE_MS);
+}
+
+void setup() {
   // Initialize pins
-  pinMode(LED_PIN,OUTPUT); 
-  digitalWrite(LED_PIN,HIGH);
-  pinMode(BTN_PIN,INPUT_PULLUP);
-  
-  // Initialize ultrasonic sensor pins
-  pinMode(TRIG_PIN, OUTPUT);
-  pinMode(ECHO_PIN, INPUT);
-  
-  Serial.println("Pins initialized");
+  hal.gpio->mode(LED_PIN,PinMode::Output); 
+  hal.gpio->write(LED_PIN,HIGH);
+  hal.gpio->mode(BTN_PIN,PinMode::InputPullup);
   
   // Load configuration (if exists)
   bool configLoaded = loadConfig(config);
+  wakeStateValid = loadWakeState();
+  
+  // Initialize the ultrasonic sensor in the configured mode
+  readInterval.setLimits(config.refreshRateMs, config.refreshMaxMs);
+  tank.compile(tankDims(config));
+  applyCalibration();
+  initSensor();
+  initTemperature();
+  
+  // Battery mode: read, send, sleep; the AP only comes up when BOOT is held
+  if (config.lowPower) {
+    bool requested = wakeStateValid && wakeState.configNextWake;
+    if (!requested && !configButtonHeld()) {
+      runLowPowerWake();
+      return;
+    }
+    if (wakeStateValid && !wakeState.radioThisWake) {
+      sleepIntoConfigMode();
+      return;
+    }
+    if (requested) {
+      wakeState.configNextWake = false;
+      saveWakeState();
+    }
+  }
+  
+  Serial.begin(74880);  // Standard ESP8266 baud rate
+  hal.clock->delayMs(200);
+  
+  Serial.println("\n\n=== ESP8266 Configuration Mode Starting ===");
+  Serial.println("Pins initialized");
   Serial.printf("Config loaded: %s\n", configLoaded ? "YES" : "NO");
 
   // Clean WiFi setup (same as working example)
   Serial.println("Setting up WiFi...");
-  WiFi.persistent(false);   // don't write Wi-Fi settings to flash
-  WiFi.mode(WIFI_OFF);
-  delay(50);
-  WiFi.mode(WIFI_AP);
-
-  // Configure AP IP (optional)
+  // Wi-Fi off → AP mode with our AP IP, settings not persisted to flash
   Serial.println("Configuring AP IP...");
-  WiFi.softAPConfig(local_IP, gateway, subnet);
+  hal.wifi->beginAccessPoint(local_IP, gateway, subnet);
 
   // NOW get MAC address after WiFi is initialized
   uint8_t mac[6]; 
-  WiFi.macAddress(mac);
+  hal.wifi->macAddress(mac);
   char ssid[32]; 
   sprintf(ssid,"%s%02X%02X%02X",config.ssidPrefix,mac[3],mac[4],mac[5]);
   
@@ -1049,40 +2584,56 @@ void setup() {
 
   // Start AP: channel=1, hidden=0 (visible), max_conn=4
   Serial.println("Starting AP...");
-  bool ok = WiFi.softAP(ssid, config.wifiPassword, 1, 0, 4);
+  bool ok = hal.wifi->softAP(ssid, config.wifiPassword, 1, false, 4);
 
   Serial.println(ok ? "AP started" : "AP failed");
   Serial.print("SSID: "); Serial.println(ssid);
   Serial.print("Password: "); Serial.println(config.wifiPassword);
-  Serial.print("AP IP: "); Serial.println(WiFi.softAPIP());
+  Serial.print("AP IP: "); Serial.println(hal.wifi->softAPIP());
   
   // Verify AP is working
   Serial.println("=== AP VERIFICATION ===");
-  Serial.printf("Current SSID: %s\n", WiFi.softAPSSID().c_str());
-  Serial.printf("Current Password: %s\n", WiFi.softAPPSK().c_str());
-  Serial.printf("AP Status: %s\n", WiFi.softAPgetStationNum() >= 0 ? "RUNNING" : "ERROR");
-  Serial.printf("AP Mode: %s\n", WiFi.getMode() == WIFI_AP ? "AP MODE" : "WRONG MODE");
-  Serial.printf("AP Channel: %d\n", WiFi.channel());
+  Serial.printf("Current SSID: %s\n", hal.wifi->softAPSSID().c_str());
+  Serial.printf("Current Password: %s\n", hal.wifi->softAPPSK().c_str());
+  Serial.printf("AP Mode: %s\n", hal.wifi->isApMode() ? "AP MODE" : "WRONG MODE");
+  Serial.printf("AP Channel: %d\n", hal.wifi->channel());
   Serial.println("=======================");
   
      // If AP failed, try alternative approach
    if (!ok) {
      Serial.println("Trying alternative AP setup...");
-     WiFi.softAP(ssid, config.wifiPassword);  // Try without extra parameters
-     delay(1000);
-     Serial.printf("Alternative SSID: %s\n", WiFi.softAPSSID().c_str());
-     Serial.printf("Alternative Password: %s\n", WiFi.softAPPSK().c_str());
+     hal.wifi->softAP(ssid, config.wifiPassword, WIFI_CH, false, 4);  // Retry once
+     hal.clock->delayMs(1000);
+     Serial.printf("Alternative SSID: %s\n", hal.wifi->softAPSSID().c_str());
+     Serial.printf("Alternative Password: %s\n", hal.wifi->softAPPSK().c_str());
    }
   
   // Setup web server
-  server.on("/",handleRoot);
-  server.on("/save",HTTP_POST,handleSave);
-  server.on("/update",handleUpdate);
-  server.on("/reset",handleReset);
-  server.on("/sensor",handleSensor);
-  server.on("/read",handleReadSensor);
-  server.on("/debugmac", handleDebugMac); // Add the new debug endpoint
-  server.begin();
+  const char* headerKeys[] = {"If-None-Match"};
+  hal.http->collectHeaders(headerKeys, 1);
+  hal.http->setRequestHook(watchRequestHeap);
+  hal.http->on("/",handleRoot);
+  hal.http->on("/save",HttpMethod::Post,handleSave);
+  hal.http->on("/update",handleUpdate);
+  hal.http->on("/reset",handleReset);
+  hal.http->on("/sensor",handleSensor);
+  hal.http->on("/read",handleReadSensor);
+  hal.http->on("/history",handleHistory);
+  hal.http->on("/calibrate",handleCalibrationPage);
+  hal.http->on("/api/calibrate",HttpMethod::Post,handleCalibrate);
+  hal.http->on("/api/calibration",handleApiCalibration);
+  hal.http->on("/debugmac", handleDebugMac); // Add the new debug endpoint
+  hal.http->on("/style.css",handleStyle);
+  hal.http->on("/app.js",handleScript);
+  hal.http->on("/api/status",handleApiStatus);
+  hal.http->on("/api/macs",handleApiMacs);
+  hal.http->on("/api/espnow",handleApiEspNow);
+  hal.http->on("/api/tasks",handleApiTasks);
+  hal.http->on("/perf",handlePerf);
+  hal.http->on("/api/stalls",handleApiStalls);
+  hal.http->on("/api/heap",handleApiHeap);
+  hal.http->on("/logs",handleLogs);
+  hal.http->begin();
   Serial.println("Web server started");
   
   // Initialize ESP-NOW
@@ -1096,46 +2647,55 @@ void setup() {
   }
   
   // Initialize sensor readings
-  currentDistance = measureDistanceCM();
-  currentWaterLevel = calculateWaterLevel(currentDistance, config.barrelHeightCm);
-  lastSensorRead = millis();
-  Serial.printf("Initial sensor reading - Distance: %.1f cm, Water Level: %.1f%%\n", 
-                currentDistance, currentWaterLevel);
+  currentDistance = measureDistanceCM(hal.clock->millis());
+  currentWaterLevel = calculateWaterLevel(currentDistance, channels[0]);
+  channels[0].level = currentWaterLevel;
+  updateChannelLevels();
+  currentVolume = currentDistance < 0 ? -1.0f : levelLiters(currentWaterLevel);
+  lastSensorRead = hal.clock->millis();
+  Serial.printf("Initial sensor reading - Distance: %.1f cm, Water Level: %.1f%%, Volume: %.1f L\n", 
+                currentDistance, currentWaterLevel, currentVolume);
   
   // Set initial LED state based on configuration
   if (!config.ledEnabled) {
-    digitalWrite(LED_PIN, HIGH); // Turn off LED (HIGH = off for built-in LED)
+    hal.gpio->write(LED_PIN, HIGH); // Turn off LED (HIGH = off for built-in LED)
     Serial.println("LED disabled in configuration");
   } else {
     Serial.println("LED enabled in configuration - will blink every 3 seconds");
   }
   
+  if (config.lowPower) {
+    Serial.printf("Battery mode: back to sleep in %u minutes\n", CONFIG_MODE_TIMEOUT_MS / 60000);
+  }
+  loadStallLog();
+  saveStallLog();
+  loopWatch.setThreshold(config.stallMs * 1000UL);
+  startTasks();
   Serial.println("Configuration mode started");
   Serial.println("Look for WiFi network with prefix: WATER_SENSOR_");
 }
 
 void loop() {
-  server.handleClient();
-  
-  // Update sensor readings based on refresh rate
-  updateSensorReadings();
-  
-  // Handle ESP-NOW retries for failed sends
-  if (espNowInitialized && !espNowSendSuccess && (millis() - lastEspNowRetry >= ESP_NOW_RETRY_MS)) {
-    Serial.println("=== ESP-NOW RETRY ATTEMPT ===");
-    Serial.printf("Retrying failed send to %s\n", macToString(config.parentMac.data()).c_str());
-    sendEspNowData();
-    lastEspNowRetry = millis();
+  PERF_SCOPE(perfLoop);
+  uint32_t startUs = hal.clock->micros();
+  loopWatch.beginIteration(startUs);
+  hal.http->handleClient();
+  
+  // Blame a slow iteration on its slowest part: the web request or a task
+  uint32_t httpUs = hal.clock->micros() - startUs;
+  if (httpUs >= loopWatch.thresholdUs()) {
+    strncpy(httpBlame, hal.http->uri().c_str(), STALL_NAME - 1);
+    loopWatch.blame(httpBlame, httpUs);
+  } else {
+    loopWatch.blame("http", httpUs);
   }
-  
-  // Blink LED to indicate device is working (only if enabled)
-  static uint32_t lastBlink = 0;
-  static bool ledState = false;
-  if(config.ledEnabled && millis() - lastBlink > 3000) { // Blink every 3 seconds
-    ledState = !ledState; // Toggle LED state
-    digitalWrite(LED_PIN, ledState ? LOW : HIGH); // LOW = on, HIGH = off
-    lastBlink = millis();
+  timers.run(hal.clock->millis(), *hal.clock);
+  if (timers.slowest()) loopWatch.blame(timers.slowest()->name(), timers.slowestUs());
+  heapWatch.tick(*hal.system);
+  
+  if (loopWatch.endIteration(hal.clock->micros(), hal.clock->millis(), stallState.log)) {
+    const StallRecord& r = stallState.log.newest(0);
+    LOG_WARN(LogMsg::LoopStall, r.loopUs / 1000, r.spanUs / 1000);
+    saveStallLog();
   }
-  
-  checkButton();
-}
\ No newline at end of file
+}
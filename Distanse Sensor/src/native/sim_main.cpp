@@ -0,0 +1,1461 @@
+/*
+   Host simulation entry point for [env:native].
+
+   Boots the firmware against the mock HAL, configures it through the web form
+   like a user would, then runs loop() for N simulated ticks while the tank
+   slowly fills and drains. Afterwards the hot paths are timed one by one on
+   the host CPU. With --sleep it runs battery mode instead: N wakes that each
+   end in deep sleep, optionally losing power (and with it the RTC memory)
+   before one of them. --sensor auto|request drives the sensor in a JSN-SR04M
+   serial mode instead of trigger/echo. Last, the serial frame parser is fed a
+   stream with line noise, distances are measured through /read at air
+   temperatures from -20 to 40 °C, blocking bursts are timed for echoes inside
+   and outside the range gate, readings are labelled and scored through /read
+   and ESP-NOW for pipe echoes, a drop, a stuck and a dead sensor, the level
+   tracker follows a draining tank, the reading interval adapts to a steady,
+   filling and again steady level, and the migration of the old EEPROM layout
+   is checked by cutting the power at every byte. --max-interval lets the main
+   run back off from the 5 s refresh rate while the level is steady, and
+   --deadband only reports readings that moved that far (the ESP-NOW report
+   policy is also checked over an hour of a steady, draining and again steady
+   tank with and without a deadband, including a low alarm crossing). The tank
+   geometry tables are compared with their analytic models, and a lying
+   cylinder is read through the firmware in liters. A distorted sensor is
+   calibrated through the calibration page. Three sensors over adjacent tanks
+   are pinged together (crosstalk) and then in turn by the firmware, which
+   sends all three in one frame. A reading is looked up in /logs and a log
+   record is timed against printf. /api/tasks shows the firmware's loop()
+   tasks, and the timer wheel is timed. /perf is read after the main run
+   (simulated time), and the profiler's probes then time loop() and the
+   handlers on the host clock. /api/stalls shows a slow request and a slow
+   task, still there after a reset and gone after a power loss. Finally a mix
+   of dashboard requests is replayed through loop() with the firmware's
+   allocations mirrored into a model of the 40 KB device heap
+   (--heap-requests, default ticks / 100; millions take a few minutes),
+   printing free heap, largest block and fragmentation as they develop.
+   Every check prints OK or FAILED; the program exits with 1 if any failed.
+   The libraries' own unit tests are in test/ (pio test -e native).
+
+     pio run -e native && .pio/build/native/program [ticks] [--batch N] [--verbose]
+         [--loss PERCENT] [--ack-loss PERCENT] [--outage SECONDS] [--drop-oldest] [--max-interval SECONDS]
+         [--deadband PERCENT] [--heap-requests N]
+         [--sleep WAKES [--power-loss WAKE]] [--sensor auto|request [--uart-noise PERCENT]]
+*/
+
+#include <Arduino.h>
+#include "HalNative.h"
+#include "SampleFilter.h"
+#include "EchoQuality.h"
+#include "WireProtocol.h"
+#include "Outbox.h"
+#include "ConfigStore.h"
+#include "SerialRanger.h"
+#include "SoundSpeed.h"
+#include "LevelTracker.h"
+#include "AdaptiveInterval.h"
+#include "ReportPolicy.h"
+#include "TankGeometry.h"
+#include "Calibration.h"
+#include "Log.h"
+#include "TimerWheel.h"
+#include "Perf.h"
+#include "LoopWatch.h"
+#include "HeapWatch.h"
+#include <chrono>
+#include <malloc.h>
+#include <memory>
+#include <math.h>
+#include <new>
+
+// Firmware entry points (src/main.cpp)
+void setup();
+void loop();
+void updateSensorReadings();
+void queueEspNowReading(float distance, float waterLevel, uint8_t quality);
+extern Outbox espNowOutbox;
+extern LevelTracker levelTracker;
+extern TimerWheel timers;
+extern LoopWatch loopWatch;
+extern HeapWatch heapWatch;
+void handleApiStatus();
+void handleHistory();
+
+// Live heap accounting, used to report the peak heap of web requests. While
+// sim.heap tracks, every allocation is also made in the model of the device heap;
+// a tag in front of the host allocation remembers where, for delete.
+size_t heapNow = 0;
+size_t heapPeak = 0;
+
+struct alignas(16) HeapTag {
+  int32_t block;          // in sim.heap, -1: not tracked
+  uint32_t generation;    // sim.heap's when it was made
+};
+
+void* operator new(size_t n) {
+  HeapTag* tag = (HeapTag*)malloc(sizeof(HeapTag) + n);
+  if (!tag) throw std::bad_alloc();
+  heapNow += malloc_usable_size(tag) - sizeof(HeapTag);
+  if (heapNow > heapPeak) heapPeak = heapNow;
+  tag->block = sim.heap.tracking() ? sim.heap.alloc(n) : -1;
+  tag->generation = sim.heap.generation();
+  return tag + 1;
+}
+void operator delete(void* p) noexcept {
+  if (!p) return;
+  HeapTag* tag = (HeapTag*)p - 1;
+  if (tag->block >= 0 && tag->generation == sim.heap.generation()) sim.heap.free(tag->block);
+  heapNow -= malloc_usable_size(tag) - sizeof(HeapTag);
+  free(tag);
+}
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+namespace {
+
+constexpr uint32_t TICK_US = 1000;        // simulated time per loop() pass
+constexpr uint32_t HTTP_EVERY_TICKS = 5000;
+
+using HostClock = std::chrono::steady_clock;
+
+// Every check reports through verdict(); the program exits with 1 if any failed
+uint32_t failedChecks = 0;
+
+const char* verdict(bool ok) {
+  if (!ok) ++failedChecks;
+  return ok ? "OK" : "FAILED";
+}
+
+// Exit status: 0 when every check passed
+int finish() {
+  if (failedChecks) printf("%u checks FAILED\n", failedChecks);
+  return failedChecks ? 1 : 0;
+}
+
+double nsSince(HostClock::time_point t0, uint64_t iterations) {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(HostClock::now() - t0).count();
+  return iterations ? (double)ns / iterations : 0.0;
+}
+
+template <typename Fn>
+void profile(const char* name, uint64_t iterations, Fn fn) {
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) fn();
+  printf("  %-24s %10.1f ns/call  (%llu calls)\n", name, nsSince(t0, iterations),
+         (unsigned long long)iterations);
+}
+
+// Cost of filling a SampleFilter with n pings and reducing it
+void profileFilter(uint8_t n, FilterMode mode, uint64_t iterations) {
+  static float noise[MAX_BURST_SAMPLES];
+  uint32_t rng = 1;
+  for (float& v : noise) {
+    rng = rng * 1103515245u + 12345u;
+    v = 40.0f + (float)((rng >> 16) % 1000) / 100.0f;
+  }
+
+  SampleFilter filter;
+  volatile float sink = 0;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    filter.reset();
+    for (uint8_t k = 0; k < n; ++k) filter.add(noise[(k + i) % MAX_BURST_SAMPLES]);
+    sink = sink + filter.reduce(mode);
+  }
+  printf("  N=%-2u %-13s %10.1f ns/burst\n", n, filterModeName(mode), nsSince(t0, iterations));
+}
+
+// Time one HTTP request and report its response size and peak heap
+void profileRequest(const char* name, uint64_t iterations, const char* path,
+                    const std::map<std::string, std::string>& headers = {}) {
+  size_t peak = 0;
+  size_t bytes = 0;
+  int code = 0;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    size_t base = heapNow;
+    heapPeak = heapNow;
+    const MockHttpServer::Response& r = sim.http.request(path, HttpMethod::Get, {}, headers);
+    if (heapPeak - base > peak) peak = heapPeak - base;
+    bytes = r.body.size();
+    code = r.code;
+  }
+  printf("  %-24s %10.1f ns/req  %d, %5zu B body, peak heap %5zu B\n", name, nsSince(t0, iterations),
+         code, bytes, peak);
+}
+
+// Parent device: decodes every delivered ESP-NOW frame and drops retransmissions
+struct Receiver {
+  uint64_t frames = 0;
+  uint64_t readings = 0;
+  uint64_t errors = 0;
+  uint64_t duplicates = 0;
+  uint64_t seqGaps = 0;     // unexplained: not after a boot or a coalesced frame
+  uint64_t otherIds = 0;    // frames whose sensor id differs from the one before
+  uint16_t lastSeq = 0;
+  WireHeader last;
+
+  void onFrame(const uint8_t* data, size_t len) {
+    WireFrame frame;
+    WireResult result = decodeFrame(data, len, frame);
+    if (result != WireResult::Ok) {
+      ++errors;
+      return;
+    }
+    const WireHeader& h = frame.header;
+    if (frames && h.seq == lastSeq) {
+      ++duplicates;
+      return;
+    }
+    if (frames && h.sensorId != last.sensorId) ++otherIds;
+    if (frames && !(h.flags & (WIRE_FLAG_BOOT | WIRE_FLAG_COALESCED)) && h.seq != (uint16_t)(lastSeq + 1)) ++seqGaps;
+    lastSeq = h.seq;
+    last = h;
+    ++frames;
+    readings += h.count;
+  }
+
+  // Every frame carried the sender's id, the last byte of its station MAC
+  bool sensorIdOk() const { return frames && !otherIds && last.sensorId == sim.wifi.staMac[5]; }
+};
+
+void profileWire(uint64_t iterations) {
+  FrameBatch batch;
+  for (uint8_t i = 0; i < WIRE_MAX_SAMPLES; ++i) batch.add(i, 40.0f + i, 50.0f, 100);
+  WireHeader header;
+  header.uptimeSec = WIRE_MAX_SAMPLES;
+  uint8_t buf[WIRE_MAX_FRAME];
+  size_t len = 0;
+
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    header.seq = (uint16_t)i;
+    len = batch.encode(header, buf, sizeof(buf));
+  }
+  double encodeNs = nsSince(t0, iterations);
+
+  WireFrame frame;
+  volatile uint32_t sink = 0;
+  t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    buf[4] = (uint8_t)i;
+    decodeFrame(buf, len, frame);
+    sink = sink + frame.header.seq;
+  }
+  double decodeNs = nsSince(t0, iterations);
+
+  printf("  encode %u readings         %10.1f ns/frame  (%zu B, %.0f MB/s)\n", WIRE_MAX_SAMPLES, encodeNs, len,
+         len * 1e3 / encodeNs);
+  printf("  decode %u readings         %10.1f ns/frame  (%.0f MB/s)\n", WIRE_MAX_SAMPLES, decodeNs,
+         len * 1e3 / decodeNs);
+}
+
+void boot() {
+  sim.system.restartRequested = false;
+  setup();
+}
+
+/* ---------- speed of sound ------------------------------------------------ */
+// The table is tested in test/test_sound_speed; here the firmware measures
+// through the DS18B20 at several air temperatures
+void checkSoundSpeed(uint64_t iterations) {
+  // Through the firmware: DS18B20 enabled, air (and echo timing) at each temperature
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}, {"probe", "on"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  sim.probe.present = true;
+  for (double tempC : {-20.0, 0.0, 20.0, 40.0}) {
+    sim.probe.airTempC = [tempC](uint64_t) { return (float)tempC; };
+    sim.sensor.soundSpeedMs = [tempC](uint64_t) { return soundSpeedMs(tempC); };
+    boot();
+    for (int t = 0; t < 1000; ++t) {   // first conversion: 750 ms
+      loop();
+      sim.clock.advanceUs(TICK_US);
+    }
+    std::string body = sim.http.request("/read").body;
+    const char* d = strstr(body.c_str(), "\"distance\":");
+    double measured = d ? atof(d + 11) : -1;
+    double truth = sim.sensor.distanceCm(sim.clock.nowUs());
+    double fixed = truth * 340.0 / soundSpeedMs(tempC);   // what duration * 0.034 / 2 gave
+    bool probe = strstr(body.c_str(), "\"tempSource\":\"probe\"") != nullptr;
+    printf("  %5.1f C: /read %6.1f cm, true %6.2f cm (fixed 340 m/s: %6.2f cm, %+.1f %%), %s: %s\n", tempC,
+           measured, truth, fixed, (fixed / truth - 1) * 100, probe ? "probe" : "NO PROBE",
+           verdict(probe && fabs(measured - truth) < 0.2));
+  }
+  sim.probe.present = false;
+  sim.sensor.soundSpeedMs = [](uint64_t) { return 343.2; };
+
+  SoundSpeed s;
+  auto t0 = HostClock::now();
+  volatile float sink = 0;
+  for (uint64_t i = 0; i < iterations; ++i) sink = sink + s.distanceCm(2000 + (uint32_t)(i & 1023));
+  printf("  distanceCm()              %10.1f ns/call\n", nsSince(t0, iterations));
+}
+
+/* ---------- range gate ---------------------------------------------------- */
+double jsonNumber(const std::string& body, const char* key) {
+  const char* p = strstr(body.c_str(), key);
+  return p ? atof(p + strlen(key)) : -1;
+}
+
+// /read blocks for one burst: time it for targets inside and outside the gate
+void checkRangeGate() {
+  for (const char* burst : {"5", "32"}) {
+    std::map<std::string, std::string> form = {
+        {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+        {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}, {"burst", burst}};
+    sim.http.request("/save", HttpMethod::Post, form);
+    boot();
+    std::string status = sim.http.request("/api/status").body;
+    if (strcmp(burst, "5") == 0) {
+      const char* g = strstr(status.c_str(), "\"gate\"");
+      printf("  50 cm barrel: %.*s\n", g ? (int)(strchr(g, '}') - g + 1) : 0, g);
+    }
+    int pings = atoi(burst);
+    for (float cm : {45.0f, 0.0f, 150.0f, 5.0f}) {
+      sim.sensor.distanceCm = [cm](uint64_t) { return cm; };
+      sim.clock.advanceUs(100000);   // previous echo long gone
+      uint64_t t0 = sim.clock.nowUs();
+      uint64_t ignored = sim.sensor.ignoredTriggers;
+      double d = jsonNumber(sim.http.request("/read").body, "\"distance\":");
+      double ms = (sim.clock.nowUs() - t0) / 1e3;
+      // Before: a fixed 60 ms between pings, each listening for up to 30 ms
+      double pingMs = cm > 0 ? 0.45 + cm * 2 / 34.32 / 1e3 * 1e3 : 30;
+      double fixedMs = (pings - 1) * 60.0 + (pingMs < 30 ? pingMs : 30);
+      status = sim.http.request("/api/status").body;
+      printf("  %5.0f cm, burst %2d: /read %6.1f ms, %5.1f pings/s, distance %6.1f, %llu ignored triggers "
+             "(60 ms spacing: %6.1f ms)\n", cm, pings, ms, jsonNumber(status, "\"pingRate\":"), d,
+             (unsigned long long)(sim.sensor.ignoredTriggers - ignored), fixedMs);
+    }
+  }
+  const char* g = nullptr;
+  std::string status = sim.http.request("/api/status").body;
+  g = strstr(status.c_str(), "\"gate\"");
+  g = g ? strstr(g, "\"valid\"") : nullptr;
+  printf("  ping outcomes: %.*s\n", g ? (int)(strchr(g, '}') - g) : 0, g);
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+}
+
+/* ---------- echo quality ------------------------------------------------ */
+// /read in the firmware; the confidence and label of the reading, and that of its ESP-NOW sample
+struct EchoRead {
+  double distance, confidence, sent;
+  std::string label;
+  bool noLevel;   // waterLevel and volume null, not an empty tank
+};
+
+EchoRead readEcho() {
+  int sent = -1;
+  sim.radio.onFrame = [&sent](const uint8_t* data, size_t len) {
+    WireFrame frame;
+    if (decodeFrame(data, len, frame) == WireResult::Ok && frame.header.count) {
+      sent = frame.samples[frame.header.count - 1].quality;
+    }
+  };
+  std::string body = sim.http.request("/read").body;
+  sim.radio.onFrame = nullptr;
+  const char* l = strstr(body.c_str(), "\"label\":\"");
+  return {jsonNumber(body, "\"distance\":"), jsonNumber(body, "\"echo\":{\"confidence\":"), (double)sent,
+          l ? std::string(l + 9, strchr(l + 9, '"')) : "",
+          body.find("\"waterLevel\":null,\"volume\":null") != std::string::npos};
+}
+
+// The labels and scores are tested in test/test_echo_quality; here a ping and
+// a burst are timed and the firmware reads through pipe echoes, a drop, a stuck
+// and a dead sensor
+void checkEchoQuality(uint64_t iterations) {
+  EchoQuality q;
+  EchoExpect e;
+  e.nearCm = 10;
+  e.farCm = 80;
+  e.heightCm = 30;
+  e.toleranceCm = 5;
+
+  // Cost: a mixed stream of pings, and a 5-ping burst end to end
+  e.tracked = true;
+  volatile uint32_t sink = 0;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    uint32_t raw = 2000 + (uint32_t)(i * 7 % 600);
+    sink = sink + (uint32_t)q.classify(e, i % 13 == 0 ? 0 : raw, i % 13 == 0 ? -1.0f : raw / 58.3f, 70 - raw / 58.3f);
+  }
+  double classifyNs = nsSince(t0, iterations);
+  t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations / 5; ++i) {
+    q.beginBurst();
+    for (uint32_t k = 0; k < 5; ++k) q.classify(e, 2330 + k, 40 + k * 0.02f, 30 - k * 0.02f);
+    sink = sink + q.endBurst(0.1f);
+  }
+  printf("  classify() %.1f ns/ping, labelled and scored 5-ping burst %.1f ns\n", classifyNs, nsSince(t0, iterations / 5));
+
+  // Through the firmware: 50 cm barrel, sensor 20 cm above the full level (gate 10-80 cm)
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}, {"burst", "5"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  sim.sensor.jitterCm = 0.1f;
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+  levelTracker.reset();   // the track the earlier checks left behind is somewhere else
+  for (int i = 0; i < 12; ++i) readEcho();   // a confident track at the new level
+  EchoRead steady = readEcho();
+
+  // Every third ping off a pipe 25 cm up: left out, the reading holds
+  static uint32_t ping;
+  sim.sensor.distanceCm = [](uint64_t) { return ++ping % 3 == 0 ? 20.0f : 45.0f; };
+  EchoRead pipe = readEcho();
+
+  // The level really dropped: every ping "jumps", and the reading follows
+  sim.sensor.distanceCm = [](uint64_t) { return 60.0f; };
+  EchoRead drop = readEcho();
+
+  // Water on the transducer: the same echo time every ping
+  sim.sensor.jitterCm = 0;
+  EchoRead stuck = readEcho();
+  stuck = readEcho();
+  stuck = readEcho();
+  stuck = readEcho();
+
+  // Ringing: an echo closer than the full level, and a dead sensor
+  sim.sensor.jitterCm = 0.1f;
+  sim.sensor.distanceCm = [](uint64_t) { return 5.0f; };
+  sim.clock.advanceUs(100000);
+  EchoRead ringing = readEcho();
+  sim.sensor.distanceCm = [](uint64_t) { return 0.0f; };
+  sim.clock.advanceUs(100000);
+  EchoRead dead = readEcho();
+  sim.sensor.jitterCm = 0;
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+  sim.clock.advanceUs(100000);
+
+  const EchoRead* all[] = {&steady, &pipe, &drop, &stuck, &ringing, &dead};
+  const char* names[] = {"steady", "pipe echo", "level drop", "stuck", "ringing", "dead"};
+  bool fw = fabs(steady.distance - 45) < 0.2 && steady.confidence == 100 && steady.label == "valid" &&
+            fabs(pipe.distance - 45) < 0.2 && pipe.confidence <= 80 && pipe.label == "jump" &&
+            fabs(drop.distance - 60) < 0.2 && drop.confidence == 0 && drop.label == "jump" &&
+            stuck.confidence == 0 && stuck.label == "stuck" && ringing.distance < 0 && ringing.label == "under-range" &&
+            dead.distance < 0 && dead.confidence == 0 && dead.label == "timeout" && dead.noLevel && !steady.noLevel;
+  for (const EchoRead* r : all) fw = fw && r->sent == r->confidence;
+  printf("  firmware /read (distance, confidence, label; ESP-NOW sample):\n");
+  for (size_t i = 0; i < 6; ++i) {
+    printf("    %-11s %6.1f cm %3.0f %% %-12s sent %3.0f %%\n", names[i], all[i]->distance, all[i]->confidence,
+           all[i]->label.c_str(), all[i]->sent);
+  }
+  printf("  firmware: %s\n", verdict(fw));
+}
+
+/* ---------- level tracker ------------------------------------------------- */
+struct Gauss {
+  uint32_t rng;
+  double uniform() {
+    rng = rng * 1103515245u + 12345u;
+    return ((rng >> 8) + 0.5) / 16777216.0;
+  }
+  double next() { return sqrt(-2 * log(uniform())) * cos(2 * M_PI * uniform()); }
+};
+
+// The gains and synthetic curves are tested in test/test_level_tracker; here
+// the firmware tracks a draining tank through /read and ESP-NOW
+void checkLevelTracker(uint64_t iterations) {
+  // Through the firmware: draining 3 cm/min, read every 5 s
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  Receiver receiver;
+  sim.radio.onFrame = [&receiver](const uint8_t* data, size_t len) { receiver.onFrame(data, len); };
+  uint64_t t0 = sim.clock.nowUs();
+  sim.sensor.distanceCm = [t0](uint64_t nowUs) { return (float)(25 + 3 * (nowUs - t0) / 6e7); };
+  for (int t = 0; t < 600000; ++t) {
+    loop();
+    sim.clock.advanceUs(TICK_US);
+  }
+  std::string body = sim.http.request("/read").body;
+  double truth = 100 - (sim.sensor.distanceCm(sim.clock.nowUs()) - 20) * 2;
+  double rate = jsonNumber(body, "\"levelRate\":");
+  printf("  firmware, draining 3 cm/min: /read %.1f%% (true %.1f%%), %+.2f cm/min, confidence %.0f%%; "
+         "ESP-NOW %+.2f cm/min, confidence %u%%: %s\n", jsonNumber(body, "\"trackedLevel\":"), truth, rate,
+         jsonNumber(body, "\"confidence\":"), wireRateCmPerMin(receiver.last.levelRate), receiver.last.confidence,
+         verdict(fabs(rate + 3) < 0.3));
+  sim.radio.onFrame = nullptr;
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+
+  LevelTracker tracker;
+  Gauss g = {3};
+  static float z[1024];
+  for (float& v : z) v = (float)(30 + TRACK_MEAS_NOISE_CM * g.next());
+  auto h0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) tracker.update((uint32_t)(i * 5000), z[i & 1023]);
+  printf("  update()                  %10.1f ns/call\n", nsSince(h0, iterations));
+}
+
+/* ---------- adaptive reading interval ------------------------------------ */
+// Run the firmware until untilUs; returns the readings taken (5 pings each)
+uint64_t runUntil(uint64_t untilUs) {
+  uint64_t pings = sim.sensor.pings;
+  while (sim.clock.nowUs() < untilUs) {
+    loop();
+    sim.clock.advanceUs(TICK_US);
+  }
+  return (sim.sensor.pings - pings) / 5;
+}
+
+void checkAdaptiveInterval() {
+  // The policy on its own: a steady level backs off 5 s → 10 → 20 → ... → 300 s
+  AdaptiveInterval ai;
+  ai.setLimits(5000, 300000);
+  uint32_t steps = 0;
+  while (ai.update(100, 0.0f, 0.3f)) ++steps;
+  bool backoff = steps == 6 && ai.intervalMs() == 300000 && ai.reason() == IntervalReason::Steady;
+  ai.update(100, 4.0f, 0.3f);    // 2 cm per 30 s
+  bool moving = ai.intervalMs() == 30000 && ai.reason() == IntervalReason::Moving;
+  ai.update(100, 0.0f, 3.0f);
+  bool scattered = ai.intervalMs() == 5000 && ai.reason() == IntervalReason::Scattered;
+  ai.setLimits(5000, 5000);
+  bool fixed = !ai.update(100, 0.0f, 0.3f) && ai.intervalMs() == 5000 && ai.reason() == IntervalReason::Fixed;
+  printf("  steady backs off in %u doublings, moving 4 cm/min → %u s, scattered → floor, fixed: %s\n", steps,
+         30000 / 1000, verdict(backoff && moving && scattered && fixed));
+
+  // Through the firmware: every 5 s to 5 min. Level steady for 30 min (0.3 cm
+  // reading noise), then filling at 4 cm/min for 5 min, then steady again.
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"maxMinutes", "5"}, {"maxSeconds", "0"},
+      {"barrel", "50"}, {"burst", "5"}, {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  uint64_t t0 = sim.clock.nowUs();
+  uint64_t fillUs = t0 + 1800000000ULL, stopUs = fillUs + 300000000ULL, endUs = stopUs + 1800000000ULL;
+  sim.sensor.distanceCm = [fillUs, stopUs](uint64_t nowUs) {
+    uint32_t h = (uint32_t)(nowUs / 1000) * 2654435761u;
+    float noise = (float)((h >> 8) % 1000) / 1000.0f * 0.6f - 0.3f;
+    uint64_t t = nowUs < fillUs ? 0 : (nowUs < stopUs ? nowUs : stopUs) - fillUs;
+    return 45.0f - 4.0f * (float)(t / 6e7) + noise;
+  };
+
+  uint64_t steady = runUntil(fillUs);
+  std::string status = sim.http.request("/api/status").body;
+  double before = jsonNumber(status, "\"interval\":{\"ms\":");
+
+  // Filling: time until the interval is back near the floor
+  uint64_t reactUs = 0, pings = sim.sensor.pings;
+  while (sim.clock.nowUs() < stopUs) {
+    runUntil(sim.clock.nowUs() + 1000000);
+    if (!reactUs && jsonNumber(sim.http.request("/api/status").body, "\"interval\":{\"ms\":") <= 30000) {
+      reactUs = sim.clock.nowUs() - fillUs;
+    }
+  }
+  uint64_t filling = (sim.sensor.pings - pings) / 5;
+  std::string during = sim.http.request("/api/status").body;
+  uint64_t after = runUntil(endUs);
+  status = sim.http.request("/api/status").body;
+  const char* iv = strstr(status.c_str(), "\"interval\"");
+  bool ok = before == 300000 && reactUs && reactUs <= 310000000ULL && jsonNumber(status, "\"interval\":{\"ms\":") == 300000;
+  printf("  firmware, 5 s..5 min: steady 30 min: %llu readings (fixed 5 s: 360), interval %.0f s; filling: "
+         "%llu readings, below 30 s after %.0f s, at %.0f s; steady again: %llu readings\n",
+         (unsigned long long)steady, before / 1000, (unsigned long long)filling, reactUs / 1e6,
+         jsonNumber(during, "\"interval\":{\"ms\":") / 1000, (unsigned long long)after);
+  printf("  %.*s: %s\n", iv ? (int)(strstr(iv, "}}") - iv + 2) : 0, iv, verdict(ok));
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+}
+
+/* ---------- report policy ----------------------------------------------- */
+// One hour of a tank through the firmware with the given deadband: steady for
+// 30 min, draining 2 cm/min for 12 min (60 % to 12 %, across the 20 % low
+// alarm), steady again. Returns the ESP-NOW frames and bytes sent; alarmS is how long after
+// the true crossing the first frame with a reading at 20 % (± the noise) went out (negative: the
+// noise tipped the level across a little early).
+
+struct ReportRun {
+  uint64_t frames, bytes;
+  double alarmS;
+};
+
+ReportRun runReportPolicy(const char* deadband) {
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"maxMinutes", "0"}, {"maxSeconds", "5"},
+      {"barrel", "50"}, {"burst", "5"}, {"batch", "4"}, {"batchAge", "60"}, {"deadband", deadband},
+      {"heartbeat", "600"}, {"lowAlarm", "20"}, {"highAlarm", "100"},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  uint64_t t0 = sim.clock.nowUs();
+  uint64_t drainUs = t0 + 1800000000ULL, stopUs = drainUs + 720000000ULL, endUs = t0 + 3600000000ULL;
+  sim.sensor.distanceCm = [drainUs, stopUs](uint64_t nowUs) {
+    uint32_t h = (uint32_t)(nowUs / 1000) * 2654435761u;
+    float noise = (float)((h >> 8) % 1000) / 1000.0f * 0.6f - 0.3f;
+    uint64_t t = nowUs < drainUs ? 0 : (nowUs < stopUs ? nowUs : stopUs) - drainUs;
+    return 40.0f + 2.0f * (float)(t / 6e7) + noise;   // 20 cm mount + 50 cm barrel
+  };
+  // 20 % is 60 cm, 10 min into the drain
+  uint64_t crossUs = drainUs + 600000000ULL;
+  uint64_t alarmAt = 0;
+  sim.radio.onFrame = [&alarmAt, drainUs](const uint8_t* data, size_t len) {
+    WireFrame frame;
+    if (alarmAt || decodeFrame(data, len, frame) != WireResult::Ok) return;
+    for (uint8_t i = 0; i < frame.header.count; ++i) {
+      const WireSample& s = frame.samples[i];
+      bool draining = sim.clock.nowUs() >= drainUs + s.ageSec * 1000000ULL;   // not a reading from an earlier check
+      if (draining && s.distance != WIRE_NO_ECHO && s.level <= 2050) alarmAt = sim.clock.nowUs();
+    }
+  };
+  uint64_t frames = sim.radio.framesSent, bytes = sim.radio.bytesSent;
+  runUntil(endUs);
+  sim.radio.onFrame = nullptr;
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+  return {sim.radio.framesSent - frames, sim.radio.bytesSent - bytes, alarmAt ? ((double)alarmAt - (double)crossUs) / 1e6 : 1e9};
+}
+
+// The policy's rules are tested in test/test_report_policy
+void checkReportPolicy() {
+  // Through the firmware: every reading vs a 2 % deadband, both with batches of 4
+  ReportRun all = runReportPolicy("0");
+  ReportRun deadband = runReportPolicy("2");
+  std::string e = sim.http.request("/api/espnow").body;
+  const char* r = strstr(e.c_str(), "\"reported\"");
+  double saved = 100.0 * (1.0 - (double)deadband.bytes / (double)all.bytes);
+  bool ok = saved > 50 && fabs(deadband.alarmS) <= 15;
+  printf("  1 h, 30 min steady, 12 min draining, 18 min steady: every reading %llu frames %llu B, "
+         "2 %% deadband %llu frames %llu B (%.0f %% less airtime); low alarm sent %+.0f s from the crossing\n",
+         (unsigned long long)all.frames, (unsigned long long)all.bytes, (unsigned long long)deadband.frames,
+         (unsigned long long)deadband.bytes, saved, deadband.alarmS);
+  printf("  %.*s: %s\n", r ? (int)(strstr(r, "}") - r + 1) : 0, r, verdict(ok));
+}
+
+/* ---------- tank geometry ----------------------------------------------- */
+// Table lookup against the analytic model, every 0.1 mm: max error in % of the capacity
+double tableError(const TankDims& d, const TankGeometry& g) {
+  double worst = 0;
+  for (uint32_t mm10 = 0; mm10 <= (uint32_t)(d.heightCm * 100); ++mm10) {
+    double err = fabs(g.liters(mm10 / 100.0f) - tankModelLiters(d, mm10 / 100.0f));
+    if (err > worst) worst = err;
+  }
+  return 100.0 * worst / g.capacityLiters();
+}
+
+void checkTankGeometry(uint64_t iterations) {
+  struct Shape {
+    const char* name;
+    TankShape shape;
+    float height, width, length;
+    double liters;   // closed-form capacity
+  };
+  const Shape shapes[] = {
+      {"200 L drum, upright", TankShape::Upright, 85, 57, 0, M_PI * 28.5 * 28.5 * 85 / 1000},
+      {"lying cylinder 120x250", TankShape::Lying, 120, 0, 250, M_PI * 60 * 60 * 250 / 1000},
+      {"IBC tote 100x120x85", TankShape::Box, 85, 100, 120, 100.0 * 120 * 85 / 1000},
+      {"tapered cistern 150/200", TankShape::Tapered, 180, 150, 200, M_PI * 180 / 3 * (75 * 75 + 75 * 100 + 100 * 100) / 1000},
+  };
+  TankGeometry g;
+  for (const Shape& s : shapes) {
+    TankDims d;
+    d.shape = s.shape;
+    d.heightCm = s.height;
+    d.widthCm = s.width;
+    d.lengthCm = s.length;
+    bool compiled = g.compile(d);
+    double err = compiled ? tableError(d, g) : 100;
+    double capErr = fabs(g.capacityLiters() - s.liters);
+    bool good = compiled && err < 0.1 && capErr <= 0.1;
+    printf("  %-24s %7.1f L (closed form %7.1f), %u points, max error %.3f %% of capacity: %s\n", s.name,
+           g.capacityLiters(), s.liters, g.points(), err, verdict(good));
+  }
+
+  // A strapping table is used as given; bad ones are rejected
+  TankDims strap;
+  strap.shape = TankShape::Strapped;
+  bool parsed = parseStrapTable("0=0, 10=35.5\n20=80,40=190.2 60=300", strap) && strap.strapPoints == 5 && g.compile(strap);
+  bool exact = fabsf(g.liters(20) - 80) < 0.05f && fabsf(g.liters(15) - 57.75f) < 0.05f && g.liters(80) == 300 &&
+               fabsf(g.capacityLiters() - 300) < 0.05f;
+  TankDims bad;
+  bool rejects = !parseStrapTable("0=0,20=80,10=90", bad) && !parseStrapTable("0=10,10=5", bad) &&
+                 !parseStrapTable("0=0", bad) && !parseStrapTable("0=0,10=", bad) &&
+                 !parseStrapTable("0=0,1=1,2=2,3=3,4=4,5=5,6=6,7=7,8=8,9=9,10=10,11=11,12=12", bad);
+  printf("  strapping table: interpolated exactly, out-of-order / short / 13-point tables rejected: %s\n",
+         verdict(parsed && exact && rejects));
+
+  // Hot path: the table against evaluating the model
+  TankDims lying;
+  lying.shape = TankShape::Lying;
+  lying.heightCm = 120;
+  lying.lengthCm = 250;
+  g.compile(lying);
+  volatile float sink = 0;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) sink = sink + g.liters((float)(i % 1200) / 10.0f);
+  double tableNs = nsSince(t0, iterations);
+  t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) sink = sink + tankModelLiters(lying, (float)(i % 1200) / 10.0f);
+  printf("  lying cylinder: table lookup %.1f ns/call, model %.1f ns/call\n", tableNs, nsSince(t0, iterations));
+
+  // Through the firmware: a lying cylinder, half full (sensor 20 cm above the top)
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "120"},
+      {"shape", "1"}, {"tankWidth", "120"}, {"tankLength", "250"}, {"strap", ""},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  sim.sensor.distanceCm = [](uint64_t) { return 80.0f; };
+  std::string read = sim.http.request("/read").body;
+  std::string status = sim.http.request("/api/status").body;
+  double volume = jsonNumber(read, "\"volume\":"), capacity = jsonNumber(status, "\"capacity\":");
+  form["shape"] = "4";
+  form["strap"] = "0=0,20=80,10=90";
+  int rejected = sim.http.request("/save", HttpMethod::Post, form).code;
+  // A rejected form changes nothing, not even the fields before the bad one
+  std::string after = sim.http.request("/api/status").body;
+  bool unchanged = jsonNumber(after, "\"shape\":") == 1 && jsonNumber(after, "\"capacity\":") == capacity;
+  bool fw = fabs(volume - 1413.7) < 1.5 && fabs(capacity - 2827.4) < 0.2 && rejected == 400 && unchanged;
+  printf("  firmware, lying cylinder half full: /read %.1f L of %.1f L, bad strapping table: %d, config %s: %s\n",
+         volume, capacity, rejected, unchanged ? "unchanged" : "changed", verdict(fw));
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+}
+
+/* ---------- calibration ------------------------------------------------- */
+// A sensor that reads 1.5 % long, 3 cm off and slightly more at range, looking
+// down on a 200 cm tank from 20 cm above the full level
+// The fits are tested in test/test_calibration; here a reading is timed and the
+// firmware is calibrated through its page
+void checkCalibration(uint64_t iterations) {
+  Calibration cal;
+  cal.set({220, -1.02f, 0.0002f});
+  volatile int32_t sink = 0;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) sink = sink + cal.heightQ16((uint32_t)(i % 153600));
+  printf("  heightQ16()               %10.1f ns/call\n", nsSince(t0, iterations));
+
+  // Through the firmware: a 50 cm barrel read by a sensor 5 % long and 3 cm off,
+  // captured at five known heights on the calibration page
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+      {"shape", "0"}, {"tankWidth", "40"}, {"tankLength", "40"}, {"strap", ""},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  static float heightCm;
+  sim.sensor.distanceCm = [](uint64_t) { return 3 + 1.05f * (70 - heightCm); };
+  heightCm = 30;
+  double before = jsonNumber(sim.http.request("/read").body, "\"waterLevel\":");
+  int added = 0;
+  for (float h : {0.0f, 12.0f, 25.0f, 38.0f, 50.0f}) {
+    heightCm = h;
+    added += sim.http.request("/api/calibrate", HttpMethod::Post, {{"action", "add"}, {"level", std::to_string(h)}}).code == 200;
+  }
+  int fit = sim.http.request("/api/calibrate", HttpMethod::Post, {{"action", "fit"}}).code;
+  boot();   // the fit is saved
+  heightCm = 30;
+  double after = jsonNumber(sim.http.request("/read").body, "\"waterLevel\":");
+  std::string state = sim.http.request("/api/calibration").body;
+  bool saved = state.find("\"calibrated\":true") != std::string::npos && fabs(jsonNumber(state, "\"gain\":") + 1 / 1.05) < 0.002;
+  int reset = sim.http.request("/api/calibrate", HttpMethod::Post, {{"action", "reset"}}).code;
+  bool fw = added == 5 && fit == 200 && saved && fabs(after - 60) < 0.5 && reset == 200 &&
+            sim.http.request("/api/calibration").body.find("\"calibrated\":false") != std::string::npos;
+  printf("  firmware, 30 of 50 cm: %.1f %% before, %.1f %% after calibrating at 5 heights: %s\n", before, after,
+         verdict(fw));
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+}
+
+/* ---------- several sensors ----------------------------------------------- */
+// Three sensors over adjacent tanks, 45, 30 and 60 cm down, each hearing the
+// others' echoes for 1.5 ms after its own comes back. Trigger/echo mode; the
+// sensor mode of the main run is restored afterwards. The ping order itself is
+// tested in test/test_ping_scheduler.
+void checkMultiSensor(const char* sensorMode) {
+  MockUltrasonic* sensors[3] = {&sim.sensor, &sim.moreSensors[0], &sim.moreSensors[1]};
+  const uint8_t pins[3][2] = {{D5, D6}, {D1, D7}, {D8, RX}};
+  const float cm[3] = {45, 30, 60};
+  for (uint8_t i = 0; i < 3; ++i) {
+    float d = cm[i];
+    sensors[i]->attach(pins[i][0], pins[i][1]);
+    sensors[i]->distanceCm = [d](uint64_t) { return d; };
+    sensors[i]->crosstalkTailUs = 1500;
+  }
+
+  // Naive: all three triggered at once, each one listening while the others' echoes come back
+  uint64_t hits = 0;
+  for (MockUltrasonic* s : sensors) hits -= s->crosstalkHits;
+  sim.clock.advanceUs(100000);
+  for (uint8_t level : {HIGH, LOW}) {
+    for (uint8_t i = 0; i < 3; ++i) sim.gpio.write(pins[i][0], level);
+  }
+  sim.clock.advanceUs(100000);
+  for (MockUltrasonic* s : sensors) hits += s->crosstalkHits;
+  printf("  triggered together: %llu crosstalk hits (a ping cut short by a neighbour's echo)\n", (unsigned long long)hits);
+
+  // Through the firmware: one board, three barrels, and one frame carrying all of them
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+      {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}, {"batch", "1"}, {"sensor", "0"}, {"channels", "3"},
+      {"trig1", "5"}, {"echo1", "13"}, {"barrel1", "40"}, {"mount1", "20"},
+      {"trig2", "15"}, {"echo2", "3"}, {"barrel2", "60"}, {"mount2", "20"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  uint8_t frameChannels = 0;
+  sim.radio.onFrame = [&frameChannels](const uint8_t* data, size_t len) {
+    WireFrame frame;
+    if (decodeFrame(data, len, frame) != WireResult::Ok) return;
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < frame.header.count; ++i) mask |= 1 << frame.samples[i].channel;
+    if (mask == 0x7) ++frameChannels;
+  };
+  hits = 0;
+  for (MockUltrasonic* s : sensors) hits -= s->crosstalkHits;
+  sim.clock.advanceUs(100000);
+  sim.http.request("/read");
+  for (MockUltrasonic* s : sensors) hits += s->crosstalkHits;
+  sim.radio.onFrame = nullptr;
+  std::string status = sim.http.request("/api/status").body;
+  double level[3];
+  const char* c = strstr(status.c_str(), "\"channels\":[");
+  for (uint8_t i = 0; i < 3; ++i) {
+    c = c ? strstr(c + 1, "\"waterLevel\":") : nullptr;
+    level[i] = c ? atof(c + 13) : -1;
+  }
+  bool fw = hits == 0 && frameChannels == 1 && fabs(level[0] - 50) < 0.5 && fabs(level[1] - 75) < 0.5 &&
+            fabs(level[2] - 100.0 / 3) < 0.5;
+  printf("  firmware, 3 sensors: %.1f %% / %.1f %% / %.1f %% (true 50.0 / 75.0 / 33.3), %.0f pings/s, %llu crosstalk "
+         "hits, %u frame with all three: %s\n", level[0], level[1], level[2], jsonNumber(status, "\"pingRate\":"),
+         (unsigned long long)hits, frameChannels, verdict(fw));
+
+  // The second sensor calibrated on its own (two heights), kept over a reboot
+  int added = 0;
+  for (float h : {10.0f, 35.0f}) {
+    sim.moreSensors[0].distanceCm = [h](uint64_t) { return 60 - h; };
+    added += sim.http.request("/api/calibrate", HttpMethod::Post,
+                              {{"action", "add"}, {"channel", "1"}, {"level", std::to_string(h)}}).code == 200;
+  }
+  int fit = sim.http.request("/api/calibrate", HttpMethod::Post, {{"action", "fit"}, {"channel", "1"}}).code;
+  boot();
+  std::string second = sim.http.request("/api/calibration", HttpMethod::Get, {{"channel", "1"}}).body;
+  std::string first = sim.http.request("/api/calibration", HttpMethod::Get, {{"channel", "0"}}).body;
+  bool calibrated = added == 2 && fit == 200 && second.find("\"calibrated\":true") != std::string::npos &&
+                    fabs(jsonNumber(second, "\"offset\":") - 60) < 0.1 &&
+                    first.find("\"calibrated\":false") != std::string::npos;
+  printf("  second sensor calibrated alone, saved: %s\n", verdict(calibrated));
+
+  sim.http.request("/api/calibrate", HttpMethod::Post, {{"action", "reset"}, {"channel", "1"}});
+  form = {{"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"}, {"barrel", "50"},
+          {"ssid", "WATER_SENSOR_"}, {"password", "HardPassword1234"}, {"sensor", sensorMode}, {"channels", "1"}};
+  sim.http.request("/save", HttpMethod::Post, form);
+  boot();
+  for (MockUltrasonic* s : sensors) s->crosstalkTailUs = 0;
+  sim.sensor.distanceCm = [](uint64_t) { return 45.0f; };
+}
+
+/* ---------- binary log ---------------------------------------------------- */
+// The ring and the formatting are tested in test/test_log; here the firmware's
+// /logs and the cost of a record.
+void checkLog(uint64_t iterations) {
+  // A reading shows up in /logs
+  sim.http.request("/read");
+  std::string logs = sim.http.request("/logs").body;
+  bool served = logs.find("records logged") != std::string::npos && logs.find(" I Reading: distance ") != std::string::npos;
+  printf("  /logs: %zu bytes of text: %s\n", logs.size(), verdict(served));
+
+  // Cost in loop(): a record against formatting the same line, and sending it at 74880 baud
+  volatile float level = 45.0f;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) LOG_INFO(0, level, (uint32_t)i, 50.0f);
+  double logNs = nsSince(t0, iterations);
+  volatile int sink = 0;
+  char text[96];
+  t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    sink = sink + snprintf(text, sizeof(text), "Reading: distance %.1f cm, water level %.1f%%, volume %.1f L\n",
+                           (double)level, (double)i, 50.0);
+  }
+  double printfNs = nsSince(t0, iterations);
+  printf("  LOG_INFO %.1f ns/call, snprintf of the line %.1f ns (on the wire at 74880 baud: %.1f ms)\n", logNs,
+         printfNs, strlen(text) * 10 / 74.88);
+}
+
+/* ---------- timer wheel ---------------------------------------------------- */
+void benchTask() {}
+
+// The wheel itself is tested in test/test_timer_wheel; here the firmware's tasks
+// and the cost of the wheel.
+void checkTimerWheel(uint64_t iterations) {
+  // The firmware's tasks, after the main run
+  std::string body = sim.http.request("/api/tasks").body;
+  const char* sensor = strstr(body.c_str(), "\"name\":\"sensor\"");
+  bool firmwareOk = sensor && strstr(body.c_str(), "\"name\":\"log\"") && strstr(body.c_str(), "\"name\":\"button\"") &&
+                    jsonNumber(sensor, "\"runs\":") > 0;
+  printf("  /api/tasks: sensor task %.0f runs, %.0f late (max %.0f ms): %s\n", sensor ? jsonNumber(sensor, "\"runs\":") : -1,
+         sensor ? jsonNumber(sensor, "\"late\":") : -1, sensor ? jsonNumber(sensor, "\"maxLateMs\":") : -1,
+         verdict(firmwareOk));
+
+  // Cost: arming and cancelling a task, and run() on a tick with nothing due
+  TimerWheel wheel;
+  uint32_t now = 1000;
+  wheel.begin(now);
+  TimerTask bench("bench", benchTask);
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    wheel.schedule(bench, now + 1 + (uint32_t)(i % 1000));
+    wheel.cancel(bench);
+  }
+  double armNs = nsSince(t0, iterations);
+  wheel.schedule(bench, now + 0x40000000u);
+  t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) wheel.run(++now, sim.clock);
+  printf("  schedule + cancel %.1f ns, idle run() %.1f ns per tick\n", armNs, nsSince(t0, iterations));
+  wheel.cancel(bench);
+}
+
+/* ---------- profiler ------------------------------------------------------ */
+PerfSection perfCheck("sim");
+
+uint32_t hostNs() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(HostClock::now().time_since_epoch()).count();
+}
+
+// The histogram is tested in test/test_perf; here the firmware's sections and
+// what a probe costs.
+void checkPerf(uint64_t iterations) {
+  // The firmware's sections after the main run, in simulated time
+  std::string body = sim.http.request("/perf").body;
+  bool served = true;
+  for (const PerfSection* s = perfSections(); s; s = s->next()) {
+    uint32_t inBuckets = 0;
+    for (uint8_t i = 0; i < PERF_BUCKETS; ++i) inBuckets += s->bucket(i);
+    std::string key = std::string("\"name\":\"") + s->name() + "\"";
+    served = served && inBuckets == s->count() && body.find(key) != std::string::npos;
+  }
+#if PERF_PROBES
+  const char* measure = strstr(body.c_str(), "\"name\":\"measureDistanceCM\"");
+  served = served && measure && jsonNumber(body, "\"count\":") > 0 && jsonNumber(measure, "\"count\":") > 0;
+  printf("  /perf: %zu bytes, measureDistanceCM %.0f runs of %.0f..%.0f us (simulated): %s\n", body.size(),
+         measure ? jsonNumber(measure, "\"count\":") : -1, measure ? jsonNumber(measure, "\"minUs\":") : -1,
+         measure ? jsonNumber(measure, "\"maxUs\":") : -1, verdict(served));
+#else
+  served = served && body.find("\"probes\":false") != std::string::npos;
+  printf("  /perf: probes compiled out (PERF_PROBES=0): %s\n", verdict(served));
+#endif
+
+  // The same probes on the host clock (1 cycle = 1 ns)
+  perfUseCounter(hostNs, 1000);
+  perfResetAll();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    loop();
+    sim.clock.advanceUs(TICK_US);
+    if (i % 100 == 0) {
+      sim.http.request("/");
+      sim.http.request("/api/status");
+    }
+  }
+  for (const PerfSection* s = perfSections(); s; s = s->next()) {
+    if (!s->count()) continue;
+    printf("  host %-18s %8u runs  min %8.2f  p50 %8.2f  p99 %8.2f  max %8.2f us\n", s->name(), s->count(),
+           s->minCycles() / 1e3, s->percentile(0.5f) / 1e3, s->percentile(0.99f) / 1e3, s->maxCycles() / 1e3);
+  }
+
+  // What a probe adds
+  volatile uint32_t sink = 0;
+  auto t0 = HostClock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    PERF_SCOPE(perfCheck);
+    sink = sink + 1;
+  }
+  printf("  one probe (PERF_PROBES=%d) %.1f ns\n", PERF_PROBES, nsSince(t0, iterations));
+  perfUseCounter(nullptr, 0);
+  perfResetAll();
+}
+
+/* ---------- loop watchdog ------------------------------------------------- */
+void stallTask() {
+  sim.clock.advanceUs(250000);
+}
+
+// The watchdog itself is tested in test/test_loop_watch; here the firmware's
+// stalls and their StallLog in RTC memory.
+void checkLoopWatch() {
+  // A threshold of 10 ms (stallMs = 10): /read blocks for a burst, a task takes 250 ms
+  static TimerTask slow("simStall", stallTask);
+  loopWatch.setThreshold(10000);
+  sim.http.queue("/read");
+  loop();
+  sim.clock.advanceUs(TICK_US);
+  timers.schedule(slow, sim.clock.millis() + 1);
+  for (int i = 0; i < 3; ++i) {
+    loop();
+    sim.clock.advanceUs(TICK_US);
+  }
+  std::string body = sim.http.request("/api/stalls").body;
+  const char* task = strstr(body.c_str(), "\"name\":\"simStall\"");
+  const char* read = strstr(body.c_str(), "\"name\":\"/read\"");
+  double bootNo = jsonNumber(body, "\"boot\":");
+  bool firmwareOk = task && read && task < read && jsonNumber(body, "\"stalls\":") >= 2;
+  printf("  /api/stalls: %.0f stalls, newest %.0f us (\"simStall\"), then \"/read\": %s\n",
+         jsonNumber(body, "\"stalls\":"), jsonNumber(body, "\"loopUs\":"), verdict(firmwareOk));
+
+  // Kept in RTC memory across a reset, lost with the power
+  boot();
+  std::string afterReset = sim.http.request("/api/stalls").body;
+  bool kept = jsonNumber(afterReset, "\"boot\":") == bootNo + 1 && afterReset.find("\"simStall\"") != std::string::npos &&
+              afterReset.find("\"/read\"") != std::string::npos;
+  sim.rtc.powerLoss();
+  boot();
+  std::string afterPowerLoss = sim.http.request("/api/stalls").body;
+  bool lost = jsonNumber(afterPowerLoss, "\"boot\":") == 1 && afterPowerLoss.find("\"records\":[]") != std::string::npos;
+  printf("  after a reset boot %.0f still lists both, after a power loss boot %.0f lists none: %s\n",
+         jsonNumber(afterReset, "\"boot\":"), jsonNumber(afterPowerLoss, "\"boot\":"), verdict(kept && lost));
+}
+
+/* ---------- heap ----------------------------------------------------------- */
+// Dashboard traffic, weighted like a page that polls /api/status and now and then
+// loads the rest
+struct WeightedPath {
+  const char* path;
+  uint32_t weight;
+};
+const WeightedPath HEAP_MIX[] = {
+    {"/api/status", 40}, {"/", 6}, {"/style.css", 3}, {"/app.js", 3}, {"/sensor", 6}, {"/read", 2},
+    {"/history", 10}, {"/api/espnow", 5}, {"/api/tasks", 3}, {"/perf", 2}, {"/api/stalls", 2},
+    {"/logs", 3}, {"/api/heap", 3}, {"/api/calibration", 3}, {"/calibrate", 2}, {"/update", 2},
+    {"/api/macs", 2}, {"/debugmac", 1}, {"/nowhere", 2}};
+
+constexpr size_t HEAP_CONNECTIONS = 4;
+
+const char* pickPath(uint32_t& rng) {
+  uint32_t total = 0;
+  for (const WeightedPath& w : HEAP_MIX) total += w.weight;
+  rng = rng * 1103515245u + 12345u;
+  uint32_t x = (rng >> 8) % total;
+  for (const WeightedPath& w : HEAP_MIX) {
+    if (x < w.weight) return w.path;
+    x -= w.weight;
+  }
+  return HEAP_MIX[0].path;
+}
+
+// The requests are served from loop() like a client's, 1 to 16 ms apart, with the
+// firmware's allocations (and only those) made in a 40 KB model heap. The network
+// stack shares that heap: as a stand-in for lwIP's pcb and buffers and the server's
+// client, each connection holds 160 to 640 B from before its request until 50 ms
+// to 2 s after it (at most HEAP_CONNECTIONS open, a new one closes the oldest, like
+// lwIP reusing a pcb in TIME_WAIT), so what the firmware allocates lands between them.
+// The heap model and HeapWatch themselves are tested in test/test_heap_watch.
+void checkHeap(uint64_t requests) {
+  sim.heap.reset(40 * 1024);
+  std::multimap<uint64_t, std::unique_ptr<char[]>> connections;   // by closing time
+  uint32_t rng = 2024;
+  auto t0 = HostClock::now();
+  printf("  %10s %8s %6s %6s %8s %8s %5s %5s %5s %6s\n", "requests", "device s", "free", "min", "maxBlock",
+         "min", "frag%", "max", "runs", "failed");
+  for (uint64_t i = 1; i <= requests; ++i) {
+    rng = rng * 1103515245u + 12345u;
+    size_t connection = 160 + (rng >> 8) % 481;
+    uint64_t closeUs = sim.clock.nowUs() + 50000 + (rng >> 12) % 1950000;
+    if (connections.size() >= HEAP_CONNECTIONS) connections.erase(connections.begin());
+    sim.heap.setTracking(true);
+    std::unique_ptr<char[]> buffers(new char[connection]);
+    sim.heap.setTracking(false);
+    connections.emplace(closeUs, std::move(buffers));
+    sim.http.queue(pickPath(rng));
+
+    rng = rng * 1103515245u + 12345u;
+    for (uint32_t ms = 1 + (rng >> 16) % 16; ms; --ms) {
+      sim.heap.setTracking(true);
+      loop();
+      sim.heap.setTracking(false);
+      sim.clock.advanceUs(TICK_US);
+      while (!connections.empty() && connections.begin()->first <= sim.clock.nowUs()) {
+        connections.erase(connections.begin());
+      }
+    }
+    if (i % (requests / 10 + 1) == 0 || i == requests) {
+      uint32_t freeBytes, maxBlock;
+      uint8_t fragmentation;
+      sim.heap.stats(freeBytes, maxBlock, fragmentation);
+      const HeapMarks& m = heapWatch.marks();
+      printf("  %10llu %8.0f %6u %6u %8u %8u %5u %5u %5u %6llu\n", (unsigned long long)i, sim.clock.nowUs() / 1e6,
+             freeBytes, m.minFree, maxBlock, m.minMaxBlock, fragmentation, m.maxFragmentation, sim.heap.used,
+             (unsigned long long)sim.heap.failures);
+    }
+  }
+  double ns = nsSince(t0, requests);
+  // Once the connections are closed the firmware holds nothing of it
+  connections.clear();
+  uint32_t endFree = sim.heap.freeBytes();
+  uint32_t leftBytes = 40 * 1024 - endFree;
+  bool steady = sim.heap.failures == 0 && leftBytes <= 256;
+  printf("  %.1f us/request: %llu allocations, %llu failed, %u B left allocated at the end: %s\n", ns / 1000,
+         (unsigned long long)sim.heap.allocs, (unsigned long long)sim.heap.failures, leftBytes,
+         verdict(steady));
+
+  // The telemetry saw the same: every request, a peak for the ones that allocate
+  std::string body = sim.http.request("/api/heap").body;
+  const char* status = strstr(body.c_str(), "\"path\":\"/api/status\"");
+  const char* missing = strstr(body.c_str(), "\"path\":\"/nowhere\"");
+  bool telemetryOk = status && !missing && jsonNumber(status, "\"requests\":") > 0 &&
+                     jsonNumber(status, "\"peak\":") > 0 && jsonNumber(body, "\"minFree\":") <= endFree &&
+                     jsonNumber(body, "\"maxFragmentation\":") > 0;
+  printf("  /api/heap: min free %.0f B, min largest block %.0f B, max fragmentation %.0f%%, "
+         "/api/status peak %.0f B: %s\n",
+         jsonNumber(body, "\"minFree\":"), jsonNumber(body, "\"minMaxBlock\":"),
+         jsonNumber(body, "\"maxFragmentation\":"), status ? jsonNumber(status, "\"peak\":") : 0.0,
+         verdict(telemetryOk));
+}
+
+/* ---------- serial frame parser ----------------------------------------- */
+void appendFrame(std::vector<uint8_t>& s, uint16_t mm) {
+  uint8_t h = (uint8_t)(mm >> 8), l = (uint8_t)mm;
+  s.insert(s.end(), {0xFF, h, l, (uint8_t)(0xFF + h + l)});
+}
+
+std::vector<uint16_t> parseStream(RangerFrameParser& parser, const uint8_t* data, size_t len) {
+  std::vector<uint16_t> out;
+  uint16_t mm;
+  for (size_t i = 0; i < len; ++i) {
+    if (parser.feed(data[i], mm)) out.push_back(mm);
+  }
+  return out;
+}
+
+uint16_t randomMm(uint32_t& rng) {
+  rng = rng * 1103515245u + 12345u;
+  return (uint16_t)(200 + (rng >> 16) % 5801);   // sensor range 20..600 cm
+}
+
+// Clean, joined and corrupted streams are tested in test/test_serial_ranger;
+// this measures recovery from line noise and the parser's speed
+void checkFrameParser(uint64_t iterations) {
+  uint32_t rng = 7;
+
+  // Line noise on 5 % of the bytes: flipped bits, lost and extra bytes
+  std::vector<uint8_t> stream;
+  std::vector<uint16_t> sent;
+  std::vector<bool> intact;
+  for (int i = 0; i < 100000; ++i) {
+    sent.push_back(randomMm(rng));
+    std::vector<uint8_t> f;
+    appendFrame(f, sent.back());
+    bool ok = true;
+    for (uint8_t byte : f) {
+      rng = rng * 1103515245u + 12345u;
+      if ((rng >> 16) % 100 < 5) {
+        ok = false;
+        uint32_t kind = (rng >> 8) % 3;
+        if (kind == 0) byte ^= (uint8_t)(1 << ((rng >> 4) % 8));
+        else if (kind == 1) continue;
+        else stream.push_back((uint8_t)(rng >> 20));
+      }
+      stream.push_back(byte);
+    }
+    intact.push_back(ok);
+  }
+  RangerFrameParser noisy;
+  std::vector<uint16_t> got = parseStream(noisy, stream.data(), stream.size());
+  size_t matched = 0, k = 0;
+  uint32_t intactFrames = 0, intactMatched = 0;
+  for (size_t i = 0; i < sent.size(); ++i) {
+    if (intact[i]) ++intactFrames;
+    size_t j = k;
+    while (j < got.size() && j < k + 3 && got[j] != sent[i]) ++j;
+    if (j < got.size() && got[j] == sent[i]) {
+      ++matched;
+      if (intact[i]) ++intactMatched;
+      k = j + 1;
+    }
+  }
+  const RangerStats& st = noisy.stats();
+  printf("  5%% line noise: %u/%u intact frames recovered, %zu false frames (%u checksum errors)\n",
+         intactMatched, intactFrames, got.size() - matched, st.checksumErrors);
+
+  auto t0 = HostClock::now();
+  RangerFrameParser fast;
+  volatile uint32_t sink = 0;
+  uint16_t mm;
+  for (uint64_t i = 0; i < iterations; ++i) {
+    if (fast.feed(stream[i % stream.size()], mm)) sink = sink + mm;
+  }
+  printf("  feed()                    %10.1f ns/byte\n", nsSince(t0, iterations));
+}
+
+/* ---------- config store power-loss harness ------------------------------ */
+// The store itself is tested in test/test_config_store; this is the firmware's
+// migration of the old fixed-offset EEPROM layout into it
+void checkConfigStore() {
+  std::vector<uint8_t> saved = sim.flash.storage;
+
+  // Migration of the old fixed-offset layout by the firmware, with power loss at every byte
+  std::fill(sim.flash.storage.begin(), sim.flash.storage.end(), 0xFF);
+  const uint8_t legacyMac[6] = {0x24, 0x6F, 0x28, 0x01, 0x02, 0x03};
+  memcpy(&sim.flash.storage[0], legacyMac, 6);
+  uint32_t refresh = 7000;
+  memcpy(&sim.flash.storage[6], &refresh, 4);
+  float barrel = 80.0f;
+  memcpy(&sim.flash.storage[10], &barrel, 4);
+  sim.flash.storage[14] = 0x01;
+  memcpy(&sim.flash.storage[15], "TANK_", 6);
+  memcpy(&sim.flash.storage[31], "Secret12345", 12);
+  sim.flash.storage[63] = 0xAA;
+  std::vector<uint8_t> legacy = sim.flash.storage;
+
+  bool quiet = !Serial.enabled();
+  Serial.setEnabled(false);
+  uint32_t migrationCuts = 0, migrationFailures = 0;
+  for (int64_t cut = 0;; ++cut) {
+    sim.flash.storage = legacy;
+    sim.flash.powerLossAfter = cut;
+    boot();
+    bool completed = !sim.flash.powerLost;
+    sim.flash.powerLost = false;
+    sim.flash.powerLossAfter = -1;
+    boot();
+    std::string status = sim.http.request("/api/status").body;
+    bool ok = status.find("\"parentMac\":\"24:6F:28:01:02:03\"") != std::string::npos &&
+              status.find("\"refreshRateMs\":7000") != std::string::npos &&
+              status.find("\"ssidPrefix\":\"TANK_\"") != std::string::npos;
+    if (!ok) ++migrationFailures;
+    ++migrationCuts;
+    if (completed) break;
+  }
+  if (!quiet) Serial.setEnabled(true);
+  printf("  EEPROM layout migration, power loss at %u points: %s (%u failed)\n", migrationCuts,
+         verdict(migrationFailures == 0), migrationFailures);
+  sim.flash.storage = saved;
+}
+
+// Battery mode: every boot is one wake that must end in deep sleep
+void runBatteryMode(uint32_t wakes, uint32_t powerLossAt, Receiver& receiver) {
+  uint64_t awakeUs = 0, maxAwakeUs = 0, sleptUs = 0;
+  uint32_t radioWakes = 0;
+  for (uint32_t i = 0; i < wakes; ++i) {
+    if (i == powerLossAt) sim.rtc.powerLoss();
+    sim.clock.restartEpoch();
+    sim.radio.initialized = false;
+    sim.radio.rfEnabled = sim.system.radioOnWake;
+    if (sim.radio.rfEnabled) ++radioWakes;
+
+    uint64_t t0 = sim.clock.nowUs();
+    boot();
+    if (!sim.system.sleepRequested) {
+      printf("  wake %u did not end in deep sleep: %s\n", i, verdict(false));
+      return;
+    }
+    uint64_t us = sim.clock.nowUs() - t0;
+    awakeUs += us;
+    if (us > maxAwakeUs) maxAwakeUs = us;
+    if (i + 1 == wakes) break;   // the reset below ends the last sleep
+    sim.system.sleepRequested = false;
+    sleptUs += sim.system.sleepUs;
+    sim.clock.advanceUs(sim.system.sleepUs);
+  }
+
+  printf("Battery mode: %u wakes over %.1f s device time\n", wakes, sim.clock.nowUs() / 1e6);
+  printf("  time to sleep %.1f ms avg, %.1f ms max; awake %.2f %% of the time\n",
+         awakeUs / 1e3 / wakes, maxAwakeUs / 1e3, 100.0 * awakeUs / (awakeUs + sleptUs));
+  printf("  RF on in %u wakes, ESP-NOW frames %llu (%llu acked), RTC writes %llu, flash writes %llu B\n",
+         radioWakes, (unsigned long long)sim.radio.framesSent, (unsigned long long)sim.radio.framesAcked,
+         (unsigned long long)sim.rtc.writes, (unsigned long long)sim.flash.bytesWritten);
+  printf("  receiver: %llu frames, %llu readings, %llu decode errors, %llu duplicates dropped, %llu seq gaps\n",
+         (unsigned long long)receiver.frames, (unsigned long long)receiver.readings,
+         (unsigned long long)receiver.errors, (unsigned long long)receiver.duplicates,
+         (unsigned long long)receiver.seqGaps);
+  printf("  sensor id 0x%02X in every frame: %s\n", receiver.last.sensorId, verdict(receiver.sensorIdOk()));
+
+  // BOOT held right after pressing RST brings up the config AP with the wake statistics
+  // (via one more short sleep if the RF was off for that wake)
+  sim.system.sleepRequested = false;
+  sim.gpio.pressed[0] = true;
+  sim.clock.schedule(sim.clock.nowUs() + 1500000, [] {
+    sim.gpio.pressed[0] = false;
+    sim.gpio.setInput(0, HIGH);
+  });
+  for (int boots = 0; boots < 3; ++boots) {
+    sim.clock.restartEpoch();
+    sim.radio.rfEnabled = sim.system.radioOnWake;
+    boot();
+    if (!sim.system.sleepRequested) break;
+    sim.system.sleepRequested = false;
+    sim.clock.advanceUs(sim.system.sleepUs);
+  }
+  const MockHttpServer::Response& r = sim.http.request("/api/status");
+  const char* stats = strstr(r.body.c_str(), "\"sleep\"");
+  bool apUp = sim.wifi.apMode && !sim.system.sleepRequested;
+  printf("  BOOT held at reset: %s, %s: %s\n", apUp ? "config AP up" : "NO config AP",
+         stats ? stats : "no wake statistics", verdict(apUp && stats));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  uint64_t ticks = 1000000;
+  const char* batch = "1";
+  const char* outbox = "1";
+  uint32_t outageSec = 0;
+  uint32_t sleepWakes = 0;
+  uint32_t maxIntervalSec = 5;
+  const char* deadband = "0";
+  uint32_t powerLossAt = UINT32_MAX;
+  const char* sensorMode = "0";
+  uint64_t heapRequests = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--verbose") == 0) Serial.setEnabled(true);
+    else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) batch = argv[++i];
+    else if (strcmp(argv[i], "--loss") == 0 && i + 1 < argc) sim.radio.lossPercent = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--ack-loss") == 0 && i + 1 < argc) sim.radio.ackLossPercent = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--outage") == 0 && i + 1 < argc) outageSec = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--drop-oldest") == 0) outbox = "0";
+    else if (strcmp(argv[i], "--max-interval") == 0 && i + 1 < argc) maxIntervalSec = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--deadband") == 0 && i + 1 < argc) deadband = argv[++i];
+    else if (strcmp(argv[i], "--sleep") == 0 && i + 1 < argc) sleepWakes = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--power-loss") == 0 && i + 1 < argc) powerLossAt = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--sensor") == 0 && i + 1 < argc) {
+      ++i;
+      sensorMode = strcmp(argv[i], "auto") == 0 ? "1" : strcmp(argv[i], "request") == 0 ? "2" : "0";
+    }
+    else if (strcmp(argv[i], "--uart-noise") == 0 && i + 1 < argc) sim.sensor.noisePercent = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--heap-requests") == 0 && i + 1 < argc) heapRequests = strtoull(argv[++i], nullptr, 10);
+    else ticks = strtoull(argv[i], nullptr, 10);
+  }
+
+  // Water surface 30..70 cm below the sensor, one fill/drain cycle per simulated hour
+  sim.sensor.attach(D5, D6);
+  if (strcmp(sensorMode, "0") != 0) sim.sensor.attachSerial(strcmp(sensorMode, "1") == 0);
+  sim.sensor.distanceCm = [](uint64_t nowUs) {
+    return 50.0f + 20.0f * (float)sin(nowUs * 2.0 * M_PI / 3.6e9);
+  };
+
+  boot();
+
+  // Configure a parent MAC so ESP-NOW is active, then reboot like the device does
+  std::map<std::string, std::string> form = {
+      {"pmac", "24:6F:28:AA:BB:CC"}, {"minutes", "0"}, {"seconds", "5"},
+      {"barrel", "50"}, {"led", "on"}, {"ssid", "WATER_SENSOR_"},
+      {"password", "HardPassword1234"}, {"batch", batch}, {"batchAge", "60"},
+      {"outbox", outbox}, {"sensor", sensorMode},
+      {"maxMinutes", std::to_string(maxIntervalSec / 60)}, {"maxSeconds", std::to_string(maxIntervalSec % 60)},
+      {"deadband", deadband}};
+  if (sleepWakes) form["sleep"] = "on";
+  sim.http.request("/save", HttpMethod::Post, form);
+
+  Receiver receiver;
+  sim.radio.onFrame = [&receiver](const uint8_t* data, size_t len) { receiver.onFrame(data, len); };
+  if (sleepWakes) {
+    runBatteryMode(sleepWakes, powerLossAt, receiver);
+    return finish();
+  }
+  if (sim.system.restartRequested) boot();
+
+  // Parent unreachable for a while, starting one minute in
+  if (outageSec) {
+    uint64_t startUs = sim.clock.nowUs() + 60000000ULL;
+    sim.clock.schedule(startUs, [] { sim.radio.down = true; });
+    sim.clock.schedule(startUs + outageSec * 1000000ULL, [] { sim.radio.down = false; });
+  }
+
+  auto t0 = HostClock::now();
+  uint64_t httpRequests = 0;
+  for (uint64_t t = 0; t < ticks; ++t) {
+    loop();
+    if (t % HTTP_EVERY_TICKS == 0) {
+      sim.http.request("/");
+      sim.http.request("/api/status");
+      sim.http.request("/history");
+      httpRequests += 3;
+    }
+    sim.clock.advanceUs(TICK_US);
+  }
+  double loopNs = nsSince(t0, ticks);
+
+  printf("Simulated %llu ticks (%.1f s device time)\n", (unsigned long long)ticks,
+         sim.clock.nowUs() / 1e6);
+  printf("  loop() incl. mocks        %10.1f ns/tick\n", loopNs);
+  printf("  pings %llu, ESP-NOW frames %llu (%llu acked), HTTP requests %llu, flash writes %llu B\n",
+         (unsigned long long)sim.sensor.pings, (unsigned long long)sim.radio.framesSent,
+         (unsigned long long)sim.radio.framesAcked, (unsigned long long)httpRequests,
+         (unsigned long long)sim.flash.bytesWritten);
+  printf("  receiver: %llu frames, %llu readings (batch %s, %.1f B/reading on air), %llu decode errors, "
+         "%llu duplicates dropped, %llu seq gaps\n",
+         (unsigned long long)receiver.frames, (unsigned long long)receiver.readings, batch,
+         receiver.readings ? (double)sim.radio.bytesSent / receiver.readings : 0.0,
+         (unsigned long long)receiver.errors, (unsigned long long)receiver.duplicates,
+         (unsigned long long)receiver.seqGaps);
+  printf("  sensor id 0x%02X in every frame: %s\n", receiver.last.sensorId, verdict(receiver.sensorIdOk()));
+  if (strcmp(sensorMode, "0") != 0) {
+    const MockHttpServer::Response& r = sim.http.request("/api/status");
+    const char* serial = strstr(r.body.c_str(), "\"serial\"");
+    printf("  sensor %s, %llu bytes hit by noise: %.*s\n", strcmp(sensorMode, "1") == 0 ? "auto output" : "on request",
+           (unsigned long long)sim.sensor.noisyBytes, serial ? (int)(strchr(serial, '}') - serial + 1) : 0, serial);
+    printf("  UART on RX D6 (ECHO) and TX D5 (TRIG): %s\n", verdict(sim.uart.rxPin == D6 && sim.uart.txPin == D5));
+  }
+  const OutboxStats& st = espNowOutbox.stats();
+  printf("  outbox: %u queued, %u sent, %u acked, %u retried, %u dropped, %u coalesced, %u pending\n",
+         st.queued, st.sent, st.acked, st.retried, st.dropped, st.coalesced, espNowOutbox.size());
+  sim.radio.onFrame = nullptr;
+  // An unknown resolution is the raw view, under its own name, not the one asked for
+  std::string hist = sim.http.request("/history", HttpMethod::Get, {{"res", "hour\",\"x"}}).body;
+  printf("  /history with a bad res is the raw view: %s\n",
+         verdict(hist.find(",\"res\":\"raw\",\"fields\":[\"t\",\"distance\"") != std::string::npos &&
+                 hist.find("\"x") == std::string::npos));
+
+  printf("Hot paths:\n");
+  uint64_t n = ticks / 10 + 1;
+  profile("updateSensorReadings()", ticks, [] { updateSensorReadings(); sim.clock.advanceUs(TICK_US); });
+  profile("handleApiStatus()", n / 10 + 1, [] { handleApiStatus(); });
+  profile("queueEspNowReading()", n, [] { queueEspNowReading(45.0f, 50.0f, 100); });
+  profile("handleHistory()", n / 100 + 1, [] { handleHistory(); });
+
+  printf("Web UI (gzip'd assets, ETag revalidation, JSON API):\n");
+  uint64_t requests = n / 10 + 1;
+  std::string etag = MockHttpServer::responseHeader(sim.http.request("/"), "ETag");
+  profileRequest("GET /", requests, "/");
+  profileRequest("GET / If-None-Match", requests, "/", {{"If-None-Match", etag}});
+  profileRequest("GET /app.js", requests, "/app.js");
+  profileRequest("GET /api/status", requests, "/api/status");
+
+  printf("ESP-NOW wire format:\n");
+  profileWire(n);
+
+  printf("Burst filter:\n");
+  for (uint8_t burst : {1, 4, 8, 16, 32}) {
+    profileFilter(burst, FilterMode::Median, n);
+    profileFilter(burst, FilterMode::TrimmedMean, n);
+  }
+
+  printf("Speed of sound:\n");
+  checkSoundSpeed(n);
+
+  printf("Range gate:\n");
+  checkRangeGate();
+
+  printf("Echo quality:\n");
+  checkEchoQuality(n);
+
+  printf("Level tracker:\n");
+  checkLevelTracker(n);
+
+  printf("Adaptive reading interval:\n");
+  checkAdaptiveInterval();
+
+  printf("ESP-NOW report policy:\n");
+  checkReportPolicy();
+
+  printf("Tank geometry:\n");
+  checkTankGeometry(n);
+
+  printf("Calibration:\n");
+  checkCalibration(n);
+
+  printf("Several sensors:\n");
+  checkMultiSensor(sensorMode);
+
+  printf("Binary log:\n");
+  checkLog(n);
+  printf("Timer wheel:\n");
+  checkTimerWheel(n);
+  printf("Profiler:\n");
+  checkPerf(n);
+  printf("Loop watchdog:\n");
+  checkLoopWatch();
+  printf("Heap under dashboard traffic:\n");
+  checkHeap(heapRequests ? heapRequests : ticks / 100);
+
+  printf("Serial frame parser:\n");
+  checkFrameParser(n * 10);
+
+  printf("Config store:\n");
+  checkConfigStore();
+  return finish();
+}
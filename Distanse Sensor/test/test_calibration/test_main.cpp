@@ -0,0 +1,119 @@
+/*
+   Distance → height calibration (lib/Calibration): linear and quadratic
+   least-squares fits of a distorted sensor from noisy points, the fixed
+   point against the float polynomial, and point sets that determine
+   nothing.
+
+   Run with: pio test -e native -f test_calibration
+*/
+
+#include <unity.h>
+#include <math.h>
+#include "Calibration.h"
+
+namespace {
+
+CalPoint points[CAL_MAX_POINTS];
+
+// A sensor 220 cm above the bottom that reads 1.5 % long, 3 cm off and bends
+double distortedCm(double heightCm) {
+  double t = 220 - heightCm;
+  return 3 + 1.015 * t + 0.00015 * t * t;
+}
+
+// Worst error of the fit over the whole 2 m tank, cm
+double calibrationError(const CalCoeffs& c) {
+  Calibration cal;
+  cal.set(c);
+  double worst = 0;
+  for (int mm = 0; mm <= 2000; ++mm) worst = fmax(worst, fabs(cal.heightCm((float)distortedCm(mm / 10.0)) - mm / 10.0));
+  return worst;
+}
+
+}  // namespace
+
+// Eight points over the tank, 0.3 cm of reading noise
+void setUp() {
+  uint32_t rng = 11;
+  for (uint8_t i = 0; i < CAL_MAX_POINTS; ++i) {
+    double noise = -6;
+    for (int k = 0; k < 12; ++k) {
+      rng = rng * 1103515245u + 12345u;
+      noise += (double)(rng >> 16) / 65536.0;
+    }
+    double h = 200.0 * i / (CAL_MAX_POINTS - 1);
+    points[i] = {(float)(distortedCm(h) + 0.3 * noise), (float)h};
+  }
+}
+
+void tearDown() {}
+
+void test_mount_height_alone_is_off() {
+  TEST_ASSERT_GREATER_THAN(10, (int)calibrationError({220, -1, 0}));
+}
+
+void test_linear_fit() {
+  CalCoeffs c;
+  float rms = 0;
+  TEST_ASSERT_TRUE(fitCalibration(points, CAL_MAX_POINTS, false, c, rms));
+  TEST_ASSERT_DOUBLE_WITHIN(2.0, 0.0, calibrationError(c));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, -1 / 1.015f, c.gain);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, c.quad);
+}
+
+void test_quadratic_fit() {
+  CalCoeffs c;
+  float rms = 0;
+  TEST_ASSERT_TRUE(fitCalibration(points, CAL_MAX_POINTS, true, c, rms));
+  TEST_ASSERT_FLOAT_WITHIN(0.4f, 0.0f, rms);
+  TEST_ASSERT_DOUBLE_WITHIN(0.5, 0.0, calibrationError(c));
+}
+
+// Fixed point against the float polynomial, over the sensor's whole range
+void test_fixed_point_matches_float() {
+  CalCoeffs c;
+  float rms;
+  TEST_ASSERT_TRUE(fitCalibration(points, CAL_MAX_POINTS, true, c, rms));
+  Calibration cal;
+  cal.set(c);
+  for (int mm = 0; mm <= (int)(CAL_MAX_DISTANCE_CM * 10); ++mm) {
+    double d = mm / 10.0;
+    double exact = c.offset + d * (c.gain + d * c.quad);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, exact, cal.heightCm((float)d));
+  }
+}
+
+void test_distance_at_inverts_height() {
+  CalCoeffs c;
+  float rms;
+  TEST_ASSERT_TRUE(fitCalibration(points, CAL_MAX_POINTS, true, c, rms));
+  Calibration cal;
+  cal.set(c);
+  const float heights[] = {0.0f, 50.0f, 120.0f, 200.0f};
+  for (float h : heights) TEST_ASSERT_FLOAT_WITHIN(0.05f, h, cal.heightCm(cal.distanceAt(h)));
+}
+
+// Fits that determine nothing, or make the height rise with the distance
+void test_degenerate_fits_rejected() {
+  CalCoeffs c;
+  float rms;
+  CalPoint same[3] = {{50, 10}, {50.4f, 20}, {50.2f, 30}};
+  CalPoint rising[2] = {{30, 10}, {60, 40}};
+  CalPoint bent[3] = {{20, 100}, {60, 50}, {100, 49}};   // turns back up before 600 cm
+  TEST_ASSERT_FALSE(fitCalibration(points, 1, false, c, rms));
+  TEST_ASSERT_FALSE(fitCalibration(points, 2, true, c, rms));
+  TEST_ASSERT_FALSE(fitCalibration(same, 3, false, c, rms));
+  TEST_ASSERT_FALSE(fitCalibration(rising, 2, false, c, rms));
+  TEST_ASSERT_FALSE(fitCalibration(bent, 3, true, c, rms));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_mount_height_alone_is_off);
+  RUN_TEST(test_linear_fit);
+  RUN_TEST(test_quadratic_fit);
+  RUN_TEST(test_fixed_point_matches_float);
+  RUN_TEST(test_distance_at_inverts_height);
+  RUN_TEST(test_degenerate_fits_rejected);
+  return UNITY_END();
+}
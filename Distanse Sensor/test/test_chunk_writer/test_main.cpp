@@ -0,0 +1,99 @@
+/*
+   Chunked response writer (lib/Hal/ChunkWriter.h) on the mock web
+   server: small fragments in one chunk, printf output that crosses the
+   end of the buffer, and printf output longer than the whole buffer,
+   none of it cut short.
+
+   Run with: pio test -e native -f test_chunk_writer
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include "HalNative.h"
+#include "ChunkWriter.h"
+
+namespace {
+
+std::string expected;
+
+void smallFragments() {
+  ChunkWriter out(sim.http, 200, "application/json");
+  out.print("{\"a\":");
+  out.printf("%.1f,\"b\":%u", 45.25f, 7u);
+  out.print(String("}"));
+  expected = "{\"a\":45.2,\"b\":7}";
+}
+
+// 250 bytes written, then 20 formatted: flushed first, then formatted whole
+void acrossBufferEnd() {
+  ChunkWriter out(sim.http, 200, "text/plain");
+  std::string fill(250, 'x');
+  out.write(fill.data(), fill.size());
+  out.printf("|%08u|%8.3f|", 12345678u, 3.14159);
+  expected = fill + "|12345678|   3.142|";
+}
+
+// Longer than the whole buffer: one chunk of its own, from the heap
+void longerThanBuffer() {
+  std::string text(400, 'y');
+  ChunkWriter out(sim.http, 200, "text/plain");
+  out.print("<");
+  out.printf("%s=%d", text.c_str(), -5);
+  out.print(">");
+  expected = "<" + text + "=-5>";
+}
+
+void emptyFormat() {
+  ChunkWriter out(sim.http, 200, "text/plain");
+  out.printf("%s", "");
+  expected = "";
+}
+
+}  // namespace
+
+void setUp() {
+  expected.clear();
+}
+
+void tearDown() {}
+
+void test_small_fragments_in_one_chunk() {
+  sim.http.on("/small", smallFragments);
+  const MockHttpServer::Response& r = sim.http.request("/small");
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), r.body.c_str());
+  TEST_ASSERT_EQUAL_size_t(1, r.chunks);
+  TEST_ASSERT_EQUAL_STRING("application/json", r.contentType.c_str());
+}
+
+void test_printf_across_buffer_end() {
+  sim.http.on("/across", acrossBufferEnd);
+  const MockHttpServer::Response& r = sim.http.request("/across");
+  TEST_ASSERT_EQUAL_size_t(expected.size(), r.body.size());
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), r.body.c_str());
+  TEST_ASSERT_EQUAL_size_t(2, r.chunks);
+}
+
+void test_printf_longer_than_buffer() {
+  sim.http.on("/long", longerThanBuffer);
+  const MockHttpServer::Response& r = sim.http.request("/long");
+  TEST_ASSERT_EQUAL_size_t(expected.size(), r.body.size());
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), r.body.c_str());
+  TEST_ASSERT_EQUAL_size_t(3, r.chunks);
+}
+
+void test_empty_output_sends_nothing() {
+  sim.http.on("/empty", emptyFormat);
+  const MockHttpServer::Response& r = sim.http.request("/empty");
+  TEST_ASSERT_EQUAL_size_t(0, r.body.size());
+  TEST_ASSERT_EQUAL_size_t(0, r.chunks);
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_small_fragments_in_one_chunk);
+  RUN_TEST(test_printf_across_buffer_end);
+  RUN_TEST(test_printf_longer_than_buffer);
+  RUN_TEST(test_empty_output_sends_nothing);
+  return UNITY_END();
+}
@@ -0,0 +1,130 @@
+/*
+   Config store (lib/ConfigStore) on the mock flash: the power is cut at
+   every programmed byte and erase of a first save, an append and a
+   sector switch, and the store must come back with the old or the new
+   record. Then the wear of many changed saves, and an unchanged save.
+
+   Run with: pio test -e native -f test_config_store
+*/
+
+#include <unity.h>
+#include <vector>
+#include <algorithm>
+#include "HalNative.h"
+#include "ConfigStore.h"
+
+namespace {
+
+MockFlash flash;
+
+// Payload variant i, 60..90 bytes so records don't line up with the sector end
+std::vector<uint8_t> configPayload(uint32_t i) {
+  std::vector<uint8_t> p(60 + i % 31);
+  for (size_t k = 0; k < p.size(); ++k) p[k] = (uint8_t)(i * 31 + k * 7);
+  return p;
+}
+
+// After a reboot the store must hold exactly one of the given payloads (or nothing)
+bool loadsOneOf(const std::vector<uint8_t>* a, const std::vector<uint8_t>& b) {
+  ConfigStore store;
+  store.begin(flash);
+  uint8_t buf[CONFIG_MAX_PAYLOAD];
+  size_t len;
+  uint8_t schema;
+  if (!store.load(buf, len, schema)) return a == nullptr;
+  std::vector<uint8_t> got(buf, buf + len);
+  return got == b || (a && got == *a);
+}
+
+uint64_t erases() { return flash.erases[0] + flash.erases[1]; }
+
+// Cut the power at every byte (and erase) of saving `next` over the current flash
+// contents, whose newest record is `prev`. Returns the number of cut points.
+uint32_t powerLossAtEveryByte(const std::vector<uint8_t>* prev, const std::vector<uint8_t>& next) {
+  std::vector<uint8_t> snapshot = flash.storage;
+  uint64_t bytes0 = flash.bytesWritten, erases0 = erases();
+  ConfigStore store;
+  store.begin(flash);
+  store.save(next.data(), next.size(), 2);
+  uint32_t work = (uint32_t)(flash.bytesWritten - bytes0 + erases() - erases0);
+
+  for (uint32_t cut = 0; cut < work; ++cut) {
+    flash.storage = snapshot;
+    flash.powerLossAfter = cut;
+    store.begin(flash);
+    store.save(next.data(), next.size(), 2);
+    flash.powerLost = false;
+    flash.powerLossAfter = -1;
+
+    // Reboot: old or new record; then saving again must work
+    TEST_ASSERT_TRUE_MESSAGE(loadsOneOf(prev, next), "neither the old nor the new record after a power loss");
+    store.begin(flash);
+    TEST_ASSERT_TRUE(store.save(next.data(), next.size(), 2) != ConfigStore::SaveResult::Failed);
+    TEST_ASSERT_TRUE(loadsOneOf(nullptr, next));
+  }
+  flash.storage = snapshot;
+  return work;
+}
+
+}  // namespace
+
+void setUp() {
+  flash = MockFlash();
+}
+
+void tearDown() {}
+
+void test_power_loss_during_first_save() {
+  TEST_ASSERT_GREATER_THAN(0, powerLossAtEveryByte(nullptr, configPayload(0)));
+}
+
+void test_power_loss_during_append_and_sector_switch() {
+  std::vector<uint8_t> prev = configPayload(0);
+  ConfigStore store;
+  store.begin(flash);
+  store.save(prev.data(), prev.size(), 2);
+  uint32_t switches = 0;
+  for (uint32_t i = 1; i < 200; ++i) {
+    std::vector<uint8_t> next = configPayload(i);
+    bool switching = store.freeBytes() < 8 + next.size() + 3;
+    if (i == 1 || switching) powerLossAtEveryByte(&prev, next);
+    switches += switching;
+    store.begin(flash);
+    store.save(next.data(), next.size(), 2);
+    prev = next;
+  }
+  TEST_ASSERT_GREATER_THAN(1, switches);
+  TEST_ASSERT_EQUAL_UINT32(switches, store.generation() - 1);
+}
+
+void test_sector_erased_once_per_many_saves() {
+  ConfigStore store;
+  store.begin(flash);
+  uint64_t erases0 = erases();
+  for (uint32_t i = 0; i < 1000; ++i) {
+    std::vector<uint8_t> next = configPayload(i);
+    TEST_ASSERT_TRUE(store.save(next.data(), next.size(), 2) == ConfigStore::SaveResult::Written);
+  }
+  // The EEPROM library erased on every commit
+  TEST_ASSERT_LESS_THAN(1000 / 20, erases() - erases0);
+  TEST_ASSERT_TRUE(loadsOneOf(nullptr, configPayload(999)));
+}
+
+void test_unchanged_save_writes_nothing() {
+  ConfigStore store;
+  store.begin(flash);
+  std::vector<uint8_t> p = configPayload(7);
+  store.save(p.data(), p.size(), 2);
+  uint64_t bytes0 = flash.bytesWritten;
+  TEST_ASSERT_TRUE(store.save(p.data(), p.size(), 2) == ConfigStore::SaveResult::Unchanged);
+  TEST_ASSERT_EQUAL_UINT64(bytes0, flash.bytesWritten);
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_power_loss_during_first_save);
+  RUN_TEST(test_power_loss_during_append_and_sector_switch);
+  RUN_TEST(test_sector_erased_once_per_many_saves);
+  RUN_TEST(test_unchanged_save_writes_nothing);
+  return UNITY_END();
+}
@@ -0,0 +1,162 @@
+/*
+   Interrupt-driven echo capture (lib/EchoCapture), driven edge by edge
+   the way the ECHO pin interrupt and loop() do: a normal echo, the tail
+   of a pulse that rose before arm(), the cycle counter wrapping in the
+   middle of a pulse, a timeout against a late falling edge, and pulses
+   outside the range gate.
+
+   Run with: pio test -e native -f test_echo_capture
+*/
+
+#include <unity.h>
+#include "EchoCapture.h"
+
+namespace {
+
+constexpr uint32_t MHZ = 80;
+
+EchoCapture* capture = nullptr;
+RangeGate gate;
+
+uint32_t us(uint32_t n) {
+  return n * MHZ;
+}
+
+void assertStatus(EchoCapture::Status expected, EchoCapture::Status actual) {
+  TEST_ASSERT_EQUAL_INT((int)expected, (int)actual);
+}
+
+}  // namespace
+
+// Echoes of 100 µs to 25 ms, given up 30 ms after arm()
+void setUp() {
+  capture = new EchoCapture();
+  capture->begin(MHZ);
+  gate = RangeGate();
+  gate.nearUs = 100;
+  gate.farUs = 25000;
+  gate.timeoutUs = 30000;
+}
+
+void tearDown() {
+  delete capture;
+  capture = nullptr;
+}
+
+void test_rise_and_fall() {
+  EchoSample s;
+  assertStatus(EchoCapture::Status::Idle, capture->poll(0, s));
+  uint32_t t0 = 1000;
+  capture->arm(t0, gate);
+  TEST_ASSERT_TRUE(capture->busy());
+  assertStatus(EchoCapture::Status::Pending, capture->poll(t0 + us(100), s));
+  capture->onEdge(true, t0 + us(450));
+  assertStatus(EchoCapture::Status::Pending, capture->poll(t0 + us(1000), s));
+  capture->onEdge(false, t0 + us(450 + 2330));
+  assertStatus(EchoCapture::Status::Ready, capture->poll(t0 + us(3000), s));
+  TEST_ASSERT_EQUAL_UINT32(2330, s.durationUs);
+  TEST_ASSERT_EQUAL_UINT32(1, s.ticket);
+  TEST_ASSERT_FALSE(capture->busy());
+  assertStatus(EchoCapture::Status::Idle, capture->poll(t0 + us(3100), s));
+}
+
+// A pulse that rose before arm() ends after it: its falling edge is ignored,
+// and the ping's own echo after it is measured
+void test_stale_fall_ignored() {
+  EchoSample s;
+  capture->onEdge(true, us(100));
+  capture->arm(us(200), gate);
+  capture->onEdge(false, us(900));
+  assertStatus(EchoCapture::Status::Pending, capture->poll(us(1000), s));
+  capture->onEdge(true, us(1200));
+  capture->onEdge(false, us(1200 + 1500));
+  assertStatus(EchoCapture::Status::Ready, capture->poll(us(3000), s));
+  TEST_ASSERT_EQUAL_UINT32(1500, s.durationUs);
+}
+
+// Same when the pulse rose during the previous ping, which timed out meanwhile
+void test_rise_from_previous_ping_ignored() {
+  EchoSample s;
+  capture->arm(0, gate);
+  capture->onEdge(true, us(29000));
+  assertStatus(EchoCapture::Status::Timeout, capture->poll(us(30000), s));
+  capture->arm(us(30100), gate);
+  capture->onEdge(false, us(30500));
+  assertStatus(EchoCapture::Status::Pending, capture->poll(us(31000), s));
+  TEST_ASSERT_TRUE(capture->busy());
+}
+
+// The 32-bit cycle counter wraps every 53.7 s at 80 MHz, here mid-pulse
+void test_cycle_counter_wrap() {
+  EchoSample s;
+  uint32_t t0 = 0u - us(1000);
+  capture->arm(t0, gate);
+  capture->onEdge(true, t0 + us(500));
+  assertStatus(EchoCapture::Status::Pending, capture->poll(t0 + us(2000), s));
+  capture->onEdge(false, t0 + us(500 + 2330));
+  TEST_ASSERT_LESS_THAN_UINT32(t0, t0 + us(500 + 2330));
+  assertStatus(EchoCapture::Status::Ready, capture->poll(t0 + us(3000), s));
+  TEST_ASSERT_EQUAL_UINT32(2330, s.durationUs);
+
+  // The timeout counts across the wrap too
+  capture->arm(t0, gate);
+  assertStatus(EchoCapture::Status::Pending, capture->poll(t0 + us(29999), s));
+  assertStatus(EchoCapture::Status::Timeout, capture->poll(t0 + us(30000), s));
+}
+
+// An echo that completed before a poll that comes late wins over the timeout;
+// one whose fall comes after the timeout was reported is dropped and does not
+// reach the next ping
+void test_timeout_against_late_fall() {
+  EchoSample s;
+  capture->arm(0, gate);
+  capture->onEdge(true, us(5000));
+  capture->onEdge(false, us(5000 + 24000));
+  assertStatus(EchoCapture::Status::Ready, capture->poll(us(40000), s));
+  TEST_ASSERT_EQUAL_UINT32(24000, s.durationUs);
+
+  uint32_t t1 = us(50000);
+  capture->arm(t1, gate);
+  capture->onEdge(true, t1 + us(6000));
+  assertStatus(EchoCapture::Status::Timeout, capture->poll(t1 + us(30000), s));
+  TEST_ASSERT_EQUAL_UINT32(0, s.durationUs);
+  TEST_ASSERT_EQUAL_UINT32(2, s.ticket);
+  capture->onEdge(false, t1 + us(30001));
+
+  uint32_t t2 = t1 + us(30100);
+  capture->arm(t2, gate);
+  assertStatus(EchoCapture::Status::Pending, capture->poll(t2 + us(100), s));
+  capture->onEdge(true, t2 + us(400));
+  capture->onEdge(false, t2 + us(400 + 800));
+  assertStatus(EchoCapture::Status::Ready, capture->poll(t2 + us(1500), s));
+  TEST_ASSERT_EQUAL_UINT32(800, s.durationUs);
+  TEST_ASSERT_EQUAL_UINT32(3, s.ticket);
+}
+
+// Shorter than nearUs or longer than farUs: rejected as soon as it ends, with its width
+void test_out_of_gate_rejected() {
+  EchoSample s;
+  capture->arm(0, gate);
+  capture->onEdge(true, us(300));
+  capture->onEdge(false, us(300 + 60));
+  assertStatus(EchoCapture::Status::Rejected, capture->poll(us(400), s));
+  TEST_ASSERT_EQUAL_UINT32(60, s.durationUs);
+  TEST_ASSERT_FALSE(capture->busy());
+
+  capture->arm(us(1000), gate);
+  capture->onEdge(true, us(1300));
+  capture->onEdge(false, us(1300 + 26000));
+  assertStatus(EchoCapture::Status::Rejected, capture->poll(us(27400), s));
+  TEST_ASSERT_EQUAL_UINT32(26000, s.durationUs);
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_rise_and_fall);
+  RUN_TEST(test_stale_fall_ignored);
+  RUN_TEST(test_rise_from_previous_ping_ignored);
+  RUN_TEST(test_cycle_counter_wrap);
+  RUN_TEST(test_timeout_against_late_fall);
+  RUN_TEST(test_out_of_gate_rejected);
+  return UNITY_END();
+}
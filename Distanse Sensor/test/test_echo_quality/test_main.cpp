@@ -0,0 +1,107 @@
+/*
+   Echo validity (lib/EchoQuality): the label of each ping against a
+   10-80 cm gate and a track at 30 cm ± 5 cm, and the confidence score
+   of a burst.
+
+   Run with: pio test -e native -f test_echo_quality
+*/
+
+#include <unity.h>
+#include "EchoQuality.h"
+
+namespace {
+
+EchoQuality q;
+EchoExpect e;
+
+void assertClass(EchoClass expected, EchoClass actual) {
+  TEST_ASSERT_EQUAL_STRING(echoClassName(expected), echoClassName(actual));
+}
+
+}  // namespace
+
+void setUp() {
+  q = EchoQuality();
+  e = EchoExpect();
+  e.nearCm = 10;
+  e.farCm = 80;
+  e.tracked = true;
+  e.heightCm = 30;
+  e.toleranceCm = 5;
+  q.beginBurst();
+}
+
+void tearDown() {}
+
+void test_labels() {
+  assertClass(EchoClass::Timeout, q.classify(e, 0, -1, 0));
+  assertClass(EchoClass::UnderRange, q.classify(e, 290, 5, 0));
+  assertClass(EchoClass::OverRange, q.classify(e, 5000, 90, 0));
+  assertClass(EchoClass::Valid, q.classify(e, 2330, 40, 30));
+  assertClass(EchoClass::Jump, q.classify(e, 1165, 20, 50));
+  assertClass(EchoClass::Valid, q.classify(e, 2331, 40.02f, 29.98f));
+}
+
+// Without a confident track there is nothing to jump from
+void test_no_jumps_without_track() {
+  e.tracked = false;
+  assertClass(EchoClass::Valid, q.classify(e, 1165, 20, 50));
+}
+
+void test_stuck_after_identical_pings() {
+  for (uint8_t i = 1; i < ECHO_STUCK_PINGS; ++i) assertClass(EchoClass::Valid, q.classify(e, 2400, 41.2f, 28.8f));
+  assertClass(EchoClass::Stuck, q.classify(e, 2400, 41.2f, 28.8f));
+  // A wobble of one count is a live echo again
+  assertClass(EchoClass::Valid, q.classify(e, 2401, 41.2f, 28.8f));
+}
+
+// Two valid pings of six, and the most frequent problem as the label
+void test_burst_score_and_label() {
+  q.classify(e, 0, -1, 0);
+  q.classify(e, 290, 5, 0);
+  q.classify(e, 5000, 90, 0);
+  q.classify(e, 2330, 40, 30);
+  q.classify(e, 1165, 20, 50);
+  q.classify(e, 2331, 40.02f, 29.98f);
+  TEST_ASSERT_EQUAL_UINT8(33, q.endBurst(0.2f));
+  TEST_ASSERT_EQUAL_UINT8(33, q.confidence());
+  assertClass(EchoClass::Timeout, q.label());
+  TEST_ASSERT_EQUAL_UINT8(1, q.burstCount(EchoClass::Jump));
+  TEST_ASSERT_EQUAL_UINT16(2, q.count(EchoClass::Valid));
+}
+
+// Pings that scatter by 4 cm score a quarter
+void test_scattered_burst() {
+  q.classify(e, 2330, 40, 30);
+  TEST_ASSERT_EQUAL_UINT8(25, q.endBurst(4));
+  assertClass(EchoClass::Valid, q.label());
+}
+
+void test_no_echo_scores_zero() {
+  for (int i = 0; i < 5; ++i) q.classify(e, 0, -1, 0);
+  TEST_ASSERT_EQUAL_UINT8(0, q.endBurst(0));
+  assertClass(EchoClass::Timeout, q.label());
+}
+
+void test_counts_survive_bursts() {
+  q.classify(e, 0, -1, 0);
+  q.endBurst(0);
+  q.beginBurst();
+  q.classify(e, 0, -1, 0);
+  q.classify(e, 2330, 40, 30);
+  q.endBurst(0);
+  TEST_ASSERT_EQUAL_UINT16(2, q.count(EchoClass::Timeout));
+  TEST_ASSERT_EQUAL_UINT8(1, q.burstCount(EchoClass::Timeout));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_labels);
+  RUN_TEST(test_no_jumps_without_track);
+  RUN_TEST(test_stuck_after_identical_pings);
+  RUN_TEST(test_burst_score_and_label);
+  RUN_TEST(test_scattered_burst);
+  RUN_TEST(test_no_echo_scores_zero);
+  RUN_TEST(test_counts_survive_bursts);
+  return UNITY_END();
+}
@@ -0,0 +1,171 @@
+/*
+   Heap telemetry (lib/HeapWatch) and the heap model it is measured on in
+   the native build (MockHeap in lib/HalNative): best fit, merging of
+   freed runs, the core's fragmentation figure, the low-water mark, and
+   per-route peaks and retained bytes around requests.
+
+   Run with: pio test -e native -f test_heap_watch
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include "HalNative.h"
+#include "HeapWatch.h"
+
+namespace {
+
+HeapWatch watch;
+
+// Bytes to ask for so an allocation takes exactly blocks (with its header)
+size_t bytesFor(size_t blocks) {
+  return blocks * MockHeap::BLOCK - MockHeap::HEADER;
+}
+
+}  // namespace
+
+void setUp() {
+  sim.heap.reset(40 * 1024);
+  watch = HeapWatch();
+}
+
+void tearDown() {}
+
+// Whole 8-byte blocks, the 4-byte header included
+void test_alloc_takes_whole_blocks() {
+  sim.heap.reset(1024);
+  TEST_ASSERT_EQUAL_INT32(0, sim.heap.alloc(4));
+  TEST_ASSERT_EQUAL_INT32(1, sim.heap.alloc(5));
+  TEST_ASSERT_EQUAL_UINT32(1024 - 24, sim.heap.freeBytes());
+  TEST_ASSERT_EQUAL_UINT32(2, sim.heap.used);
+  TEST_ASSERT_EQUAL_UINT64(2, sim.heap.allocs);
+}
+
+// Holes of 5 and 3 blocks: each allocation goes into the smallest that fits
+void test_best_fit() {
+  sim.heap.reset(1024);
+  int32_t a = sim.heap.alloc(bytesFor(5));
+  sim.heap.alloc(bytesFor(1));
+  int32_t b = sim.heap.alloc(bytesFor(3));
+  sim.heap.alloc(bytesFor(1));
+  sim.heap.free(a);
+  sim.heap.free(b);
+  TEST_ASSERT_EQUAL_INT32(b, sim.heap.alloc(bytesFor(3)));
+  TEST_ASSERT_EQUAL_INT32(a, sim.heap.alloc(bytesFor(2)));
+  TEST_ASSERT_EQUAL_INT32(a + 2, sim.heap.alloc(bytesFor(3)));
+}
+
+// Two free runs of 8 blocks: 100 - 100 / √2 in the core's integer math; freed
+// neighbours merge back into one run
+void test_fragmentation_and_merging() {
+  sim.heap.reset(256);
+  int32_t runs[4];
+  for (int32_t& r : runs) r = sim.heap.alloc(bytesFor(8));
+  sim.heap.free(runs[0]);
+  sim.heap.free(runs[2]);
+  uint32_t freeBytes, maxBlock;
+  uint8_t fragmentation;
+  sim.heap.stats(freeBytes, maxBlock, fragmentation);
+  TEST_ASSERT_EQUAL_UINT32(128, freeBytes);
+  TEST_ASSERT_EQUAL_UINT32(60, maxBlock);
+  TEST_ASSERT_EQUAL_UINT8(32, fragmentation);
+  // 9 blocks fit in neither
+  TEST_ASSERT_EQUAL_INT32(-1, sim.heap.alloc(bytesFor(9)));
+  TEST_ASSERT_EQUAL_UINT64(1, sim.heap.failures);
+
+  sim.heap.free(runs[1]);
+  sim.heap.free(runs[3]);
+  sim.heap.stats(freeBytes, maxBlock, fragmentation);
+  TEST_ASSERT_EQUAL_UINT32(256, freeBytes);
+  TEST_ASSERT_EQUAL_UINT32(252, maxBlock);
+  TEST_ASSERT_EQUAL_UINT8(0, fragmentation);
+  TEST_ASSERT_EQUAL_UINT32(0, sim.heap.used);
+  TEST_ASSERT_EQUAL_UINT64(4, sim.heap.frees);
+}
+
+// The lowest free heap since the last call, then from now on
+void test_low_water() {
+  int32_t a = sim.heap.alloc(bytesFor(128));
+  sim.heap.free(a);
+  TEST_ASSERT_EQUAL_UINT32(40 * 1024 - 1024, sim.heap.lowWater());
+  TEST_ASSERT_EQUAL_UINT32(40 * 1024, sim.heap.lowWater());
+}
+
+void test_untracked_nests() {
+  sim.heap.setTracking(true);
+  {
+    MockHeap::Untracked outer(sim.heap);
+    {
+      MockHeap::Untracked inner(sim.heap);
+      TEST_ASSERT_FALSE(sim.heap.tracking());
+    }
+    TEST_ASSERT_FALSE(sim.heap.tracking());
+  }
+  TEST_ASSERT_TRUE(sim.heap.tracking());
+  sim.heap.setTracking(false);
+}
+
+// A dip allocated and freed between two passes still reaches the marks
+void test_tick_keeps_dip() {
+  int32_t a = sim.heap.alloc(bytesFor(128));
+  sim.heap.free(a);
+  watch.tick(sim.system);
+  TEST_ASSERT_EQUAL_UINT32(1, watch.ticks());
+  TEST_ASSERT_EQUAL_UINT32(40 * 1024 - 1024, watch.marks().minFree);
+  watch.sample(sim.system);
+  TEST_ASSERT_EQUAL_UINT32(40 * 1024, watch.last().freeBytes);
+  TEST_ASSERT_EQUAL_UINT32(40 * 1024 - 1024, watch.marks().minFree);
+  TEST_ASSERT_EQUAL_UINT32(1, watch.samples());
+}
+
+// 2 KB at once and 64 B kept, then the 64 B given back on the next request
+void test_route_peak_and_retained() {
+  watch.beginRequest(sim.system);
+  int32_t big = sim.heap.alloc(bytesFor(256));
+  int32_t kept = sim.heap.alloc(bytesFor(8));
+  sim.heap.free(big);
+  watch.endRequest("/api/status", sim.system);
+  TEST_ASSERT_EQUAL_UINT8(1, watch.routeCount());
+  const HeapRoute& r = watch.route(0);
+  TEST_ASSERT_EQUAL_STRING("/api/status", r.path);
+  TEST_ASSERT_EQUAL_UINT32(1, r.requests);
+  TEST_ASSERT_EQUAL_UINT32(2048 + 64, r.maxPeakBytes);
+  TEST_ASSERT_EQUAL_INT32(64, r.retainedBytes);
+  TEST_ASSERT_EQUAL_UINT32(40 * 1024 - 64, r.after.minFree);
+
+  // The same route by its text, not its pointer
+  char path[] = "/api/status";
+  watch.beginRequest(sim.system);
+  sim.heap.free(kept);
+  watch.endRequest(path, sim.system);
+  TEST_ASSERT_EQUAL_UINT8(1, watch.routeCount());
+  TEST_ASSERT_EQUAL_UINT32(2, r.requests);
+  TEST_ASSERT_EQUAL_UINT32(2048 + 64, r.maxPeakBytes);
+  TEST_ASSERT_EQUAL_INT32(-64, r.retainedBytes);
+  TEST_ASSERT_EQUAL_INT32(64, r.maxRetainedBytes);
+}
+
+// Past HEAP_ROUTES routes requests are only counted
+void test_route_table_full() {
+  static char paths[HEAP_ROUTES + 1][8];
+  for (uint8_t i = 0; i <= HEAP_ROUTES; ++i) {
+    snprintf(paths[i], sizeof(paths[i]), "/r%u", i);
+    watch.beginRequest(sim.system);
+    watch.endRequest(paths[i], sim.system);
+  }
+  TEST_ASSERT_EQUAL_UINT8(HEAP_ROUTES, watch.routeCount());
+  TEST_ASSERT_EQUAL_UINT32(1, watch.unlistedRequests());
+  TEST_ASSERT_EQUAL_UINT32(HEAP_ROUTES + 1, watch.samples());
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_alloc_takes_whole_blocks);
+  RUN_TEST(test_best_fit);
+  RUN_TEST(test_fragmentation_and_merging);
+  RUN_TEST(test_low_water);
+  RUN_TEST(test_untracked_nests);
+  RUN_TEST(test_tick_keeps_dip);
+  RUN_TEST(test_route_peak_and_retained);
+  RUN_TEST(test_route_table_full);
+  return UNITY_END();
+}
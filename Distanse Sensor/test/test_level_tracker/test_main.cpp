@@ -0,0 +1,172 @@
+/*
+   Level tracker (lib/LevelTracker): the interpolated gains against
+   Kalata's model, and synthetic fill and drain curves read with 0.5 cm
+   noise, misses and spikes, compared with the truth.
+
+   Run with: pio test -e native -f test_level_tracker
+*/
+
+#include <unity.h>
+#include <math.h>
+#include "LevelTracker.h"
+
+void setUp() {}
+void tearDown() {}
+
+namespace {
+
+struct Gauss {
+  uint32_t rng;
+  double uniform() {
+    rng = rng * 1103515245u + 12345u;
+    return ((rng >> 8) + 0.5) / 16777216.0;
+  }
+  double next() { return sqrt(-2 * log(uniform())) * cos(2 * M_PI * uniform()); }
+};
+
+// A synthetic level curve: true level and rate at t minutes
+struct Curve {
+  uint32_t intervalMs;
+  double minutes;
+  double (*level)(double t);
+  double (*rate)(double t);
+  uint32_t missPercent;
+  uint32_t spikePercent;
+};
+
+struct CurveResult {
+  double rawRms;     // readings against the truth, cm
+  double trackRms;   // tracked level against the truth, cm
+  double rateRms;    // rate against the true rate, cm/min
+  float finalRate;
+  uint8_t finalConfidence;
+  uint32_t outliers;
+};
+
+// Feed the tracker readings with 0.5 cm noise and compare it with the truth
+// wherever it claims over 50 % confidence (past the warm-up and the
+// outliers before a restart)
+CurveResult runCurve(const Curve& c) {
+  LevelTracker tracker;
+  Gauss g = {7};
+  double rawSq = 0, trackSq = 0, rateSq = 0;
+  uint32_t n = 0;
+  for (uint32_t ms = 0; ms <= c.minutes * 60000; ms += c.intervalMs) {
+    double t = ms / 60000.0;
+    double truth = c.level(t);
+    double z = truth + TRACK_MEAS_NOISE_CM * g.next();
+    uint32_t roll = (uint32_t)(g.uniform() * 100);
+    if (roll < c.missPercent) {
+      tracker.miss();
+    } else if (roll < c.missPercent + c.spikePercent) {
+      tracker.update(ms, (float)(truth - 30));   // echo off a bracket or the inlet pipe
+    } else {
+      tracker.update(ms, (float)z);
+      if (tracker.confidence() > 50) {
+        rawSq += (z - truth) * (z - truth);
+        double e = tracker.levelCm(ms) - truth;
+        trackSq += e * e;
+        double r = tracker.rateCmPerMin() - c.rate(t);
+        rateSq += r * r;
+        ++n;
+      }
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(0, n);
+  return {sqrt(rawSq / n), sqrt(trackSq / n), sqrt(rateSq / n), tracker.rateCmPerMin(), tracker.confidence(),
+          tracker.outliers()};
+}
+
+}  // namespace
+
+// Interpolated Q15 gains against the model
+void test_gains_match_model() {
+  for (uint32_t dtMs = 100; dtMs <= 4000000; dtMs = dtMs * 21 / 20 + 1) {
+    double minutes = dtMs / 60000.0;
+    double lambda = TRACK_ACCEL_CM_MIN2 * minutes * minutes / TRACK_MEAS_NOISE_CM;
+    if (lambda < 1.0 / 65536 || lambda > 65536) continue;
+    uint16_t a, b;
+    LevelTracker::gains(dtMs, a, b);
+    TEST_ASSERT_DOUBLE_WITHIN(0.02, trackAlpha(lambda), a / 32768.0);
+    TEST_ASSERT_DOUBLE_WITHIN(0.02, trackBeta(lambda), b / 32768.0);
+  }
+}
+
+void test_boost_raises_gains() {
+  uint16_t a, b, boostedA, boostedB;
+  LevelTracker::gains(5000, a, b);
+  LevelTracker::gains(5000, boostedA, boostedB, TRACK_MAX_BOOST);
+  TEST_ASSERT_GREATER_THAN(a, boostedA);
+  TEST_ASSERT_GREATER_THAN(b, boostedB);
+}
+
+void test_steady_fill() {
+  CurveResult r = runCurve({5000, 20, [](double t) { return 10 + 2 * t; }, [](double) { return 2.0; }, 0, 0});
+  TEST_ASSERT_TRUE_MESSAGE(r.trackRms < r.rawRms, "tracked level noisier than the readings");
+  TEST_ASSERT_DOUBLE_WITHIN(0.5, 0.0, r.rateRms);
+  TEST_ASSERT_GREATER_THAN(50, r.finalConfidence);
+}
+
+void test_drain() {
+  CurveResult r = runCurve({5000, 8, [](double t) { return 45 - 5 * t; }, [](double) { return -5.0; }, 0, 0});
+  TEST_ASSERT_TRUE_MESSAGE(r.trackRms < r.rawRms, "tracked level noisier than the readings");
+  TEST_ASSERT_DOUBLE_WITHIN(1.2, 0.0, r.rateRms);
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, -5.0f, r.finalRate);
+}
+
+// The rate has to catch up with a pump switching on and off again
+void test_pump_on_and_off() {
+  CurveResult r = runCurve({5000, 25, [](double t) { return t < 10 ? 5.0 : t < 15 ? 5 + 10 * (t - 10) : 55.0; },
+                            [](double t) { return t < 10 ? 0.0 : t < 15 ? 10.0 : 0.0; }, 0, 0});
+  TEST_ASSERT_TRUE_MESSAGE(r.trackRms < r.rawRms, "tracked level noisier than the readings");
+  TEST_ASSERT_DOUBLE_WITHIN(2.5, 0.0, r.rateRms);
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, r.finalRate);
+}
+
+// Sparse readings, as in battery mode
+void test_slow_rain_read_every_minute() {
+  CurveResult r = runCurve({60000, 120, [](double t) { return 5 + 0.2 * t; }, [](double) { return 0.2; }, 0, 0});
+  TEST_ASSERT_TRUE_MESSAGE(r.trackRms < r.rawRms, "tracked level noisier than the readings");
+  TEST_ASSERT_DOUBLE_WITHIN(1.0, 0.0, r.rateRms);
+}
+
+void test_misses_and_spikes() {
+  CurveResult r = runCurve({5000, 20, [](double t) { return 10 + 2 * t; }, [](double) { return 2.0; }, 20, 5});
+  TEST_ASSERT_TRUE_MESSAGE(r.trackRms < r.rawRms, "tracked level noisier than the readings");
+  TEST_ASSERT_GREATER_THAN(0, r.outliers);
+  TEST_ASSERT_DOUBLE_WITHIN(0.5, 0.0, r.rateRms);
+}
+
+// A jump no fill could explain: outliers first, then a new track at the new level
+void test_emptied_by_hand_restarts() {
+  CurveResult r = runCurve({5000, 20, [](double t) { return t < 10 ? 45.0 : 5.0; }, [](double) { return 0.0; }, 0, 0});
+  TEST_ASSERT_TRUE_MESSAGE(r.trackRms < r.rawRms, "tracked level noisier than the readings");
+  TEST_ASSERT_EQUAL_UINT32(TRACK_RESTART_OUTLIERS, r.outliers);
+  TEST_ASSERT_DOUBLE_WITHIN(0.4, 0.0, r.rateRms);
+}
+
+void test_miss_coasts_and_lowers_confidence() {
+  LevelTracker tracker;
+  TEST_ASSERT_FALSE(tracker.valid());
+  for (uint32_t i = 0; i < 20; ++i) tracker.update(i * 5000, 20.0f + 0.1f * i);
+  uint8_t before = tracker.confidence();
+  float predicted = tracker.levelCm(25 * 5000);
+  tracker.miss();
+  tracker.miss();
+  TEST_ASSERT_LESS_THAN(before, tracker.confidence());
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, predicted, tracker.levelCm(25 * 5000));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_gains_match_model);
+  RUN_TEST(test_boost_raises_gains);
+  RUN_TEST(test_steady_fill);
+  RUN_TEST(test_drain);
+  RUN_TEST(test_pump_on_and_off);
+  RUN_TEST(test_slow_rain_read_every_minute);
+  RUN_TEST(test_misses_and_spikes);
+  RUN_TEST(test_emptied_by_hand_restarts);
+  RUN_TEST(test_miss_coasts_and_lowers_confidence);
+  return UNITY_END();
+}
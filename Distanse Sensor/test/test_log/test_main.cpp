@@ -0,0 +1,122 @@
+/*
+   Binary log ring (lib/Log): a reader that keeps up and one that falls
+   behind, records written through the LOG_ macros, and the deferred
+   formatting against printf.
+
+   Run with: pio test -e native -f test_log
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include "HalNative.h"
+#include "Log.h"
+
+namespace {
+
+LogRing ring;
+
+// Record i has i % 7 arguments (0..LOG_MAX_ARGS) and ID i % 13
+void writeRecord(uint32_t i) {
+  LogWord args[LOG_MAX_ARGS];
+  uint8_t argc = i % (LOG_MAX_ARGS + 1);
+  for (uint8_t k = 0; k < argc; ++k) args[k] = i * 7 + k;
+  ring.write(LOG_LEVEL_INFO, (uint8_t)(i % 13), i, args, argc);
+}
+
+void assertRecord(uint32_t i, const LogRecord& r) {
+  TEST_ASSERT_EQUAL_UINT32(i, r.ms);
+  TEST_ASSERT_EQUAL_UINT8(LOG_LEVEL_INFO, r.level);
+  TEST_ASSERT_EQUAL_UINT8(i % 13, r.id);
+  TEST_ASSERT_EQUAL_UINT8(i % (LOG_MAX_ARGS + 1), r.argc);
+  for (uint8_t k = 0; k < r.argc; ++k) TEST_ASSERT_EQUAL_UINT32(i * 7 + k, r.args[k]);
+}
+
+}  // namespace
+
+void setUp() {
+  ring = LogRing();
+  logRing = LogRing();
+}
+
+void tearDown() {}
+
+// A reader that keeps up gets every record in order
+void test_live_reader_gets_everything() {
+  uint32_t cursor = 0, n = 0;
+  LogRecord r;
+  for (uint32_t i = 0; i < 2000; ++i) {
+    writeRecord(i);
+    while (ring.read(cursor, r)) assertRecord(n++, r);
+  }
+  TEST_ASSERT_EQUAL_UINT32(2000, n);
+  TEST_ASSERT_EQUAL_UINT32(2000, ring.written());
+  TEST_ASSERT_EQUAL_UINT32(ring.head(), cursor);
+}
+
+// One that fell behind gets the newest ones, from the oldest kept on
+void test_late_reader_skips_to_oldest_kept() {
+  for (uint32_t i = 0; i < 2000; ++i) writeRecord(i);
+  TEST_ASSERT_LESS_OR_EQUAL(LOG_RING_SIZE, ring.head() - ring.tail());
+  uint32_t cursor = 0, n = 0, first = 0;
+  LogRecord r;
+  while (ring.read(cursor, r)) {
+    if (!n) first = r.ms;
+    assertRecord(first + n, r);
+    ++n;
+  }
+  TEST_ASSERT_EQUAL_UINT32(2000, first + n);
+  TEST_ASSERT_EQUAL_UINT32(2000, ring.overwritten() + n);
+  TEST_ASSERT_FALSE(ring.read(cursor, r));
+}
+
+void test_macros_stamp_the_clock() {
+  sim.clock.advanceUs(5000000);
+  LOG_WARN(3, 1.5f, -2, "x");
+  uint32_t cursor = 0;
+  LogRecord r;
+  TEST_ASSERT_TRUE(logRing.read(cursor, r));
+  TEST_ASSERT_EQUAL_UINT32(sim.clock.millis(), r.ms);
+  TEST_ASSERT_EQUAL_UINT8(LOG_LEVEL_WARN, r.level);
+  TEST_ASSERT_EQUAL_UINT8(3, r.id);
+  TEST_ASSERT_EQUAL_UINT8(3, r.argc);
+  // Above LOG_LEVEL: compiled out, nothing written
+  LOG_DEBUG(4, 1);
+  TEST_ASSERT_FALSE(logRing.read(cursor, r));
+}
+
+// Formatted later the same as printf would have then; a missing argument is "?"
+void test_format_matches_printf() {
+  const char* fmt = "%5.1f cm|%-4d|%u|%02X|%s|%%|%+.2f|%lu";
+  LogWord words[] = {logWord(45.25f), logWord(-12), logWord(4000000000u), logWord(0x0A), logWord("valid"),
+                     logWord(-0.5f), logWord(7)};
+  LogRecord rec = {1234, LOG_LEVEL_INFO, 0, 6, {}};
+  memcpy(rec.args, words, sizeof(rec.args));
+  char text[96], expected[96];
+  size_t len = logFormat(text, sizeof(text), fmt, rec);
+  snprintf(expected, sizeof(expected), "%5.1f cm|%-4d|%u|%02X|%s|%%|%+.2f|?", 45.25, -12, 4000000000u, 0x0A, "valid", -0.5);
+  TEST_ASSERT_EQUAL_STRING(expected, text);
+  TEST_ASSERT_EQUAL_size_t(strlen(expected), len);
+
+  char cut[8];
+  TEST_ASSERT_EQUAL_size_t(7, logFormat(cut, sizeof(cut), fmt, rec));
+  TEST_ASSERT_EQUAL_MEMORY(expected, cut, 7);
+  TEST_ASSERT_EQUAL_UINT8('\0', cut[7]);
+}
+
+void test_level_chars() {
+  TEST_ASSERT_EQUAL_INT('E', logLevelChar(LOG_LEVEL_ERROR));
+  TEST_ASSERT_EQUAL_INT('W', logLevelChar(LOG_LEVEL_WARN));
+  TEST_ASSERT_EQUAL_INT('I', logLevelChar(LOG_LEVEL_INFO));
+  TEST_ASSERT_EQUAL_INT('D', logLevelChar(LOG_LEVEL_DEBUG));
+  TEST_ASSERT_EQUAL_INT('?', logLevelChar(9));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_live_reader_gets_everything);
+  RUN_TEST(test_late_reader_skips_to_oldest_kept);
+  RUN_TEST(test_macros_stamp_the_clock);
+  RUN_TEST(test_format_matches_printf);
+  RUN_TEST(test_level_chars);
+  return UNITY_END();
+}
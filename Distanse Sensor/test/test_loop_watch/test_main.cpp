@@ -0,0 +1,111 @@
+/*
+   Loop-latency watchdog (lib/LoopWatch): the histogram of iteration
+   lengths, stalls blamed on their longest part, the newest stalls kept
+   in the StallLog and a name too long for a record.
+
+   Run with: pio test -e native -f test_loop_watch
+*/
+
+#include <unity.h>
+#include <string.h>
+#include "LoopWatch.h"
+
+namespace {
+
+LoopWatch watch;
+StallLog stallLog;
+
+}  // namespace
+
+// Stalls from 1 ms on
+void setUp() {
+  watch = LoopWatch();
+  watch.setThreshold(1000);
+  stallLog = {};
+  stallLog.boots = 3;
+}
+
+void tearDown() {}
+
+// 10, 500 and 1500 µs, then ten of 2000..2009 µs: 11 over 1 ms
+void test_histogram_and_stalls() {
+  const uint32_t lengths[] = {10, 500, 1500};
+  bool stalled = false;
+  for (uint32_t us : lengths) {
+    watch.beginIteration(100);
+    watch.blame("a", us / 10);
+    watch.blame("b", us * 8 / 10);
+    stalled = watch.endIteration(100 + us, 7, stallLog);
+  }
+  TEST_ASSERT_TRUE(stalled);
+  for (uint32_t i = 0; i < 10; ++i) {
+    watch.beginIteration(0);
+    TEST_ASSERT_TRUE(watch.endIteration(2000 + i, 8 + i, stallLog));
+  }
+  TEST_ASSERT_EQUAL_UINT32(13, watch.iterations());
+  TEST_ASSERT_EQUAL_UINT32(11, watch.stalls());
+  TEST_ASSERT_EQUAL_UINT32(1, watch.bucket(3));
+  TEST_ASSERT_EQUAL_UINT32(1, watch.bucket(8));
+  TEST_ASSERT_EQUAL_UINT32(11, watch.bucket(10));
+  TEST_ASSERT_EQUAL_UINT32(2009, watch.maxUs());
+}
+
+// The newest STALL_RECORDS, newest first; nothing blamed is "loop"
+void test_log_keeps_newest() {
+  for (uint32_t i = 0; i < 11; ++i) {
+    watch.beginIteration(0);
+    watch.endIteration(2000 + i, 7 + i, stallLog);
+  }
+  TEST_ASSERT_EQUAL_UINT32(11, stallLog.total);
+  TEST_ASSERT_EQUAL_UINT8(STALL_RECORDS, stallLog.count);
+  TEST_ASSERT_EQUAL_UINT32(17, stallLog.newest(0).atMs);
+  TEST_ASSERT_EQUAL_UINT32(2010, stallLog.newest(0).loopUs);
+  TEST_ASSERT_EQUAL_UINT32(10, stallLog.newest(STALL_RECORDS - 1).atMs);
+  TEST_ASSERT_EQUAL_UINT16(3, stallLog.newest(0).boot);
+  TEST_ASSERT_EQUAL_STRING("loop", stallLog.newest(0).name);
+}
+
+// Blamed on the longest part, whatever the order they came in
+void test_blames_longest_part() {
+  watch.beginIteration(0);
+  watch.blame("a", 300);
+  watch.blame("b", 1200);
+  watch.blame("c", 900);
+  TEST_ASSERT_TRUE(watch.endIteration(2500, 0, stallLog));
+  TEST_ASSERT_EQUAL_STRING("b", stallLog.newest(0).name);
+  TEST_ASSERT_EQUAL_UINT32(1200, stallLog.newest(0).spanUs);
+  TEST_ASSERT_EQUAL_UINT32(2500, stallLog.newest(0).loopUs);
+}
+
+// Under the threshold nothing is recorded, and the blame does not carry over
+void test_below_threshold_not_recorded() {
+  watch.beginIteration(0);
+  watch.blame("fast", 900);
+  TEST_ASSERT_FALSE(watch.endIteration(999, 0, stallLog));
+  TEST_ASSERT_EQUAL_UINT8(0, stallLog.count);
+  watch.beginIteration(1000);
+  TEST_ASSERT_TRUE(watch.endIteration(2000, 1, stallLog));
+  TEST_ASSERT_EQUAL_STRING("loop", stallLog.newest(0).name);
+  TEST_ASSERT_EQUAL_UINT32(0, stallLog.newest(0).spanUs);
+}
+
+// Cut to fit the record, still terminated
+void test_long_name_cut() {
+  const char* name = "/api/calibration?channel=2";
+  watch.beginIteration(0);
+  watch.blame(name, 1500);
+  watch.endIteration(1600, 0, stallLog);
+  const char* kept = stallLog.newest(0).name;
+  TEST_ASSERT_EQUAL_size_t(STALL_NAME - 1, strlen(kept));
+  TEST_ASSERT_EQUAL_MEMORY(name, kept, STALL_NAME - 1);
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_histogram_and_stalls);
+  RUN_TEST(test_log_keeps_newest);
+  RUN_TEST(test_blames_longest_part);
+  RUN_TEST(test_below_threshold_not_recorded);
+  RUN_TEST(test_long_name_cut);
+  return UNITY_END();
+}
@@ -0,0 +1,123 @@
+/*
+   Cycle-counter profiler (lib/Perf): the log2 histogram against known
+   durations, its percentiles, probes timing every return path on a
+   counter swapped in with perfUseCounter(), and the section registry.
+
+   Run with: pio test -e native -f test_perf
+*/
+
+#include <unity.h>
+#include "HalNative.h"
+#include "Perf.h"
+
+namespace {
+
+PerfSection first("first");
+PerfSection second("second");
+
+uint32_t fakeCycles = 0;
+uint32_t readFake() { return fakeCycles; }
+
+// Takes 100 cycles, or 5000 when it goes the long way
+int probed(bool longWay) {
+  PERF_SCOPE(second);
+  if (!longWay) {
+    fakeCycles += 100;
+    return 1;
+  }
+  fakeCycles += 5000;
+  return 2;
+}
+
+}  // namespace
+
+void setUp() {
+  perfResetAll();
+  perfUseCounter(nullptr, 0);
+  fakeCycles = 0;
+}
+
+void tearDown() {}
+
+// 0 and 1 cycle in the first bucket, 2..3 in the second, 1000 in 2^9..2^10 - 1,
+// anything from 2^23 cycles on in the last
+void test_histogram_buckets() {
+  for (uint32_t c : {0u, 1u, 2u, 3u, 1000u, 1000u, 1000u, 1u << 30}) first.record(c);
+  TEST_ASSERT_EQUAL_UINT32(8, first.count());
+  TEST_ASSERT_EQUAL_UINT32(2, first.bucket(0));
+  TEST_ASSERT_EQUAL_UINT32(2, first.bucket(1));
+  TEST_ASSERT_EQUAL_UINT32(3, first.bucket(9));
+  TEST_ASSERT_EQUAL_UINT32(1, first.bucket(PERF_BUCKETS - 1));
+  TEST_ASSERT_EQUAL_UINT32(0, first.minCycles());
+  TEST_ASSERT_EQUAL_UINT32(1u << 30, first.maxCycles());
+  TEST_ASSERT_EQUAL_UINT64(3006 + (1ull << 30), first.totalCycles());
+}
+
+// To the upper edge of the bucket, never past the maximum
+void test_percentiles() {
+  for (uint32_t c : {0u, 1u, 2u, 3u, 1000u, 1000u, 1000u, 1u << 30}) first.record(c);
+  TEST_ASSERT_EQUAL_UINT32(3, first.percentile(0.5f));
+  TEST_ASSERT_EQUAL_UINT32(1023, first.percentile(0.8f));
+  TEST_ASSERT_EQUAL_UINT32(1u << 30, first.percentile(1.0f));
+  second.record(600);
+  TEST_ASSERT_EQUAL_UINT32(600, second.percentile(0.99f));
+}
+
+void test_empty_and_reset() {
+  TEST_ASSERT_EQUAL_UINT32(0, first.minCycles());
+  TEST_ASSERT_EQUAL_UINT32(0, first.percentile(0.5f));
+  first.record(50);
+  second.record(70);
+  perfResetAll();
+  TEST_ASSERT_EQUAL_UINT32(0, first.count());
+  TEST_ASSERT_EQUAL_UINT32(0, second.count());
+  TEST_ASSERT_EQUAL_UINT32(0, first.bucket(5));
+  TEST_ASSERT_EQUAL_UINT64(0, second.totalCycles());
+}
+
+// Every return path is timed on the swapped-in counter
+void test_probe_on_every_return() {
+  perfUseCounter(readFake, 1000);
+  TEST_ASSERT_EQUAL_UINT32(1000, perfMhz());
+  TEST_ASSERT_EQUAL_INT(1, probed(false));
+  TEST_ASSERT_EQUAL_INT(2, probed(true));
+  TEST_ASSERT_EQUAL_INT(1, probed(false));
+  TEST_ASSERT_EQUAL_UINT32(3, second.count());
+  TEST_ASSERT_EQUAL_UINT32(100, second.minCycles());
+  TEST_ASSERT_EQUAL_UINT32(5000, second.maxCycles());
+  TEST_ASSERT_EQUAL_UINT64(5200, second.totalCycles());
+  TEST_ASSERT_EQUAL_UINT32(2, second.bucket(6));
+  TEST_ASSERT_EQUAL_UINT32(1, second.bucket(12));
+}
+
+// Back on the CPU counter: simulated time at the mock's 80 MHz
+void test_cpu_counter() {
+  TEST_ASSERT_EQUAL_UINT32(80, perfMhz());
+  {
+    PERF_SCOPE(first);
+    sim.clock.advanceUs(25);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, first.count());
+  TEST_ASSERT_EQUAL_UINT32(2000, first.maxCycles());
+}
+
+// In the order they were constructed
+void test_registry() {
+  const PerfSection* s = perfSections();
+  TEST_ASSERT_NOT_NULL(s);
+  TEST_ASSERT_EQUAL_STRING("first", s->name());
+  TEST_ASSERT_NOT_NULL(s->next());
+  TEST_ASSERT_EQUAL_STRING("second", s->next()->name());
+  TEST_ASSERT_NULL(s->next()->next());
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_histogram_buckets);
+  RUN_TEST(test_percentiles);
+  RUN_TEST(test_empty_and_reset);
+  RUN_TEST(test_probe_on_every_return);
+  RUN_TEST(test_cpu_counter);
+  RUN_TEST(test_registry);
+  return UNITY_END();
+}
@@ -0,0 +1,104 @@
+/*
+   Round-robin pings of several sensors (lib/PingScheduler): the gaps
+   between channels, the order of a round, a busy channel passed over,
+   and the rate over all of them.
+
+   Run with: pio test -e native -f test_ping_scheduler
+*/
+
+#include <unity.h>
+#include <string.h>
+#include "PingScheduler.h"
+
+namespace {
+
+PingScheduler sched;
+
+}  // namespace
+
+// Listening windows of 3, 2 and 4 ms, 0.5 ms of ring-down after each
+void setUp() {
+  sched = PingScheduler();
+  sched.setWindow(0, 3000);
+  sched.setWindow(1, 2000);
+  sched.setWindow(2, 4000);
+  sched.setGuard(500);
+}
+
+void tearDown() {}
+
+// The larger window of the two, plus the guard; after itself only its own
+void test_gaps() {
+  TEST_ASSERT_EQUAL_UINT32(3500, sched.gapUs(0, 1));
+  TEST_ASSERT_EQUAL_UINT32(3500, sched.gapUs(1, 0));
+  TEST_ASSERT_EQUAL_UINT32(4500, sched.gapUs(1, 2));
+  TEST_ASSERT_EQUAL_UINT32(2500, sched.gapUs(1, 1));
+  TEST_ASSERT_EQUAL_UINT32(4500, sched.gapUs(2, 0));
+}
+
+// One round: 3500 + 4500 + 4500 µs for 3 pings; one sensor alone waits for its own window
+void test_max_rate() {
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 240.0f, sched.maxRate(3));
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 1e6f / 3500, sched.maxRate(1));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, sched.maxRate(0));
+}
+
+void test_round_in_turn() {
+  sched.start(3, 2, 0);
+  uint8_t order[6], n = 0;
+  for (uint32_t now = 0; !sched.done() && now < 100000; now += 100) {
+    int8_t c = sched.next(now, 0);
+    if (c < 0) continue;
+    TEST_ASSERT_LESS_THAN(6, n);
+    order[n++] = (uint8_t)c;
+    sched.fired((uint8_t)c, now);
+  }
+  const uint8_t expected[6] = {0, 1, 2, 0, 1, 2};
+  TEST_ASSERT_EQUAL_UINT8(6, n);
+  TEST_ASSERT_EQUAL_MEMORY(expected, order, 6);
+  TEST_ASSERT_TRUE(sched.done());
+  TEST_ASSERT_EQUAL_INT8(-1, sched.next(100000, 0));
+}
+
+// Channel 1 still busy at the second ping: passed over once, its turn comes back,
+// and no ping goes out before its gap
+void test_busy_channel_passed_over() {
+  sched.start(3, 2, 0);
+  uint8_t order[6], n = 0;
+  uint32_t now = 0;
+  for (; !sched.done() && now < 100000; now += 100) {
+    uint8_t busy = n == 1 ? 0x2 : 0;
+    int8_t c = sched.next(now, busy);
+    if (c < 0) continue;
+    if (n) TEST_ASSERT_EQUAL_INT8(-1, sched.next(now - 1, busy));
+    order[n++] = (uint8_t)c;
+    sched.fired((uint8_t)c, now);
+  }
+  const uint8_t expected[6] = {0, 2, 0, 1, 2, 1};
+  TEST_ASSERT_EQUAL_UINT8(6, n);
+  TEST_ASSERT_EQUAL_MEMORY(expected, order, 6);
+  TEST_ASSERT_EQUAL_INT8(-1, sched.next(now, 0));
+}
+
+void test_start_limits_channels() {
+  sched.start(5, 1, 1234);
+  TEST_ASSERT_EQUAL_UINT8(PING_MAX_CHANNELS, sched.channels());
+  TEST_ASSERT_EQUAL_UINT32(1234, sched.roundStartUs());
+  TEST_ASSERT_EQUAL_UINT8(1, sched.pingsLeft(2));
+  TEST_ASSERT_EQUAL_UINT8(0, sched.pingsLeft(3));
+  // A channel that has no pings left is not fired again
+  sched.fired(0, 1300);
+  sched.fired(0, 9000);
+  TEST_ASSERT_EQUAL_UINT8(0, sched.pingsLeft(0));
+  TEST_ASSERT_EQUAL_INT8(1, sched.next(1300 + sched.gapUs(0, 1), 0));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_gaps);
+  RUN_TEST(test_max_rate);
+  RUN_TEST(test_round_in_turn);
+  RUN_TEST(test_busy_channel_passed_over);
+  RUN_TEST(test_start_limits_channels);
+  return UNITY_END();
+}
@@ -0,0 +1,148 @@
+/*
+   ESP-NOW report policy (lib/ReportPolicy): the first reading, the
+   deadband, a lost and returning echo, the heartbeat, the alarm levels
+   with their hysteresis, the per-reason counts, and the additional
+   sensors' ChannelReport.
+
+   Run with: pio test -e native -f test_report_policy
+*/
+
+#include <unity.h>
+#include "ReportPolicy.h"
+
+namespace {
+
+ReportSettings settings;
+
+void assertReason(ReportReason expected, ReportReason actual) {
+  TEST_ASSERT_EQUAL_STRING(reportReasonName(expected), reportReasonName(actual));
+}
+
+}  // namespace
+
+void setUp() {
+  settings = ReportSettings();
+  settings.deadbandPct = 2.0f;
+  settings.heartbeatS = 600;
+  settings.lowAlarmPct = 20;
+}
+
+void tearDown() {}
+
+void test_first_then_deadband() {
+  ReportPolicy p;
+  assertReason(ReportReason::First, p.check(0, 50.0f, settings));
+  assertReason(ReportReason::Suppressed, p.check(5, 51.5f, settings));
+  assertReason(ReportReason::Suppressed, p.check(10, 48.5f, settings));
+  assertReason(ReportReason::Moved, p.check(15, 52.5f, settings));
+  // Measured from the last reported level, not the last reading
+  assertReason(ReportReason::Suppressed, p.check(20, 54.0f, settings));
+  assertReason(ReportReason::Moved, p.check(25, 54.6f, settings));
+}
+
+void test_no_deadband_reports_every_reading() {
+  settings.deadbandPct = 0;
+  ReportPolicy p;
+  p.check(0, 50.0f, settings);
+  for (uint32_t t = 5; t < 100; t += 5) assertReason(ReportReason::Moved, p.check(t, 50.0f, settings));
+  TEST_ASSERT_EQUAL_UINT16(0, p.suppressed());
+}
+
+void test_echo_lost_and_back() {
+  ReportPolicy p;
+  p.check(0, 50.0f, settings);
+  assertReason(ReportReason::Echo, p.check(5, -1.0f, settings));
+  assertReason(ReportReason::Suppressed, p.check(10, -1.0f, settings));
+  assertReason(ReportReason::Echo, p.check(15, 50.0f, settings));
+}
+
+void test_heartbeat() {
+  ReportPolicy p;
+  p.check(25, 52.0f, settings);
+  assertReason(ReportReason::Suppressed, p.check(600, 52.0f, settings));
+  assertReason(ReportReason::Heartbeat, p.check(625, 52.0f, settings));
+  TEST_ASSERT_EQUAL_UINT32(625, p.lastReportSec());
+  assertReason(ReportReason::Suppressed, p.check(1200, 52.0f, settings));
+}
+
+// Back above 20 % but not above 21 % stays in the alarm zone
+void test_low_alarm_with_hysteresis() {
+  ReportPolicy p;
+  p.check(0, 52.0f, settings);
+  ReportReason r = p.check(5, 19.5f, settings);
+  assertReason(ReportReason::Alarm, r);
+  TEST_ASSERT_TRUE(ReportPolicy::urgent(r));
+  assertReason(ReportReason::Suppressed, p.check(10, 20.5f, settings));
+  // No echo keeps the alarm state
+  assertReason(ReportReason::Echo, p.check(15, -1.0f, settings));
+  assertReason(ReportReason::Echo, p.check(20, 19.8f, settings));
+  assertReason(ReportReason::Alarm, p.check(25, 21.5f, settings));
+}
+
+void test_high_alarm() {
+  settings.highAlarmPct = 90;
+  ReportPolicy p;
+  p.check(0, 88.0f, settings);
+  assertReason(ReportReason::Alarm, p.check(5, 90.5f, settings));
+  assertReason(ReportReason::Suppressed, p.check(10, 89.5f, settings));
+  assertReason(ReportReason::Alarm, p.check(15, 88.5f, settings));
+  TEST_ASSERT_FALSE(ReportPolicy::urgent(ReportReason::Heartbeat));
+}
+
+void test_counts() {
+  ReportPolicy p;
+  p.check(0, 50.0f, settings);
+  p.check(5, 51.5f, settings);
+  p.check(10, 48.5f, settings);
+  p.check(15, 52.5f, settings);
+  p.check(20, -1.0f, settings);
+  p.check(25, 52.0f, settings);
+  p.check(600, 52.0f, settings);
+  p.check(625, 52.0f, settings);
+  p.check(630, 19.5f, settings);
+  p.check(635, 20.5f, settings);
+  p.check(640, 21.5f, settings);
+  TEST_ASSERT_EQUAL_UINT16(4, p.suppressed());
+  TEST_ASSERT_EQUAL_UINT32(7, p.reported());
+  TEST_ASSERT_EQUAL_UINT16(2, p.count(ReportReason::Alarm));
+  TEST_ASSERT_EQUAL_UINT16(2, p.count(ReportReason::Echo));
+}
+
+// A manual reading restarts the deadband and the heartbeat from it
+void test_report_anyway() {
+  ReportPolicy p;
+  p.check(0, 50.0f, settings);
+  p.reportAnyway(300, 53.0f, settings);
+  TEST_ASSERT_EQUAL_UINT16(1, p.count(ReportReason::Manual));
+  assertReason(ReportReason::Suppressed, p.check(305, 54.0f, settings));
+  assertReason(ReportReason::Suppressed, p.check(605, 53.0f, settings));
+  assertReason(ReportReason::Heartbeat, p.check(900, 53.0f, settings));
+}
+
+// Same rules, no heartbeat; a reading that went out anyway counts as reported
+void test_channel_report() {
+  ChannelReport c;
+  assertReason(ReportReason::First, c.check(50.0f, settings));
+  assertReason(ReportReason::Suppressed, c.check(51.5f, settings));
+  assertReason(ReportReason::Moved, c.check(52.5f, settings));
+  assertReason(ReportReason::Echo, c.check(-1.0f, settings));
+  assertReason(ReportReason::Echo, c.check(52.0f, settings));
+  assertReason(ReportReason::Alarm, c.check(19.0f, settings));
+  assertReason(ReportReason::Suppressed, c.check(20.5f, settings));
+  c.sent(30.0f, settings);
+  assertReason(ReportReason::Suppressed, c.check(31.0f, settings));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_then_deadband);
+  RUN_TEST(test_no_deadband_reports_every_reading);
+  RUN_TEST(test_echo_lost_and_back);
+  RUN_TEST(test_heartbeat);
+  RUN_TEST(test_low_alarm_with_hysteresis);
+  RUN_TEST(test_high_alarm);
+  RUN_TEST(test_counts);
+  RUN_TEST(test_report_anyway);
+  RUN_TEST(test_channel_report);
+  return UNITY_END();
+}
@@ -0,0 +1,166 @@
+/*
+   JSN-SR04M serial modes (lib/SerialRanger): the frame parser on clean
+   streams, joined mid-frame and with every single-byte corruption, and
+   SerialRanger's pings on the mock UART.
+
+   Run with: pio test -e native -f test_serial_ranger
+*/
+
+#include <unity.h>
+#include <vector>
+#include "HalNative.h"
+#include "SerialRanger.h"
+
+namespace {
+
+MockUart uart;
+std::vector<uint8_t> sentToSensor;
+uint32_t rng;
+
+void appendFrame(std::vector<uint8_t>& s, uint16_t mm) {
+  uint8_t h = (uint8_t)(mm >> 8), l = (uint8_t)mm;
+  s.insert(s.end(), {0xFF, h, l, (uint8_t)(0xFF + h + l)});
+}
+
+std::vector<uint16_t> parseStream(RangerFrameParser& parser, const uint8_t* data, size_t len) {
+  std::vector<uint16_t> out;
+  uint16_t mm;
+  for (size_t i = 0; i < len; ++i) {
+    if (parser.feed(data[i], mm)) out.push_back(mm);
+  }
+  return out;
+}
+
+uint16_t randomMm() {
+  rng = rng * 1103515245u + 12345u;
+  return (uint16_t)(200 + (rng >> 16) % 5801);   // sensor range 20..600 cm
+}
+
+// A frame arriving from the sensor
+void sensorSends(uint16_t mm) {
+  std::vector<uint8_t> f;
+  appendFrame(f, mm);
+  for (uint8_t b : f) uart.receive(b);
+}
+
+}  // namespace
+
+void setUp() {
+  rng = 7;
+  uart = MockUart();
+  uart.begin(SerialRanger::BAUD, D6, D5);
+  sentToSensor.clear();
+  uart.onWrite = [](uint8_t b) { sentToSensor.push_back(b); };
+}
+
+void tearDown() {}
+
+void test_clean_stream_parses_every_frame() {
+  std::vector<uint8_t> stream;
+  std::vector<uint16_t> sent;
+  for (int i = 0; i < 10000; ++i) {
+    sent.push_back(randomMm());
+    appendFrame(stream, sent.back());
+  }
+  RangerFrameParser parser;
+  TEST_ASSERT_TRUE(parseStream(parser, stream.data(), stream.size()) == sent);
+  TEST_ASSERT_EQUAL_UINT32(10000, parser.stats().frames);
+  TEST_ASSERT_EQUAL_UINT32(0, parser.stats().checksumErrors);
+}
+
+// Joining mid-frame at every offset, also right after a 0xFF low or checksum byte:
+// from the first whole frame on, nothing may be lost
+void test_join_mid_frame_at_every_offset() {
+  for (uint16_t mm : {0x12FF, 0x00FE, 0x0700, 0x1234}) {
+    std::vector<uint8_t> s;
+    appendFrame(s, mm);
+    for (int i = 0; i < 4; ++i) appendFrame(s, 1000 + i);
+    for (size_t offset = 1; offset < 4; ++offset) {
+      RangerFrameParser p;
+      std::vector<uint16_t> got = parseStream(p, s.data() + offset, s.size() - offset);
+      TEST_ASSERT_TRUE(got == std::vector<uint16_t>({1000, 1001, 1002, 1003}));
+    }
+  }
+}
+
+// Every single-byte corruption of a frame between clean ones: the checksum must
+// reject it, and the frame after next must come through
+void test_single_byte_corruption_rejected_and_resynced() {
+  for (int set = 0; set < 20; ++set) {
+    uint16_t a = randomMm(), b = randomMm(), c = randomMm(), d = randomMm();
+    for (size_t pos = 0; pos < 4; ++pos) {
+      for (int x = 1; x < 256; ++x) {
+        std::vector<uint8_t> s;
+        appendFrame(s, a);
+        appendFrame(s, b);
+        s[4 + pos] ^= (uint8_t)x;
+        appendFrame(s, c);
+        appendFrame(s, d);
+        RangerFrameParser p;
+        std::vector<uint16_t> got = parseStream(p, s.data(), s.size());
+        TEST_ASSERT_FALSE(got.empty());
+        TEST_ASSERT_EQUAL_UINT16(a, got.front());
+        TEST_ASSERT_EQUAL_UINT16(d, got.back());
+        for (uint16_t mm : got) TEST_ASSERT_NOT_EQUAL(b, mm);
+      }
+    }
+  }
+}
+
+// Auto mode: a frame measured before the ping started must not complete it
+void test_auto_ping_ignores_frames_before_start() {
+  SerialRanger ranger;
+  ranger.begin(uart, RangerMode::Auto);
+  sensorSends(1111);
+  sensorSends(2222);
+  ranger.start(0, 200);
+  uint16_t mm = 0;
+  TEST_ASSERT_TRUE(ranger.poll(50, mm) == SerialRanger::Status::Pending);
+  sensorSends(3333);
+  TEST_ASSERT_TRUE(ranger.poll(100, mm) == SerialRanger::Status::Ready);
+  TEST_ASSERT_EQUAL_UINT16(3333, mm);
+  TEST_ASSERT_TRUE(sentToSensor.empty());
+  TEST_ASSERT_TRUE(ranger.poll(150, mm) == SerialRanger::Status::Idle);
+}
+
+// Controlled mode: one trigger byte per ping; the frame may arrive in pieces
+void test_controlled_ping_sends_trigger() {
+  SerialRanger ranger;
+  ranger.begin(uart, RangerMode::Controlled);
+  ranger.start(0, 200);
+  TEST_ASSERT_EQUAL_size_t(1, sentToSensor.size());
+  TEST_ASSERT_EQUAL_UINT8(SerialRanger::TRIGGER_BYTE, sentToSensor[0]);
+  std::vector<uint8_t> f;
+  appendFrame(f, 4567);
+  uint16_t mm = 0;
+  for (size_t i = 0; i + 1 < f.size(); ++i) {
+    uart.receive(f[i]);
+    TEST_ASSERT_TRUE(ranger.poll(10 + i, mm) == SerialRanger::Status::Pending);
+  }
+  uart.receive(f.back());
+  TEST_ASSERT_TRUE(ranger.poll(20, mm) == SerialRanger::Status::Ready);
+  TEST_ASSERT_EQUAL_UINT16(4567, mm);
+}
+
+void test_ping_times_out_on_garbage() {
+  SerialRanger ranger;
+  ranger.begin(uart, RangerMode::Controlled);
+  ranger.start(1000, 200);
+  for (uint8_t b : {0xFF, 0x01, 0x02, 0x00, 0x12}) uart.receive(b);
+  uint16_t mm = 0;
+  TEST_ASSERT_TRUE(ranger.poll(1199, mm) == SerialRanger::Status::Pending);
+  TEST_ASSERT_TRUE(ranger.poll(1200, mm) == SerialRanger::Status::Timeout);
+  TEST_ASSERT_FALSE(ranger.busy());
+  TEST_ASSERT_EQUAL_UINT32(1, ranger.stats().checksumErrors);
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_clean_stream_parses_every_frame);
+  RUN_TEST(test_join_mid_frame_at_every_offset);
+  RUN_TEST(test_single_byte_corruption_rejected_and_resynced);
+  RUN_TEST(test_auto_ping_ignores_frames_before_start);
+  RUN_TEST(test_controlled_ping_sends_trigger);
+  RUN_TEST(test_ping_times_out_on_garbage);
+  return UNITY_END();
+}
@@ -0,0 +1,70 @@
+/*
+   Speed of sound (lib/SoundSpeed): the flash table against the model and
+   against measured values, clamping, and echo time ↔ distance.
+
+   Run with: pio test -e native -f test_sound_speed
+*/
+
+#include <unity.h>
+#include <math.h>
+#include "SoundSpeed.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Table + interpolation against the model, over the whole range in 1/16 °C
+void test_table_matches_model() {
+  SoundSpeed s;
+  for (int t16 = SOUND_TEMP_MIN * 16; t16 <= SOUND_TEMP_MAX * 16; ++t16) {
+    s.setTemperature((int16_t)t16);
+    double exact = soundSpeedMs(t16 / 16.0) * (0.5 / 1000.0) * (1 << SOUND_SPEED_Q);
+    TEST_ASSERT_DOUBLE_WITHIN(exact * 100e-6, exact, (double)s.halfSpeedQ());
+  }
+}
+
+// Measured speed of sound in dry air (CRC Handbook / NPL tables), within 0.1 %
+void test_reference_values() {
+  const double reference[][2] = {{-20, 319.1}, {0, 331.3}, {10, 337.3}, {20, 343.2}, {30, 349.0}, {40, 354.7}};
+  SoundSpeed s;
+  for (const auto& r : reference) {
+    s.setTemperature((int16_t)(r[0] * 16));
+    TEST_ASSERT_DOUBLE_WITHIN(r[1] * 0.001, r[1], s.metersPerSecond());
+  }
+}
+
+void test_starts_at_20_degrees() {
+  SoundSpeed s;
+  TEST_ASSERT_EQUAL_INT16(20 * 16, s.temperature16());
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 343.2f, s.metersPerSecond());
+}
+
+void test_clamped_to_table_range() {
+  SoundSpeed s, edge;
+  s.setTemperature(-60 * 16);
+  edge.setTemperature(SOUND_TEMP_MIN * 16);
+  TEST_ASSERT_EQUAL_UINT32(edge.halfSpeedQ(), s.halfSpeedQ());
+  s.setTemperature(120 * 16);
+  edge.setTemperature(SOUND_TEMP_MAX * 16);
+  TEST_ASSERT_EQUAL_UINT32(edge.halfSpeedQ(), s.halfSpeedQ());
+}
+
+// 1 m at 20 °C is 5828 µs there and back; echoUs() inverts distanceCm()
+void test_echo_time_and_distance() {
+  SoundSpeed s;
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 100.0f, s.distanceCm(5828));
+  for (uint32_t us = 120; us < 65536; us += 97) {
+    TEST_ASSERT_UINT32_WITHIN(1, us, s.echoUs(s.distanceCm(us)));
+  }
+  s.setTemperature(-20 * 16);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f * 319.1f / 343.2f, s.distanceCm(5828));
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_table_matches_model);
+  RUN_TEST(test_reference_values);
+  RUN_TEST(test_starts_at_20_degrees);
+  RUN_TEST(test_clamped_to_table_range);
+  RUN_TEST(test_echo_time_and_distance);
+  return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/*
+   Timer wheel of loop() (lib/TimerWheel): one-shot deadlines over many
+   turns of the wheel and across the millis() wrap, cancelled tasks, a
+   periodic task through a stall, a task that cancels another due in the
+   same tick, and the slowest task of a run.
+
+   Run with: pio test -e native -f test_timer_wheel
+*/
+
+#include <unity.h>
+#include <memory>
+#include <vector>
+#include "HalNative.h"
+#include "TimerWheel.h"
+
+namespace {
+
+MockClock mockClock;
+TimerWheel* wheel = nullptr;
+uint32_t runs = 0;
+TimerTask* victim = nullptr;
+
+void countRun() { ++runs; }
+void cancelVictim() {
+  ++runs;
+  wheel->cancel(*victim);
+}
+void slowRun() { mockClock.advanceUs(3000); }
+
+}  // namespace
+
+void setUp() {
+  wheel = new TimerWheel();
+  runs = 0;
+  victim = nullptr;
+}
+
+void tearDown() {
+  delete wheel;
+  wheel = nullptr;
+}
+
+// Up to 5 s out, from 4 s before the wrap; every third cancelled. Each other one
+// runs once, in the tick it is due.
+void test_one_shots_across_wrap() {
+  uint32_t base = 0xFFFFF000u;
+  wheel->begin(base);
+  std::vector<std::unique_ptr<TimerTask>> tasks;
+  uint32_t rng = 7;
+  for (uint32_t i = 0; i < 300; ++i) {
+    rng = rng * 1103515245u + 12345u;
+    tasks.emplace_back(new TimerTask("oneShot", countRun));
+    wheel->schedule(*tasks.back(), base + 1 + (rng >> 8) % 5000);
+  }
+  for (uint32_t i = 0; i < tasks.size(); i += 3) wheel->cancel(*tasks[i]);
+  for (uint32_t ms = 1; ms <= 5100; ++ms) wheel->run(base + ms, mockClock);
+  for (uint32_t i = 0; i < tasks.size(); ++i) {
+    const TimerStats& st = tasks[i]->stats();
+    TEST_ASSERT_EQUAL_UINT32(i % 3 ? 1 : 0, st.runs);
+    TEST_ASSERT_EQUAL_UINT32(0, st.maxLateMs);
+    TEST_ASSERT_FALSE(tasks[i]->armed());
+  }
+  TEST_ASSERT_EQUAL_UINT32(200, runs);
+}
+
+// A task already past its deadline runs on the next run(), late
+void test_past_deadline_runs_next() {
+  TimerTask task("past", countRun);
+  wheel->begin(1000);
+  wheel->schedule(task, 980);
+  wheel->run(1001, mockClock);
+  TEST_ASSERT_EQUAL_UINT32(1, runs);
+  TEST_ASSERT_EQUAL_UINT32(21, task.stats().maxLateMs);
+  TEST_ASSERT_EQUAL_UINT32(1, task.stats().late);
+}
+
+// Keeps its beat; after a stall longer than the wheel it runs once, counts as
+// late and continues one period from then
+void test_periodic_through_stall() {
+  TimerTask periodic("periodic", countRun, 7);
+  uint32_t now = 1000;
+  wheel->begin(now);
+  wheel->schedule(periodic, now + 7);
+  for (uint32_t ms = 0; ms < 700; ++ms) wheel->run(++now, mockClock);
+  TEST_ASSERT_EQUAL_UINT32(100, periodic.stats().runs);
+  TEST_ASSERT_EQUAL_UINT32(0, periodic.stats().late);
+  now += 250;
+  wheel->run(now, mockClock);
+  const TimerStats& st = periodic.stats();
+  TEST_ASSERT_EQUAL_UINT32(101, st.runs);
+  TEST_ASSERT_EQUAL_UINT32(1, st.late);
+  TEST_ASSERT_GREATER_OR_EQUAL(250 - 7, st.maxLateMs);
+  TEST_ASSERT_EQUAL_UINT32(now + 7, periodic.dueMs());
+  wheel->cancel(periodic);
+  TEST_ASSERT_FALSE(periodic.armed());
+}
+
+// Due in the same tick: the first cancels the second, which then does not run
+void test_cancelled_by_task_in_same_tick() {
+  TimerTask first("first", cancelVictim), second("second", countRun);
+  victim = &second;
+  wheel->begin(500);
+  wheel->schedule(first, 503);
+  wheel->schedule(second, 503);
+  wheel->run(503, mockClock);
+  TEST_ASSERT_EQUAL_UINT32(1, runs);
+  TEST_ASSERT_EQUAL_UINT32(0, second.stats().runs);
+  TEST_ASSERT_FALSE(second.armed());
+}
+
+// Rescheduling replaces the deadline
+void test_reschedule_moves_deadline() {
+  TimerTask task("moved", countRun);
+  wheel->begin(0);
+  wheel->schedule(task, 10);
+  wheel->schedule(task, 40);
+  for (uint32_t ms = 1; ms < 40; ++ms) wheel->run(ms, mockClock);
+  TEST_ASSERT_EQUAL_UINT32(0, runs);
+  wheel->run(40, mockClock);
+  TEST_ASSERT_EQUAL_UINT32(1, runs);
+}
+
+void test_slowest_task_and_registry() {
+  TimerTask fast("fast", countRun), slow("slow", slowRun);
+  wheel->begin(0);
+  wheel->schedule(fast, 1);
+  wheel->schedule(slow, 1);
+  wheel->run(1, mockClock);
+  TEST_ASSERT_NOT_NULL(wheel->slowest());
+  TEST_ASSERT_EQUAL_STRING("slow", wheel->slowest()->name());
+  TEST_ASSERT_EQUAL_UINT32(3000, wheel->slowestUs());
+  TEST_ASSERT_EQUAL_UINT32(3000, slow.stats().maxUs);
+  wheel->run(2, mockClock);
+  TEST_ASSERT_NULL(wheel->slowest());
+  uint32_t listed = 0;
+  wheel->forEachTask([&](const TimerTask&) { ++listed; });
+  TEST_ASSERT_EQUAL_UINT32(2, listed);
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_one_shots_across_wrap);
+  RUN_TEST(test_past_deadline_runs_next);
+  RUN_TEST(test_periodic_through_stall);
+  RUN_TEST(test_cancelled_by_task_in_same_tick);
+  RUN_TEST(test_reschedule_moves_deadline);
+  RUN_TEST(test_slowest_task_and_registry);
+  return UNITY_END();
+}
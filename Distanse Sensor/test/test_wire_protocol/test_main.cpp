@@ -0,0 +1,110 @@
+/*
+   ESP-NOW wire format (lib/WireProtocol): frames of random readings are
+   encoded and decoded again, sent with any other version number, and
+   cut off at every byte.
+
+   Run with: pio test -e native -f test_wire_protocol
+*/
+
+#include <unity.h>
+#include "WireProtocol.h"
+
+void setUp() {}
+void tearDown() {}
+
+namespace {
+
+// A full batch of random readings and the header it is sent with
+struct RandomFrame {
+  float distance[WIRE_MAX_SAMPLES];
+  float level[WIRE_MAX_SAMPLES];
+  uint8_t quality[WIRE_MAX_SAMPLES];
+  uint8_t channel[WIRE_MAX_SAMPLES];
+  WireHeader header;
+  uint8_t buf[WIRE_MAX_FRAME];
+  size_t len;
+
+  explicit RandomFrame(uint32_t seed) {
+    FrameBatch batch;
+    uint32_t rng = seed;
+    for (uint8_t i = 0; i < WIRE_MAX_SAMPLES; ++i) {
+      rng = rng * 1103515245u + 12345u;
+      distance[i] = (rng >> 16) % 7 == 0 ? -1.0f : (float)((rng >> 8) % 60000) / 100.0f;
+      level[i] = (float)((rng >> 4) % 10000) / 100.0f;
+      quality[i] = distance[i] < 0 ? 0 : (uint8_t)((rng >> 12) % 101);
+      channel[i] = (uint8_t)((rng >> 20) % 3);
+      batch.add(1000 + i, distance[i], level[i], quality[i], channel[i]);
+    }
+    header.sensorId = (uint8_t)(seed % 255 + 1);
+    header.seq = (uint16_t)seed;
+    header.uptimeSec = 1000 + WIRE_MAX_SAMPLES;
+    header.barrelHeight = wireDistance(123.4f);
+    header.airTemp = wireTemp((float)((int32_t)(seed % 1250) - 400) / 10.0f);
+    header.trackedLevel = wireLevel((float)(seed % 10001) / 100.0f);
+    header.levelRate = wireRate((float)((int32_t)(seed * 7919 % 20001) - 10000) / 100.0f);
+    header.confidence = (uint8_t)(seed % 101);
+    header.trackedVolume = seed % 5 == 0 ? WIRE_NO_VOLUME : wireVolume((float)(seed * 104729 % 1000001) / 10.0f);
+    header.capacity = seed % 5 == 0 ? WIRE_NO_VOLUME : seed * 31;
+    len = batch.encode(header, buf, sizeof(buf));
+  }
+};
+
+}  // namespace
+
+void test_random_frames_round_trip() {
+  for (uint32_t seed = 1; seed <= 1000; ++seed) {
+    RandomFrame f(seed);
+    TEST_ASSERT_EQUAL_size_t(WIRE_MAX_FRAME, f.len);
+    WireFrame frame;
+    TEST_ASSERT_EQUAL_INT((int)WireResult::Ok, (int)decodeFrame(f.buf, f.len, frame));
+    const WireHeader& h = frame.header;
+    TEST_ASSERT_EQUAL_UINT8(f.header.sensorId, h.sensorId);
+    TEST_ASSERT_EQUAL_UINT16(f.header.seq, h.seq);
+    TEST_ASSERT_EQUAL_UINT8(WIRE_MAX_SAMPLES, h.count);
+    TEST_ASSERT_EQUAL_INT16(f.header.airTemp, h.airTemp);
+    TEST_ASSERT_EQUAL_UINT16(f.header.trackedLevel, h.trackedLevel);
+    TEST_ASSERT_EQUAL_INT16(f.header.levelRate, h.levelRate);
+    TEST_ASSERT_EQUAL_UINT8(f.header.confidence, h.confidence);
+    TEST_ASSERT_EQUAL_UINT32(f.header.trackedVolume, h.trackedVolume);
+    TEST_ASSERT_EQUAL_UINT32(f.header.capacity, h.capacity);
+    // Within fixed-point resolution, ages counted back from the header uptime
+    for (uint8_t i = 0; i < WIRE_MAX_SAMPLES; ++i) {
+      const WireSample& s = frame.samples[i];
+      TEST_ASSERT_EQUAL_UINT16(WIRE_MAX_SAMPLES - i, s.ageSec);
+      TEST_ASSERT_EQUAL_UINT8(f.quality[i], s.quality);
+      TEST_ASSERT_EQUAL_UINT8(f.channel[i], s.channel);
+      if (f.distance[i] < 0) TEST_ASSERT_EQUAL_UINT16(WIRE_NO_ECHO, s.distance);
+      else TEST_ASSERT_FLOAT_WITHIN(0.051f, f.distance[i], wireDistanceCm(s.distance));
+      TEST_ASSERT_FLOAT_WITHIN(0.0051f, f.level[i], wireLevelPercent(s.level));
+    }
+  }
+}
+
+// Only the current version is decoded, whatever else the frame holds
+void test_other_versions_rejected() {
+  RandomFrame f(7);
+  WireFrame frame;
+  for (uint16_t version = 0; version <= 0xFF; ++version) {
+    if (version == WIRE_VERSION) continue;
+    f.buf[1] = (uint8_t)version;
+    TEST_ASSERT_EQUAL_INT((int)WireResult::UnsupportedVersion, (int)decodeFrame(f.buf, f.len, frame));
+  }
+}
+
+void test_cut_off_frames_rejected() {
+  for (uint32_t seed = 1; seed <= 100; ++seed) {
+    RandomFrame f(seed);
+    WireFrame frame;
+    for (size_t cut = 0; cut < f.len; ++cut) {
+      TEST_ASSERT_NOT_EQUAL((int)WireResult::Ok, (int)decodeFrame(f.buf, cut, frame));
+    }
+  }
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_random_frames_round_trip);
+  RUN_TEST(test_other_versions_rejected);
+  RUN_TEST(test_cut_off_frames_rejected);
+  return UNITY_END();
+}
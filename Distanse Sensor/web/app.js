@@ -0,0 +1,312 @@
+/*
+   Shared script of all pages. The pages themselves are static; every
+   device value is fetched from the JSON API (/api/status, /api/macs)
+   and filled into the elements whose id matches the field name.
+*/
+
+var ESP_NOW_TEXT = {
+  ok: 'Connected',
+  error: 'Error',
+  disabled: 'Disabled (Parent MAC not configured)'
+};
+
+function $(id) {
+  return document.getElementById(id);
+}
+
+function api(path) {
+  return fetch(path).then(function (r) {
+    if (!r.ok) throw new Error('HTTP ' + r.status);
+    return r.json();
+  });
+}
+
+// Set the text of every element whose id is a key of values
+function fill(values) {
+  Object.keys(values).forEach(function (id) {
+    var el = $(id);
+    if (el) el.textContent = values[id];
+  });
+}
+
+function minSec(ms) {
+  return { minutes: Math.floor(ms / 60000), seconds: Math.floor(ms % 60000 / 1000) };
+}
+
+// Battery-mode statistics, present once the device has slept
+function wakes(w) {
+  if (!w) return '';
+  return ' (' + w.wakes + ' wakes, ' + w.avgMs + ' ms awake on average, max ' + w.maxMs + ' ms)';
+}
+
+// Serial sensor frame counters, present in the serial modes
+function serialFrames(r) {
+  if (!r) return '';
+  return ' (' + r.frames + ' frames, ' + r.checksumErrors + ' bad checksums)';
+}
+
+// Achieved ping rate, and the range gate in trigger/echo mode
+function pings(s) {
+  var r = ', ' + s.pingRate.toFixed(0) + ' pings/s' + (s.channelCount > 1 ? ' over ' + s.channelCount + ' sensors' : '');
+  if (!s.gate) return r;
+  return r + ' (gate ' + s.gate.nearCm.toFixed(0) + '-' + s.gate.farCm.toFixed(0) + ' cm, ' +
+    s.gate.rejected + ' rejected, ' + s.gate.timeouts + ' timeouts)';
+}
+
+// Backed-off reading interval, when one is configured
+function interval(s) {
+  if (s.refreshMaxMs <= s.refreshRateMs) return '';
+  var t = minSec(s.refreshMaxMs);
+  return ', up to ' + t.minutes + 'm ' + t.seconds + 's while the level is steady (now ' +
+    (s.interval.ms / 1000).toFixed(0) + ' s, ' + s.interval.reason + ')';
+}
+
+// Report policy: deadband, heartbeat and alarm levels
+function reports(s) {
+  var t = s.deadband > 0 ? 'moves over ' + s.deadband.toFixed(1) + '% or every ' + s.heartbeatS + ' s' : 'every reading';
+  if (s.lowAlarm > 0) t += ', alarm below ' + s.lowAlarm + '%';
+  if (s.highAlarm < 100) t += ', alarm above ' + s.highAlarm + '%';
+  return t;
+}
+
+// Liters, or nothing without a tank shape
+// Level in %, "no echo" when the firmware sends null
+function level(v) {
+  return v === null || v === undefined ? 'no echo' : v.toFixed(1) + '%';
+}
+
+function liters(v) {
+  return v === null || v === undefined ? '' : v.toFixed(1) + ' L';
+}
+
+function tank(t) {
+  return t.name + (t.capacity === null ? '' : ', ' + liters(t.capacity));
+}
+
+// Tracked level and fill/drain rate, in /api/status and /read
+function trend(s) {
+  if (!s.confidence) return 'no track yet';
+  var r = s.levelRate;
+  var dir = Math.abs(r) < 0.05 ? 'steady' : (r > 0 ? 'filling ' : 'draining ') + Math.abs(r).toFixed(2) + ' cm/min';
+  return s.trackedLevel.toFixed(1) + '%, ' + dir + ' (confidence ' + s.confidence + '%)';
+}
+
+// Echo quality of the last reading, in /api/status and /read
+function echo(s) {
+  if (s.distance < 0) return 'No echo (' + s.echo.label + ')';
+  return s.echo.confidence + '%' + (s.echo.label === 'valid' ? '' : ', mostly ' + s.echo.label);
+}
+
+// Readings of the additional sensors on the board (/api/status lists all
+// configured ones, /read only those in use)
+function others(s) {
+  var used = (s.channels || []).slice(1, s.channelCount || undefined);
+  if (!used.length) return 'None';
+  return used.map(function (c, i) {
+    return 'sensor ' + (i + 2) + ' ' + (c.distance < 0 ? 'no echo' : c.waterLevel.toFixed(1) + '% at ' +
+      c.distance.toFixed(1) + ' cm') + ' (echo ' + c.confidence + '%)';
+  }).join(', ');
+}
+
+// Status fields as they are displayed
+function describe(s) {
+  var t = minSec(s.refreshRateMs);
+  return {
+    wifiMac: s.wifiMac,
+    espNowMac: s.espNowMac,
+    parentMac: s.parentMac,
+    refreshRate: t.minutes + 'm ' + t.seconds + 's' + interval(s),
+    barrelHeight: s.barrelHeight,
+    mount: s.calibrated ? 'calibrated' : s.mountCm + ' cm above the full level',
+    sensorStatus: s.sensorName + serialFrames(s.serial) + pings(s),
+    temperature: s.temperature.toFixed(1) + ' \u00b0C (' + (s.tempSource === 'probe' ? 'probe' : 'configured') +
+      '), speed of sound ' + s.soundSpeed.toFixed(1) + ' m/s',
+    burst: s.burstSamples + ' pings, ' + s.filterName,
+    batch: s.batchSize > 1 ? s.batchSize + ' readings per frame, max ' + s.batchMaxAgeS + ' s' : 'Every reading',
+    reports: reports(s),
+    lowPower: s.lowPower ? 'Enabled' + wakes(s.sleep) : 'Disabled',
+    ledStatus: s.led ? 'Enabled' : 'Disabled',
+    ssidPrefix: s.ssidPrefix,
+    password: s.password,
+    espNow: ESP_NOW_TEXT[s.espNow],
+    waterLevel: level(s.waterLevel),
+    volume: liters(s.volume),
+    tank: tank(s.tank),
+    distance: s.distance.toFixed(1),
+    echo: echo(s),
+    trend: trend(s),
+    otherSensors: others(s)
+  };
+}
+
+function showEspNow(s) {
+  var el = $('espNow');
+  if (el) el.className = s.espNow === 'disabled' ? 'error' : 'ok';
+}
+
+var pages = {
+  // Status overview; an unconfigured device goes straight to the setup form
+  status: function () {
+    api('/api/status').then(function (s) {
+      if (!s.configured) {
+        location.replace('/update');
+        return;
+      }
+      fill(describe(s));
+    });
+    api('/api/espnow').then(function (e) {
+      fill({ delivery: e.acked + ' acked, ' + e.retried + ' retries, ' + e.dropped + ' dropped, ' + e.pending + ' pending; ' +
+        e.reported + ' readings reported, ' + e.suppressed + ' suppressed' });
+    });
+  },
+
+  // Settings form, used for the first setup and for later changes
+  update: function () {
+    api('/api/status').then(function (s) {
+      var f = document.forms.settings;
+      var t = minSec(s.refreshRateMs);
+      var max = minSec(Math.max(s.refreshMaxMs, s.refreshRateMs));
+      f.pmac.value = s.parentMac;
+      f.minutes.value = t.minutes;
+      f.seconds.value = t.seconds;
+      f.maxMinutes.value = max.minutes;
+      f.maxSeconds.value = max.seconds;
+      f.barrel.value = s.barrelHeight;
+      f.mount.value = s.mountCm;
+      f.shape.value = s.tank.shape;
+      f.tankWidth.value = s.tank.width;
+      f.tankLength.value = s.tank.length;
+      f.strap.value = s.tank.strap;
+      f.sensor.value = s.sensorMode;
+      f.channels.value = s.channelCount;
+      s.channels.forEach(function (c, i) {
+        if (!i) return;
+        f['trig' + i].value = c.trig;
+        f['echo' + i].value = c.echo;
+        f['barrel' + i].value = c.barrelHeight;
+        f['mount' + i].value = c.mountCm;
+      });
+      f.airTemp.value = s.airTemp;
+      f.probe.checked = s.tempProbe;
+      f.burst.value = s.burstSamples;
+      f.filter.value = s.filterMode;
+      f.batch.value = s.batchSize;
+      f.batchAge.value = s.batchMaxAgeS;
+      f.deadband.value = s.deadband;
+      f.heartbeat.value = s.heartbeatS;
+      f.lowAlarm.value = s.lowAlarm;
+      f.highAlarm.value = s.highAlarm;
+      f.outbox.value = s.outboxPolicy;
+      f.sleep.checked = s.lowPower;
+      f.stallMs.value = s.stallMs;
+      f.led.checked = s.led;
+      f.ssid.value = s.ssidPrefix;
+      f.password.value = s.password;
+
+      // Pins and tank of the additional sensors, shown as many as are on the board
+      function showChannels() {
+        for (var i = 1; $('channel' + i); ++i) $('channel' + i).hidden = i >= f.channels.value;
+      }
+      f.channels.onchange = showChannels;
+      showChannels();
+
+      fill(describe(s));
+      fill({ state: s.configured ? 'Updating configuration' : 'Initial configuration required' });
+      $('setup').hidden = s.configured;
+      $('cancel').hidden = !s.configured;
+    });
+  },
+
+  // Live reading, polled at the configured refresh rate
+  sensor: function () {
+    function show(s) {
+      fill(describe(s));
+      showEspNow(s);
+    }
+    api('/api/status').then(function (s) {
+      var t = minSec(s.refreshRateMs);
+      show(s);
+      fill({ every: t.minutes > 0 ? t.minutes + 'm ' + t.seconds + 's' : t.seconds + 's' });
+      setInterval(function () {
+        api('/api/status').then(show);
+      }, Math.max(s.refreshRateMs, 1000));
+    });
+
+    $('refreshBtn').onclick = function () {
+      var btn = $('refreshBtn');
+      btn.textContent = 'Refreshing...';
+      btn.disabled = true;
+      api('/read').then(function (r) {
+        fill({ waterLevel: level(r.waterLevel), volume: liters(r.volume), distance: r.distance.toFixed(1), barrelHeight: r.barrelHeight,
+               echo: echo(r), trend: trend(r), otherSensors: others(r) });
+        btn.textContent = 'Refresh Reading';
+        btn.disabled = false;
+      }).catch(function () {
+        btn.textContent = 'Error - Click to Retry';
+        btn.disabled = false;
+      });
+    };
+  },
+
+  debugmac: function () {
+    api('/api/macs').then(fill);
+
+    $('testBtn').onclick = function () {
+      api('/read').then(function () {
+        alert('Test data sent! Check your parent device to see which MAC address it reports.');
+      }).catch(function (e) {
+        alert('Error sending test data: ' + e);
+      });
+    };
+  },
+
+  // Capture points at known water heights, then fit and save the calibration
+  calibrate: function () {
+    function show(c) {
+      var f = c.calibrated ? 'fitted: height = ' + c.offset.toFixed(2) + ' cm ' + (c.gain < 0 ? '- ' : '+ ') +
+        Math.abs(c.gain).toFixed(4) + ' \u00d7 distance' + (c.quad ? ' ' + (c.quad < 0 ? '- ' : '+ ') +
+        Math.abs(c.quad).toExponential(2) + ' \u00d7 distance\u00b2' : '') +
+        (c.rms >= 0 ? ' (rms ' + c.rms.toFixed(2) + ' cm)' : '') :
+        'not calibrated: sensor ' + c.mountCm.toFixed(1) + ' cm above the full level of ' + c.barrelHeight.toFixed(0) + ' cm';
+      fill({ formula: f, reading: c.distance.toFixed(1) + ' cm, water height ' + c.height.toFixed(1) + ' cm', calError: '' });
+      var list = $('points');
+      list.textContent = '';
+      c.points.forEach(function (p, i) {
+        var li = document.createElement('li');
+        li.textContent = 'Point ' + (i + 1) + ': ' + p[0].toFixed(1) + ' cm at ' + p[1].toFixed(1) + ' cm height (reads ' +
+          (p[2] >= 0 ? '+' : '') + p[2].toFixed(2) + ' cm off)';
+        list.appendChild(li);
+      });
+      $('addBtn').disabled = c.points.length >= c.maxPoints;
+      var pick = $('channel');
+      while (pick.options.length < c.channels) pick.add(new Option('Sensor ' + (pick.options.length + 1), pick.options.length));
+      pick.value = c.channel;
+      $('channelPick').hidden = c.channels < 2;
+    }
+    function act(params) {
+      params.channel = $('channel').value || 0;
+      return fetch('/api/calibrate', { method: 'POST', body: new URLSearchParams(params) }).then(function (r) {
+        return r.ok ? r.json().then(show) : r.text().then(function (t) { fill({ calError: t }); });
+      });
+    }
+    api('/api/calibration').then(show);
+    $('channel').onchange = function () {
+      api('/api/calibration?channel=' + $('channel').value).then(show);
+    };
+    $('addBtn').onclick = function () {
+      $('addBtn').disabled = true;
+      act({ action: 'add', level: $('level').value }).then(function () { $('addBtn').disabled = false; });
+    };
+    $('fitBtn').onclick = function () {
+      var params = { action: 'fit' };
+      if ($('quadratic').checked) params.quadratic = 'on';
+      act(params);
+    };
+    $('clearBtn').onclick = function () { act({ action: 'clear' }); };
+    $('resetBtn').onclick = function () { act({ action: 'reset' }); };
+  },
+
+  reset: function () {}
+};
+
+pages[document.body.dataset.page]();